@@ -0,0 +1,489 @@
+// BenchmarkScenes.cpp : Generates the scenes used by the propagation benchmark.
+//
+#include "BenchmarkScenes.h"
+#include <cstring>
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Benchmark Scene Class Definition
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+BenchmarkScene::BenchmarkScene(const char* newName)
+	: name(newName)
+{
+}
+
+
+
+
+BenchmarkScene::~BenchmarkScene()
+{
+	// Remove everything from the scene before destroying it.
+	scene.removeAllObjects();
+	scene.removeAllSources();
+
+	for (Index i = 0; i < sources.getSize(); i++)
+		delete sources[i];
+
+	for (Index i = 0; i < objects.getSize(); i++)
+		delete objects[i];
+
+	for (Index i = 0; i < meshes.getSize(); i++)
+		delete meshes[i];
+}
+
+
+
+
+void BenchmarkScene::addMesh(SoundMesh* mesh)
+{
+	SoundObject* object = new SoundObject(mesh);
+
+	meshes.add(mesh);
+	objects.add(object);
+	scene.addObject(object);
+}
+
+
+
+
+void BenchmarkScene::addSource(const Vector3& position)
+{
+	SoundSource* source = new SoundSource(position);
+
+	// Use the same distance attenuation as playSound().
+	source->setIntensity(1);
+	source->setDistanceAttenuation(SoundDistanceAttenuation(1, 1, 0));
+
+	sources.add(source);
+	scene.addSource(source);
+}
+
+
+
+
+Size BenchmarkScene::getNumberOfTriangles() const
+{
+	Size numTriangles = 0;
+
+	for (Index i = 0; i < meshes.getSize(); i++)
+		numTriangles += meshes[i]->getNumberOfTriangles();
+
+	return numTriangles;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Geometry Helper Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// Return the material that is used for all benchmark geometry, the same one as in playSound().
+static SoundMaterial getDefaultMaterial()
+{
+	return SoundMaterial(
+		// The reflection attenuation for the material.
+		FrequencyResponse::getLinearHighRolloff(1000)*
+		FrequencyResponse::getLinearLowRolloff(200)*0.9,
+		// The transmisison attenuation per world unit for the material.
+		FrequencyResponse::getQuadraticHighRolloff(800)*0.9,
+		// The absorption attenuation for the material.
+		FrequencyResponse::getLinearHighRolloff()*0.5);
+}
+
+
+
+
+/// Append the 12 outward-facing triangles of an axis-aligned box to the specified vertex and triangle lists.
+static void addBox(const AABB3& box, ArrayList<SoundVertex>& vertices, ArrayList<SoundTriangle>& triangles)
+{
+	const Index v = vertices.getSize();
+
+	// Vertex i has the maximum x coordinate if bit 0 is set, y for bit 1, and z for bit 2.
+	for (Index i = 0; i < 8; i++)
+	{
+		vertices.add(SoundVertex((i & 1) ? box.max.x : box.min.x,
+								(i & 2) ? box.max.y : box.min.y,
+								(i & 4) ? box.max.z : box.min.z));
+	}
+
+	// negative x face
+	triangles.add(SoundTriangle(v + 0, v + 4, v + 6, 0));
+	triangles.add(SoundTriangle(v + 0, v + 6, v + 2, 0));
+
+	// positive x face
+	triangles.add(SoundTriangle(v + 1, v + 3, v + 7, 0));
+	triangles.add(SoundTriangle(v + 1, v + 7, v + 5, 0));
+
+	// negative y face
+	triangles.add(SoundTriangle(v + 0, v + 1, v + 5, 0));
+	triangles.add(SoundTriangle(v + 0, v + 5, v + 4, 0));
+
+	// positive y face
+	triangles.add(SoundTriangle(v + 2, v + 6, v + 7, 0));
+	triangles.add(SoundTriangle(v + 2, v + 7, v + 3, 0));
+
+	// negative z face
+	triangles.add(SoundTriangle(v + 0, v + 2, v + 3, 0));
+	triangles.add(SoundTriangle(v + 0, v + 3, v + 1, 0));
+
+	// positive z face
+	triangles.add(SoundTriangle(v + 4, v + 5, v + 7, 0));
+	triangles.add(SoundTriangle(v + 4, v + 7, v + 6, 0));
+}
+
+
+
+
+/// Create a mesh with the default material from the specified vertices and triangles.
+static SoundMesh* createMesh(const ArrayList<SoundVertex>& vertices, const ArrayList<SoundTriangle>& triangles)
+{
+	ArrayList<SoundMaterial> materials;
+	materials.add(getDefaultMaterial());
+
+	return new SoundMesh(vertices, triangles, materials);
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Scene Generation Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// The 4x3x8 meter box room from playSound(), with one source and the listener inside.
+static BenchmarkScene* createBoxScene(math::RandomVariable<Real>& random)
+{
+	BenchmarkScene* benchmarkScene = new BenchmarkScene("box");
+
+	ArrayList<SoundVertex> vertices;
+	ArrayList<SoundTriangle> triangles;
+
+	// The box is 1.5 units higher along the Y-axis so that its floor is at 0.
+	addBox(AABB3(-2, 2, 0, 3, -4, 4), vertices, triangles);
+	benchmarkScene->addMesh(createMesh(vertices, triangles));
+
+	benchmarkScene->addSource(Vector3(0, 1, -3));
+	benchmarkScene->listener.setPosition(Vector3(0, 1.5, 0));
+
+	return benchmarkScene;
+}
+
+
+
+
+/// A 3x3 grid of 5x3x4 meter rooms that are connected by doorways, with a desk and source in every room.
+static BenchmarkScene* createOfficeScene(math::RandomVariable<Real>& random)
+{
+	BenchmarkScene* benchmarkScene = new BenchmarkScene("office");
+
+	const Size numRooms = 3;
+	const Real roomWidth = 5;
+	const Real roomDepth = 4;
+	const Real roomHeight = 3;
+	const Real wallThickness = 0.1;
+	const Real doorWidth = 1;
+	const Real doorHeight = 2.1;
+	const Real width = numRooms*roomWidth;
+	const Real depth = numRooms*roomDepth;
+
+	ArrayList<SoundVertex> vertices;
+	ArrayList<SoundTriangle> triangles;
+
+	// The floor and ceiling.
+	addBox(AABB3(0, width, -wallThickness, 0, 0, depth), vertices, triangles);
+	addBox(AABB3(0, width, roomHeight, roomHeight + wallThickness, 0, depth), vertices, triangles);
+
+	for (Index i = 0; i <= numRooms; i++)
+	{
+		const Real x = i*roomWidth;
+		const Real z = i*roomDepth;
+		const Bool isExterior = i == 0 || i == numRooms;
+
+		for (Index j = 0; j < numRooms; j++)
+		{
+			// The walls of constant x, between rooms along the z axis.
+			const Real zMin = j*roomDepth;
+			const Real zMax = zMin + roomDepth;
+			const Real zDoor = (zMin + zMax)*Real(0.5);
+
+			if (isExterior)
+				addBox(AABB3(x, x + wallThickness, 0, roomHeight, zMin, zMax), vertices, triangles);
+			else
+			{
+				addBox(AABB3(x, x + wallThickness, 0, roomHeight, zMin, zDoor - doorWidth*Real(0.5)), vertices, triangles);
+				addBox(AABB3(x, x + wallThickness, 0, roomHeight, zDoor + doorWidth*Real(0.5), zMax), vertices, triangles);
+				addBox(AABB3(x, x + wallThickness, doorHeight, roomHeight,
+							zDoor - doorWidth*Real(0.5), zDoor + doorWidth*Real(0.5)), vertices, triangles);
+			}
+
+			// The walls of constant z, between rooms along the x axis.
+			const Real xMin = j*roomWidth;
+			const Real xMax = xMin + roomWidth;
+			const Real xDoor = (xMin + xMax)*Real(0.5);
+
+			if (isExterior)
+				addBox(AABB3(xMin, xMax, 0, roomHeight, z, z + wallThickness), vertices, triangles);
+			else
+			{
+				addBox(AABB3(xMin, xDoor - doorWidth*Real(0.5), 0, roomHeight, z, z + wallThickness), vertices, triangles);
+				addBox(AABB3(xDoor + doorWidth*Real(0.5), xMax, 0, roomHeight, z, z + wallThickness), vertices, triangles);
+				addBox(AABB3(xDoor - doorWidth*Real(0.5), xDoor + doorWidth*Real(0.5),
+							doorHeight, roomHeight, z, z + wallThickness), vertices, triangles);
+			}
+		}
+	}
+
+	// Put a desk in a random position in every room, and a source above it.
+	for (Index i = 0; i < numRooms; i++)
+	{
+		for (Index j = 0; j < numRooms; j++)
+		{
+			const Real x = i*roomWidth + random.sample(Real(1), roomWidth - Real(2.5));
+			const Real z = j*roomDepth + random.sample(Real(1), roomDepth - Real(1.75));
+
+			addBox(AABB3(x, x + Real(1.5), Real(0.7), Real(0.75), z, z + Real(0.75)), vertices, triangles);
+			benchmarkScene->addSource(Vector3(x + Real(0.75), Real(1.2), z + Real(0.375)));
+		}
+	}
+
+	benchmarkScene->addMesh(createMesh(vertices, triangles));
+
+	// The listener is in the center room, away from its desk.
+	benchmarkScene->listener.setPosition(Vector3(width*Real(0.5), Real(1.5), depth*Real(0.5) - Real(1.5)));
+
+	return benchmarkScene;
+}
+
+
+
+
+/// An 80x80 meter open area surrounded by buildings of random heights, with pillars and no ceiling.
+static BenchmarkScene* createCourtyardScene(math::RandomVariable<Real>& random)
+{
+	BenchmarkScene* benchmarkScene = new BenchmarkScene("courtyard");
+
+	const Real size = 80;
+	const Real halfSize = size*Real(0.5);
+	const Size numBuildingsPerSide = 6;
+	const Real buildingDepth = 10;
+	const Size numPillars = 12;
+	const Size numSources = 8;
+
+	ArrayList<SoundVertex> vertices;
+	ArrayList<SoundTriangle> triangles;
+
+	// The ground.
+	addBox(AABB3(-halfSize - buildingDepth, halfSize + buildingDepth, -1, 0,
+				-halfSize - buildingDepth, halfSize + buildingDepth), vertices, triangles);
+
+	// A ring of buildings with gaps between them on every side of the courtyard.
+	const Real buildingSpacing = size / numBuildingsPerSide;
+
+	for (Index i = 0; i < numBuildingsPerSide; i++)
+	{
+		const Real a = -halfSize + i*buildingSpacing + Real(1);
+		const Real b = a + buildingSpacing - Real(2);
+
+		addBox(AABB3(a, b, 0, random.sample(Real(6), Real(20)), -halfSize - buildingDepth, -halfSize), vertices, triangles);
+		addBox(AABB3(a, b, 0, random.sample(Real(6), Real(20)), halfSize, halfSize + buildingDepth), vertices, triangles);
+		addBox(AABB3(-halfSize - buildingDepth, -halfSize, 0, random.sample(Real(6), Real(20)), a, b), vertices, triangles);
+		addBox(AABB3(halfSize, halfSize + buildingDepth, 0, random.sample(Real(6), Real(20)), a, b), vertices, triangles);
+	}
+
+	// A fountain in the center and pillars at random positions.
+	addBox(AABB3(-3, 3, 0, Real(1.2), -3, 3), vertices, triangles);
+
+	for (Index i = 0; i < numPillars; i++)
+	{
+		const Real x = random.sample(-halfSize + Real(5), halfSize - Real(5));
+		const Real z = random.sample(-halfSize + Real(5), halfSize - Real(5));
+
+		addBox(AABB3(x - Real(0.4), x + Real(0.4), 0, 8, z - Real(0.4), z + Real(0.4)), vertices, triangles);
+	}
+
+	benchmarkScene->addMesh(createMesh(vertices, triangles));
+
+	for (Index i = 0; i < numSources; i++)
+	{
+		benchmarkScene->addSource(Vector3(random.sample(-halfSize + Real(5), halfSize - Real(5)),
+										random.sample(Real(1), Real(3)),
+										random.sample(-halfSize + Real(5), halfSize - Real(5))));
+	}
+
+	benchmarkScene->listener.setPosition(Vector3(0, Real(1.7), 8));
+
+	return benchmarkScene;
+}
+
+
+
+
+/// A closed cave with an irregular surface made of 128x256 quads, with the listener and sources inside.
+static BenchmarkScene* createDenseScene(math::RandomVariable<Real>& random)
+{
+	BenchmarkScene* benchmarkScene = new BenchmarkScene("dense");
+
+	const Size numRings = 128;
+	const Size numSegments = 256;
+	const Size numWaves = 6;
+	const Real radius = 10;
+	const Size numSources = 4;
+
+	// The cave's radius is perturbed by a sum of waves with random frequencies and phases.
+	Real waveFrequencies[numWaves][2];
+	Real wavePhases[numWaves];
+
+	for (Index w = 0; w < numWaves; w++)
+	{
+		waveFrequencies[w][0] = random.sample(Real(1), Real(12));
+		waveFrequencies[w][1] = random.sample(Real(1), Real(12));
+		wavePhases[w] = random.sample(Real(0), Real(2)*math::pi<Real>());
+	}
+
+	ArrayList<SoundVertex> vertices;
+	ArrayList<SoundTriangle> triangles;
+
+	// The poles of the cave.
+	vertices.add(SoundVertex(0, -radius, 0));
+	vertices.add(SoundVertex(0, radius, 0));
+
+	for (Index i = 1; i < numRings; i++)
+	{
+		const Real theta = math::pi<Real>()*Real(i) / Real(numRings);
+
+		for (Index j = 0; j < numSegments; j++)
+		{
+			const Real phi = Real(2)*math::pi<Real>()*Real(j) / Real(numSegments);
+			Real r = radius;
+
+			for (Index w = 0; w < numWaves; w++)
+				r += Real(0.3)*math::sin(waveFrequencies[w][0]*theta + waveFrequencies[w][1]*phi + wavePhases[w]);
+
+			vertices.add(SoundVertex(r*math::sin(theta)*math::cos(phi),
+									-r*math::cos(theta),
+									r*math::sin(theta)*math::sin(phi)));
+		}
+	}
+
+	// The vertex index of segment j on ring i, where rings start at 1.
+	#define RING_VERTEX(i, j) (2 + ((i) - 1)*numSegments + ((j) % numSegments))
+
+	for (Index j = 0; j < numSegments; j++)
+	{
+		triangles.add(SoundTriangle(0, RING_VERTEX(1, j), RING_VERTEX(1, j + 1), 0));
+		triangles.add(SoundTriangle(1, RING_VERTEX(numRings - 1, j + 1), RING_VERTEX(numRings - 1, j), 0));
+	}
+
+	for (Index i = 1; i < numRings - 1; i++)
+	{
+		for (Index j = 0; j < numSegments; j++)
+		{
+			triangles.add(SoundTriangle(RING_VERTEX(i, j), RING_VERTEX(i + 1, j), RING_VERTEX(i + 1, j + 1), 0));
+			triangles.add(SoundTriangle(RING_VERTEX(i, j), RING_VERTEX(i + 1, j + 1), RING_VERTEX(i, j + 1), 0));
+		}
+	}
+
+	#undef RING_VERTEX
+
+	benchmarkScene->addMesh(createMesh(vertices, triangles));
+
+	for (Index i = 0; i < numSources; i++)
+	{
+		benchmarkScene->addSource(Vector3(random.sample(Real(-5), Real(5)),
+										random.sample(Real(-5), Real(5)),
+										random.sample(Real(-5), Real(5))));
+	}
+
+	benchmarkScene->listener.setPosition(Vector3(0, 0, 0));
+
+	return benchmarkScene;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Scene Lookup Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// A function which generates a benchmark scene using the specified random variable.
+typedef BenchmarkScene* (*BenchmarkSceneGenerator)(math::RandomVariable<Real>& random);
+
+
+/// The name and generator function for each benchmark scene.
+static const struct
+{
+	const char* name;
+	BenchmarkSceneGenerator generator;
+}
+benchmarkScenes[] =
+{
+	{ "box", createBoxScene },
+	{ "office", createOfficeScene },
+	{ "courtyard", createCourtyardScene },
+	{ "dense", createDenseScene }
+};
+
+
+
+
+Size getNumberOfBenchmarkScenes()
+{
+	return sizeof(benchmarkScenes) / sizeof(benchmarkScenes[0]);
+}
+
+
+
+
+const char* getBenchmarkSceneName(Index sceneIndex)
+{
+	return benchmarkScenes[sceneIndex].name;
+}
+
+
+
+
+BenchmarkScene* createBenchmarkScene(const char* name, UInt32 seed)
+{
+	for (Index i = 0; i < getNumberOfBenchmarkScenes(); i++)
+	{
+		if (std::strcmp(name, benchmarkScenes[i].name) == 0)
+		{
+			math::RandomVariable<Real> random(seed);
+
+			return benchmarkScenes[i].generator(random);
+		}
+	}
+
+	return NULL;
+}
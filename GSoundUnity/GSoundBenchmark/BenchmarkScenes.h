@@ -0,0 +1,120 @@
+// BenchmarkScenes.h : Declares the procedurally generated scenes used by the propagation benchmark.
+//
+#ifndef INCLUDE_GSOUND_BENCHMARK_SCENES_H
+#define INCLUDE_GSOUND_BENCHMARK_SCENES_H
+
+
+#include "gsound/GSound.h"
+
+
+using namespace gsound;
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Benchmark Scene Class Declaration
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// A scene, listener, and the objects that they reference, generated from a fixed seed.
+/**
+  * The scene owns all of the meshes, objects, and sources that it contains and
+  * destroys them when it is destroyed. Generating a scene with the same name and
+  * seed always produces the same geometry and source positions.
+  */
+class BenchmarkScene
+{
+	public:
+
+		/// Create an empty benchmark scene with the specified name.
+		BenchmarkScene(const char* newName);
+
+
+		/// Destroy the scene and all of the meshes, objects, and sources that it owns.
+		~BenchmarkScene();
+
+
+		/// Add a mesh to the scene as a new object with the identity transformation.
+		void addMesh(SoundMesh* mesh);
+
+
+		/// Add a sound source at the specified position to the scene.
+		void addSource(const Vector3& position);
+
+
+		/// Return the total number of triangles in all of the scene's objects.
+		Size getNumberOfTriangles() const;
+
+
+		/// The name of the scene, as it should appear in the benchmark output.
+		const char* name;
+
+
+		/// The scene that is used for propagation.
+		SoundScene scene;
+
+
+		/// The listener that sound is propagated to.
+		SoundListener listener;
+
+
+	private:
+
+		/// Declared but not defined so that scenes can't be copied.
+		BenchmarkScene(const BenchmarkScene& other);
+		BenchmarkScene& operator = (const BenchmarkScene& other);
+
+
+		/// The meshes that are owned by the scene.
+		ArrayList<SoundMesh*> meshes;
+
+
+		/// The objects that are owned by the scene.
+		ArrayList<SoundObject*> objects;
+
+
+		/// The sources that are owned by the scene.
+		ArrayList<SoundSource*> sources;
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Scene Generation Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// Return the number of scenes that can be generated by createBenchmarkScene().
+Size getNumberOfBenchmarkScenes();
+
+
+/// Return the name of the benchmark scene at the specified index.
+const char* getBenchmarkSceneName(Index sceneIndex);
+
+
+/// Generate the benchmark scene with the specified name, or return NULL if there is no scene with that name.
+/**
+  * The available scenes are:
+  * - "box": the 4x3x8 meter box room that is used by playSound().
+  * - "office": a 3x3 grid of furnished rooms connected by doorways.
+  * - "courtyard": a large open area surrounded by buildings with no ceiling.
+  * - "dense": a closed, irregular cave made of over 60,000 triangles.
+  */
+BenchmarkScene* createBenchmarkScene(const char* name, UInt32 seed);
+
+
+#endif // INCLUDE_GSOUND_BENCHMARK_SCENES_H
@@ -0,0 +1,368 @@
+// GSoundBenchmark.cpp : Defines the entry point for the headless propagation and rendering benchmarks.
+//
+// The benchmark doesn't use any audio devices, so it also builds on platforms
+// without one. On Linux it can be built from this directory with:
+//
+//     g++ -O2 -std=c++11 -msse4.1 -fpermissive -DGSOUND_PROPAGATION_STATISTICS=1
+//         -DGSOUND_RENDERING_STATISTICS=1 -I../GSoundUnity *.cpp ../GSoundUnity/gsound/*.cpp
+//         ../GSoundUnity/gsound/internal/*.cpp ../GSoundUnity/gsound/dsp/*.cpp
+//         ../GSoundUnity/gsound/util/*.cpp -lpthread -o GSoundBenchmark
+//
+// The per-stage times are only reported when GSOUND_PROPAGATION_STATISTICS and
+// GSOUND_RENDERING_STATISTICS are enabled for the whole build. Otherwise those columns
+// are left empty and the ray count is the number of rays that were requested rather
+// than the number that were traced.
+//
+// By default the propagation benchmark is run. With --renderer, the renderer is
+// instead driven with synthetic propagation paths and its cost per audio block is
+// written in a different CSV format.
+//
+// The renderer's delay line reads whole SIMD sample frames, so changes to it should
+// also be checked with AddressSanitizer. Build as above with -O1 -g -fsanitize=address
+// in place of -O2 and run it with:
+//
+//     ASAN_OPTIONS=detect_leaks=0:alloc_dealloc_mismatch=0 ./GSoundBenchmark --renderer
+//
+#include "BenchmarkScenes.h"
+#include "RendererBenchmark.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(GSOUND_PLATFORM_WINDOWS)
+#define NOMINMAX
+#include <Windows.h>
+#include <Psapi.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(GSOUND_PLATFORM_APPLE)
+#include <mach/mach.h>
+#elif defined(GSOUND_PLATFORM_LINUX)
+#include <unistd.h>
+#endif
+
+using gsound::util::Timer;
+
+
+/// The settings that apply to every benchmark run.
+struct BenchmarkSettings
+{
+	/// The seed used to generate the scenes and the probe ray directions.
+	UInt32 seed;
+
+	/// The number of frames that are propagated before timing begins.
+	Size numWarmupFrames;
+
+	/// The number of frames that are timed for each configuration.
+	Size numFrames;
+
+	/// The number of threads that the propagator uses to trace listener probe rays.
+	Size numThreads;
+};
+
+
+/// The listener probe ray counts that each scene is benchmarked with.
+static const Size listenerRayCounts[] = { 1000, 4000, 16000 };
+
+/// The probe depths that each scene is benchmarked with.
+static const Size probeDepths[] = { 2, 4, 8 };
+
+/// The number of source probe rays per listener probe ray.
+static const Size sourceRayDivisor = 10;
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Memory Usage Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// Return the number of bytes of memory that are resident for the current process, or 0 if it is unknown.
+static Size getResidentMemory()
+{
+#if defined(GSOUND_PLATFORM_WINDOWS)
+	PROCESS_MEMORY_COUNTERS counters;
+
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+		return (Size)counters.WorkingSetSize;
+#elif defined(GSOUND_PLATFORM_APPLE)
+	mach_task_basic_info info;
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+
+	if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+		return (Size)info.resident_size;
+#elif defined(GSOUND_PLATFORM_LINUX)
+	// The second field of statm is the number of resident pages.
+	FILE* statm = std::fopen("/proc/self/statm", "r");
+
+	if (statm != NULL)
+	{
+		unsigned long numPages = 0, numResidentPages = 0;
+		const int numFields = std::fscanf(statm, "%lu %lu", &numPages, &numResidentPages);
+		std::fclose(statm);
+
+		if (numFields == 2)
+			return (Size)numResidentPages*(Size)sysconf(_SC_PAGESIZE);
+	}
+#endif
+
+	return 0;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Benchmark Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// Write the CSV column names to the specified file.
+static void writeHeader(FILE* output)
+{
+	std::fprintf(output, "scene,triangles,sources,threads,listener_rays,source_rays,depth,frames,"
+		"mean_frame_ms,max_frame_ms,rays_per_second,paths,"
+		"direct_ms,validation_ms,source_ms,listener_ms,memory_mb\n");
+}
+
+
+
+
+/// Propagate sound in the scene with the specified ray count and depth and write one CSV row with the results.
+static void runBenchmark(BenchmarkScene& benchmarkScene, Size numListenerRays, Size depth,
+						const BenchmarkSettings& settings, FILE* output)
+{
+	const Size numSourceRays = numListenerRays / sourceRayDivisor;
+	const Size numSources = benchmarkScene.scene.getNumberOfSources();
+
+	// Use a new propagator for every configuration so that no cached paths carry over.
+	SoundPropagator propagator;
+	propagator.setDirectSoundIsEnabled(true);
+	propagator.setTransmissionIsEnabled(true);
+	propagator.setReflectionIsEnabled(true);
+	propagator.setDiffractionIsEnabled(true);
+	propagator.setReverbIsEnabled(true);
+	propagator.setNumberOfThreads(settings.numThreads);
+	propagator.setRandomSeed(settings.seed);
+
+	SoundPropagationPathBuffer pathBuffer;
+
+	// Let the path caches fill up before timing begins.
+	for (Index frame = 0; frame < settings.numWarmupFrames; frame++)
+	{
+		propagator.propagateSound(benchmarkScene.scene, benchmarkScene.listener,
+			depth, numListenerRays, depth, numSourceRays, pathBuffer);
+	}
+
+	Double totalTime = 0;
+	Double maxTime = 0;
+	Double totalRays = 0;
+	Size totalPaths = 0;
+#if GSOUND_PROPAGATION_STATISTICS
+	Double directTime = 0;
+	Double validationTime = 0;
+	Double sourceTime = 0;
+	Double listenerTime = 0;
+#endif
+
+	for (Index frame = 0; frame < settings.numFrames; frame++)
+	{
+		const Double startTime = Timer::getTime();
+
+		propagator.propagateSound(benchmarkScene.scene, benchmarkScene.listener,
+			depth, numListenerRays, depth, numSourceRays, pathBuffer);
+
+		const Double frameTime = Timer::getTime() - startTime;
+
+		totalTime += frameTime;
+		maxTime = math::max(maxTime, frameTime);
+		totalPaths += pathBuffer.getTotalNumberOfPropagationPaths();
+
+#if GSOUND_PROPAGATION_STATISTICS
+		const SoundPropagationStatistics& statistics = propagator.getStatistics();
+		totalRays += Double(statistics.numRaysTraced);
+		directTime += statistics.directPathTime;
+		validationTime += statistics.cachedPathValidationTime;
+		sourceTime += statistics.sourcePropagationTime;
+		listenerTime += statistics.listenerPropagationTime;
+#else
+		totalRays += Double(numListenerRays*depth + numSources*numSourceRays*depth);
+#endif
+	}
+
+	const Double numFrames = Double(settings.numFrames);
+
+	std::fprintf(output, "%s,%u,%u,%u,%u,%u,%u,%u,%.3f,%.3f,%.0f,%.1f,",
+		benchmarkScene.name, (unsigned int)benchmarkScene.getNumberOfTriangles(), (unsigned int)numSources,
+		(unsigned int)settings.numThreads, (unsigned int)numListenerRays, (unsigned int)numSourceRays,
+		(unsigned int)depth, (unsigned int)settings.numFrames,
+		1000.0*totalTime / numFrames, 1000.0*maxTime,
+		totalTime > 0 ? totalRays / totalTime : 0.0, Double(totalPaths) / numFrames);
+
+#if GSOUND_PROPAGATION_STATISTICS
+	std::fprintf(output, "%.3f,%.3f,%.3f,%.3f,",
+		1000.0*directTime / numFrames, 1000.0*validationTime / numFrames,
+		1000.0*sourceTime / numFrames, 1000.0*listenerTime / numFrames);
+#else
+	std::fprintf(output, ",,,,");
+#endif
+
+	std::fprintf(output, "%.1f\n", Double(getResidentMemory()) / (1024.0*1024.0));
+	std::fflush(output);
+}
+
+
+
+
+/// Run every ray count and depth configuration for the scene with the specified name.
+static Bool runSceneBenchmarks(const char* sceneName, const BenchmarkSettings& settings, FILE* output)
+{
+	BenchmarkScene* benchmarkScene = createBenchmarkScene(sceneName, settings.seed);
+
+	if (benchmarkScene == NULL)
+	{
+		std::fprintf(stderr, "Unknown scene '%s'.\n", sceneName);
+		return false;
+	}
+
+	for (Index i = 0; i < sizeof(listenerRayCounts) / sizeof(listenerRayCounts[0]); i++)
+	{
+		for (Index j = 0; j < sizeof(probeDepths) / sizeof(probeDepths[0]); j++)
+			runBenchmark(*benchmarkScene, listenerRayCounts[i], probeDepths[j], settings, output);
+	}
+
+	delete benchmarkScene;
+
+	return true;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Main Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+static void printUsage(const char* programName)
+{
+	std::fprintf(stderr, "Usage: %s [options]\n"
+		"  --renderer        Benchmark the audio renderer instead of sound propagation.\n"
+		"  --scene <name>    Only benchmark the named scene (box, office, courtyard, dense).\n"
+		"  --frames <n>      The number of timed frames per configuration (default 10).\n"
+		"  --warmup <n>      The number of untimed frames per configuration (default 2).\n"
+		"  --threads <n>     The number of listener propagation threads (default 1).\n"
+		"  --seed <n>        The seed for scene generation and ray directions (default 1).\n"
+		"  --duration <s>    The seconds of audio rendered per renderer configuration (default 0.25).\n"
+		"  --sources <n>     The largest number of sources rendered by the renderer benchmark (default 512).\n"
+		"  --output <file>   Write the CSV results to a file instead of standard output.\n",
+		programName);
+}
+
+
+
+
+int main(int argc, char** argv)
+{
+	BenchmarkSettings settings;
+	settings.seed = 1;
+	settings.numWarmupFrames = 2;
+	settings.numFrames = 10;
+	settings.numThreads = 1;
+
+	RendererBenchmarkSettings rendererSettings;
+	rendererSettings.numWarmupBlocks = 4;
+	rendererSettings.duration = 0.25;
+	rendererSettings.maxNumberOfSources = 512;
+
+	const char* sceneName = NULL;
+	const char* outputPath = NULL;
+	Bool benchmarkRenderer = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const Bool hasValue = i + 1 < argc;
+
+		if (std::strcmp(argv[i], "--renderer") == 0)
+			benchmarkRenderer = true;
+		else if (std::strcmp(argv[i], "--scene") == 0 && hasValue)
+			sceneName = argv[++i];
+		else if (std::strcmp(argv[i], "--frames") == 0 && hasValue)
+			settings.numFrames = math::max((Size)std::atoi(argv[++i]), Size(1));
+		else if (std::strcmp(argv[i], "--warmup") == 0 && hasValue)
+			settings.numWarmupFrames = (Size)std::atoi(argv[++i]);
+		else if (std::strcmp(argv[i], "--threads") == 0 && hasValue)
+			settings.numThreads = math::max((Size)std::atoi(argv[++i]), Size(1));
+		else if (std::strcmp(argv[i], "--seed") == 0 && hasValue)
+			settings.seed = (UInt32)std::strtoul(argv[++i], NULL, 10);
+		else if (std::strcmp(argv[i], "--duration") == 0 && hasValue)
+			rendererSettings.duration = math::max(std::atof(argv[++i]), 0.001);
+		else if (std::strcmp(argv[i], "--sources") == 0 && hasValue)
+			rendererSettings.maxNumberOfSources = math::max((Size)std::atoi(argv[++i]), Size(1));
+		else if (std::strcmp(argv[i], "--output") == 0 && hasValue)
+			outputPath = argv[++i];
+		else
+		{
+			printUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	FILE* output = stdout;
+
+	if (outputPath != NULL)
+	{
+		output = std::fopen(outputPath, "w");
+
+		if (output == NULL)
+		{
+			std::fprintf(stderr, "Unable to open '%s' for writing.\n", outputPath);
+			return 1;
+		}
+	}
+
+	rendererSettings.seed = settings.seed;
+
+	Bool success = true;
+
+	if (benchmarkRenderer)
+	{
+		writeRendererHeader(output);
+		runRendererBenchmarks(rendererSettings, output);
+	}
+	else
+	{
+		writeHeader(output);
+
+		if (sceneName != NULL)
+			success = runSceneBenchmarks(sceneName, settings, output);
+		else
+		{
+			for (Index i = 0; i < getNumberOfBenchmarkScenes(); i++)
+				success &= runSceneBenchmarks(getBenchmarkSceneName(i), settings, output);
+		}
+	}
+
+	if (output != stdout)
+		std::fclose(output);
+
+	return success ? 0 : 1;
+}
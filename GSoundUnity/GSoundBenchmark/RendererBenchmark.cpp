@@ -0,0 +1,397 @@
+// RendererBenchmark.cpp : Measures how long the propagation renderer takes to render synthetic paths.
+//
+#include "RendererBenchmark.h"
+
+
+/// The source counts that are rendered.
+static const Size sourceCounts[] = { 1, 8, 64, 512 };
+
+/// The numbers of propagation paths per source that are rendered.
+static const Size pathCounts[] = { 1, 10, 50, 200 };
+
+/// The numbers of frequency bands that the source audio is split into.
+static const Size frequencyBandCounts[] = { 4, 8 };
+
+/// The audio block sizes, in samples, that the renderer is asked for.
+static const Size blockSizes[] = { 64, 256, 1024 };
+
+/// The number of times per second of rendered audio that new paths are published to the renderer.
+static const Double pathUpdateRate = 30.0;
+
+/// The speed of sound used to compute the path delays, in meters per second.
+static const Real speedOfSound = 343;
+
+/// The shortest and longest synthetic path lengths, in meters.
+/**
+  * The longest path has a delay of about 0.3 seconds, which is less than the
+  * renderer's default maximum delay time, so no path is clamped.
+  */
+static const Real minPathDistance = 1;
+static const Real maxPathDistance = 100;
+
+/// The fastest speed, in meters per second, at which a path's length changes when Doppler is enabled.
+static const Real maxPathSpeed = 10;
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Noise Sound Output Class
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// A mono sound output that produces white noise forever.
+/**
+  * Every source in the benchmark has its own noise generator so that the cost
+  * of reading the source audio is the same as for a source playing a sound file.
+  */
+class NoiseSoundOutput : public SoundOutput
+{
+	public:
+
+		/// Create a noise generator with the specified nonzero seed.
+		NoiseSoundOutput(UInt32 seed)
+			: state(seed | 1)
+		{
+		}
+
+
+		virtual Float getSampleRate() const
+		{
+			return Float(44100);
+		}
+
+
+		virtual Size getNumberOfChannels() const
+		{
+			return 1;
+		}
+
+
+		virtual Size getNumberOfOutputs() const
+		{
+			return 1;
+		}
+
+
+		virtual Bool hasOutputRemaining() const
+		{
+			return true;
+		}
+
+
+	protected:
+
+		virtual Size fillBuffer(SoundStream& stream, Index startIndex, Size numSamples)
+		{
+			Sample* output = stream.getBuffer(0).getChannelStart(0) + startIndex;
+			const Sample* const outputEnd = output + numSamples;
+
+			while (output != outputEnd)
+			{
+				// Use a xorshift generator, which is cheap enough not to affect the timing.
+				state ^= state << 13;
+				state ^= state >> 17;
+				state ^= state << 5;
+
+				*output = Sample(Float(state)*(Float(0.2) / Float(4294967295.0)) - Float(0.1));
+				output++;
+			}
+
+			return numSamples;
+		}
+
+
+	private:
+
+		/// The current state of the random number generator.
+		UInt32 state;
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Synthetic Path Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// The state of one synthetic propagation path that changes between path updates.
+struct SyntheticPath
+{
+	/// The direction from the listener to the virtual source of the path.
+	Vector3 direction;
+
+	/// The length of the path in meters.
+	Real distance;
+
+	/// The rate at which the length of the path changes, in meters per second.
+	Real speed;
+
+	/// The attenuation of the path in each frequency band.
+	FrequencyResponse attenuation;
+};
+
+
+
+
+/// Return a frequency partition with the specified number of bands (4 or 8), spaced at octaves or two octaves.
+static FrequencyPartition getBenchmarkFrequencyPartition(Size numFrequencyBands)
+{
+	FrequencyPartition frequencyPartition;
+
+	if (numFrequencyBands >= 8)
+	{
+		for (Real frequency = 88; frequency < 10000; frequency *= 2)
+			frequencyPartition.addSplitFrequency(frequency);
+	}
+	else
+	{
+		// These are the same bands that playSound() and renderSound() use.
+		frequencyPartition.addSplitFrequency(250);
+		frequencyPartition.addSplitFrequency(1000);
+		frequencyPartition.addSplitFrequency(4000);
+	}
+
+	return frequencyPartition;
+}
+
+
+
+
+/// Fill the path buffer with the current state of every synthetic path.
+/**
+  * Each path has a unique description made from the source, one reflection whose
+  * object is the address of that path's state, and the listener, so that the
+  * renderer matches each path to the same render state from update to update.
+  */
+static void fillPathBuffer(const ArrayList<SoundSource*>& sources, const ArrayList<SyntheticPath>& paths,
+						Size numPathsPerSource, const SoundListener& listener, Bool doppler,
+						SoundPropagationPathBuffer& pathBuffer)
+{
+	const Size numSources = sources.getSize();
+	const SoundSourceReverbResponse reverbResponse(Real(500), Real(400), FrequencyResponse(Real(0.8)), FrequencyResponse(Real(0.1)));
+
+	pathBuffer.setNumberOfSources(numSources);
+
+	for (Index s = 0; s < numSources; s++)
+	{
+		SoundSourcePropagationPathBuffer& sourceBuffer = pathBuffer.getSourceBuffer(s);
+		sourceBuffer.setSource(sources[s]);
+		sourceBuffer.clearPropagationPaths();
+		sourceBuffer.setReverbResponse(reverbResponse);
+
+		for (Index p = 0; p < numPathsPerSource; p++)
+		{
+			const SyntheticPath& path = paths[s*numPathsPerSource + p];
+
+			PropagationPathDescription description;
+			description.addPoint(PropagationPathPoint(PropagationPathPoint::SOURCE, sources[s]));
+			description.addPoint(PropagationPathPoint(PropagationPathPoint::TRIANGLE_REFLECTION, &path));
+			description.addPoint(PropagationPathPoint(PropagationPathPoint::LISTENER, &listener));
+
+			sourceBuffer.addPropagationPath(PropagationPath(path.direction, path.distance,
+				doppler ? path.speed : Real(0), speedOfSound, path.attenuation, description));
+		}
+	}
+}
+
+
+
+
+/// Move every synthetic path by the distance that it travels in the specified time, reversing at the length limits.
+static void moveSyntheticPaths(ArrayList<SyntheticPath>& paths, Real timeStep)
+{
+	for (Index i = 0; i < paths.getSize(); i++)
+	{
+		SyntheticPath& path = paths[i];
+		path.distance += path.speed*timeStep;
+
+		if (path.distance < minPathDistance || path.distance > maxPathDistance)
+		{
+			path.distance = math::clamp(path.distance, minPathDistance, maxPathDistance);
+			path.speed = -path.speed;
+		}
+	}
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Rendering Benchmark Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void writeRendererHeader(FILE* output)
+{
+	std::fprintf(output, "sources,paths_per_source,bands,block_size,reverb,doppler,blocks,"
+		"mean_block_us,max_block_us,real_time_factor,"
+		"update_us,crossover_us,delay_line_us,reverb_us,interpolated_paths\n");
+}
+
+
+
+
+/// Render the synthetic paths for one configuration and write one CSV row with the results.
+static void runRendererBenchmark(Size numSources, Size numPathsPerSource, Size numFrequencyBands,
+								Size blockSize, Bool reverb, Bool doppler,
+								const RendererBenchmarkSettings& settings, FILE* output)
+{
+	math::RandomVariable<Real> random(settings.seed);
+
+	//***********************************************************************
+	// Create the sources and their paths.
+
+	SoundListener listener;
+	ArrayList<NoiseSoundOutput*> noiseOutputs;
+	ArrayList<SoundSource*> sources;
+	ArrayList<SyntheticPath> paths;
+
+	for (Index s = 0; s < numSources; s++)
+	{
+		NoiseSoundOutput* noise = new NoiseSoundOutput(settings.seed + UInt32(s)*7919);
+		SoundSource* source = new SoundSource();
+		source->setIntensity(1);
+		source->setSoundInput(noise);
+
+		noiseOutputs.add(noise);
+		sources.add(source);
+
+		for (Index p = 0; p < numPathsPerSource; p++)
+		{
+			SyntheticPath path;
+			path.direction = Vector3(random.sample(-1, 1), random.sample(-1, 1), random.sample(-1, 1)).normalize();
+			path.distance = random.sample(minPathDistance, maxPathDistance);
+			path.speed = random.sample(-maxPathSpeed, maxPathSpeed);
+			path.attenuation = FrequencyResponse(random.sample(0.1, 1), random.sample(0.1, 1),
+				random.sample(0.1, 1), random.sample(0.1, 1), random.sample(0.1, 1),
+				random.sample(0.1, 1), random.sample(0.1, 1), random.sample(0.1, 1));
+
+			paths.add(path);
+		}
+	}
+
+	//***********************************************************************
+	// Create the renderer and a virtual device that pulls blocks from it.
+
+	SoundPropagationRenderer* renderer = new SoundPropagationRenderer(SpeakerConfiguration::getStereo());
+	renderer->setFrequencyPartition(getBenchmarkFrequencyPartition(numFrequencyBands));
+	renderer->setReverbIsEnabled(reverb);
+
+	VirtualSoundOutputDevice outputDevice(blockSize);
+	outputDevice.setInput(renderer);
+
+	SoundPropagationPathBuffer pathBuffer;
+	const Double updateInterval = 1.0 / pathUpdateRate;
+
+	fillPathBuffer(sources, paths, numPathsPerSource, listener, doppler, pathBuffer);
+	renderer->updatePropagationPaths(pathBuffer);
+
+	// Render a few blocks so that every delay buffer has been allocated before timing begins.
+	for (Index i = 0; i < settings.numWarmupBlocks; i++)
+		outputDevice.renderBlock();
+
+	outputDevice.resetTiming();
+#if GSOUND_RENDERING_STATISTICS
+	renderer->resetStatistics();
+#endif
+
+	//***********************************************************************
+	// Render the audio, publishing new paths at the update rate.
+
+	const Double endTime = outputDevice.getCurrentTime() + settings.duration;
+
+	while (outputDevice.getCurrentTime() < endTime)
+	{
+		if (doppler)
+			moveSyntheticPaths(paths, Real(updateInterval));
+
+		fillPathBuffer(sources, paths, numPathsPerSource, listener, doppler, pathBuffer);
+		renderer->updatePropagationPaths(pathBuffer);
+
+		outputDevice.render(math::min(updateInterval, endTime - outputDevice.getCurrentTime()));
+	}
+
+	//***********************************************************************
+	// Write the results.
+
+	const Size numBlocks = outputDevice.getNumberOfBlocksRendered();
+
+	std::fprintf(output, "%u,%u,%u,%u,%d,%d,%u,%.2f,%.2f,%.4f,",
+		(unsigned int)numSources, (unsigned int)numPathsPerSource, (unsigned int)numFrequencyBands,
+		(unsigned int)blockSize, reverb ? 1 : 0, doppler ? 1 : 0, (unsigned int)numBlocks,
+		1.0e6*outputDevice.getAverageBlockTime(), 1.0e6*outputDevice.getMaxBlockTime(),
+		outputDevice.getRealTimeFactor());
+
+#if GSOUND_RENDERING_STATISTICS
+	const SoundRenderingStatistics& statistics = renderer->getStatistics();
+	const Double blockCount = Double(math::max(statistics.numBuffersRendered, Size(1)));
+
+	std::fprintf(output, "%.2f,%.2f,%.2f,%.2f,%.3f\n",
+		1.0e6*statistics.targetUpdateTime / blockCount, 1.0e6*statistics.crossoverTime / blockCount,
+		1.0e6*statistics.delayLineTime / blockCount, 1.0e6*statistics.reverbTime / blockCount,
+		statistics.numPathsRendered > 0 ?
+			Double(statistics.numInterpolatedPaths) / Double(statistics.numPathsRendered) : 0.0);
+#else
+	std::fprintf(output, ",,,,\n");
+#endif
+	std::fflush(output);
+
+	//***********************************************************************
+	// Destroy the renderer before the sources and inputs that it references.
+
+	outputDevice.removeInput();
+	delete renderer;
+
+	for (Index s = 0; s < numSources; s++)
+	{
+		delete sources[s];
+		delete noiseOutputs[s];
+	}
+}
+
+
+
+
+void runRendererBenchmarks(const RendererBenchmarkSettings& settings, FILE* output)
+{
+	for (Index i = 0; i < sizeof(sourceCounts) / sizeof(sourceCounts[0]); i++)
+	{
+		if (sourceCounts[i] > settings.maxNumberOfSources)
+			break;
+
+		for (Index j = 0; j < sizeof(pathCounts) / sizeof(pathCounts[0]); j++)
+		{
+			for (Index k = 0; k < sizeof(frequencyBandCounts) / sizeof(frequencyBandCounts[0]); k++)
+			{
+				for (Index b = 0; b < sizeof(blockSizes) / sizeof(blockSizes[0]); b++)
+				{
+					for (Index mode = 0; mode < 4; mode++)
+					{
+						runRendererBenchmark(sourceCounts[i], pathCounts[j], frequencyBandCounts[k],
+							blockSizes[b], (mode & 1) != 0, (mode & 2) != 0, settings, output);
+					}
+				}
+			}
+		}
+	}
+}
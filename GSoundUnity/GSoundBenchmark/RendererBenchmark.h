@@ -0,0 +1,57 @@
+// RendererBenchmark.h : Declares the audio rendering throughput benchmark.
+//
+#ifndef INCLUDE_GSOUND_RENDERER_BENCHMARK_H
+#define INCLUDE_GSOUND_RENDERER_BENCHMARK_H
+
+
+#include "gsound/GSound.h"
+#include <cstdio>
+
+
+using namespace gsound;
+
+
+/// The settings that apply to every rendering benchmark run.
+struct RendererBenchmarkSettings
+{
+	/// The seed used to generate the synthetic propagation paths.
+	UInt32 seed;
+
+	/// The number of blocks that are rendered before timing begins.
+	Size numWarmupBlocks;
+
+	/// The duration in seconds of the audio that is rendered and timed for each configuration.
+	Double duration;
+
+	/// The largest number of sound sources that are rendered.
+	Size maxNumberOfSources;
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Rendering Benchmark Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// Write the CSV column names for the rendering benchmark to the specified file.
+void writeRendererHeader(FILE* output);
+
+
+/// Render synthetic propagation paths for every source count, path count, band count, and block size.
+/**
+  * Each configuration is rendered with and without reverb and with and without
+  * Doppler delay changes. The paths are published to the renderer 30 times per
+  * second of rendered audio, the same rate at which renderSound() propagates.
+  */
+void runRendererBenchmarks(const RendererBenchmarkSettings& settings, FILE* output);
+
+
+#endif // INCLUDE_GSOUND_RENDERER_BENCHMARK_H
@@ -0,0 +1,232 @@
+// RayTracerWidthTest.cpp : Checks that wide triangle BVHs give the same ray tracing results as the 4-wide QBVH.
+//
+// The width of the triangle BVHs is fixed by GSOUND_TRIANGLE_BVH_WIDTH when the library
+// is compiled, so the test is built once with a width of 4 to write the reference results
+// and once more for each wider BVH to compare against them. RunRayTracerWidthTest.sh does
+// all of this. On Linux, a single build can be made from this directory with:
+//
+//     g++ -O2 -std=c++11 -msse4.1 -fpermissive -DGSOUND_TRIANGLE_BVH_WIDTH=8 -I../GSoundUnity
+//         -I../GSoundBenchmark *.cpp ../GSoundBenchmark/BenchmarkScenes.cpp
+//         ../GSoundUnity/gsound/*.cpp ../GSoundUnity/gsound/internal/*.cpp
+//         ../GSoundUnity/gsound/dsp/*.cpp ../GSoundUnity/gsound/util/*.cpp
+//         -lpthread -o RayTracerWidthTest8
+//
+// The same rays are traced through every benchmark scene with traceProbeRay() and
+// traceBinaryOcclusionRay(). With --write, each ray's hit flag, hit distance and
+// occlusion results are written to a file. With --compare, they are checked against
+// such a file and the program exits with a non-zero status if any of them differ.
+// The intersected triangles aren't compared, since BVHs of different widths may
+// find different triangles when several are hit at exactly the same distance.
+//
+#include "BenchmarkScenes.h"
+#include "gsound/internal/RayTracer.h"
+#include <cstdio>
+#include <cstring>
+
+
+/// The number of rays that are traced through each scene.
+static const Size numRaysPerScene = 20000;
+
+/// The seed used to generate the scenes and the rays.
+static const UInt32 seed = 1;
+
+/// The largest relative difference allowed between the hit distances of two builds.
+static const Real distanceTolerance = Real(1e-5);
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############
+//############		Ray Result Class
+//############
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// The results of tracing one ray with the probe and occlusion methods of the ray tracer.
+struct RayResult
+{
+	/// Whether or not the probe ray hit a triangle.
+	int hit;
+
+	/// The distance to the closest hit, or 0 if there was no hit.
+	Real distance;
+
+	/// Whether or not the ray is occluded before half of the closest hit distance, which it never should be.
+	int occludedBeforeHit;
+
+	/// Whether or not the ray is occluded before a random maximum distance.
+	int occludedRandom;
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############
+//############		Ray Tracing Method
+//############
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// Trace the test rays through the specified scene and append their results to the list.
+static void traceScene(BenchmarkScene& benchmarkScene, math::RandomVariable<Real>& random, ArrayList<RayResult>& results)
+{
+	const SoundScene& scene = benchmarkScene.scene;
+
+	// Start the rays at random points inside the bounding box of all of the scene's objects.
+	AABB3 bounds = scene.getObject(0)->getBoundingBox();
+
+	for (Index i = 1; i < scene.getNumberOfObjects(); i++)
+		bounds += scene.getObject(i)->getBoundingBox();
+
+	const Real maxDistance = (bounds.max - bounds.min).getMagnitude();
+
+	internal::RayTracer rayTracer(scene.getObjectBVH());
+
+	for (Index i = 0; i < numRaysPerScene; i++)
+	{
+		Vector3 origin(random.sample(bounds.min.x, bounds.max.x),
+						random.sample(bounds.min.y, bounds.max.y),
+						random.sample(bounds.min.z, bounds.max.z));
+
+		Vector3 direction;
+
+		do
+		{
+			direction = Vector3(random.sample(-1, 1), random.sample(-1, 1), random.sample(-1, 1));
+		}
+		while (direction.getMagnitudeSquared() > Real(1) || direction.getMagnitudeSquared() < Real(0.0001));
+
+		const Ray3 ray(origin, direction.normalize());
+		const Real randomDistance = random.sample(0, maxDistance);
+
+		RayResult result;
+		Real closestIntersection = math::max<Real>();
+		internal::ObjectSpaceTriangle triangle;
+
+		result.hit = rayTracer.traceProbeRay(ray, closestIntersection, triangle);
+		result.distance = result.hit ? closestIntersection : Real(0);
+		result.occludedBeforeHit = result.hit ? rayTracer.traceBinaryOcclusionRay(ray, Real(0.5)*closestIntersection) : 0;
+		result.occludedRandom = rayTracer.traceBinaryOcclusionRay(ray, randomDistance);
+
+		results.add(result);
+	}
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############
+//############		Main Function
+//############
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+static void printUsage(const char* program)
+{
+	std::printf("Usage: %s --write <file> | --compare <file>\n"
+		"  --write <file>    Write the ray tracing results of this build to a file.\n"
+		"  --compare <file>  Compare the results of this build with a file written by another build.\n", program);
+}
+
+
+
+
+int main(int argc, char** argv)
+{
+	if (argc != 3 || (std::strcmp(argv[1], "--write") != 0 && std::strcmp(argv[1], "--compare") != 0))
+	{
+		printUsage(argv[0]);
+		return 2;
+	}
+
+	const bool write = std::strcmp(argv[1], "--write") == 0;
+
+	// Trace the same rays through every scene.
+	ArrayList<RayResult> results;
+	math::RandomVariable<Real> random(seed);
+
+	for (Index i = 0; i < getNumberOfBenchmarkScenes(); i++)
+	{
+		BenchmarkScene* benchmarkScene = createBenchmarkScene(getBenchmarkSceneName(i), seed);
+		traceScene(*benchmarkScene, random, results);
+		delete benchmarkScene;
+	}
+
+	FILE* file = std::fopen(argv[2], write ? "w" : "r");
+
+	if (file == NULL)
+	{
+		std::fprintf(stderr, "Couldn't open %s.\n", argv[2]);
+		return 2;
+	}
+
+	if (write)
+	{
+		for (Index i = 0; i < results.getSize(); i++)
+		{
+			const RayResult& result = results[i];
+			std::fprintf(file, "%d %.9g %d %d\n", result.hit, (double)result.distance,
+						result.occludedBeforeHit, result.occludedRandom);
+		}
+
+		std::fclose(file);
+		std::printf("Wrote the results of %u rays with a triangle BVH width of %d.\n",
+					(unsigned int)results.getSize(), GSOUND_TRIANGLE_BVH_WIDTH);
+		return 0;
+	}
+
+	// Compare the results with the reference file.
+	Size numHitMismatches = 0;
+	Size numDistanceMismatches = 0;
+	Size numOcclusionMismatches = 0;
+
+	for (Index i = 0; i < results.getSize(); i++)
+	{
+		const RayResult& result = results[i];
+		RayResult reference;
+		double referenceDistance = 0;
+
+		if (std::fscanf(file, "%d %lf %d %d", &reference.hit, &referenceDistance,
+						&reference.occludedBeforeHit, &reference.occludedRandom) != 4)
+		{
+			std::fprintf(stderr, "%s has fewer results than the %u rays that were traced.\n",
+						argv[2], (unsigned int)results.getSize());
+			std::fclose(file);
+			return 1;
+		}
+
+		reference.distance = Real(referenceDistance);
+
+		if ((result.hit != 0) != (reference.hit != 0))
+			numHitMismatches++;
+		else if (math::abs(result.distance - reference.distance) > distanceTolerance*math::max(Real(1), reference.distance))
+			numDistanceMismatches++;
+
+		if ((result.occludedBeforeHit != 0) != (reference.occludedBeforeHit != 0) ||
+			(result.occludedRandom != 0) != (reference.occludedRandom != 0))
+			numOcclusionMismatches++;
+	}
+
+	std::fclose(file);
+
+	std::printf("Compared %u rays with a triangle BVH width of %d: %u hit, %u distance and %u occlusion mismatches.\n",
+				(unsigned int)results.getSize(), GSOUND_TRIANGLE_BVH_WIDTH, (unsigned int)numHitMismatches,
+				(unsigned int)numDistanceMismatches, (unsigned int)numOcclusionMismatches);
+
+	return numHitMismatches + numDistanceMismatches + numOcclusionMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,36 @@
+#!/bin/sh
+# Build the ray tracer width test with 4-, 8- and 16-wide triangle BVHs and check
+# that the wide builds trace the same hits and occlusions as the 4-wide build.
+#
+# The wide node code is only compiled in the wide builds, so they must not give any
+# compiler warnings that the 4-wide build doesn't also give.
+#
+# Usage: ./RunRayTracerWidthTest.sh [build directory]
+set -e
+
+cd "$(dirname "$0")"
+BUILD_DIR="${1:-build}"
+mkdir -p "$BUILD_DIR"
+
+SOURCES="RayTracerWidthTest.cpp ../GSoundBenchmark/BenchmarkScenes.cpp
+	../GSoundUnity/gsound/*.cpp ../GSoundUnity/gsound/internal/*.cpp
+	../GSoundUnity/gsound/dsp/*.cpp ../GSoundUnity/gsound/util/*.cpp"
+
+for WIDTH in 4 8 16; do
+	${CXX:-g++} -O2 -std=c++11 -msse4.1 -fpermissive -DGSOUND_TRIANGLE_BVH_WIDTH=$WIDTH \
+		-I../GSoundUnity -I../GSoundBenchmark $SOURCES -lpthread -o "$BUILD_DIR/RayTracerWidthTest$WIDTH" \
+		2> "$BUILD_DIR/Build$WIDTH.log" || { cat "$BUILD_DIR/Build$WIDTH.log"; exit 1; }
+	grep "warning:" "$BUILD_DIR/Build$WIDTH.log" | sort -u > "$BUILD_DIR/Warnings$WIDTH.txt" || true
+done
+
+for WIDTH in 8 16; do
+	if ! cmp -s "$BUILD_DIR/Warnings4.txt" "$BUILD_DIR/Warnings$WIDTH.txt"; then
+		echo "The $WIDTH-wide build gives different compiler warnings than the 4-wide build:"
+		diff "$BUILD_DIR/Warnings4.txt" "$BUILD_DIR/Warnings$WIDTH.txt" || true
+		exit 1
+	fi
+done
+
+"$BUILD_DIR/RayTracerWidthTest4" --write "$BUILD_DIR/RayTracerWidth4.txt"
+"$BUILD_DIR/RayTracerWidthTest8" --compare "$BUILD_DIR/RayTracerWidth4.txt"
+"$BUILD_DIR/RayTracerWidthTest16" --compare "$BUILD_DIR/RayTracerWidth4.txt"
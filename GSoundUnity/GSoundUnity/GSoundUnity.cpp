@@ -183,13 +183,109 @@ void playSound(const char* soundFile)
 	delete box;
 }
 
+void renderSound(const char* soundFile, const char* outputFile, float duration)
+{
+	// The object which performs sound propagation, with all types of propagation paths enabled.
+	SoundPropagator propagator;
+
+	propagator.setDirectSoundIsEnabled(true);
+	propagator.setTransmissionIsEnabled(true);
+	propagator.setReflectionIsEnabled(true);
+	propagator.setDiffractionIsEnabled(true);
+	propagator.setReverbIsEnabled(true);
+
+	//***********************************************************************
+
+	// Create the same box room, source, and listener as playSound().
+	SoundScene scene;
+	SoundListener listener;
+	listener.setPosition(Vector3(0, 1.5, 0));
+
+	SoundMaterial defaultMaterial(
+		FrequencyResponse::getLinearHighRolloff(1000)*
+		FrequencyResponse::getLinearLowRolloff(200)*0.9,
+		FrequencyResponse::getQuadraticHighRolloff(800)*0.9,
+		FrequencyResponse::getLinearHighRolloff()*0.5);
+
+	SoundMesh* box = loadBox(AABB3(-2, 2, -1.5, 1.5, -4, 4), defaultMaterial);
+	SoundObject* boxObject = new SoundObject(box);
+	boxObject->setPosition(Vector3(0, 1.5, 0));
+	scene.addObject(boxObject);
+
+	SoundSource* source = new SoundSource();
+	source->setPosition(Vector3(0, 1, -3));
+	source->setIntensity(1);
+	source->setDistanceAttenuation(SoundDistanceAttenuation(1, 0.5, 0));
+
+	WaveDecoder* decoder = new WaveDecoder(gsound::String(soundFile));
+	SoundPlayer* player = new SoundPlayer(decoder);
+	player->setIsPlaying(true);
+	player->setIsLooping(true);
+	source->setSoundInput(player);
+	scene.addSource(source);
+
+	//***********************************************************************
+
+	// Create a stereo renderer with the same frequency bands as playSound().
+	SoundPropagationRenderer* offlineRenderer = new SoundPropagationRenderer(
+		SpeakerConfiguration::getStereo());
+
+	FrequencyPartition frequencyPartition;
+	frequencyPartition.addSplitFrequency(250);
+	frequencyPartition.addSplitFrequency(1000);
+	frequencyPartition.addSplitFrequency(4000);
+	offlineRenderer->setFrequencyPartition(frequencyPartition);
+
+	//***********************************************************************
+
+	// Create a virtual output device which pulls audio from the renderer on its
+	// own clock, as fast as possible, and writes it to the output file.
+	VirtualSoundOutputDevice outputDevice(512);
+	outputDevice.setInput(offlineRenderer);
+
+	WaveEncoder encoder(gsound::String(outputFile),
+		offlineRenderer->getNumberOfChannels(), offlineRenderer->getSampleRate());
+	outputDevice.setEncoder(&encoder);
+
+	//***********************************************************************
+
+	SoundPropagationPathBuffer pathBuffer;
+
+	// Propagate sound 30 times per second of rendered audio.
+	const Double propagationInterval = 1.0 / 30.0;
+
+	while (outputDevice.getCurrentTime() < duration)
+	{
+		propagator.propagateSound(scene, listener, 4, 1000, 4, 100, pathBuffer);
+		offlineRenderer->updatePropagationPaths(pathBuffer);
+
+		outputDevice.render(propagationInterval);
+	}
+
+	encoder.close();
+
+	std::cout << "Rendered " << outputDevice.getCurrentTime() << " seconds of audio\n";
+	std::cout << "Real-time factor: " << outputDevice.getRealTimeFactor() << "\n";
+	std::cout << "Worst block time: " << outputDevice.getMaxBlockTime()*1000.0 << " ms\n";
+
+	//***********************************************************************
+
+	// Destroy the various objects used for rendering.
+	outputDevice.removeInput();
+	delete offlineRenderer;
+	delete player;
+	delete decoder;
+	delete source;
+	delete boxObject;
+	delete box;
+}
+
 void init()
 {
 
 	propagator = new SoundPropagator;
 	scene = new SoundScene;
 	listener = new SoundListener;
-	pathBuffer = new SoundPropagationPathBuffer;
 
 	// Enable all types of propagation paths.
 	propagator->setDirectSoundIsEnabled(true);
@@ -238,6 +334,20 @@ void init()
 
 	// Start outputing audio to the device.
 	outputDevice->start();
+
+	//***********************************************************************
+
+	// Create the service which propagates sound on its own thread. The propagator
+	// must be fully configured before the service is started.
+	propagationService = new SoundPropagationService(*propagator,
+		4, // The maximum depth of the rays shot from the listener.
+		1000, // The number of rays to shoot from the listener,
+		// influences the quality of the early reflection paths.
+		4, // The maximum depth of the rays shot from each sound source.
+		100); // The number of rays to shoot from each sound source, 
+		// influences reverb estimation quality.
+
+	propagationService->start();
 }
 
 void addAABB(float minX, float maxX, float minY, float maxY, float minZ, float maxZ,
@@ -327,29 +437,25 @@ void addSource(const char* soundFile, float posX, float posY, float posZ, float
 
 	// Add the sound source to the scene.
 	scene->addSource(source);
-
-	pathBuffer = new SoundPropagationPathBuffer;
 }
 
 void update() 
 {
-	// Perform sound propagation in the scene.
-	propagator->propagateSound(*scene, // The scene in which to perform propagation.
-		*listener, // The listener to use as the sound receiver.
-		4, // The maximum depth of the rays shot from the listener.
-		1000, // The number of rays to shoot from the listener,
-		// influences the quality of the early reflection paths.
-		4, // The maximum depth of the rays shot from each sound source.
-		100, // The number of rays to shoot from each sound source, 
-		// influences reverb estimation quality.
-		*pathBuffer); // The buffer in which to put the propagation paths.
-
-	// Update the state of the sound propagation renderer.
-	renderer->updatePropagationPaths(*pathBuffer);
+	// Hand the current state of the scene and listener to the propagation thread.
+	// This only copies the state and doesn't wait for propagation.
+	propagationService->updateState(*scene, *listener);
+
+	// Update the state of the sound propagation renderer if a new frame of
+	// propagation has finished since the last update.
+	if (propagationService->updatePathBuffer())
+		renderer->updatePropagationPaths(propagationService->getPathBuffer());
 }
 
 void stop()
 {
+	// Stop propagating sound before the scene is torn down.
+	propagationService->stop();
+
 	// Stop outputing audio to the device and destroy it.
 	//std::cout << "Stopping output device...\n";
 	outputDevice->stop();
@@ -358,12 +464,12 @@ void stop()
 
 void clear()
 {
+	delete propagationService;
 	delete propagator;
 	delete scene;
 	delete listener;
 	delete renderer;
 	delete outputDevice;
-	delete pathBuffer;
 }
 
 
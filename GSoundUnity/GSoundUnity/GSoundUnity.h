@@ -30,8 +30,9 @@ static SoundPropagationRenderer* renderer;
 // to a sound output device. Use the default system output device.
 static SoundOutputDevice* outputDevice;
 
-// Create a buffer to hold the output of the propagation system.
-static SoundPropagationPathBuffer* pathBuffer;
+// The object which performs sound propagation on a background thread so that
+// update() doesn't block the caller for the duration of propagation.
+static SoundPropagationService* propagationService;
 
 SoundMaterial* getMaterial(float gain67, float gain125, float gain250, float gain500,
 	float gain1000, float gain2000, float gain4000, float gain8000,
@@ -48,6 +49,9 @@ void setCurrentDirectory();
 // Main method
 __declspec(dllexport) void playSound(const char *soundFile);
 
+// Render the playSound() scene to a WAVE file without an audio device.
+__declspec(dllexport) void renderSound(const char *soundFile, const char *outputFile, float duration);
+
 // Test method
 __declspec(dllexport) int getSomeInt();
 
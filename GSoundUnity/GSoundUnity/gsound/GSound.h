@@ -338,9 +338,12 @@
 
 
 #include "SoundPropagator.h"
+#include "SoundPropagationStatistics.h"
 #include "SoundPropagationController.h"
+#include "SoundPropagationService.h"
 
 #include "SoundPropagationRenderer.h"
+#include "SoundRenderingStatistics.h"
 
 
 
@@ -396,6 +399,9 @@ typedef dsp::SoundDeviceID SoundDeviceID;
 /// Import the SoundOutputDevice type into the base gsound namespace to make it more easily accessible.
 typedef dsp::SoundOutputDevice SoundOutputDevice;
 
+/// Import the VirtualSoundOutputDevice type into the base gsound namespace to make it more easily accessible.
+typedef dsp::VirtualSoundOutputDevice VirtualSoundOutputDevice;
+
 /// Import the ChannelIOMap type into the base gsound namespace to make it more easily accessible.
 typedef dsp::ChannelIOMap ChannelIOMap;
 
@@ -405,6 +411,9 @@ typedef dsp::SoundPlayer SoundPlayer;
 /// Import the WaveDecoder type into the base gsound namespace to make it more easily accessible.
 typedef dsp::WaveDecoder WaveDecoder;
 
+/// Import the WaveEncoder type into the base gsound namespace to make it more easily accessible.
+typedef dsp::WaveEncoder WaveEncoder;
+
 
 
 //##########################################################################################
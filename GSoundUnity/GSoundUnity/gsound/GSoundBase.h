@@ -115,6 +115,7 @@ using util::String;
 using util::StaticArray;
 
 using util::Mutex;
+using util::AtomicInteger;
 
 
 
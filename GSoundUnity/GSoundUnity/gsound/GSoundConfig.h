@@ -208,6 +208,27 @@
 
 
 
+/// Define the number of children in each node of the triangle BVHs that are ray traced.
+/**
+  * If set to 4, the 4-wide QBVH of each mesh is traversed directly. If set to 8 or 16,
+  * each QBVH is also collapsed into a wider BVH with up to 8 or 16 children per node
+  * which is used for ray tracing instead. Wider nodes are worthwhile on hardware with
+  * wide vector units, so the default is 16 when compiling for AVX-512, 8 when compiling
+  * for AVX, and 4 otherwise.
+  */
+#ifndef GSOUND_TRIANGLE_BVH_WIDTH
+	#if defined(__AVX512F__)
+		#define GSOUND_TRIANGLE_BVH_WIDTH 16
+	#elif defined(__AVX__)
+		#define GSOUND_TRIANGLE_BVH_WIDTH 8
+	#else
+		#define GSOUND_TRIANGLE_BVH_WIDTH 4
+	#endif
+#endif
+
+
+
+
 /// Determine whether or not OpenCL code should be used.
 /**
   * If set to 1, GSound will test to see if any OpenCL devices
@@ -236,6 +257,34 @@
 
 
 
+/// Determine whether or not statistics about sound propagation performance should be collected.
+/**
+  * If set to 1, each SoundPropagator fills a SoundPropagationStatistics object on
+  * every call to propagateSound() with the time spent in each stage of propagation
+  * and counts of the work that was done. If set to 0, none of the statistics code
+  * is compiled, so there is no overhead.
+  */
+#ifndef GSOUND_PROPAGATION_STATISTICS
+	#define GSOUND_PROPAGATION_STATISTICS 0
+#endif
+
+
+
+
+/// Determine whether or not statistics about audio rendering performance should be collected.
+/**
+  * If set to 1, each SoundPropagationRenderer accumulates a SoundRenderingStatistics
+  * object with the time spent in each stage of rendering during every call to
+  * fillBuffer(). If set to 0, none of the statistics code is compiled, so the audio
+  * thread has no extra overhead.
+  */
+#ifndef GSOUND_RENDERING_STATISTICS
+	#define GSOUND_RENDERING_STATISTICS 0
+#endif
+
+
+
+
 #if GSOUND_FIXED_MAX_PATH_DEPTH
 	/// Set the maximum propagation path depth allowed when a fixed max path depth is enabled.
 	/**
@@ -343,6 +392,19 @@
 
 
 
+
+
+/// Determine whether or not the compiler supports rvalue references, which are used for move semantics.
+#ifndef GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+	#if __cplusplus >= 201103L || (defined( GSOUND_COMPILER_MSVC ) && GSOUND_COMPILER_VERSION >= 1800)
+		#define GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED 1
+	#else
+		#define GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED 0
+	#endif
+#endif
+
+
+
 #if defined( GSOUND_COMPILER_GCC )
 	
 	#ifdef GSOUND_DEBUG
@@ -87,11 +87,13 @@
 #include "dsp/SampleRateConverter.h"
 
 #include "dsp/WaveDecoder.h"
+#include "dsp/WaveEncoder.h"
 
 #include "dsp/SoundPlayer.h"
 
 #include "dsp/SoundDeviceManager.h"
 #include "dsp/SoundOutputDevice.h"
+#include "dsp/VirtualSoundOutputDevice.h"
 
 
 #endif // INCLUDE_GSOUND_DSP_H
@@ -80,6 +80,9 @@
 
 // Thread classes
 #include "util/Mutex.h"
+#include "util/AtomicInteger.h"
+#include "util/Thread.h"
+#include "util/Signal.h"
 
 
 // Timing classes
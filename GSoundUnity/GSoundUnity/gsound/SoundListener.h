@@ -307,7 +307,7 @@ class SoundListener
 					GSOUND_INLINE ProbeVisibilityRecord( Real newRayDotNormal, const Vector3& newRayDirection,
 														Index newTimeStamp )
 						:	rayDotNormal( newRayDotNormal ),
-							rayDirection( rayDirection ),
+							rayDirection( newRayDirection ),
 							timeStamp( newTimeStamp )
 					{
 					}
@@ -418,6 +418,19 @@ class SoundMesh
 			
 			
 			
+			/// Get an axis-aligned bounding box for this SoundMesh in its local coordinate frame.
+			/**
+			  * The box is computed from the root of the mesh's triangle BVH each time
+			  * this method is called.
+			  */
+			GSOUND_INLINE AABB3 getBoundingBox() const
+			{
+				return bvh->getRoot()->getVolume();
+			}
+			
+			
+			
+			
 			/// Return a pointer to the root node of this SoundMesh's bounding volume hierarchy.
 			GSOUND_FORCE_INLINE const BVHType* getBVH() const
 			{
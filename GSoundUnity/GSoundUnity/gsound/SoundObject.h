@@ -105,7 +105,7 @@ class SoundObject
 				:	mesh( NULL ),
 					transformation()
 			{
-				updateWorldSpaceBoundingSphere();
+				updateWorldSpaceBoundingVolumes();
 			}
 			
 			
@@ -116,7 +116,7 @@ class SoundObject
 				:	mesh( newMesh ),
 					transformation()
 			{
-				updateWorldSpaceBoundingSphere();
+				updateWorldSpaceBoundingVolumes();
 			}
 			
 			
@@ -128,7 +128,7 @@ class SoundObject
 				:	mesh( newMesh ),
 					transformation( newTransformation )
 			{
-				updateWorldSpaceBoundingSphere();
+				updateWorldSpaceBoundingVolumes();
 			}
 			
 			
@@ -158,7 +158,7 @@ class SoundObject
 												newTransformation.orientation.orthonormalize(),
 												newTransformation.scale );
 				
-				updateWorldSpaceBoundingSphere();
+				updateWorldSpaceBoundingVolumes();
 			}
 			
 			
@@ -186,7 +186,7 @@ class SoundObject
 			{
 				transformation.position = newPosition;
 				
-				updateWorldSpaceBoundingSphere();
+				updateWorldSpaceBoundingVolumes();
 			}
 			
 			
@@ -213,6 +213,8 @@ class SoundObject
 			GSOUND_INLINE void setOrientation( const Matrix3& newOrientation )
 			{
 				transformation.orientation = newOrientation.orthonormalize();
+				
+				updateWorldSpaceBoundingVolumes();
 			}
 			
 			
@@ -240,7 +242,7 @@ class SoundObject
 			{
 				transformation.scale = newScale;
 				
-				updateWorldSpaceBoundingSphere();
+				updateWorldSpaceBoundingVolumes();
 			}
 			
 			
@@ -292,6 +294,15 @@ class SoundObject
 			
 			
 			
+			/// Get the world-space axis-aligned bounding box of this SoundObject.
+			GSOUND_INLINE const AABB3& getBoundingBox() const
+			{
+				return worldSpaceBoundingBox;
+			}
+			
+			
+			
+			
 			
 		//********************************************************************************
 		//********************************************************************************
@@ -324,7 +335,7 @@ class SoundObject
 			{
 				mesh = newMesh;
 				
-				updateWorldSpaceBoundingSphere();
+				updateWorldSpaceBoundingVolumes();
 			}
 			
 			
@@ -340,8 +351,8 @@ class SoundObject
 			
 			
 			
-			/// Update the world-space bounding sphere for this object.
-			GSOUND_INLINE void updateWorldSpaceBoundingSphere()
+			/// Update the world-space bounding sphere and bounding box for this object.
+			GSOUND_INLINE void updateWorldSpaceBoundingVolumes()
 			{
 				if ( mesh != NULL )
 				{
@@ -349,9 +360,20 @@ class SoundObject
 					
 					worldSpaceBoundingSphere.position = transformation.transformToWorldSpace( meshBoundingSphere.position );
 					worldSpaceBoundingSphere.radius = transformation.transformToWorldSpace( meshBoundingSphere.radius );
+					
+					// Transform the center of the mesh's box and enclose its rotated extent.
+					const AABB3 meshBoundingBox = mesh->getBoundingBox();
+					const Vector3 center = transformation.transformToWorldSpace( meshBoundingBox.getCenter() );
+					const Vector3 halfExtent = (math::abs( transformation.orientation )*
+												(meshBoundingBox.getDiagonal()*Real(0.5)))*transformation.scale;
+					
+					worldSpaceBoundingBox = AABB3( center - halfExtent, center + halfExtent );
 				}
 				else
+				{
 					worldSpaceBoundingSphere = internal::BoundingSphere();
+					worldSpaceBoundingBox = AABB3();
+				}
 			}
 			
 			
@@ -383,6 +405,12 @@ class SoundObject
 			
 			
 			
+			/// The axis-aligned bounding box of this sound object in world space.
+			AABB3 worldSpaceBoundingBox;
+			
+			
+			
+			
 			/// The mesh of this sound object.
 			SoundMesh* mesh;
 			
@@ -87,7 +87,8 @@ SoundPropagationController:: SoundPropagationController()
 		currentNumberOfSourceRays( 100 ),
 		minimumNumberOfSourceRays( 10 ),
 		sourceRayRatio( 0.1f ),
-		increaseAmount( 1 )
+		increaseAmount( 1 ),
+		cutShortDecreaseMultiplier( 0.75f )
 {
 }
 
@@ -102,7 +103,8 @@ SoundPropagationController:: SoundPropagationController( Size numListenerRays, S
 		currentNumberOfSourceRays( math::max( numSourceRays, Size(10) ) ),
 		minimumNumberOfSourceRays( 10 ),
 		sourceRayRatio( 0.1f ),
-		increaseAmount( 1 )
+		increaseAmount( 1 ),
+		cutShortDecreaseMultiplier( 0.75f )
 {
 }
 
@@ -131,26 +133,12 @@ void SoundPropagationController:: propagateSound( SoundPropagator& propagator,
 	propagator.propagateSound( scene, listener,
 								maxListenerProbeDepth, currentNumberOfListenerRays,
 								maxSourceProbeDepth, currentNumberOfSourceRays,
-								propagationPathBuffer );
+								propagationPathBuffer, maximumFrameTime );
 	
 	timer.update();
 	lastFrameTime = timer.getLastInterval();
 	
-	if ( lastFrameTime > 0.0 )
-	{
-		if ( lastFrameTime < maximumFrameTime )
-		{
-			currentNumberOfListenerRays += increaseAmount;
-			currentNumberOfSourceRays = Size(currentNumberOfListenerRays*sourceRayRatio);
-		}
-		else
-		{
-			Double decreaseMultiplier = lastFrameTime / maximumFrameTime;
-			
-			currentNumberOfListenerRays = Size(decreaseMultiplier*currentNumberOfListenerRays);
-			currentNumberOfSourceRays = Size(decreaseMultiplier*currentNumberOfSourceRays);
-		}
-	}
+	updateNumberOfRays( propagator.getPropagationWasCutShort() );
 }
 
 
@@ -169,27 +157,53 @@ void SoundPropagationController:: propagateSound( SoundPropagator& propagator,
 								maxListenerProbeDepth, currentNumberOfListenerRays,
 								maxSourceProbeDepth, currentNumberOfSourceRays,
 								propagationPathBuffer,
-								debugDrawingCache );
+								debugDrawingCache, maximumFrameTime );
 	
 	timer.update();
 	lastFrameTime = timer.getLastInterval();
 	
-	if ( lastFrameTime > 0.0 )
+	updateNumberOfRays( propagator.getPropagationWasCutShort() );
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Ray Count Update Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationController:: updateNumberOfRays( Bool propagationWasCutShort )
+{
+	if ( lastFrameTime <= 0.0 )
+		return;
+	
+	// The maximum frame time is also the propagator's time budget, so a frame that had
+	// too many rays usually finishes on time by skipping work rather than by running over.
+	// Reduce the number of rays whenever that happens, not just when the frame ran over.
+	if ( propagationWasCutShort || lastFrameTime >= maximumFrameTime )
+	{
+		Float decreaseMultiplier = Float(maximumFrameTime / lastFrameTime);
+		
+		// A frame that was cut short may not have run over, so always remove at least a fixed fraction of the rays.
+		if ( propagationWasCutShort )
+			decreaseMultiplier = math::min( decreaseMultiplier, cutShortDecreaseMultiplier );
+		
+		currentNumberOfListenerRays = math::max( Size(decreaseMultiplier*currentNumberOfListenerRays),
+												minimumNumberOfListenerRays );
+		currentNumberOfSourceRays = math::max( Size(decreaseMultiplier*currentNumberOfSourceRays),
+												minimumNumberOfSourceRays );
+	}
+	else
 	{
-		if ( lastFrameTime < maximumFrameTime )
-		{
-			currentNumberOfListenerRays += increaseAmount;
-			currentNumberOfSourceRays = Size(currentNumberOfListenerRays*sourceRayRatio);
-		}
-		else
-		{
-			Float decreaseMultiplier = Float(maximumFrameTime / lastFrameTime);
-			
-			currentNumberOfListenerRays = math::max( Size(decreaseMultiplier*currentNumberOfListenerRays),
-													minimumNumberOfListenerRays );
-			currentNumberOfSourceRays = math::max( Size(decreaseMultiplier*currentNumberOfSourceRays),
-													minimumNumberOfSourceRays );
-		}
+		currentNumberOfListenerRays += increaseAmount;
+		currentNumberOfSourceRays = Size(currentNumberOfListenerRays*sourceRayRatio);
 	}
 }
 
@@ -88,6 +88,12 @@ GSOUND_NAMESPACE_START
   * on the next frame is reduced by the amount necessary to meet the time requirement. In order
   * to balance this, the number of rays is increased additively by a certain amount each frame
   * that the time requirement is not exceeded.
+  *
+  * The maximum frame time is also passed to the SoundPropagator as a time budget, so a
+  * sudden change in the scene doesn't cause a frame to overrun it while the number of
+  * rays is being adjusted. The propagator stops early and keeps its partial results instead.
+  * Since such a frame usually doesn't run over, the number of rays is also reduced whenever
+  * the propagator reports that it had to stop early, by at least a fixed fraction.
   */
 class SoundPropagationController
 {
@@ -335,8 +341,51 @@ class SoundPropagationController
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Ray Decrease Accessor Methods
+			
+			
+			
+			
+			/// Get the largest fraction of the rays that are kept after the propagator ran out of time.
+			GSOUND_INLINE Float getCutShortDecreaseMultiplier() const
+			{
+				return cutShortDecreaseMultiplier;
+			}
+			
+			
+			
+			
+			/// Set the largest fraction of the rays that are kept after the propagator ran out of time.
+			/**
+			  * The value is clamped to the range [0.1,1].
+			  */
+			GSOUND_INLINE void setCutShortDecreaseMultiplier( Float newCutShortDecreaseMultiplier )
+			{
+				cutShortDecreaseMultiplier = math::clamp( newCutShortDecreaseMultiplier, 0.1f, 1.0f );
+			}
+			
+			
+			
+			
 	private:
 		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Helper Method
+			
+			
+			
+			
+			/// Update the number of rays to shoot on the next frame from the last frame time.
+			void updateNumberOfRays( Bool propagationWasCutShort );
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -354,8 +403,9 @@ class SoundPropagationController
 			/// The maximum time that it can take for a frame to be processed in seconds.
 			/**
 			  * If the last frame time was less than this value, the number of rays is increased
-			  * by the increaseAmount. If the last frame time was greater, the number of rays
-			  * is decreased by multiplying it by the ratio of the maximumFrameTime to the lastFrameTime.
+			  * by the increaseAmount. If the last frame time was greater, or the propagator ran
+			  * out of time, the number of rays is decreased by multiplying it by the ratio of the
+			  * maximumFrameTime to the lastFrameTime, or by the cutShortDecreaseMultiplier if smaller.
 			  */
 			Double maximumFrameTime;
 			
@@ -404,6 +454,12 @@ class SoundPropagationController
 			
 			
 			
+			/// The largest fraction of the rays that are kept after the propagator ran out of time.
+			Float cutShortDecreaseMultiplier;
+			
+			
+			
+			
 };
 
 
@@ -127,13 +127,7 @@ class SoundPropagationRenderer:: MonoMixer : public dsp::SoundProcessor
 			
 			virtual void setInput( SoundOutput* newInput )
 			{
-				// Acquire the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.acquire();
-				
 				input = newInput;
-				
-				// Relase the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.release();
 			}
 			
 			
@@ -141,13 +135,7 @@ class SoundPropagationRenderer:: MonoMixer : public dsp::SoundProcessor
 			
 			virtual void removeInput()
 			{
-				// Acquire the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.acquire();
-				
 				input = NULL;
-				
-				// Relase the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.release();
 			}
 			
 			
@@ -226,9 +214,6 @@ class SoundPropagationRenderer:: MonoMixer : public dsp::SoundProcessor
 				if ( input == NULL || !input->hasOutputRemaining() )
 					return 0;
 				
-				// Acquire the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.acquire();
-				
 				Size numInputChannels = input->getNumberOfChannels();
 				
 				Size numRead;
@@ -271,9 +256,6 @@ class SoundPropagationRenderer:: MonoMixer : public dsp::SoundProcessor
 					}
 				}
 				
-				// Relase the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.release();
-				
 				return numRead;
 			}
 			
@@ -298,11 +280,6 @@ class SoundPropagationRenderer:: MonoMixer : public dsp::SoundProcessor
 			
 			
 			
-			mutable Mutex renderMutex;
-			
-			
-			
-			
 };
 
 
@@ -358,13 +335,7 @@ class SoundPropagationRenderer:: MonoSplitter : public dsp::SoundProcessor
 			
 			GSOUND_INLINE void setNumberOfOutputChannels( Size newNumOutputChannels )
 			{
-				// Acquire the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.acquire();
-				
 				numOutputChannels = newNumOutputChannels;
-				
-				// Relase the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.release();
 			}
 			
 			
@@ -388,13 +359,7 @@ class SoundPropagationRenderer:: MonoSplitter : public dsp::SoundProcessor
 			
 			virtual void setInput( SoundOutput* newInput )
 			{
-				// Acquire the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.acquire();
-				
 				input = newInput;
-				
-				// Relase the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.release();
 			}
 			
 			
@@ -402,13 +367,7 @@ class SoundPropagationRenderer:: MonoSplitter : public dsp::SoundProcessor
 			
 			virtual void removeInput()
 			{
-				// Acquire the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.acquire();
-				
 				input = NULL;
-				
-				// Relase the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.release();
 			}
 			
 			
@@ -487,9 +446,6 @@ class SoundPropagationRenderer:: MonoSplitter : public dsp::SoundProcessor
 				if ( input == NULL || !input->hasOutputRemaining() )
 					return 0;
 				
-				// Acquire the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.acquire();
-				
 				Size numOutputs = input->getNumberOfOutputs();
 				
 				// Read sound from the input audio unit directly into the output stream.
@@ -518,9 +474,6 @@ class SoundPropagationRenderer:: MonoSplitter : public dsp::SoundProcessor
 					}
 				}
 				
-				// Relase the mutex which indicates that rendering parameters are either being used or changed.
-				renderMutex.release();
-				
 				return numRead;
 			}
 			
@@ -545,11 +498,6 @@ class SoundPropagationRenderer:: MonoSplitter : public dsp::SoundProcessor
 			
 			
 			
-			mutable Mutex renderMutex;
-			
-			
-			
-			
 };
 
 
@@ -992,7 +940,10 @@ class SoundPropagationRenderer:: PropagationPathRenderState
 			GSOUND_INLINE PropagationPathRenderState( const PropagationPathRenderState& other )
 				:	numFrequencyBands( other.numFrequencyBands ),
 					numChannels( other.numChannels ),
-					timeStamp( other.timeStamp )
+					timeStamp( other.timeStamp ),
+					currentDelayTime( other.currentDelayTime ),
+					targetDelayTime( other.targetDelayTime ),
+					delayChangePerSecond( other.delayChangePerSecond )
 			{
 				interpolationStates = util::copyArray( other.interpolationStates, numFrequencyBands*numChannels );
 			}
@@ -1000,6 +951,24 @@ class SoundPropagationRenderer:: PropagationPathRenderState
 			
 			
 			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Create a path render state which takes the interpolation states of another, leaving it empty.
+			GSOUND_INLINE PropagationPathRenderState( PropagationPathRenderState&& other )
+				:	timeStamp( other.timeStamp ),
+					currentDelayTime( other.currentDelayTime ),
+					targetDelayTime( other.targetDelayTime ),
+					delayChangePerSecond( other.delayChangePerSecond ),
+					interpolationStates( other.interpolationStates ),
+					numFrequencyBands( other.numFrequencyBands ),
+					numChannels( other.numChannels )
+			{
+				other.interpolationStates = NULL;
+			}
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -1010,7 +979,8 @@ class SoundPropagationRenderer:: PropagationPathRenderState
 			
 			GSOUND_INLINE ~PropagationPathRenderState()
 			{
-				util::destructArray( interpolationStates, numFrequencyBands*numChannels );
+				if ( interpolationStates )
+					util::destructArray( interpolationStates, numFrequencyBands*numChannels );
 			}
 			
 			
@@ -1046,6 +1016,32 @@ class SoundPropagationRenderer:: PropagationPathRenderState
 			
 			
 			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			GSOUND_INLINE PropagationPathRenderState& operator = ( PropagationPathRenderState&& other )
+			{
+				if ( this != &other )
+				{
+					if ( interpolationStates )
+						util::destructArray( interpolationStates, numFrequencyBands*numChannels );
+					
+					numFrequencyBands = other.numFrequencyBands;
+					numChannels = other.numChannels;
+					timeStamp = other.timeStamp;
+					currentDelayTime = other.currentDelayTime;
+					targetDelayTime = other.targetDelayTime;
+					delayChangePerSecond = other.delayChangePerSecond;
+					
+					interpolationStates = other.interpolationStates;
+					other.interpolationStates = NULL;
+				}
+				
+				return *this;
+			}
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -1176,20 +1172,23 @@ class SoundPropagationRenderer:: SoundSourceRenderState
 			
 			GSOUND_INLINE SoundSourceRenderState( SoundOutput* newInput, Size numOutputChannels,
 												const FrequencyPartition& newFrequencyPartition,
+												Index newFrequencyPartitionVersion,
 												Size newTimeStamp, Float newSampleRate )
-				:	input( newInput ),
+				:	reverbRenderState( numOutputChannels, newFrequencyPartition.getNumberOfFrequencyBands() ),
+					timeStamp( newTimeStamp ),
+					renderTimeStamp( newTimeStamp ),
+					currentDelayWriteIndex( 0 ),
+					input( newInput ),
 					sampleRateConverter( util::construct<dsp::SampleRateConverter>( newInput, newSampleRate ) ),
 					monoMixer( util::construct<MonoMixer>() ),
 					crossover( util::construct<dsp::Crossover>() ),
 					monoSplitter( util::construct<MonoSplitter>( numOutputChannels ) ),
-					timeStamp( newTimeStamp ),
-					currentDelayWriteIndex( 0 ),
-					reverbRenderState( numOutputChannels, newFrequencyPartition.getNumberOfFrequencyBands() )
+					sampleRate( newSampleRate )
 			{
 				monoMixer->setInput( sampleRateConverter );
 				crossover->setInput( monoMixer );
 				monoSplitter->setInput( crossover );
-				setFrequencyPartition( newFrequencyPartition );
+				setFrequencyPartition( newFrequencyPartition, newFrequencyPartitionVersion );
 			}
 			
 			
@@ -1261,9 +1260,18 @@ class SoundPropagationRenderer:: SoundSourceRenderState
 			
 			
 			
-			GSOUND_INLINE void setFrequencyPartition( const FrequencyPartition& newFrequencyPartition )
+			GSOUND_INLINE Index getFrequencyPartitionVersion() const
+			{
+				return frequencyPartitionVersion;
+			}
+			
+			
+			
+			
+			GSOUND_INLINE void setFrequencyPartition( const FrequencyPartition& newFrequencyPartition, Index newVersion )
 			{
 				crossover->setCrossoverFrequencies( newFrequencyPartition.getSplitFrequencies() );
+				frequencyPartitionVersion = newVersion;
 			}
 			
 			
@@ -1293,9 +1301,18 @@ class SoundPropagationRenderer:: SoundSourceRenderState
 			
 			
 			
+			GSOUND_INLINE Float getSampleRate() const
+			{
+				return sampleRate;
+			}
+			
+			
+			
+			
 			GSOUND_INLINE void setSampleRate( Float newSampleRate )
 			{
 				sampleRateConverter->setSampleRate( newSampleRate );
+				sampleRate = newSampleRate;
 			}
 			
 			
@@ -1331,11 +1348,20 @@ class SoundPropagationRenderer:: SoundSourceRenderState
 			
 			
 			/// An integer representing the frame index when the sound source's rendering information was last updated.
+			/**
+			  * This time stamp is only used by the thread which updates the propagation paths.
+			  */
 			Index timeStamp;
 			
 			
 			
 			
+			/// The time stamp of the last target state that the audio thread applied to this render state.
+			Index renderTimeStamp;
+			
+			
+			
+			
 			/// The current position being written to in the delay buffer.
 			Index currentDelayWriteIndex;
 			
@@ -1380,6 +1406,18 @@ class SoundPropagationRenderer:: SoundSourceRenderState
 			
 			
 			
+			
+			/// The version of the frequency partition that the crossover is currently using.
+			Index frequencyPartitionVersion;
+			
+			
+			
+			
+			/// The sample rate that the input audio is currently being converted to.
+			Float sampleRate;
+			
+			
+			
 };
 
 
@@ -1389,7 +1427,7 @@ class SoundPropagationRenderer:: SoundSourceRenderState
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Constructors
+//############		Propagation Path Target Class Definition
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -1397,20 +1435,39 @@ class SoundPropagationRenderer:: SoundSourceRenderState
 
 
 
-SoundPropagationRenderer:: SoundPropagationRenderer( const dsp::SpeakerConfiguration& newSpeakerConfiguration )
-	:	speakerConfiguration( newSpeakerConfiguration ),
-		timeStamp( 0 ),
-		reverbIsEnabled( true ),
-		maxNumberOfPropagationPaths( math::max<Size>() ),
-		maxPathAge( 10 ),
-		sampleRate( Float(44100) ),
-		maxDelayTime( Real(0.5) )
+class SoundPropagationRenderer:: PropagationPathTarget
 {
-#if GSOUND_USE_SIMD
-	numSIMDIterations = 1;
-	sampleFrameWidth = numSIMDIterations*SIMDSample::getWidth();
-#endif
-}
+	public:
+		
+		GSOUND_INLINE PropagationPathTarget( const PropagationPathID& newPathID,
+											Real newDelayTime, Real newDelayChangePerSecond )
+			:	pathID( newPathID ),
+				delayTime( newDelayTime ),
+				delayChangePerSecond( newDelayChangePerSecond )
+		{
+		}
+		
+		
+		
+		
+		/// The ID of the propagation path that these targets are for.
+		PropagationPathID pathID;
+		
+		
+		
+		
+		/// The delay time in seconds that the path should be rendered with.
+		Real delayTime;
+		
+		
+		
+		
+		/// The rate of change of the path's delay time due to the relative motion of the source and listener.
+		Real delayChangePerSecond;
+		
+		
+		
+};
 
 
 
@@ -1418,7 +1475,7 @@ SoundPropagationRenderer:: SoundPropagationRenderer( const dsp::SpeakerConfigura
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Destructor
+//############		Sound Source Target Class Definition
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -1426,9 +1483,55 @@ SoundPropagationRenderer:: SoundPropagationRenderer( const dsp::SpeakerConfigura
 
 
 
-SoundPropagationRenderer:: ~SoundPropagationRenderer()
+class SoundPropagationRenderer:: SoundSourceTarget
 {
-}
+	public:
+		
+		GSOUND_INLINE SoundSourceTarget()
+			:	renderState( NULL ),
+				input( NULL )
+		{
+		}
+		
+		
+		
+		
+		/// The render state which should be rendered with these targets.
+		SoundSourceRenderState* renderState;
+		
+		
+		
+		
+		/// The audio input of the sound source.
+		SoundOutput* input;
+		
+		
+		
+		
+		/// The targets for every propagation path of the sound source.
+		ArrayList<PropagationPathTarget> paths;
+		
+		
+		
+		
+		/// The target amplitude for each frequency band and channel of every path, in the order of the paths.
+		ArrayList<Float> pathAmplitudes;
+		
+		
+		
+		
+		/// The reverb time in seconds for each frequency band.
+		ArrayList<Real> reverbTimes;
+		
+		
+		
+		
+		/// The target reverb gain for each frequency band.
+		ArrayList<Float> reverbGains;
+		
+		
+		
+};
 
 
 
@@ -1436,7 +1539,7 @@ SoundPropagationRenderer:: ~SoundPropagationRenderer()
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Propagation Path Update Method
+//############		Render Target State Class Definition
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -1444,140 +1547,375 @@ SoundPropagationRenderer:: ~SoundPropagationRenderer()
 
 
 
-void SoundPropagationRenderer:: updatePropagationPaths( const SoundPropagationPathBuffer& newPathBuffer )
+class SoundPropagationRenderer:: RenderTargetState
 {
-	const Size numSources = newPathBuffer.getNumberOfSources();
-	const Size totalNumPaths = newPathBuffer.getTotalNumberOfPropagationPaths();
-	
-	// Whether or not culling of quieter paths should be performed.
-	const Bool shouldCullPaths = totalNumPaths > maxNumberOfPropagationPaths;
-	
-	// The percentage of the incoming propagation paths that should be discarded if there are too many.
-	const Float percentValidPaths = Float(maxNumberOfPropagationPaths) / Float(totalNumPaths);
-	
-	// Acquire a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.acquire();
-	
-	for ( Index s = 0; s < numSources; s++ )
-	{
-		const SoundSourcePropagationPathBuffer& sourcePathBuffer = newPathBuffer.getSourceBuffer(s);
-		SoundSource* source = sourcePathBuffer.getSource();
-		
-		// Ignore this buffer if its source is NULL.
-		if ( source == NULL )
-			continue;
-		
-		// Calculate the number of paths that should be kept for the sound source if 
-		// it is necessary to cull propagation paths.
-		Size maxNumberOfSourcePaths;
-		
-		if ( shouldCullPaths )
-			maxNumberOfSourcePaths = Size(percentValidPaths * sourcePathBuffer.getNumberOfPropagationPaths());
-		else
-			maxNumberOfSourcePaths = sourcePathBuffer.getNumberOfPropagationPaths();
-		
-		SoundSourceRenderState** renderState;
+	public:
 		
-		// Is there already a rendering state for this source?
-		if ( sourceRenderStates.find( source->getHashCode(), source, renderState ) )
-		{
-			// If the source is disabled, clear its render state and continue to the next source.
-			if ( !source->getIsEnabled() )
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			GSOUND_INLINE RenderTargetState()
+				:	timeStamp( 0 ),
+					frequencyPartitionVersion( 0 ),
+					sampleRate( Float(44100) ),
+					maxDelayTime( Real(0.5) ),
+					reverbIsEnabled( true ),
+					maxPathAge( 10 ),
+					numSources( 0 )
 			{
-				(*renderState)->propagationPaths.clear();
-				continue;
 			}
 			
-			// If we have already encountered a path buffer for this sound source,
-			// skip this path buffer. This should not happen in practice.
-			if ( (*renderState)->timeStamp == timeStamp )
-				continue;
 			
-			// Update the time stamp of the source's render state.
-			(*renderState)->timeStamp = timeStamp;
 			
-			updateSourcePropagationPaths( sourcePathBuffer, **renderState, maxNumberOfSourcePaths );
-		}
-		else
-		{
-			// We didn't find a source render state for this sound source.
-			// Create a new one.
-			SoundSourceRenderState* newRenderState = util::construct<SoundSourceRenderState>( source->getSoundInput(), 
-																			speakerConfiguration.getNumberOfChannels(),
-																			frequencyPartition,
-																			timeStamp,
-																			sampleRate );
 			
-			// Add the new source render state to the set of source render states.
-			sourceRenderStates.add( source->getHashCode(), source, newRenderState );
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Source Target Accessor Methods
 			
-			// Update the paths for that render state.
-			updateSourcePropagationPaths( sourcePathBuffer, *newRenderState, maxNumberOfSourcePaths );
-		}
-	}
-	
-	
-	//****************************************************************************
-	// Iterate over the sound source render states and remove ones that no
-	// longer correspond to a sound source.
-	
-	HashMap<SoundSource*,SoundSourceRenderState*>::Iterator i = sourceRenderStates.getIterator();
-	
-	while ( i )
-	{
-		if ( (*i)->timeStamp < timeStamp )
-		{
-			util::destruct( *i );
-			i.remove();
-			continue;
-		}
-		
-		i++;
-	}
-	
-	// Increment the current time stamp.
-	timeStamp++;
-	
-	
-	// Release a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.release();
-}
-
-
-
-
-
-//##########################################################################################
-//##########################################################################################
-//############		
-//############		Sound Source Propagation Path Update Method
-//############		
-//##########################################################################################
-//##########################################################################################
-
-
-
-
-void SoundPropagationRenderer:: updateSourcePropagationPaths( const SoundSourcePropagationPathBuffer& pathBuffer,
-																SoundSourceRenderState& renderState,
-																Size maxNumberOfSourcePaths )
-{
-	SoundSource* source = pathBuffer.getSource();
-	
-	const Size numChannels = speakerConfiguration.getNumberOfChannels();
-	const Size numFrequencyBands = frequencyPartition.getNumberOfFrequencyBands();
+			
+			
+			
+			/// Remove all of the source targets while keeping their storage for later reuse.
+			GSOUND_INLINE void clearSources()
+			{
+				numSources = 0;
+			}
+			
+			
+			
+			
+			/// Add an empty source target for the specified render state and return a reference to it.
+			GSOUND_INLINE SoundSourceTarget& addSource( SoundSourceRenderState* renderState, SoundOutput* input )
+			{
+				if ( numSources == sources.getSize() )
+					sources.add( SoundSourceTarget() );
+				
+				SoundSourceTarget& sourceTarget = sources[numSources];
+				numSources++;
+				
+				sourceTarget.renderState = renderState;
+				sourceTarget.input = input;
+				sourceTarget.paths.clear();
+				sourceTarget.pathAmplitudes.clear();
+				sourceTarget.reverbTimes.clear();
+				sourceTarget.reverbGains.clear();
+				
+				return sourceTarget;
+			}
+			
+			
+			
+			
+			GSOUND_INLINE Size getNumberOfSources() const
+			{
+				return numSources;
+			}
+			
+			
+			
+			
+			GSOUND_INLINE const SoundSourceTarget& getSource( Index sourceIndex ) const
+			{
+				GSOUND_DEBUG_ASSERT( sourceIndex < numSources );
+				
+				return sources[sourceIndex];
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Public Data Members
+			
+			
+			
+			
+			/// The time stamp of the update which produced this target state.
+			Index timeStamp;
+			
+			
+			
+			
+			/// The frequency partition that the sources should be rendered with.
+			FrequencyPartition frequencyPartition;
+			
+			
+			
+			
+			/// The version of the frequency partition, used to detect when it changes.
+			Index frequencyPartitionVersion;
+			
+			
+			
+			
+			/// The sample rate that the sources should be rendered with.
+			Float sampleRate;
+			
+			
+			
+			
+			/// The maximum allowed delay time for any propagation path in seconds.
+			Real maxDelayTime;
+			
+			
+			
+			
+			/// Whether or not reverb should be rendered.
+			Bool reverbIsEnabled;
+			
+			
+			
+			
+			/// The maximum number of updates that a propagation path can go without being updated.
+			Size maxPathAge;
+	
+	
+	
+	
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// The source targets, including unused ones past the number of sources that are kept for reuse.
+			ArrayList<SoundSourceTarget> sources;
+			
+			
+			
+			
+			/// The number of source targets that are in use.
+			Size numSources;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Constructors
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+SoundPropagationRenderer:: SoundPropagationRenderer( const dsp::SpeakerConfiguration& newSpeakerConfiguration )
+	:	speakerConfiguration( newSpeakerConfiguration ),
+		timeStamp( 0 ),
+		frequencyPartitionVersion( 0 ),
+		backTargetIndex( 0 ),
+		pendingTargetIndex( 1 ),
+		frontTargetIndex( 2 ),
+		delayBufferSize( 0 ),
+		renderSampleRate( Float(44100) ),
+		renderNumFrequencyBands( 1 ),
+		renderReverbIsEnabled( true ),
+		reverbIsEnabled( true ),
+		maxNumberOfPropagationPaths( math::max<Size>() ),
+		maxPathAge( 10 ),
+		sampleRate( Float(44100) ),
+		maxDelayTime( Real(0.5) )
+{
+	targetStates = util::constructArray<RenderTargetState>( NUM_TARGET_STATES );
+	
+#if GSOUND_USE_SIMD
+	numSIMDIterations = 1;
+	sampleFrameWidth = numSIMDIterations*SIMDSample::getWidth();
+#endif
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Destructor
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+SoundPropagationRenderer:: ~SoundPropagationRenderer()
+{
+	// Audio is no longer being rendered, so every render state can be destroyed.
+	for ( HashMap<SoundSource*,SoundSourceRenderState*>::Iterator i = sourceRenderStates.getIterator(); i; i++ )
+		util::destruct( *i );
+	
+	for ( Index i = 0; i < retiredRenderStates.getSize(); i++ )
+		util::destruct( retiredRenderStates[i] );
+	
+	util::destructArray( targetStates, NUM_TARGET_STATES );
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Propagation Path Update Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationRenderer:: updatePropagationPaths( const SoundPropagationPathBuffer& newPathBuffer )
+{
+	const Size numSources = newPathBuffer.getNumberOfSources();
+	const Size totalNumPaths = newPathBuffer.getTotalNumberOfPropagationPaths();
+	
+	// Whether or not culling of quieter paths should be performed.
+	const Bool shouldCullPaths = totalNumPaths > maxNumberOfPropagationPaths;
+	
+	// The percentage of the incoming propagation paths that should be discarded if there are too many.
+	const Float percentValidPaths = Float(maxNumberOfPropagationPaths) / Float(totalNumPaths);
+	
+	//****************************************************************************
+	// Build the new targets in the back target state, which the audio thread never uses.
+	
+	RenderTargetState& targetState = targetStates[backTargetIndex];
+	
+	targetState.clearSources();
+	targetState.timeStamp = timeStamp;
+	targetState.sampleRate = sampleRate;
+	targetState.maxDelayTime = maxDelayTime;
+	targetState.reverbIsEnabled = reverbIsEnabled;
+	targetState.maxPathAge = maxPathAge;
+	
+	if ( targetState.frequencyPartitionVersion != frequencyPartitionVersion )
+	{
+		targetState.frequencyPartition = frequencyPartition;
+		targetState.frequencyPartitionVersion = frequencyPartitionVersion;
+	}
+	
+	for ( Index s = 0; s < numSources; s++ )
+	{
+		const SoundSourcePropagationPathBuffer& sourcePathBuffer = newPathBuffer.getSourceBuffer(s);
+		SoundSource* source = sourcePathBuffer.getSource();
+		
+		// Ignore this buffer if its source is NULL. Disabled sources are not rendered,
+		// so their render states are retired below along with those of removed sources.
+		if ( source == NULL || !source->getIsEnabled() )
+			continue;
+		
+		// Calculate the number of paths that should be kept for the sound source if
+		// it is necessary to cull propagation paths.
+		Size maxNumberOfSourcePaths;
+		
+		if ( shouldCullPaths )
+			maxNumberOfSourcePaths = Size(percentValidPaths * sourcePathBuffer.getNumberOfPropagationPaths());
+		else
+			maxNumberOfSourcePaths = sourcePathBuffer.getNumberOfPropagationPaths();
+		
+		SoundSourceRenderState** renderState;
+		
+		// Is there already a rendering state for this source?
+		if ( sourceRenderStates.find( source->getHashCode(), source, renderState ) )
+		{
+			// If we have already encountered a path buffer for this sound source,
+			// skip this path buffer. This should not happen in practice.
+			if ( (*renderState)->timeStamp == timeStamp )
+				continue;
+			
+			// Update the time stamp of the source's render state.
+			(*renderState)->timeStamp = timeStamp;
+			
+			updateSourcePropagationPaths( sourcePathBuffer, targetState.addSource( *renderState, source->getSoundInput() ),
+										maxNumberOfSourcePaths );
+		}
+		else
+		{
+			// We didn't find a source render state for this sound source.
+			// Create a new one. It isn't visible to the audio thread until the target state is published.
+			SoundSourceRenderState* newRenderState = util::construct<SoundSourceRenderState>( source->getSoundInput(),
+																			speakerConfiguration.getNumberOfChannels(),
+																			frequencyPartition,
+																			frequencyPartitionVersion,
+																			timeStamp,
+																			sampleRate );
+			
+			// Add the new source render state to the set of source render states.
+			sourceRenderStates.add( source->getHashCode(), source, newRenderState );
+			
+			// Update the paths for that render state.
+			updateSourcePropagationPaths( sourcePathBuffer, targetState.addSource( newRenderState, source->getSoundInput() ),
+										maxNumberOfSourcePaths );
+		}
+	}
+	
 	
-	if ( source == NULL )
+	//****************************************************************************
+	// Iterate over the sound source render states and retire ones that no
+	// longer correspond to a sound source. The audio thread may still be rendering
+	// them from an older target state, so they can't be destroyed yet.
+	
+	HashMap<SoundSource*,SoundSourceRenderState*>::Iterator i = sourceRenderStates.getIterator();
+	
+	while ( i )
 	{
-		// If the source that the renderer is supposed to be rendering is NULL,
-		// clear all rendering state.
-		renderState.setInput( NULL );
-		renderState.propagationPaths.clear();
+		if ( (*i)->timeStamp < timeStamp )
+		{
+			retiredRenderStates.add( *i );
+			i.remove();
+			continue;
+		}
+		
+		i++;
 	}
 	
-	// Make sure that the renderer is using the correct audio input.
-	if ( source->getSoundInput() != renderState.getInput() )
-		renderState.setInput( source->getSoundInput() );
+	// Hand the new targets to the audio thread.
+	publishTargetState();
+	
+	// Increment the current time stamp.
+	timeStamp++;
+}
+
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Sound Source Propagation Path Update Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationRenderer:: updateSourcePropagationPaths( const SoundSourcePropagationPathBuffer& pathBuffer,
+																SoundSourceTarget& sourceTarget,
+																Size maxNumberOfSourcePaths )
+{
+	SoundSource* source = pathBuffer.getSource();
+	
+	const Size numChannels = speakerConfiguration.getNumberOfChannels();
+	const Size numFrequencyBands = frequencyPartition.getNumberOfFrequencyBands();
 	
 	
 	//****************************************************************************
@@ -1620,150 +1958,39 @@ void SoundPropagationRenderer:: updateSourcePropagationPaths( const SoundSourceP
 	}
 	else
 		numValidImpulses = impulseSortList.getSize();
-	
-	
-	//****************************************************************************
-	
-	
-	for ( Index i = 0; i < numValidImpulses; i++ )
-	{
-		const Impulse& impulse = impulseSortList[i];
-		const PropagationPath& path = *impulse.path;
-		const PropagationPathID& pathID = path.getID();
-		
-		// Compute the gain for each channel based on the direction of the path.
-		speakerConfiguration.spatializeDirection( path.getDirection(), channelGainArray );
-		
-		PropagationPathRenderState* pathRenderState;
-		
-		// Is there already a propagation path render state for this propagation path?
-		// If so, update the render state for that path.
-		
-		if ( renderState.propagationPaths.find( pathID.getHashCode(), pathID, pathRenderState ) )
-		{
-			// If the number of frequency bands or number of channels in the path render state
-			// is not the same as the current number of bands or channels, reset the path's render state.
-			if ( pathRenderState->getNumberOfChannels() != numChannels ||
-				pathRenderState->getNumberOfFrequencyBands() != numFrequencyBands )
-			{
-				*pathRenderState = PropagationPathRenderState( numFrequencyBands, numChannels, renderState.timeStamp );
-			}
-			
-			// Update the target delay time and doppler delay change. These are constant for all channels/bands.
-			pathRenderState->targetDelayTime = impulse.delay;
-			pathRenderState->delayChangePerSecond = impulse.delayChangePerSecond;
-			
-			for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
-			{
-				Real bandGain = path.getFrequencyAttenuation().getBandAverageGain( 
-												frequencyPartition.getFrequencyBandRange( bandIndex ) )*impulse.amplitude;
-				
-				for ( Index c = 0; c < numChannels; c++ )
-				{
-					InterpolationState& interpolationState = pathRenderState->getInterpolationState( bandIndex, c );
-					
-					// Update the target ampltiude, delay time, and delay change per second of this interpolation state.
-					interpolationState.targetAmplitude = bandGain*channelGainArray.getGain(c);
-				}
-			}
-			
-			// Update the time stamp for this path render state.
-			pathRenderState->timeStamp = renderState.timeStamp;
-		}
-		else
-		{
-			// This is a new propagation path. Add a propagation path render state to the
-			// hash map of render states.
-			renderState.propagationPaths.add( pathID.getHashCode(), pathID,
-											PropagationPathRenderState( numFrequencyBands, numChannels, renderState.timeStamp ) );
-			
-			// Get a pointer to the new propagation path render state. TODO: this is inefficient.
-			renderState.propagationPaths.find( pathID.getHashCode(), pathID, pathRenderState );
-			
-			// Set the delay time and doppler delay change. These are constant for all channels/bands.
-			pathRenderState->currentDelayTime = impulse.delay;
-			pathRenderState->targetDelayTime = impulse.delay;
-			pathRenderState->delayChangePerSecond = impulse.delayChangePerSecond;
-			
-			for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
-			{
-				Real bandGain = path.getFrequencyAttenuation().getBandAverageGain( 
-												frequencyPartition.getFrequencyBandRange( bandIndex ) )*impulse.amplitude;
-				
-				for ( Index c = 0; c < numChannels; c++ )
-				{
-					InterpolationState& interpolationState = pathRenderState->getInterpolationState( bandIndex, c );
-					
-					// Update the target ampltiude, delay time, and delay change per second of this interpolation state.
-					interpolationState = InterpolationState( bandGain*channelGainArray.getGain(c) );
-				}
-			}
-		}
-	}
-	
-	
-	//****************************************************************************
-	// Iterate over the data structure of propagation path render states and prepare aging
-	// states for removal and remove states that are older than the maximum allowed value.
-	
-	{
-		HashMap<PropagationPathID,PropagationPathRenderState>::Iterator i = renderState.propagationPaths.getIterator();
 		
-		while ( i )
-		{
-			if ( i->timeStamp < renderState.timeStamp )
-			{
-				// If the number of frequency bands or number of channels is not equal to the current
-				// number of bands or channels, remove this propagation path render state immediately
-				// because there is no way we can gracefully perform this operation.
-				if ( i->getNumberOfFrequencyBands() != numFrequencyBands || i->getNumberOfChannels() != numChannels )
-				{
-					i.remove();
-					continue;
-				}
-				
-				// Compute the age of the path.
-				Size pathAge = renderState.timeStamp - i->timeStamp;
-				
-				// Remove paths that are older than the maximum allowed value.
-				if ( pathAge > maxPathAge )
-				{
-					i.remove();
-					continue;
-				}
-				
-				// If the path is aging but not ready to be removed yet, fade it out.
-				Float lastGain = math::square(1.0f - (Float)(pathAge - 1) / (Float)maxPathAge);
-				Float gain = math::square(1.0f - (Float)pathAge / (Float)maxPathAge);
-				
-				for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
-				{
-					for ( Index c = 0; c < numChannels; c++ )
-					{
-						InterpolationState& interpolationState = i->getInterpolationState( bandIndex, c );
-						
-						Float originalAmplitude = interpolationState.currentAmplitude/lastGain;
-						
-						// Update the target amplitude so that it will fade out exponentially.
-						interpolationState.targetAmplitude = originalAmplitude*gain;
-					}
-				}
-			}
+		
+	//****************************************************************************
+	// Compute the target delay and the target amplitude for each band and channel of every path.
+	
+	for ( Index i = 0; i < numValidImpulses; i++ )
+	{
+		const Impulse& impulse = impulseSortList[i];
+		const PropagationPath& path = *impulse.path;
+		
+		// Compute the gain for each channel based on the direction of the path.
+		speakerConfiguration.spatializeDirection( path.getDirection(), channelGainArray );
+		
+		sourceTarget.paths.add( PropagationPathTarget( path.getID(), impulse.delay, impulse.delayChangePerSecond ) );
+		
+		for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
+		{
+			Real bandGain = path.getFrequencyAttenuation().getBandAverageGain(
+											frequencyPartition.getFrequencyBandRange( bandIndex ) )*impulse.amplitude;
 			
-			i++;
+			for ( Index c = 0; c < numChannels; c++ )
+				sourceTarget.pathAmplitudes.add( bandGain*channelGainArray.getGain(c) );
 		}
 	}
 	
-	//****************************************************************************
-	
-	ReverbRenderState& reverbRenderState = renderState.reverbRenderState;
 	
+	//****************************************************************************
 	
 	if ( reverbIsEnabled )
 	{
 		const SoundSourceReverbResponse& reverbResponse = pathBuffer.getReverbResponse();
 		
-		// Update the reverb times and amplitudes for all frequency bands.
+		// Compute the reverb times and amplitudes for all frequency bands.
 		for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
 		{
 			// Calculate the reverb time for this frequency band.
@@ -1781,11 +2008,8 @@ void SoundPropagationRenderer:: updateSourcePropagationPaths( const SoundSourceP
 			
 			Float bandAmplitude = reverbResponse.distanceAttenuation.getBandAverageGain( bandRange )*source->getIntensity();
 			
-			for ( Index i = 0; i < numChannels; i++ )
-			{
-				reverbRenderState.setReverbTime( i, bandIndex, reverbTime );
-				reverbRenderState.setTargetGain( i, bandIndex, bandAmplitude ); // *reverbGain
-			}
+			sourceTarget.reverbTimes.add( reverbTime );
+			sourceTarget.reverbGains.add( bandAmplitude ); // *reverbGain
 		}
 	}
 	else
@@ -1793,11 +2017,8 @@ void SoundPropagationRenderer:: updateSourcePropagationPaths( const SoundSourceP
 		// Make sure that the reverb output gain and reverb times are zero.
 		for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
 		{
-			for ( Index i = 0; i < numChannels; i++ )
-			{
-				reverbRenderState.setReverbTime( bandIndex, i, 0 );
-				reverbRenderState.setTargetGain( bandIndex, i, 0 );
-			}
+			sourceTarget.reverbTimes.add( Real(0) );
+			sourceTarget.reverbGains.add( Float(0) );
 		}
 	}
 }
@@ -1805,11 +2026,10 @@ void SoundPropagationRenderer:: updateSourcePropagationPaths( const SoundSourceP
 
 
 
-
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Frequency Partition Accessor Method
+//############		Target State Publishing Methods
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -1817,27 +2037,87 @@ void SoundPropagationRenderer:: updateSourcePropagationPaths( const SoundSourceP
 
 
 
-void SoundPropagationRenderer:: setFrequencyPartition( const FrequencyPartition& newFrequencyPartition )
+void SoundPropagationRenderer:: publishTargetState()
 {
-	// Acquire a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.acquire();
+	// Swap the finished back state with the pending state, flagging it as new for the audio thread.
+	// The previously pending state is no longer visible to the audio thread, so it becomes the new back state.
+	Int32 oldPendingIndex = pendingTargetIndex.exchange( Int32(backTargetIndex) | NEW_TARGET_STATE_FLAG );
 	
-	frequencyPartition = newFrequencyPartition;
+	backTargetIndex = Index(oldPendingIndex & TARGET_STATE_INDEX_MASK);
 	
-#if GSOUND_USE_SIMD
-	// Compute the number of SIMD words that are necessary to encompass all frequency bands in an interleaved sample stream.
-	sampleFrameWidth = math::nextMultiple( frequencyPartition.getNumberOfFrequencyBands(), SIMDSample::getWidth() );
-	numSIMDIterations = sampleFrameWidth / SIMDSample::getWidth();
+	destroyRetiredRenderStates();
+}
+
+
+
+
+void SoundPropagationRenderer:: retireAllRenderStates()
+{
+	for ( HashMap<SoundSource*,SoundSourceRenderState*>::Iterator i = sourceRenderStates.getIterator(); i; i++ )
+		retiredRenderStates.add( *i );
 	
-#endif
+	sourceRenderStates.clear();
+}
+
+
+
+
+void SoundPropagationRenderer:: destroyRetiredRenderStates()
+{
+	if ( retiredRenderStates.getSize() == 0 )
+		return;
 	
-	for ( HashMap<SoundSource*,SoundSourceRenderState*>::Iterator i = sourceRenderStates.getIterator(); i; i++ )
+	// The audio thread can only be using the pending or front target state, which are the two
+	// states other than the back state. A retired render state is only referenced by target
+	// states that were built no later than its last update, so it can be destroyed once
+	// both of those states are newer than that.
+	Index oldestVisibleTimeStamp = math::max<Index>();
+	
+	for ( Index i = 0; i < NUM_TARGET_STATES; i++ )
+	{
+		if ( i != backTargetIndex )
+			oldestVisibleTimeStamp = math::min( oldestVisibleTimeStamp, targetStates[i].timeStamp );
+	}
+	
+	Index i = 0;
+	
+	while ( i < retiredRenderStates.getSize() )
 	{
-		(*i)->setFrequencyPartition( frequencyPartition );
+		if ( retiredRenderStates[i]->timeStamp < oldestVisibleTimeStamp )
+		{
+			util::destruct( retiredRenderStates[i] );
+			retiredRenderStates.removeAtIndexUnordered( i );
+		}
+		else
+			i++;
 	}
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Frequency Partition Accessor Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationRenderer:: setFrequencyPartition( const FrequencyPartition& newFrequencyPartition )
+{
+	// The reverb state of a sound source can't change its number of frequency bands,
+	// so all sound source render states are recreated if the number of bands changes.
+	if ( newFrequencyPartition.getNumberOfFrequencyBands() != frequencyPartition.getNumberOfFrequencyBands() )
+		retireAllRenderStates();
+	
+	frequencyPartition = newFrequencyPartition;
 	
-	// Release a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.release();
+	// The audio thread updates the crossovers of the remaining sources when it sees the new version.
+	frequencyPartitionVersion++;
 }
 
 
@@ -1856,23 +2136,17 @@ void SoundPropagationRenderer:: setFrequencyPartition( const FrequencyPartition&
 
 void SoundPropagationRenderer:: setSpeakerConfiguration( const dsp::SpeakerConfiguration& newSpeakerConfiguration )
 {
-	// Acquire a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.acquire();
-	
 	if ( speakerConfiguration.getNumberOfChannels() != newSpeakerConfiguration.getNumberOfChannels() )
 	{
-		// Clear all sound source render states from the renderer. This is costly and will interupt
+		// Retire all sound source render states from the renderer. This is costly and will interupt
 		// playback of propagated sound, but is necessary due to the difficulty in updating the new number
-		// of channels any other way. This operation shouldn't need to be performed in regular use of the 
+		// of channels any other way. This operation shouldn't need to be performed in regular use of the
 		// library anyway.
-		sourceRenderStates.clear();
+		retireAllRenderStates();
 	}
 	
 	// Set the new speaker configuration to use.
 	speakerConfiguration = newSpeakerConfiguration;
-	
-	// Release a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.release();
 }
 
 
@@ -1899,18 +2173,8 @@ Float SoundPropagationRenderer:: getSampleRate() const
 
 void SoundPropagationRenderer:: setSampleRate( Float newSampleRate )
 {
-	// Acquire a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.acquire();
-	
+	// The audio thread updates the sample rate converter of each source when it sees the new rate.
 	sampleRate = math::max( newSampleRate, Float(0) );
-	
-	for ( HashMap<SoundSource*,SoundSourceRenderState*>::Iterator i = sourceRenderStates.getIterator(); i; i++ )
-	{
-		(*i)->setSampleRate( sampleRate );
-	}
-	
-	// Release a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.release();
 }
 
 
@@ -1964,26 +2228,244 @@ Bool SoundPropagationRenderer:: hasOutputRemaining() const
 
 Size SoundPropagationRenderer:: fillBuffer( dsp::SoundStream& outputStream, Index startIndex, Size numSamples )
 {
-	// Acquire a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.acquire();
+#if GSOUND_RENDERING_STATISTICS
+	const Double bufferStartTime = util::Timer::getTime();
+#endif
+	
+	// If a new target state has been published, exchange it for the one that was being rendered.
+	// This never waits for the update thread, which may publish again at any time.
+	if ( pendingTargetIndex.get() & NEW_TARGET_STATE_FLAG )
+	{
+		frontTargetIndex = Index(pendingTargetIndex.exchange( Int32(frontTargetIndex) ) & TARGET_STATE_INDEX_MASK);
+		
+#if GSOUND_RENDERING_STATISTICS
+		const Double updateStartTime = util::Timer::getTime();
+#endif
+		
+		applyTargetState( targetStates[frontTargetIndex] );
+		
+#if GSOUND_RENDERING_STATISTICS
+		statistics.targetUpdateTime += util::Timer::getTime() - updateStartTime;
+#endif
+	}
+	
+	const RenderTargetState& targetState = targetStates[frontTargetIndex];
 	
 	// Zero the output stream.
 	outputStream.zero( startIndex, numSamples );
 	
+	// For each sound source, render the audio to the output stream.
+	const Size numSources = targetState.getNumberOfSources();
+	
+	for ( Index i = 0; i < numSources; i++ )
+		renderSoundSource( outputStream.getBuffer(0), startIndex, numSamples, *targetState.getSource(i).renderState );
+	
+#if GSOUND_RENDERING_STATISTICS
+	statistics.numBuffersRendered++;
+	statistics.numSamplesRendered += numSamples;
+	statistics.numSourcesRendered += numSources;
+	statistics.totalTime += util::Timer::getTime() - bufferStartTime;
+#endif
+	
+	return numSamples;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Target State Application Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationRenderer:: applyTargetState( const RenderTargetState& targetState )
+{
+	renderSampleRate = targetState.sampleRate;
+	renderNumFrequencyBands = targetState.frequencyPartition.getNumberOfFrequencyBands();
+	renderReverbIsEnabled = targetState.reverbIsEnabled;
+	
+#if GSOUND_USE_SIMD
+	// Compute the number of SIMD words that are necessary to encompass all frequency bands in an interleaved sample stream.
+	sampleFrameWidth = math::nextMultiple( renderNumFrequencyBands, SIMDSample::getWidth() );
+	numSIMDIterations = sampleFrameWidth / SIMDSample::getWidth();
+#endif
+	
 	// Update the delay buffer size to use.
-	delayBufferSize = Size(Real(2)*sampleRate*maxDelayTime);
+	delayBufferSize = Size(Real(2)*renderSampleRate*targetState.maxDelayTime);
 	
-	// For each sound source, render the audio to the output stream.
-	for ( HashMap<SoundSource*,SoundSourceRenderState*>::Iterator i = sourceRenderStates.getIterator(); i; i++ )
+	const Size numSources = targetState.getNumberOfSources();
+	
+	for ( Index i = 0; i < numSources; i++ )
+	{
+		const SoundSourceTarget& sourceTarget = targetState.getSource(i);
+		SoundSourceRenderState& renderState = *sourceTarget.renderState;
+		
+		// Make sure that the renderer is using the correct audio input and format.
+		if ( renderState.getInput() != sourceTarget.input )
+			renderState.setInput( sourceTarget.input );
+		
+		if ( renderState.getFrequencyPartitionVersion() != targetState.frequencyPartitionVersion )
+			renderState.setFrequencyPartition( targetState.frequencyPartition, targetState.frequencyPartitionVersion );
+		
+		if ( renderState.getSampleRate() != renderSampleRate )
+			renderState.setSampleRate( renderSampleRate );
+		
+		updateSourceRenderState( sourceTarget, renderState, targetState );
+	}
+}
+
+
+
+
+void SoundPropagationRenderer:: updateSourceRenderState( const SoundSourceTarget& sourceTarget,
+														SoundSourceRenderState& renderState,
+														const RenderTargetState& targetState )
+{
+	const Size numChannels = renderState.getNumberOfOutputChannels();
+	const Size numFrequencyBands = renderNumFrequencyBands;
+	const Size numPathAmplitudes = numFrequencyBands*numChannels;
+	const Size numPaths = sourceTarget.paths.getSize();
+	const Index newTimeStamp = targetState.timeStamp;
+	
+	//****************************************************************************
+	// Move the targets of every path into its render state, adding render states for new paths.
+	
+	for ( Index i = 0; i < numPaths; i++ )
 	{
-		renderSoundSource( outputStream.getBuffer(0), startIndex, numSamples, **i );
+		const PropagationPathTarget& pathTarget = sourceTarget.paths[i];
+		const PropagationPathID& pathID = pathTarget.pathID;
+		const Float* amplitudes = &sourceTarget.pathAmplitudes[i*numPathAmplitudes];
+		
+		PropagationPathRenderState* pathRenderState;
+		
+		// Is there already a propagation path render state for this propagation path?
+		// If so, update the render state for that path.
+		
+		if ( renderState.propagationPaths.find( pathID.getHashCode(), pathID, pathRenderState ) )
+		{
+			// If the number of frequency bands or number of channels in the path render state
+			// is not the same as the current number of bands or channels, reset the path's render state.
+			if ( pathRenderState->getNumberOfChannels() != numChannels ||
+				pathRenderState->getNumberOfFrequencyBands() != numFrequencyBands )
+			{
+				*pathRenderState = PropagationPathRenderState( numFrequencyBands, numChannels, newTimeStamp );
+			}
+			
+			// Update the target delay time and doppler delay change. These are constant for all channels/bands.
+			pathRenderState->targetDelayTime = pathTarget.delayTime;
+			pathRenderState->delayChangePerSecond = pathTarget.delayChangePerSecond;
+			
+			for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
+			{
+				for ( Index c = 0; c < numChannels; c++ )
+				{
+					pathRenderState->getInterpolationState( bandIndex, c ).targetAmplitude =
+																	amplitudes[bandIndex*numChannels + c];
+				}
+			}
+			
+			// Update the time stamp for this path render state.
+			pathRenderState->timeStamp = newTimeStamp;
+		}
+		else
+		{
+			// This is a new propagation path. Add a propagation path render state to the
+			// hash map of render states and keep a pointer to it.
+			pathRenderState = &renderState.propagationPaths.add( pathID.getHashCode(), pathID,
+											PropagationPathRenderState( numFrequencyBands, numChannels, newTimeStamp ) );
+			
+			// Set the delay time and doppler delay change. These are constant for all channels/bands.
+			pathRenderState->currentDelayTime = pathTarget.delayTime;
+			pathRenderState->targetDelayTime = pathTarget.delayTime;
+			pathRenderState->delayChangePerSecond = pathTarget.delayChangePerSecond;
+			
+			for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
+			{
+				for ( Index c = 0; c < numChannels; c++ )
+				{
+					pathRenderState->getInterpolationState( bandIndex, c ) =
+														InterpolationState( amplitudes[bandIndex*numChannels + c] );
+				}
+			}
+		}
 	}
 	
-	// Release a mutex which indicates that rendering parameters are either being used or changed.
-	renderMutex.release();
 	
+	//****************************************************************************
+	// Iterate over the data structure of propagation path render states and prepare aging
+	// states for removal and remove states that are older than the maximum allowed value.
 	
-	return numSamples;
+	{
+		HashMap<PropagationPathID,PropagationPathRenderState>::Iterator i = renderState.propagationPaths.getIterator();
+		
+		while ( i )
+		{
+			if ( i->timeStamp < newTimeStamp )
+			{
+				// If the number of frequency bands or number of channels is not equal to the current
+				// number of bands or channels, remove this propagation path render state immediately
+				// because there is no way we can gracefully perform this operation.
+				if ( i->getNumberOfFrequencyBands() != numFrequencyBands || i->getNumberOfChannels() != numChannels )
+				{
+					i.remove();
+					continue;
+				}
+				
+				// Compute the age of the path now and when this source's render state was last updated.
+				// These can differ by more than one if the audio thread skipped over some target states.
+				Size pathAge = newTimeStamp - i->timeStamp;
+				Size lastPathAge = renderState.renderTimeStamp - i->timeStamp;
+				
+				// Remove paths that are older than the maximum allowed value.
+				if ( pathAge > targetState.maxPathAge || lastPathAge >= targetState.maxPathAge )
+				{
+					i.remove();
+					continue;
+				}
+				
+				// If the path is aging but not ready to be removed yet, fade it out.
+				Float lastGain = math::square(1.0f - (Float)lastPathAge / (Float)targetState.maxPathAge);
+				Float gain = math::square(1.0f - (Float)pathAge / (Float)targetState.maxPathAge);
+				
+				for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
+				{
+					for ( Index c = 0; c < numChannels; c++ )
+					{
+						InterpolationState& interpolationState = i->getInterpolationState( bandIndex, c );
+						
+						Float originalAmplitude = interpolationState.currentAmplitude/lastGain;
+						
+						// Update the target amplitude so that it will fade out exponentially.
+						interpolationState.targetAmplitude = originalAmplitude*gain;
+					}
+				}
+			}
+			
+			i++;
+		}
+	}
+	
+	//****************************************************************************
+	// Update the reverb times and amplitudes for all frequency bands.
+	
+	ReverbRenderState& reverbRenderState = renderState.reverbRenderState;
+	
+	for ( Index bandIndex = 0; bandIndex < numFrequencyBands; bandIndex++ )
+	{
+		for ( Index c = 0; c < numChannels; c++ )
+		{
+			reverbRenderState.setReverbTime( c, bandIndex, sourceTarget.reverbTimes[bandIndex] );
+			reverbRenderState.setTargetGain( c, bandIndex, sourceTarget.reverbGains[bandIndex] );
+		}
+	}
+	
+	renderState.renderTimeStamp = newTimeStamp;
 }
 
 
@@ -2007,14 +2489,18 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 	// Compute some constants that are used in both the SIMD and non-SIMD versions of this method.
 	
 	// Calculate the length of the output buffer in seconds.
-	const Float outputBufferLength = Float(numSamples)/sampleRate;
+	const Float outputBufferLength = Float(numSamples)/renderSampleRate;
 	
 	// Calculate the length in seconds of half a sample.
-	const Float halfSampleLength = Float(0.5)/sampleRate;
+	const Float halfSampleLength = Float(0.5)/renderSampleRate;
 	const Float inverseNumSamples = 1.0f / (Float)(numSamples);
 	
 	const Size numChannels = renderState.getNumberOfOutputChannels();
-	const Size numFrequencyBands = frequencyPartition.getNumberOfFrequencyBands();
+	const Size numFrequencyBands = renderNumFrequencyBands;
+	
+#if GSOUND_RENDERING_STATISTICS
+	const Double crossoverStartTime = util::Timer::getTime();
+#endif
 	
 #if GSOUND_USE_SIMD
 	
@@ -2184,6 +2670,12 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 	//****************************************************************************
 	// Render every propagation path for the sound source.
 	
+#if GSOUND_RENDERING_STATISTICS
+	const Double delayLineStartTime = util::Timer::getTime();
+	statistics.crossoverTime += delayLineStartTime - crossoverStartTime;
+	statistics.numPathsRendered += renderState.propagationPaths.getSize();
+#endif
+	
 	HashMap<PropagationPathID,PropagationPathRenderState>::Iterator pathIterator = renderState.propagationPaths.getIterator();
 	
 	while ( pathIterator )
@@ -2227,9 +2719,9 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 		}
 		
 		const Float delayChangePerSample = (1.0f - (newDelayTime - pathRenderState.currentDelayTime)*
-																	inverseNumSamples*sampleRate);
+																	inverseNumSamples*renderSampleRate);
 		
-		Float delayStart = (Float)currentDelayReadIndex - sampleRate*pathRenderState.currentDelayTime;
+		Float delayStart = (Float)currentDelayReadIndex - renderSampleRate*pathRenderState.currentDelayTime;
 		
 		if ( delayStart < 0.0f )
 			delayStart += (Float)delayBufferSize;
@@ -2237,6 +2729,11 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 		Float fractionalSampleDelay = delayStart - math::floor(delayStart);
 		Index delayStartIndex = (Index)delayStart;
 		
+#if GSOUND_RENDERING_STATISTICS
+		if ( pathRenderState.currentDelayTime != newDelayTime )
+			statistics.numInterpolatedPaths++;
+#endif
+		
 		//****************************************************************************
 		// Render the path for each frequency band and channel.
 		
@@ -2254,12 +2751,14 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 			// Perform multiple SIMD iterations if there are more than the SIMD width frequency bands.
 			for ( Index iteration = 0; iteration < numSIMDIterations; iteration++ )
 			{
-				SIMDAmplitude currentAmplitude;
-				SIMDAmplitude amplitudeChangePerSample;
+				// Bands past the last frequency band are silent, so their amplitudes are zero.
+				SIMDAmplitude currentAmplitude( Float(0) );
+				SIMDAmplitude amplitudeChangePerSample( Float(0) );
 				
-				Size bandIndexStart = iteration*SIMDSample::getWidth();
+				const Size bandIndexStart = iteration*SIMDSample::getWidth();
+				const Size bandIndexEnd = math::min( bandIndexStart + SIMDSample::getWidth(), numFrequencyBands );
 				
-				for ( Index bandIndex = bandIndexStart, i = 0; bandIndex < numFrequencyBands; bandIndex++, i++ )
+				for ( Index bandIndex = bandIndexStart, i = 0; bandIndex < bandIndexEnd; bandIndex++, i++ )
 				{
 					InterpolationState& state = pathRenderState.getInterpolationState( bandIndex, c );
 					
@@ -2327,7 +2826,12 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 	//****************************************************************************
 	// Render the reverb for the sound source.
 	
-	if ( reverbIsEnabled )
+#if GSOUND_RENDERING_STATISTICS
+	const Double reverbStartTime = util::Timer::getTime();
+	statistics.delayLineTime += reverbStartTime - delayLineStartTime;
+#endif
+	
+	if ( renderReverbIsEnabled )
 	{
 		ReverbRenderState& reverbRenderState = renderState.reverbRenderState;
 		
@@ -2367,7 +2871,7 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 				
 #if GSOUND_USE_SIMD
 				
-				Size combFilterDelayBufferSize = Size(sampleRate*combFilterChannel.delayTime)*sampleFrameWidth;
+				Size combFilterDelayBufferSize = Size(renderSampleRate*combFilterChannel.delayTime)*sampleFrameWidth;
 				
 				if ( combFilterChannel.delayBuffer.getSize() < combFilterDelayBufferSize )
 				{
@@ -2385,13 +2889,14 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 				
 				for ( Index iteration = 0; iteration < numSIMDIterations; iteration++ )
 				{
-					SIMDAmplitude feedbackGain;
-					SIMDAmplitude currentAmplitude;
-					SIMDAmplitude amplitudeChangePerSample;
+					SIMDAmplitude feedbackGain( Float(0) );
+					SIMDAmplitude currentAmplitude( Float(0) );
+					SIMDAmplitude amplitudeChangePerSample( Float(0) );
 					
-					Size bandIndexStart = iteration*SIMDSample::getWidth();
+					const Size bandIndexStart = iteration*SIMDSample::getWidth();
+					const Size bandIndexEnd = math::min( bandIndexStart + SIMDSample::getWidth(), numFrequencyBands );
 					
-					for ( Index bandIndex = bandIndexStart, i = 0; bandIndex < numFrequencyBands; bandIndex++, i++ )
+					for ( Index bandIndex = bandIndexStart, i = 0; bandIndex < bandIndexEnd; bandIndex++, i++ )
 					{
 						ReverbRenderState::CombFilter::CombFilterChannel::FrequencyBand& band =
 																		combFilterChannel.frequencyBands[bandIndex];
@@ -2412,12 +2917,12 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 				}
 				
 				combFilterChannel.currentDelayReadIndex = (combFilterChannel.currentDelayReadIndex + numSamples) % 
-																			Size(sampleRate*combFilterChannel.delayTime);
+																			Size(renderSampleRate*combFilterChannel.delayTime);
 				
 				
 #else // GSOUND_USE_SIMD
 				
-				Size combFilterDelayBufferSize = Size(sampleRate*combFilterChannel.delayTime);
+				Size combFilterDelayBufferSize = Size(renderSampleRate*combFilterChannel.delayTime);
 				
 				if ( combFilterChannel.delayBuffers.getSize() < combFilterDelayBufferSize || 
 					combFilterChannel.delayBuffers.getNumberOfBuffers() < numFrequencyBands )
@@ -2470,7 +2975,7 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 			{
 				ReverbRenderState::AllPassFilter::AllPassFilterChannel& allPassFilterChannel = allPassFilter.channels[c];
 				
-				Size allPassFilterDelayBufferSize = Size(sampleRate*allPassFilterChannel.delayTime);
+				Size allPassFilterDelayBufferSize = Size(renderSampleRate*allPassFilterChannel.delayTime);
 				
 				if ( allPassFilterChannel.delayBuffer.getSize() < allPassFilterDelayBufferSize )
 				{
@@ -2514,6 +3019,10 @@ void SoundPropagationRenderer:: renderSoundSource( dsp::SoundBuffer& outputBuffe
 			}
 		}
 	}
+	
+#if GSOUND_RENDERING_STATISTICS
+	statistics.reverbTime += util::Timer::getTime() - reverbStartTime;
+#endif
 }
 
 
@@ -2602,9 +3111,16 @@ void SoundPropagationRenderer:: fillBufferDelayChanges( dsp::Sample* output, con
 {
 	// Get a copy of the sample frame width on the stack, to avoid having to go to the heap every iteration.
 	const Size sampleWidth = sampleFrameWidth;
-
+	
+	// Each sample frame is read with a full SIMD load, so it must be at least that wide.
+	GSOUND_DEBUG_ASSERT( sampleWidth >= SIMDSample::getWidth() && sampleWidth % SIMDSample::getWidth() == 0 );
+	
 	SIMDAmplitude currentAmplitude = startingAmplitude;
 	
+	// The start of the delay can round to the end of the delay buffer, so wrap it before it is read.
+	if ( delay >= delayBufferEnd )
+		delay = delayBufferStart;
+	
 	const dsp::Sample* lastDelay = delay;
 	SIMDFloat a = fractionalSampleDelay;
 	SIMDFloat d = delayChangePerSample;
@@ -2623,11 +3139,16 @@ void SoundPropagationRenderer:: fillBufferDelayChanges( dsp::Sample* output, con
 		a += d;
 		currentAmplitude += amplitudeChangePerSample;
 		
-		while ( a.a > 1.0f )
+		// The delay can advance by more than one sample, so wrap it at every step
+		// to keep the previous sample inside the delay buffer.
+		while ( a[0] > 1.0f )
 		{
 			a -= one;
 			lastDelay = delay;
 			delay += sampleWidth;
+			
+			if ( delay >= delayBufferEnd )
+				delay = delayBufferStart;
 		}
 	}
 }
@@ -2643,6 +3164,10 @@ void SoundPropagationRenderer:: fillBufferDelayChanges( dsp::Sample* output, con
 												Float fractionalSampleDelay, Float delayChangePerSample,
 												Float currentAmplitude, Float amplitudeChangePerSample )
 {
+	// The start of the delay can round to the end of the delay buffer, so wrap it before it is read.
+	if ( delay >= delayBufferEnd )
+		delay = delayBufferStart;
+	
 	const dsp::Sample* lastDelay = delay;
 	Float a = fractionalSampleDelay;
 	
@@ -2661,11 +3186,16 @@ void SoundPropagationRenderer:: fillBufferDelayChanges( dsp::Sample* output, con
 		a += delayChangePerSample;
 		currentAmplitude += amplitudeChangePerSample;
 		
+		// The delay can advance by more than one sample, so wrap it at every step
+		// to keep the previous sample inside the delay buffer.
 		while ( a > 1.0f )
 		{
 			a -= 1.0f;
 			lastDelay = delay;
 			delay++;
+			
+			if ( delay >= delayBufferEnd )
+				delay = delayBufferStart;
 		}
 	}
 }
@@ -68,6 +68,7 @@
 #include "GSoundDSP.h"
 #include "FrequencyPartition.h"
 #include "SoundPropagationPathBuffer.h"
+#include "SoundRenderingStatistics.h"
 
 
 //##########################################################################################
@@ -83,6 +84,18 @@ GSOUND_NAMESPACE_START
 //********************************************************************************
 //********************************************************************************
 /// A class which renders audio based on the output of a sound propagation system.
+/**
+  * The renderer is meant to be updated by one thread while audio is pulled from it by
+  * another. Each call to updatePropagationPaths() builds a complete set of target
+  * amplitudes, delays, and reverb parameters for every sound source and publishes it
+  * through a triple buffer. The audio thread picks up the most recently published set
+  * at the start of each buffer with a single atomic exchange and then moves its own
+  * interpolation state toward those targets, so it never waits for an update in progress
+  * and never sees a partially-updated set of paths.
+  *
+  * Changes to the renderer's configuration are therefore only heard once the next set of
+  * paths has been published by updatePropagationPaths().
+  */
 class SoundPropagationRenderer : public dsp::SoundOutput
 {
 	public:
@@ -122,6 +135,11 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 			
 			
 			/// Update the propagation paths currently being rendered.
+			/**
+			  * The new paths, along with the current renderer configuration, are published
+			  * to the audio rendering thread as a single unit. This method must always be
+			  * called from the same thread.
+			  */
 			void updatePropagationPaths( const SoundPropagationPathBuffer& newPathBuffer );
 			
 			
@@ -406,6 +424,43 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 			
 			
 			
+#if GSOUND_RENDERING_STATISTICS
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Statistics Accessor Methods
+			
+			
+			
+			
+			/// Get statistics about every buffer that has been rendered since the statistics were last reset.
+			/**
+			  * The statistics include the time spent in each stage of rendering and the number
+			  * of sources and paths that were rendered. They are written by the audio thread,
+			  * so they should only be read while audio is not being rendered. They are only
+			  * collected when GSOUND_RENDERING_STATISTICS is enabled.
+			  */
+			GSOUND_INLINE const SoundRenderingStatistics& getStatistics() const
+			{
+				return statistics;
+			}
+			
+			
+			
+			
+			/// Set all of the rendering statistics to zero.
+			/**
+			  * This method should only be called while audio is not being rendered.
+			  */
+			GSOUND_INLINE void resetStatistics()
+			{
+				statistics.reset();
+			}
+			
+			
+			
+			
+#endif
 	private:
 		
 		//********************************************************************************
@@ -457,6 +512,24 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 			
 			
 			
+			/// A class which holds the target delay and doppler shifting for a single propagation path.
+			class PropagationPathTarget;
+			
+			
+			
+			
+			/// A class which holds the target rendering parameters for every path of a single sound source.
+			class SoundSourceTarget;
+			
+			
+			
+			
+			/// A class which holds a complete set of target rendering parameters that is handed to the audio thread.
+			class RenderTargetState;
+			
+			
+			
+			
 #if GSOUND_USE_SIMD
 			/// Define the type to use for a set of interleaved samples.
 			typedef SIMDFloat SIMDAmplitude;
@@ -553,6 +626,27 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Target State Application Methods
+			
+			
+			
+			
+			/// Bring the audio thread's rendering state up to date with a newly published target state.
+			void applyTargetState( const RenderTargetState& targetState );
+			
+			
+			
+			
+			/// Update the propagation path and reverb interpolation state of a source from its new targets.
+			void updateSourceRenderState( const SoundSourceTarget& sourceTarget, SoundSourceRenderState& renderState,
+											const RenderTargetState& targetState );
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -561,7 +655,7 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 			
 			
 			void updateSourcePropagationPaths( const SoundSourcePropagationPathBuffer& pathBuffer,
-												SoundSourceRenderState& renderState, Size maxNumberOfSourcePaths );
+												SoundSourceTarget& sourceTarget, Size maxNumberOfSourcePaths );
 			
 			
 			
@@ -570,6 +664,32 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Target State Publishing Methods
+			
+			
+			
+			
+			/// Hand the back target state to the audio thread and take the previously pending state in exchange.
+			void publishTargetState();
+			
+			
+			
+			
+			/// Stop rendering every source render state, destroying them once the audio thread can no longer use them.
+			void retireAllRenderStates();
+			
+			
+			
+			
+			/// Destroy the retired source render states that no target state visible to the audio thread refers to.
+			void destroyRetiredRenderStates();
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -593,22 +713,117 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Private Rendering Data Members
+		//******	Private Static Data Members
+			
+			
+			
+			
+			/// The number of target states used for the handoff: the back, pending, and front states.
+			static const Size NUM_TARGET_STATES = 3;
+			
+			
+			
+			
+			/// A flag which is set in the pending target index when the audio thread hasn't picked it up yet.
+			static const Int32 NEW_TARGET_STATE_FLAG = 0x4;
+			
+			
+			
+			
+			/// A mask which extracts the index of a target state from the pending target index.
+			static const Int32 TARGET_STATE_INDEX_MASK = 0x3;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Update Data Members
 			
 			
 			
 			
 			/// A map from each sound source being rendered to that source's rendering state object.
+			/**
+			  * This map is only used by the thread which updates the propagation paths.
+			  * The render states themselves are only modified by the audio thread once
+			  * they have been published in a target state.
+			  */
 			HashMap<SoundSource*,SoundSourceRenderState*> sourceRenderStates;
 			
 			
 			
 			
+			/// Source render states which are no longer rendered but may still be in use by the audio thread.
+			ArrayList<SoundSourceRenderState*> retiredRenderStates;
+			
+			
+			
+			
 			/// The current time stamp (frame index) for this sound propagation renderer.
 			Index timeStamp;
 			
 			
 			
+			
+			/// A number which is incremented whenever the frequency partition changes.
+			Index frequencyPartitionVersion;
+			
+			
+			
+			
+			/// A temporary object (stored here to reduce reallocations) that holds panning information.
+			dsp::ChannelGainArray channelGainArray;
+			
+			
+			
+			
+			/// A list of impulses that is used as scratch when sorting impulses by decreasing intensity.
+			ArrayList<Impulse> impulseSortList;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Target State Data Members
+			
+			
+			
+			
+			/// The target states that are rotated between the update thread and the audio thread.
+			RenderTargetState* targetStates;
+			
+			
+			
+			
+			/// The index of the target state which the update thread is writing into.
+			Index backTargetIndex;
+			
+			
+			
+			
+			/// The index of the most recently published target state, combined with NEW_TARGET_STATE_FLAG.
+			AtomicInteger pendingTargetIndex;
+			
+			
+			
+			
+			/// The index of the target state which the audio thread is rendering.
+			Index frontTargetIndex;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Rendering Data Members
+			
+			
+			
 #if GSOUND_USE_SIMD
 			/**
 			  * A sound stream used to get the frequency band separated output from each sound source
@@ -642,24 +857,38 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 			
 			
 			
-			/// A temporary object (stored here to reduce reallocations) that holds panning information.
-			dsp::ChannelGainArray channelGainArray;
+			/// The number of samples required for each channel of the delay buffer for each frequency band.
+			Size delayBufferSize;
 			
 			
 			
 			
-			/// A list of impulses that is used as scratch when sorting impulses by decreasing intensity.
-			ArrayList<Impulse> impulseSortList;
+			/// The sample rate of the target state that the audio thread is rendering.
+			Float renderSampleRate;
 			
 			
 			
 			
-			/// The number of samples required for each channel of the delay buffer for each frequency band.
-			Size delayBufferSize;
+			/// The number of frequency bands in the target state that the audio thread is rendering.
+			Size renderNumFrequencyBands;
+			
+			
+			
+			
+			/// Whether or not reverb is enabled in the target state that the audio thread is rendering.
+			Bool renderReverbIsEnabled;
+			
+			
+			
 			
+#if GSOUND_RENDERING_STATISTICS
+			/// Statistics about the buffers that have been rendered since the statistics were last reset.
+			SoundRenderingStatistics statistics;
 			
 			
 			
+			
+#endif
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -718,16 +947,6 @@ class SoundPropagationRenderer : public dsp::SoundOutput
 			
 			/// The maximum number of frames that a propagation path can be without an update and still be kept.
 			Size maxPathAge;
-			
-			
-			
-			
-			/// A mutex which indicates that rendering parameters are either being used or changed.
-			mutable Mutex renderMutex;
-			
-			
-			
-			
 };
 
 
@@ -0,0 +1,539 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/SoundPropagationService.cpp
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::SoundPropagationService class implementation
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+
+#include "SoundPropagationService.h"
+
+
+//##########################################################################################
+//******************************  Start GSound Namespace  **********************************
+GSOUND_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Constructors
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+SoundPropagationService:: SoundPropagationService( SoundPropagator& newPropagator )
+	:	propagator( &newPropagator ),
+		maxListenerProbeDepth( 4 ),
+		numListenerProbeRays( 1000 ),
+		maxSourceProbeDepth( 4 ),
+		numSourceProbeRays( 100 ),
+		pendingSpeedOfSound( 343 ),
+		hasNewState( false ),
+		stopRequested( false ),
+		hasPropagationState( false ),
+		backIndex( 0 ),
+		pendingIndex( 1 ),
+		frontIndex( 2 ),
+		hasNewPathBuffer( false ),
+		pendingFrameTime( 0.0 ),
+		frontFrameTime( 0.0 )
+{
+}
+
+
+
+
+SoundPropagationService:: SoundPropagationService( SoundPropagator& newPropagator,
+												Size newMaxListenerProbeDepth, Size newNumListenerProbeRays,
+												Size newMaxSourceProbeDepth, Size newNumSourceProbeRays )
+	:	propagator( &newPropagator ),
+		maxListenerProbeDepth( newMaxListenerProbeDepth ),
+		numListenerProbeRays( newNumListenerProbeRays ),
+		maxSourceProbeDepth( newMaxSourceProbeDepth ),
+		numSourceProbeRays( newNumSourceProbeRays ),
+		pendingSpeedOfSound( 343 ),
+		hasNewState( false ),
+		stopRequested( false ),
+		hasPropagationState( false ),
+		backIndex( 0 ),
+		pendingIndex( 1 ),
+		frontIndex( 2 ),
+		hasNewPathBuffer( false ),
+		pendingFrameTime( 0.0 ),
+		frontFrameTime( 0.0 )
+{
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Destructor
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+SoundPropagationService:: ~SoundPropagationService()
+{
+	// Make sure that the propagation thread is no longer using the snapshots.
+	stop();
+	
+	// The propagation scene doesn't own its sources and objects, so destroy them here.
+	propagationScene.removeAllSources();
+	propagationScene.removeAllObjects();
+	
+	resizeSnapshots( pendingSources, 0 );
+	resizeSnapshots( pendingObjects, 0 );
+	resizeSnapshots( propagationSources, 0 );
+	resizeSnapshots( propagationObjects, 0 );
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Service Start and Stop Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Bool SoundPropagationService:: start()
+{
+	if ( thread.isRunning() )
+		return false;
+	
+	stopRequested = false;
+	
+	return thread.start( propagationThreadEntry, this );
+}
+
+
+
+
+void SoundPropagationService:: stop()
+{
+	if ( !thread.isRunning() )
+		return;
+	
+	stateMutex.acquire();
+	stopRequested = true;
+	stateMutex.release();
+	
+	// Wake the propagation thread if it is waiting for the first snapshot.
+	stateSignal.signal();
+	
+	thread.join();
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		State Update Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationService:: updateState( const SoundScene& scene, const SoundListener& listener )
+{
+	const Size numSources = scene.getNumberOfSources();
+	const Size numObjects = scene.getNumberOfObjects();
+	
+	stateMutex.acquire();
+	
+	copyListenerState( listener, pendingListener );
+	
+	// Copy the state of each source, remembering which of the caller's sources it came from.
+	resizeSnapshots( pendingSources, numSources );
+	pendingSourceKeys.clear();
+	
+	for ( Index i = 0; i < numSources; i++ )
+	{
+		SoundSource* source = scene.getSource(i);
+		
+		pendingSourceKeys.add( source );
+		copySourceState( *source, *pendingSources[i] );
+	}
+	
+	// Objects don't have any propagation caches, so they can be copied directly.
+	// Their meshes are shared with the caller's objects rather than copied.
+	resizeSnapshots( pendingObjects, numObjects );
+	
+	for ( Index i = 0; i < numObjects; i++ )
+		*pendingObjects[i] = *scene.getObject(i);
+	
+	pendingSpeedOfSound = scene.getSpeedOfSound();
+	hasNewState = true;
+	
+	stateMutex.release();
+	
+	stateSignal.signal();
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Path Buffer Accessor Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Bool SoundPropagationService:: updatePathBuffer()
+{
+	pathBufferMutex.acquire();
+	
+	const Bool result = hasNewPathBuffer;
+	
+	if ( hasNewPathBuffer )
+	{
+		Index temp = frontIndex;
+		frontIndex = pendingIndex;
+		pendingIndex = temp;
+		
+		frontFrameTime = pendingFrameTime;
+		hasNewPathBuffer = false;
+	}
+	
+	pathBufferMutex.release();
+	
+	return result;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Ray Count Accessor Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationService:: setNumberOfListenerProbeRays( Size newNumListenerProbeRays )
+{
+	stateMutex.acquire();
+	numListenerProbeRays = newNumListenerProbeRays;
+	stateMutex.release();
+}
+
+
+
+
+void SoundPropagationService:: setNumberOfSourceProbeRays( Size newNumSourceProbeRays )
+{
+	stateMutex.acquire();
+	numSourceProbeRays = newNumSourceProbeRays;
+	stateMutex.release();
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Propagation Thread Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationService:: propagationThreadEntry( void* service )
+{
+	((SoundPropagationService*)service)->runPropagation();
+}
+
+
+
+
+void SoundPropagationService:: runPropagation()
+{
+	util::Timer timer;
+	
+	while ( true )
+	{
+		//****************************************************************************
+		// Pick up the latest snapshot and propagation parameters.
+		
+		stateMutex.acquire();
+		
+		if ( stopRequested )
+		{
+			stateMutex.release();
+			break;
+		}
+		
+		if ( hasNewState )
+		{
+			updatePropagationScene();
+			hasNewState = false;
+			hasPropagationState = true;
+		}
+		
+		const Size listenerDepth = maxListenerProbeDepth;
+		const Size listenerRays = numListenerProbeRays;
+		const Size sourceDepth = maxSourceProbeDepth;
+		const Size sourceRays = numSourceProbeRays;
+		
+		stateMutex.release();
+		
+		// Wait for the caller to publish the first snapshot or to stop the service.
+		// A signal that was sent before the wait began is not lost.
+		if ( !hasPropagationState )
+		{
+			stateSignal.wait();
+			continue;
+		}
+		
+		//****************************************************************************
+		// Propagate sound into the back buffer.
+		
+		SoundPropagationPathBuffer& pathBuffer = pathBuffers[backIndex];
+		
+		timer.update();
+		
+		propagator->propagateSound( propagationScene, propagationListener,
+									listenerDepth, listenerRays, sourceDepth, sourceRays,
+									pathBuffer );
+		
+		timer.update();
+		
+		// Refer to the caller's sources rather than the service's copies so that
+		// a renderer can associate the paths with the sources' audio.
+		const Size numSources = math::min( pathBuffer.getNumberOfSources(), propagationSourceKeys.getSize() );
+		
+		for ( Index i = 0; i < numSources; i++ )
+			pathBuffer.getSourceBuffer(i).setSource( propagationSourceKeys[i] );
+		
+		//****************************************************************************
+		// Publish the finished buffer by swapping it with the pending buffer.
+		
+		pathBufferMutex.acquire();
+		
+		Index temp = pendingIndex;
+		pendingIndex = backIndex;
+		backIndex = temp;
+		
+		pendingFrameTime = timer.getLastInterval();
+		hasNewPathBuffer = true;
+		
+		pathBufferMutex.release();
+	}
+}
+
+
+
+
+void SoundPropagationService:: updatePropagationScene()
+{
+	copyListenerState( pendingListener, propagationListener );
+	
+	//****************************************************************************
+	// Update the sources. A source that now corresponds to a different caller
+	// source is recreated so that it doesn't keep another source's caches.
+	
+	const Size numSources = pendingSources.getSize();
+	Bool sourcesChanged = numSources != propagationSources.getSize();
+	
+	resizeSnapshots( propagationSources, numSources );
+	
+	while ( propagationSourceKeys.getSize() < numSources )
+		propagationSourceKeys.add( NULL );
+	
+	while ( propagationSourceKeys.getSize() > numSources )
+		propagationSourceKeys.removeLast();
+	
+	for ( Index i = 0; i < numSources; i++ )
+	{
+		if ( propagationSourceKeys[i] != pendingSourceKeys[i] )
+		{
+			util::destruct( propagationSources[i] );
+			propagationSources[i] = util::construct<SoundSource>();
+			propagationSourceKeys[i] = pendingSourceKeys[i];
+			sourcesChanged = true;
+		}
+		
+		copySourceState( *pendingSources[i], *propagationSources[i] );
+	}
+	
+	if ( sourcesChanged )
+	{
+		propagationScene.removeAllSources();
+		
+		for ( Index i = 0; i < numSources; i++ )
+			propagationScene.addSource( propagationSources[i] );
+	}
+	
+	//****************************************************************************
+	// Update the objects. The scene only needs to rebuild its BVH if the number of
+	// objects changed, otherwise it refits the BVH to the new transformations.
+	
+	const Size numObjects = pendingObjects.getSize();
+	
+	if ( numObjects != propagationObjects.getSize() )
+	{
+		propagationScene.removeAllObjects();
+		resizeSnapshots( propagationObjects, numObjects );
+		
+		for ( Index i = 0; i < numObjects; i++ )
+			propagationScene.addObject( propagationObjects[i] );
+	}
+	
+	for ( Index i = 0; i < numObjects; i++ )
+		*propagationObjects[i] = *pendingObjects[i];
+	
+	propagationScene.setSpeedOfSound( pendingSpeedOfSound );
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Snapshot Helper Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagationService:: copyListenerState( const SoundListener& listener, SoundListener& destination )
+{
+	destination.setPosition( listener.getPosition() );
+	destination.setVelocity( listener.getVelocity() );
+	destination.setOrientationRaw( listener.getOrientation() );
+	destination.setUserData( listener.getUserData() );
+}
+
+
+
+
+void SoundPropagationService:: copySourceState( const SoundSource& source, SoundSource& destination )
+{
+	destination.setPosition( source.getPosition() );
+	destination.setVelocity( source.getVelocity() );
+	destination.setDirection( source.getDirection() );
+	destination.setIntensity( source.getIntensity() );
+	destination.setRadius( source.getRadius() );
+	destination.setDistanceAttenuation( source.getDistanceAttenuation() );
+	destination.setReverbDistanceAttenuation( source.getReverbDistanceAttenuation() );
+	destination.setIsDirectional( source.getIsDirectional() );
+	destination.setOnAxisFrequencyResponse( source.getOnAxisFrequencyResponse() );
+	destination.setOffAxisFrequencyResponse( source.getOffAxisFrequencyResponse() );
+	destination.setSoundInput( const_cast<dsp::SoundOutput*>( source.getSoundInput() ) );
+	destination.setUserData( source.getUserData() );
+	destination.setIsEnabled( source.getIsEnabled() );
+}
+
+
+
+
+template < typename T >
+void SoundPropagationService:: resizeSnapshots( ArrayList<T*>& snapshots, Size newSize )
+{
+	while ( snapshots.getSize() < newSize )
+		snapshots.add( util::construct<T>() );
+	
+	while ( snapshots.getSize() > newSize )
+	{
+		util::destruct( snapshots.getLast() );
+		snapshots.removeLast();
+	}
+}
+
+
+
+
+//##########################################################################################
+//******************************  End GSound Namespace  ************************************
+GSOUND_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
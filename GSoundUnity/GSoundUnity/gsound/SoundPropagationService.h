@@ -0,0 +1,616 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/SoundPropagationService.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::SoundPropagationService class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+
+#ifndef INCLUDE_GSOUND_SOUND_PROPAGATION_SERVICE_H
+#define INCLUDE_GSOUND_SOUND_PROPAGATION_SERVICE_H
+
+
+#include "GSoundBase.h"
+
+
+#include "SoundPropagator.h"
+
+
+//##########################################################################################
+//******************************  Start GSound Namespace  **********************************
+GSOUND_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which performs sound propagation continuously on a background thread.
+/**
+  * A SoundPropagationService decouples the cost of sound propagation from the thread
+  * that drives the simulation. Once started, the service repeatedly propagates sound on
+  * its own thread using a snapshot of the listener, the sources, and the objects of the
+  * scene. The caller publishes a new snapshot whenever it likes by calling updateState(),
+  * which only copies the state of those objects and never waits for propagation to finish.
+  *
+  * Finished SoundPropagationPathBuffer objects are handed back through a double buffer.
+  * The propagation thread writes into a back buffer and then swaps it with a pending
+  * buffer, while the caller swaps the pending buffer into the front buffer by calling
+  * updatePathBuffer(). Neither side holds the lock for more than a pointer swap, so the
+  * caller always has a complete front buffer that it can pass to a SoundPropagationRenderer.
+  *
+  * The SoundSource pointers in the published path buffers refer to the caller's sources,
+  * not to the service's internal copies. A source must therefore not be destroyed until
+  * the service has been stopped or has published a path buffer that doesn't contain it.
+  *
+  * The snapshot of an object copies its transformation but not its SoundMesh. The
+  * propagation thread reads the triangles, materials, and BVH of the caller's meshes
+  * directly. Every mesh that is used by an object in a snapshot must therefore be kept
+  * alive and must not be modified, for instance with SoundMesh::setMaterial(), until
+  * the service has been stopped.
+  *
+  * The SoundPropagator that the service uses must not be used or reconfigured by other
+  * threads while the service is running.
+  */
+class SoundPropagationService
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructors
+			
+			
+			
+			
+			/// Create a SoundPropagationService which uses the specified propagator and default ray counts.
+			/**
+			  * The service shoots 1000 rays with a maximum depth of 4 from the listener
+			  * and 100 rays with a maximum depth of 4 from each source. The service
+			  * is not running until start() is called.
+			  */
+			SoundPropagationService( SoundPropagator& newPropagator );
+			
+			
+			
+			
+			/// Create a SoundPropagationService which uses the specified propagator and ray counts.
+			/**
+			  * The service is not running until start() is called.
+			  */
+			SoundPropagationService( SoundPropagator& newPropagator,
+									Size newMaxListenerProbeDepth, Size newNumListenerProbeRays,
+									Size newMaxSourceProbeDepth, Size newNumSourceProbeRays );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Destructor
+			
+			
+			
+			
+			/// Destroy a SoundPropagationService, stopping its propagation thread if it is running.
+			~SoundPropagationService();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Service Start and Stop Methods
+			
+			
+			
+			
+			/// Start propagating sound on the service's background thread.
+			/**
+			  * Propagation begins as soon as the first snapshot has been published
+			  * with updateState(). If the service is already running or the thread
+			  * could not be created, FALSE is returned.
+			  */
+			Bool start();
+			
+			
+			
+			
+			/// Stop the service's background thread, waiting for the current frame to finish.
+			/**
+			  * If the service is not running, this method has no effect.
+			  */
+			void stop();
+			
+			
+			
+			
+			/// Return whether or not the service's background thread is running.
+			GSOUND_INLINE Bool isRunning() const
+			{
+				return thread.isRunning();
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	State Update Method
+			
+			
+			
+			
+			/// Publish a snapshot of the specified scene and listener for the next frame of propagation.
+			/**
+			  * The position, orientation, and parameters of the listener, every source,
+			  * and every object in the scene are copied. The propagation thread picks up
+			  * the most recent snapshot at the start of its next frame, so it is safe to
+			  * modify the scene and listener as soon as this method returns. The objects'
+			  * meshes are not copied, so they must not be modified or destroyed until the
+			  * service has been stopped.
+			  */
+			void updateState( const SoundScene& scene, const SoundListener& listener );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Path Buffer Accessor Methods
+			
+			
+			
+			
+			/// Swap the most recently finished path buffer into the front buffer.
+			/**
+			  * If the propagation thread has finished a frame since the last call to this
+			  * method, the front buffer is replaced by that frame's paths and TRUE is
+			  * returned. Otherwise, the front buffer is left unchanged and FALSE is returned.
+			  */
+			Bool updatePathBuffer();
+			
+			
+			
+			
+			/// Return a reference to the front path buffer.
+			/**
+			  * The front buffer is only changed by updatePathBuffer(), so the returned
+			  * reference remains valid and unchanged until then.
+			  */
+			GSOUND_INLINE const SoundPropagationPathBuffer& getPathBuffer() const
+			{
+				return pathBuffers[frontIndex];
+			}
+			
+			
+			
+			
+			/// Return the time in seconds that it took to propagate the paths in the front buffer.
+			GSOUND_INLINE Double getPathBufferFrameTime() const
+			{
+				return frontFrameTime;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Ray Count Accessor Methods
+			
+			
+			
+			
+			/// Get the number of rays that are shot from the listener each frame.
+			GSOUND_INLINE Size getNumberOfListenerProbeRays() const
+			{
+				return numListenerProbeRays;
+			}
+			
+			
+			
+			
+			/// Set the number of rays that are shot from the listener each frame.
+			/**
+			  * The new ray count takes effect at the start of the next frame of propagation.
+			  */
+			void setNumberOfListenerProbeRays( Size newNumListenerProbeRays );
+			
+			
+			
+			
+			/// Get the number of rays that are shot from each source each frame.
+			GSOUND_INLINE Size getNumberOfSourceProbeRays() const
+			{
+				return numSourceProbeRays;
+			}
+			
+			
+			
+			
+			/// Set the number of rays that are shot from each source each frame.
+			/**
+			  * The new ray count takes effect at the start of the next frame of propagation.
+			  */
+			void setNumberOfSourceProbeRays( Size newNumSourceProbeRays );
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Copy Operations
+			
+			
+			
+			
+			/// Declared but not defined, services can't be copied.
+			SoundPropagationService( const SoundPropagationService& other );
+			
+			
+			
+			
+			/// Declared but not defined, services can't be copied.
+			SoundPropagationService& operator = ( const SoundPropagationService& other );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Propagation Thread Methods
+			
+			
+			
+			
+			/// The entry point of the propagation thread, the parameter points to the service.
+			static void propagationThreadEntry( void* service );
+			
+			
+			
+			
+			/// Propagate sound repeatedly until the service is asked to stop.
+			void runPropagation();
+			
+			
+			
+			
+			/// Copy the most recently published snapshot into the scene used for propagation.
+			void updatePropagationScene();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Snapshot Helper Methods
+			
+			
+			
+			
+			/// Copy the position, orientation, and user data of one listener to another.
+			/**
+			  * The propagation caches of the destination listener are left untouched.
+			  */
+			static void copyListenerState( const SoundListener& listener, SoundListener& destination );
+			
+			
+			
+			
+			/// Copy the position and all public parameters of one source to another.
+			/**
+			  * The propagation caches of the destination source are left untouched.
+			  */
+			static void copySourceState( const SoundSource& source, SoundSource& destination );
+			
+			
+			
+			
+			/// Resize a list of owned snapshot objects, constructing or destroying objects as needed.
+			template < typename T >
+			static void resizeSnapshots( ArrayList<T*>& snapshots, Size newSize );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Data Members
+			
+			
+			
+			
+			/// The number of path buffers used for the handoff: the back, pending, and front buffers.
+			static const Size NUM_PATH_BUFFERS = 3;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Propagation Data Members
+			
+			
+			
+			
+			/// The propagator which performs sound propagation on the service's thread.
+			SoundPropagator* propagator;
+			
+			
+			
+			
+			/// The background thread on which sound propagation is performed.
+			util::Thread thread;
+			
+			
+			
+			
+			/// The maximum depth of the rays shot from the listener.
+			Size maxListenerProbeDepth;
+			
+			
+			
+			
+			/// The number of rays shot from the listener each frame.
+			Size numListenerProbeRays;
+			
+			
+			
+			
+			/// The maximum depth of the rays shot from each source.
+			Size maxSourceProbeDepth;
+			
+			
+			
+			
+			/// The number of rays shot from each source each frame.
+			Size numSourceProbeRays;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Published Snapshot Data Members
+			
+			
+			
+			
+			/// A mutex which protects the published snapshot and the stop request.
+			Mutex stateMutex;
+			
+			
+			
+			
+			/// A copy of the state of the listener from the last call to updateState().
+			SoundListener pendingListener;
+			
+			
+			
+			
+			/// The caller's sources from the last call to updateState().
+			ArrayList<SoundSource*> pendingSourceKeys;
+			
+			
+			
+			
+			/// Copies of the state of the caller's sources from the last call to updateState().
+			ArrayList<SoundSource*> pendingSources;
+			
+			
+			
+			
+			/// Copies of the caller's objects from the last call to updateState().
+			ArrayList<SoundObject*> pendingObjects;
+			
+			
+			
+			
+			/// The speed of sound in the caller's scene from the last call to updateState().
+			Real pendingSpeedOfSound;
+			
+			
+			
+			
+			/// Whether or not a snapshot has been published that the propagation thread hasn't used yet.
+			Bool hasNewState;
+			
+			
+			
+			
+			/// Whether or not the propagation thread should stop after its current frame.
+			Bool stopRequested;
+			
+			
+			
+			
+			/// A signal which wakes the propagation thread when a snapshot is published or a stop is requested.
+			util::Signal stateSignal;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Propagation Thread Data Members
+			
+			
+			
+			
+			/// The scene that is used for propagation, containing the service's own copies of the sources and objects.
+			SoundScene propagationScene;
+			
+			
+			
+			
+			/// The listener that is used for propagation, which keeps its caches from frame to frame.
+			SoundListener propagationListener;
+			
+			
+			
+			
+			/// The caller's source that corresponds to each source in the propagation scene.
+			ArrayList<SoundSource*> propagationSourceKeys;
+			
+			
+			
+			
+			/// The sources in the propagation scene, owned by the service.
+			ArrayList<SoundSource*> propagationSources;
+			
+			
+			
+			
+			/// The objects in the propagation scene, owned by the service.
+			ArrayList<SoundObject*> propagationObjects;
+			
+			
+			
+			
+			/// Whether or not any snapshot has been copied into the propagation scene.
+			Bool hasPropagationState;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Path Buffer Data Members
+			
+			
+			
+			
+			/// A mutex which protects the pending buffer index and frame time.
+			Mutex pathBufferMutex;
+			
+			
+			
+			
+			/// The path buffers that are rotated between the propagation thread and the caller.
+			SoundPropagationPathBuffer pathBuffers[NUM_PATH_BUFFERS];
+			
+			
+			
+			
+			/// The index of the buffer which the propagation thread is writing into.
+			Index backIndex;
+			
+			
+			
+			
+			/// The index of the most recently finished buffer that the caller hasn't picked up yet.
+			Index pendingIndex;
+			
+			
+			
+			
+			/// The index of the buffer which the caller is reading from.
+			Index frontIndex;
+			
+			
+			
+			
+			/// Whether or not the pending buffer contains paths that are newer than the front buffer.
+			Bool hasNewPathBuffer;
+			
+			
+			
+			
+			/// The time in seconds that it took to propagate the paths in the pending buffer.
+			Double pendingFrameTime;
+			
+			
+			
+			
+			/// The time in seconds that it took to propagate the paths in the front buffer.
+			Double frontFrameTime;
+			
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//******************************  End GSound Namespace  ************************************
+GSOUND_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_SOUND_PROPAGATION_SERVICE_H
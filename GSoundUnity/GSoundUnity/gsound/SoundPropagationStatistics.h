@@ -0,0 +1,295 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/SoundPropagationStatistics.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::SoundPropagationStatistics class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_SOUND_PROPAGATION_STATISTICS_H
+#define INCLUDE_GSOUND_SOUND_PROPAGATION_STATISTICS_H
+
+
+#include "GSoundBase.h"
+
+
+//##########################################################################################
+//******************************  Start GSound Namespace  **********************************
+GSOUND_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which records where the time was spent during one call to SoundPropagator::propagateSound().
+/**
+  * A SoundPropagator fills one of these objects on every call to propagateSound()
+  * when GSOUND_PROPAGATION_STATISTICS is enabled. It contains the wall-clock time
+  * spent in each stage of the propagation, the amount of ray tracing work that was
+  * done, how effective the listener's probe path cache was, and the number of
+  * propagation paths that were found of each type.
+  *
+  * All times are in seconds. The ray tracing counts include the work done by every
+  * thread that traced listener probe rays.
+  */
+class SoundPropagationStatistics
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			/// Create a sound propagation statistics object with all statistics set to zero.
+			GSOUND_INLINE SoundPropagationStatistics()
+			{
+				this->reset();
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Reset Method
+			
+			
+			
+			
+			/// Set all of the statistics to zero.
+			GSOUND_INLINE void reset()
+			{
+				totalTime = Double(0);
+				cachedPathValidationTime = Double(0);
+				directPathTime = Double(0);
+				listenerPropagationTime = Double(0);
+				sourcePropagationTime = Double(0);
+				
+				numRaysTraced = 0;
+				numNodesVisited = 0;
+				numTrianglesTested = 0;
+				
+				numProbePathCacheHits = 0;
+				numProbePathCacheMisses = 0;
+				
+				numOcclusionCacheHits = 0;
+				numOcclusionCacheMisses = 0;
+				
+				numDirectPaths = 0;
+				numTransmissionPaths = 0;
+				numReflectionPaths = 0;
+				numDiffractionPaths = 0;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Stage Timing Data Members
+			
+			
+			
+			
+			/// The total time spent in the call to propagateSound().
+			Double totalTime;
+			
+			
+			
+			
+			/// The time spent validating the listener's cached probe paths.
+			Double cachedPathValidationTime;
+			
+			
+			
+			
+			/// The time spent finding direct and transmitted propagation paths.
+			Double directPathTime;
+			
+			
+			
+			
+			/// The time spent tracing listener probe rays and merging their output.
+			Double listenerPropagationTime;
+			
+			
+			
+			
+			/// The time spent tracing source probe rays and estimating reverb.
+			Double sourcePropagationTime;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Ray Tracing Data Members
+			
+			
+			
+			
+			/// The number of rays that were traced, including probe, occlusion, and transmission rays.
+			Size numRaysTraced;
+			
+			
+			
+			
+			/// The number of object and triangle BVH nodes whose children were tested against a ray.
+			Size numNodesVisited;
+			
+			
+			
+			
+			/// The number of ray-triangle intersection tests that were performed.
+			Size numTrianglesTested;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Probe Path Cache Data Members
+			
+			
+			
+			
+			/// The number of listener probe paths that were already in the listener's probe path cache.
+			Size numProbePathCacheHits;
+			
+			
+			
+			
+			/// The number of listener probe paths that were not in the cache and had to be validated.
+			Size numProbePathCacheMisses;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Occlusion Cache Data Members
+			
+			
+			
+			
+			/// The number of path validation occlusion rays whose result was found in an occlusion cache.
+			Size numOcclusionCacheHits;
+			
+			
+			
+			
+			/// The number of path validation occlusion rays which were not cached and had to be traced.
+			Size numOcclusionCacheMisses;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Propagation Path Count Data Members
+			
+			
+			
+			
+			/// The number of unoccluded direct propagation paths that were found.
+			Size numDirectPaths;
+			
+			
+			
+			
+			/// The number of direct propagation paths that were found through transmission.
+			Size numTransmissionPaths;
+			
+			
+			
+			
+			/// The number of specular reflection propagation paths that were found.
+			Size numReflectionPaths;
+			
+			
+			
+			
+			/// The number of propagation paths containing an edge diffraction that were found.
+			Size numDiffractionPaths;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//******************************  End GSound Namespace  ************************************
+GSOUND_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_SOUND_PROPAGATION_STATISTICS_H
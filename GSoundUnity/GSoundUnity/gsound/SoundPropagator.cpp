@@ -61,6 +61,7 @@
 #include "SoundPropagator.h"
 
 
+#include "internal/ProbeDirectionSequence.h"
 #include "internal/ProbePath.h"
 #include "internal/ProbePathCache.h"
 #include "internal/ProbedTriangleCache.h"
@@ -115,6 +116,210 @@ class SoundPropagator:: ProbeIntersectionRecord
 
 
 
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Private Internal Source Propagation Path Class
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+class SoundPropagator:: SourcePropagationPath
+{
+	public:
+		
+		GSOUND_INLINE SourcePropagationPath( Index newSourceIndex, const PropagationPath& newPath )
+			:	sourceIndex( newSourceIndex ),
+				path( newPath )
+		{
+		}
+		
+		
+		/// The index of the source in the scene that this path belongs to.
+		Index sourceIndex;
+		
+		/// The propagation path from the source to the listener.
+		PropagationPath path;
+		
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Private Internal Listener Probe Thread Class
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+class SoundPropagator:: ListenerProbeThread
+{
+	public:
+		
+		/// A probe path which was first found by this thread, along with the end of its propagation paths.
+		class StagedProbePath
+		{
+			public:
+				
+				GSOUND_INLINE StagedProbePath( const ProbePath& newProbePath, Index newPathsEnd )
+					:	probePath( newProbePath ),
+						pathsEnd( newPathsEnd )
+				{
+				}
+				
+				ProbePath probePath;
+				
+				/// The index after the last propagation path that was found for this probe path.
+				Index pathsEnd;
+		};
+		
+		
+		/// A triangle which was hit by a probe ray traced by this thread.
+		class StagedProbedTriangle
+		{
+			public:
+				
+				GSOUND_INLINE StagedProbedTriangle( const internal::ObjectSpaceTriangle& newTriangle,
+													const SoundListener::ProbeVisibilityRecord& newRecord )
+					:	triangle( newTriangle ),
+						record( newRecord )
+				{
+				}
+				
+				internal::ObjectSpaceTriangle triangle;
+				
+				SoundListener::ProbeVisibilityRecord record;
+		};
+		
+		
+		GSOUND_INLINE ListenerProbeThread()
+			:	propagator( NULL ),
+				listener( NULL ),
+				maxDepth( 0 ),
+				raysPerCell( 0 ),
+				frameSeed( 0 ),
+				ranOutOfTime( false )
+		{
+		}
+		
+		
+		//******	Input
+		
+		/// The sound propagator which is using this thread.
+		SoundPropagator* propagator;
+		
+		/// The listener for which probe rays are being traced.
+		const SoundListener* listener;
+		
+		/// The maximum depth to which probe rays are traced.
+		Size maxDepth;
+		
+		/// The number of rays to trace for a cell with a ray affinity of 1.
+		Real raysPerCell;
+		
+		/// The indices of the ray distribution cells that this thread traces rays for, in tracing order.
+		ArrayList<Index> cells;
+		
+		/// The seed from which each cell's random stream is derived for the current frame.
+		UInt32 frameSeed;
+		
+		
+		//******	Per-Thread Tracing State
+		
+		/// A ray tracer with its own traversal stack.
+		internal::RayTracer rayTracer;
+		
+		/// An object which is used to accumulate all points along a propagation path.
+		PropagationPathDescription pathDescription;
+		
+		/// A random variable which generates the initial directions for probe rays.
+		math::RandomVariable<Real> randomVariable;
+		
+		/// The intersection records for the probe ray currently being traced.
+		ArrayList<ProbeIntersectionRecord> path;
+		
+		/// The probe paths that were first found by this thread on the current frame.
+		internal::ProbePathCache newProbePaths;
+		
+		/// The results of the occlusion rays traced by this thread on the current frame.
+		internal::OcclusionCache occlusionCache;
+		
+		/// The source batches that may be reached by the probe path currently being validated.
+		ArrayList<Index> sourceBatches;
+		
+		
+		//******	Staged Output
+		
+		/// Whether or not the time budget ran out before all of this thread's rays were traced.
+		Bool ranOutOfTime;
+		
+		/// The new probe paths found by this thread, in the order that they were found.
+		ArrayList<StagedProbePath> probePaths;
+		
+		/// The propagation paths found for the new probe paths, in the same order.
+		ArrayList<SourcePropagationPath> propagationPaths;
+		
+		/// The triangles hit by this thread's probe rays, in the order that they were hit.
+		ArrayList<StagedProbedTriangle> probedTriangles;
+		
+#if GSOUND_PROPAGATION_STATISTICS
+		/// The number of probe paths traced by this thread that had already been visited.
+		Size numProbePathCacheHits;
+		
+		/// The number of probe paths traced by this thread that had not already been visited.
+		Size numProbePathCacheMisses;
+		
+#endif
+		
+		/// The thread which traces the probe rays if this is not the calling thread.
+		util::Thread thread;
+		
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Private Internal Listener Probe Cell Class
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+class SoundPropagator:: ListenerProbeCell
+{
+	public:
+		
+		GSOUND_INLINE ListenerProbeCell( Index newCellIndex, Real newRayAffinity )
+			:	cellIndex( newCellIndex ),
+				rayAffinity( newRayAffinity )
+		{
+		}
+		
+		
+		/// The index of the cell within the listener's ray distribution.
+		Index cellIndex;
+		
+		/// The ray affinity of the cell when the propagation started.
+		Real rayAffinity;
+		
+};
+
+
+
+
 //##########################################################################################
 //##########################################################################################
 //############		
@@ -127,17 +332,25 @@ class SoundPropagator:: ProbeIntersectionRecord
 
 
 SoundPropagator:: SoundPropagator()
-	:	rayTracer( util::construct<internal::RayTracer>() ),
+	:	scene( NULL ),
+		debugDrawingCache( NULL ),
+		rayTracer( util::construct<internal::RayTracer>() ),
+		numThreads( 1 ),
+		maxNumProbePaths( 65536 ),
+		propagationDeadline( 0 ),
+		hasPropagationDeadline( false ),
+		listenerMergeTimeRatio( 0.25 ),
+		sourcePropagationTime( 0 ),
+		propagationWasCutShort( false ),
+		timeStamp( 0 ),
+		rayEpsilon( Real(0.0001) ),
 		directSoundIsEnabled( true ),
 		transmissionIsEnabled( true ),
+		transmissionThreshold( 0 ),
 		reflectionIsEnabled( true ),
 		diffractionIsEnabled( true ),
 		reverbIsEnabled( true ),
-		timeStamp( 0 ),
-		rayEpsilon( Real(0.0001) ),
-		maxReverbCacheAge( 10 ),
-		scene( NULL ),
-		debugDrawingCache( NULL )
+		maxReverbCacheAge( 10 )
 {
 }
 
@@ -145,17 +358,25 @@ SoundPropagator:: SoundPropagator()
 
 
 SoundPropagator:: SoundPropagator( const SoundPropagator& other )
-	:	rayTracer( util::construct<internal::RayTracer>(*other.rayTracer) ),
+	:	scene( NULL ),
+		debugDrawingCache( NULL ),
+		rayTracer( util::construct<internal::RayTracer>(*other.rayTracer) ),
+		numThreads( other.numThreads ),
+		maxNumProbePaths( other.maxNumProbePaths ),
+		propagationDeadline( 0 ),
+		hasPropagationDeadline( false ),
+		listenerMergeTimeRatio( other.listenerMergeTimeRatio ),
+		sourcePropagationTime( other.sourcePropagationTime ),
+		propagationWasCutShort( false ),
+		timeStamp( other.timeStamp ),
+		rayEpsilon( other.rayEpsilon ),
 		directSoundIsEnabled( other.directSoundIsEnabled ),
 		transmissionIsEnabled( other.transmissionIsEnabled ),
+		transmissionThreshold( other.transmissionThreshold ),
 		reflectionIsEnabled( other.reflectionIsEnabled ),
 		diffractionIsEnabled( other.diffractionIsEnabled ),
 		reverbIsEnabled( other.reverbIsEnabled ),
-		timeStamp( other.timeStamp ),
-		rayEpsilon( other.rayEpsilon ),
-		maxReverbCacheAge( other.maxReverbCacheAge ),
-		scene( NULL ),
-		debugDrawingCache( NULL )
+		maxReverbCacheAge( other.maxReverbCacheAge )
 {
 }
 
@@ -176,6 +397,10 @@ SoundPropagator:: SoundPropagator( const SoundPropagator& other )
 SoundPropagator:: ~SoundPropagator()
 {
 	util::destruct( rayTracer );
+	
+	// Destroy the per-thread listener probe state.
+	for ( Index i = 0; i < listenerProbeThreads.getSize(); i++ )
+		util::destruct( listenerProbeThreads[i] );
 }
 
 
@@ -203,12 +428,17 @@ SoundPropagator& SoundPropagator:: operator = ( const SoundPropagator& other )
 		// Copy the other internal state of the SoundPropagator object.
 		directSoundIsEnabled = other.directSoundIsEnabled;
 		transmissionIsEnabled = other.transmissionIsEnabled;
+		transmissionThreshold = other.transmissionThreshold;
 		reflectionIsEnabled = other.reflectionIsEnabled;
 		diffractionIsEnabled = other.diffractionIsEnabled;
 		reverbIsEnabled = other.reverbIsEnabled;
 		timeStamp = other.timeStamp;
 		rayEpsilon = other.rayEpsilon;
+		numThreads = other.numThreads;
+		maxNumProbePaths = other.maxNumProbePaths;
 		maxReverbCacheAge = other.maxReverbCacheAge;
+		listenerMergeTimeRatio = other.listenerMergeTimeRatio;
+		sourcePropagationTime = other.sourcePropagationTime;
 		scene = other.scene;
 		debugDrawingCache = other.debugDrawingCache;
 	}
@@ -234,8 +464,26 @@ void SoundPropagator:: propagateSound( const SoundScene& soundScene, const Sound
 										Size maxListenerProbeDepth, Size numListenerProbeRays,
 										Size maxSourceProbeDepth, Size numSourceProbeRays,
 										SoundPropagationPathBuffer& pathBuffer,
-										DebugDrawingCache* debugCache )
+										DebugDrawingCache* debugCache, Double maxPropagationTime )
 {
+	// Determine when the propagation should stop if there is a time budget.
+	hasPropagationDeadline = maxPropagationTime < math::infinity<Double>();
+	propagationWasCutShort = false;
+	
+	if ( hasPropagationDeadline )
+		propagationDeadline = util::Timer::getTime() + math::max( maxPropagationTime, Double(0) );
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	// Start collecting statistics for this frame.
+	statistics.reset();
+	rayTracer->resetStatistics();
+	cachedPathOcclusionCache.resetStatistics();
+	
+	const Double propagationStartTime = util::Timer::getTime();
+	Double stageStartTime = propagationStartTime;
+#endif
+	
+	
 #if GSOUND_FIXED_MAX_PATH_DEPTH
 	//***************************************************************************
 	// Make sure that the probe depths don't exceed the maximum allowed depths
@@ -282,19 +530,36 @@ void SoundPropagator:: propagateSound( const SoundScene& soundScene, const Sound
 	// Make sure that the contribution list is valid and empty for each sound source.
 	preparePropagationPathBuffer( pathBuffer );
 	
+	// Pack the enabled sources so that each probe path can be validated against several at once.
+	updateSourceBatches();
+	
 	
 	//***************************************************************************
-	// Check previously found cached probe paths for contributions.
+	// Find all direct/transmitted contribution paths.
 	
 	
-	validateCachedPaths( listener, pathBuffer );
+#if GSOUND_PROPAGATION_STATISTICS
+	stageStartTime = util::Timer::getTime();
+#endif
+	
+	addDirectPaths( listener, pathBuffer );
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	statistics.directPathTime = util::Timer::getTime() - stageStartTime;
+	stageStartTime += statistics.directPathTime;
+#endif
 	
 	
 	//***************************************************************************
-	// Find all direct/transmitted contribution paths.
+	// Check previously found cached probe paths for contributions.
 	
 	
-	addDirectPaths( listener, pathBuffer );
+	validateCachedPaths( listener, pathBuffer );
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	statistics.cachedPathValidationTime = util::Timer::getTime() - stageStartTime;
+	stageStartTime += statistics.cachedPathValidationTime;
+#endif
 	
 	
 	// Don't bother propagating sound if there are no objects in the scene.
@@ -304,6 +569,9 @@ void SoundPropagator:: propagateSound( const SoundScene& soundScene, const Sound
 		scene = NULL;
 		debugDrawingCache = NULL;
 		
+#if GSOUND_PROPAGATION_STATISTICS
+		finishStatistics( propagationStartTime );
+#endif
 		return;
 	}
 	
@@ -312,16 +580,48 @@ void SoundPropagator:: propagateSound( const SoundScene& soundScene, const Sound
 	// Shoot out probe rays from the listener.
 	
 	
-	if ( maxListenerProbeDepth > 0 && numListenerProbeRays > 0 )
+	if ( maxListenerProbeDepth > 0 && numListenerProbeRays > 0 && !propagationMustStop() )
+	{
+		const Double deadline = propagationDeadline;
+		
+		// If there is a time budget, stop the listener propagation early enough to leave the
+		// source propagation the time that it last needed, but never more than half of the
+		// remaining time.
+		if ( hasPropagationDeadline && maxSourceProbeDepth > 0 && numSourceProbeRays > 0 )
+		{
+			const Double remainingTime = deadline - util::Timer::getTime();
+			propagationDeadline = deadline - math::min( sourcePropagationTime, Double(0.5)*remainingTime );
+		}
+		
 		doListenerPropagation( listener, maxListenerProbeDepth, numListenerProbeRays, pathBuffer );
+		
+		propagationDeadline = deadline;
+	}
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	statistics.listenerPropagationTime = util::Timer::getTime() - stageStartTime;
+	stageStartTime += statistics.listenerPropagationTime;
+#endif
 	
 	
 	//***************************************************************************
 	// Do source-space sound propagation and reverb estimation.
 	
 	
-	if ( maxSourceProbeDepth > 0 && numSourceProbeRays > 0 )
+	if ( maxSourceProbeDepth > 0 && numSourceProbeRays > 0 && !propagationMustStop() )
+	{
+		const Double sourceStartTime = util::Timer::getTime();
+		
 		doSourcePropagation( listener, maxSourceProbeDepth, numSourceProbeRays, pathBuffer );
+		
+		// Remember how long the source propagation took if it wasn't cut short by the time budget.
+		if ( !propagationTimeHasExpired() )
+			sourcePropagationTime = util::Timer::getTime() - sourceStartTime;
+	}
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	statistics.sourcePropagationTime = util::Timer::getTime() - stageStartTime;
+#endif
 	
 	
 	//***************************************************************************
@@ -330,6 +630,10 @@ void SoundPropagator:: propagateSound( const SoundScene& soundScene, const Sound
 	scene = NULL;
 	debugDrawingCache = NULL;
 	
+#if GSOUND_PROPAGATION_STATISTICS
+	finishStatistics( propagationStartTime );
+#endif
+	
 	//***************************************************************************
 	// Increment the current timestamp
 	
@@ -354,184 +658,504 @@ void SoundPropagator:: doListenerPropagation( const SoundListener& listener,
 												Size maxListenerProbeDepth, Size numListenerProbeRays,
 												SoundPropagationPathBuffer& pathBuffer )
 {
-	internal::ProbePathCache& probePathCache = listener.probePathCache;
-	internal::ProbedTriangleCache<SoundListener::ProbeVisibilityRecord>& probedTriangles = listener.probedTriangles;
 	internal::RayDistributionCache& rayDistribution = listener.rayDistribution;
 	
-	ProbePath probePath;
-	ArrayList<ProbeIntersectionRecord> path;
+	// Compute the number of rays for a cell with a ray affinity of 1.
+	const Real raysPerCell = Real(numListenerProbeRays) / rayDistribution.getSum();
+	const Size numCells = rayDistribution.getNumberOfCells();
 	
-	Real totalDistance;
-	Vector3 directionToSource;
-	Vector3 directionFromListener;
-	FrequencyResponse attenuation;
+	// The debug drawing cache can't be written to concurrently, so only use the calling thread when drawing.
+	const Size numProbeThreads = debugDrawingCache != NULL ? Size(1) : math::min( numThreads, numCells );
 	
-	// Validate potential reflection paths.
-	const Size numSources = scene->getNumberOfSources();
+	// Make sure that there is state for each thread.
+	while ( listenerProbeThreads.getSize() < numProbeThreads )
+		listenerProbeThreads.add( util::construct<ListenerProbeThread>() );
 	
-	// Get an iterator for the ray distribution.
-	internal::RayDistributionCache::Iterator distributionCell = rayDistribution.getIterator();
+	// Choose the seed for this frame's probe ray directions. Each cell derives its own
+	// random stream from this seed so that the directions don't depend on the number of threads.
+	probeRandomVariable.sample();
+	const UInt32 frameSeed = probeRandomVariable.getSeed();
 	
-	// Compute the number of rays for a cell with a ray affinity of 1.
-	Real raysPerCell = Real(numListenerProbeRays) / rayDistribution.getSum();
+	//***************************************************************************
+	// Set up the input of each thread.
+	
+	for ( Index t = 0; t < numProbeThreads; t++ )
+	{
+		ListenerProbeThread& thread = *listenerProbeThreads[t];
+		
+		thread.propagator = this;
+		thread.listener = &listener;
+		thread.maxDepth = maxListenerProbeDepth;
+		thread.raysPerCell = raysPerCell;
+		thread.frameSeed = frameSeed;
+		thread.rayTracer.setObjectBVH( rayTracer->getObjectBVH() );
+		thread.cells.clear();
+		thread.ranOutOfTime = false;
+	}
+	
+	if ( hasPropagationDeadline )
+	{
+		//***************************************************************************
+		// The propagation may run out of time before all cells are traced, so trace the cells
+		// in order of decreasing ray affinity. These are the cells which have recently found
+		// new probe paths. The cells are dealt out to the threads in turn so that each thread
+		// starts with the most important of the remaining cells.
+		
+		listenerProbeCells.clear();
+		
+		internal::RayDistributionCache::Iterator distributionCell( rayDistribution, 0 );
+		
+		for ( Index c = 0; c < numCells; c++, distributionCell++ )
+			listenerProbeCells.add( ListenerProbeCell( c, distributionCell.getRayAffinity() ) );
+		
+		std::qsort( listenerProbeCells.getArrayPointer(), listenerProbeCells.getSize(),
+					sizeof(ListenerProbeCell), compareCellsByDecreasingRayAffinity );
+		
+		for ( Index c = 0; c < numCells; c++ )
+			listenerProbeThreads[c % numProbeThreads]->cells.add( listenerProbeCells[c].cellIndex );
+	}
+	else
+	{
+		//***************************************************************************
+		// Divide the cells into contiguous ranges with approximately the same number of rays.
+		
+		Size totalNumRays = 0;
+		
+		{
+			internal::RayDistributionCache::Iterator distributionCell( rayDistribution, 0 );
+			
+			for ( Index c = 0; c < numCells; c++, distributionCell++ )
+				totalNumRays += getNumberOfCellRays( distributionCell.getRayAffinity(), raysPerCell, Real(0.5) );
+		}
+		
+		internal::RayDistributionCache::Iterator distributionCell( rayDistribution, 0 );
+		Index cellIndex = 0;
+		Size numAssignedRays = 0;
+		
+		for ( Index t = 0; t < numProbeThreads; t++ )
+		{
+			ListenerProbeThread& thread = *listenerProbeThreads[t];
+			
+			// The last thread takes all remaining cells.
+			const Size threadRayLimit = t == numProbeThreads - 1 ? totalNumRays : totalNumRays*(t + 1) / numProbeThreads;
+			
+			while ( cellIndex < numCells && numAssignedRays < threadRayLimit )
+			{
+				numAssignedRays += getNumberOfCellRays( distributionCell.getRayAffinity(), raysPerCell, Real(0.5) );
+				thread.cells.add( cellIndex );
+				cellIndex++;
+				distributionCell++;
+			}
+		}
+	}
+	
+	//***************************************************************************
+	// Trace the probe rays for each thread's cells.
+	
+	// If there is a time budget, stop tracing early enough to leave time for merging
+	// the output of the threads. This time is estimated from previous frames as a
+	// fraction of the time spent tracing.
+	const Double traceStartTime = util::Timer::getTime();
+	const Double deadline = propagationDeadline;
+	
+	if ( hasPropagationDeadline )
+		propagationDeadline = traceStartTime + (deadline - traceStartTime) / (Double(1) + listenerMergeTimeRatio);
+	
+	// Start the other threads. If a thread can't be started, trace its rays here instead.
+	for ( Index t = 1; t < numProbeThreads; t++ )
+	{
+		ListenerProbeThread& thread = *listenerProbeThreads[t];
+		
+		if ( !thread.thread.start( listenerProbeThreadEntry, &thread ) )
+			traceListenerProbeRays( thread );
+	}
+	
+	// The calling thread traces the first thread's cells.
+	traceListenerProbeRays( *listenerProbeThreads[0] );
+	
+	// Wait for the other threads to finish.
+	for ( Index t = 1; t < numProbeThreads; t++ )
+		listenerProbeThreads[t]->thread.join();
+	
+	const Double traceEndTime = util::Timer::getTime();
+	propagationDeadline = deadline;
+	
+	//***************************************************************************
+	// Merge the output of each thread in thread order.
 	
-	// Trace each probe path and store the valid paths.
-	while ( distributionCell )
+	for ( Index t = 0; t < numProbeThreads; t++ )
 	{
-		// Compute the number of rays to trace for this cell. Always trace at least 1 ray per cell.
-		Size numCellRays = math::max( Size(distributionCell.getRayAffinity()*raysPerCell), Size(1) );
+		mergeListenerProbeThread( *listenerProbeThreads[t], listener, pathBuffer );
 		
-		// Get the ranges for longitude and latitude for this cell.
+		if ( listenerProbeThreads[t]->ranOutOfTime )
+			propagationWasCutShort = true;
+	}
+	
+	//***************************************************************************
+	// Remove the listener probed triangles that are older than the maximum age.
+	// Only the generations of triangles that have expired are visited.
+	
+	listener.probedTriangles.removeExpired( getMinReverbTimeStamp( timeStamp ) );
+	
+	//***************************************************************************
+	// Update the estimate of the time needed to merge the output relative to the tracing time.
+	
+	const Double traceTime = traceEndTime - traceStartTime;
+	
+	if ( traceTime > Double(0) )
+	{
+		const Double mergeTimeRatio = (util::Timer::getTime() - traceEndTime) / traceTime;
+		listenerMergeTimeRatio = Double(0.5)*(listenerMergeTimeRatio + mergeTimeRatio);
+	}
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Listener Probe Ray Tracing Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagator:: traceListenerProbeRays( ListenerProbeThread& thread )
+{
+	const SoundListener& listener = *thread.listener;
+	const internal::ProbePathCache& probePathCache = listener.probePathCache;
+	internal::RayDistributionCache& rayDistribution = listener.rayDistribution;
+	
+	internal::RayTracer& tracer = thread.rayTracer;
+	PropagationPathDescription& description = thread.pathDescription;
+	math::RandomVariable<Real>& randomVariable = thread.randomVariable;
+	ArrayList<ProbeIntersectionRecord>& path = thread.path;
+	
+	// Clear the output that was staged on the previous frame.
+	thread.newProbePaths.clear();
+	thread.probePaths.clear();
+	thread.propagationPaths.clear();
+	thread.probedTriangles.clear();
+	
+	// The scene may have changed since the last frame, so forget the previous occlusion results.
+	thread.occlusionCache.clear();
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	thread.numProbePathCacheHits = 0;
+	thread.numProbePathCacheMisses = 0;
+	tracer.resetStatistics();
+	thread.occlusionCache.resetStatistics();
+#endif
+	
+	if ( thread.cells.getSize() == 0 )
+		return;
+	
+	ProbePath probePath;
+	
+	// The low-discrepancy sequence which chooses the directions of the probe rays in a cell.
+	internal::ProbeDirectionSequence directionSequence;
+	
+	SIMDFloat totalDistances;
+	SIMDVector3 directionsToSource;
+	SIMDVector3 directionsFromListener;
+	FrequencyResponse attenuation;
+	
+	// The number of listener probe rays that are traced together.
+	const Size PACKET_SIZE = internal::RayTracer::PROBE_RAY_PACKET_SIZE;
+	
+	// Trace each probe path and stage the valid paths.
+	for ( Index cellIndex = 0; cellIndex < thread.cells.getSize(); cellIndex++ )
+	{
+		const Index c = thread.cells[cellIndex];
+		
+		// Get an iterator for this cell in the ray distribution.
+		internal::RayDistributionCache::Iterator distributionCell( rayDistribution, c );
+		
+		// Get the ranges for longitude and height for this cell.
 		AABB1 cellLongitudes = distributionCell.getCellLongitudes();
-		AABB1 cellLatitudes = distributionCell.getCellLatitudes();
+		AABB1 cellHeights = distributionCell.getCellHeights();
+		
+		// Start this cell's random stream.
+		randomVariable.setSeed( getCellRandomSeed( thread.frameSeed, c ) );
 		
+		// Rotate the cell's direction sequence by a random amount so that each frame probes new directions.
+		randomVariable.sample();
+		const UInt32 rotationU = randomVariable.getSeed();
+		randomVariable.sample();
+		const UInt32 rotationV = randomVariable.getSeed();
+		directionSequence.setRotation( rotationU, rotationV );
 		
-		for ( Index i = 0; i < numCellRays; i++ )
+		// Compute the number of rays to trace for this cell, rounding the fractional ray at random.
+		randomVariable.sample();
+		const Real roundingOffset = Real(randomVariable.getSeed() >> 8)*Real(1.0/16777216.0);
+		const Size numCellRays = getNumberOfCellRays( distributionCell.getRayAffinity(), thread.raysPerCell, roundingOffset );
+		
+		for ( Index i = 0; i < numCellRays; i += PACKET_SIZE )
 		{
-			path.clear();
-			probePath.clearTriangles();
+			// Stop tracing if the time budget has run out. The paths that were already
+			// staged are complete, so they are still merged into the output.
+			if ( propagationTimeHasExpired() )
+			{
+				thread.ranOutOfTime = true;
+				return;
+			}
 			
-			// Take a random sample of (longitude, latitude) in the valid ranges for this cell.
-			Real longitude = probeRandomVariable.sample( cellLongitudes.min, cellLongitudes.max );
-			Real latitude = probeRandomVariable.sample( cellLatitudes.min, cellLatitudes.max );
+			const Size numPacketRays = math::min( numCellRays - i, PACKET_SIZE );
 			
-			// Create the ray that start at the listener's position and passes
-			// through the point specified by (longitude, latitude) in spherical coordinates.
-			Ray3 ray( listener.getPosition(), Vector3( math::cos(longitude)*math::sin(latitude),
-														math::cos(latitude),
-														math::sin(longitude)*math::sin(latitude) ) );
+			Ray3 packetRays[PACKET_SIZE];
+			Bool packetHits[PACKET_SIZE];
+			Real packetClosestIntersections[PACKET_SIZE];
+			internal::ObjectSpaceTriangle packetTriangles[PACKET_SIZE];
 			
-			Vector3 firstRayDirection = ray.direction*listener.getOrientation();
-			Vector3 currentListenerImagePosition = listener.getPosition();
+			for ( Index k = 0; k < numPacketRays; k++ )
+			{
+				// Create the ray that starts at the listener's position and passes through
+				// the next direction of the cell's stratified sequence.
+				packetRays[k] = Ray3( listener.getPosition(),
+									directionSequence.getDirection( i + k, cellLongitudes, cellHeights ) );
+			}
 			
-			for ( Index d = 0; d < maxListenerProbeDepth; d++ )
+			// The first bounces of the rays in a cell start at the listener and point in
+			// similar directions, so trace them together as a packet.
+			tracer.traceProbeRayPacket( packetRays, numPacketRays, packetHits,
+										packetClosestIntersections, packetTriangles );
+			
+			for ( Index k = 0; k < numPacketRays; k++ )
 			{
-				Real closestIntersection;
-				internal::ObjectSpaceTriangle closestTriangle;
+				path.clear();
+				probePath.clearTriangles();
 				
-				if ( rayTracer->traceProbeRay( ray, closestIntersection, closestTriangle ) )
+				Ray3 ray = packetRays[k];
+				
+				Vector3 firstRayDirection = ray.direction*listener.getOrientation();
+				Vector3 currentListenerImagePosition = listener.getPosition();
+				
+				for ( Index d = 0; d < thread.maxDepth; d++ )
 				{
-					// We have intersected a triangle. Add this triangle to the probe path array.
-					probePath.addTriangle( closestTriangle );
-					
-					// Test to see if we have already visited this same probe path
-					// previously. If not, mark this path as visted for future probe rays.
-					Bool pathHasNotBeenVisited = !probePathCache.containsPath( probePath );
-					
-					// Transform the closest triangle into world space.
-					const internal::WorldSpaceTriangle worldSpaceTriangle( closestTriangle );
-					const Vector3& normal = worldSpaceTriangle.plane.normal;
-					
-					Real rayDotNormal = math::dot( ray.direction, normal );
+					Real closestIntersection;
+					internal::ObjectSpaceTriangle closestTriangle;
+					Bool foundIntersection;
 					
-					// Add this triangle to a hash map which keeps track of all triangles probed so far.
-					probedTriangles.add( closestTriangle,
-								SoundListener::ProbeVisibilityRecord( rayDotNormal, firstRayDirection, timeStamp ) );
-					
-					// Calculate the intersection point of the ray with the triangle in world space.
-					Vector3 intersectionPoint = ray.origin + ray.direction*closestIntersection;
-					
-					// Calculate the direction of the ray reflected off of the closest triangle in world space.
-					Vector3 reflectedDirection = ray.direction - Real(2)*normal*rayDotNormal;
-					
-					// Bias the intersection point by a small amount in order to avoid floating point precision problems.
-					Vector3 bias = normal*rayEpsilon;
-					intersectionPoint += rayDotNormal < Real(0) ? bias : -bias;
-					
-					// Draw the probe ray if debug drawing is enabled.
-					if ( debugDrawingCache != NULL && debugDrawingCache->getFiniteProbeRaysAreEnabled() && d == 0 )
-						debugDrawingCache->addFiniteProbeRay( ray.origin, intersectionPoint );
-					
-					ray = Ray3( intersectionPoint, reflectedDirection );
-					
-					Bool foundPaths = false;
-					
-					// If we have not already visited this path, check the intersected triangle
-					// for possible diffraction paths.
-					if ( pathHasNotBeenVisited && diffractionIsEnabled )
+					// The first bounce has already been traced with the rest of the packet.
+					if ( d == 0 )
 					{
-						foundPaths = addDiffractionPaths( listener, worldSpaceTriangle, path, pathBuffer );
+						foundIntersection = packetHits[k];
+						closestIntersection = packetClosestIntersections[k];
+						closestTriangle = packetTriangles[k];
 					}
+					else
+						foundIntersection = tracer.traceProbeRay( ray, closestIntersection, closestTriangle );
 					
-					// Reflect the current listener image position over the intersected triangle
-					// and store the result for the next depth.
-					currentListenerImagePosition = worldSpaceTriangle.plane.getReflection( currentListenerImagePosition );
-					
-					path.add( ProbeIntersectionRecord( worldSpaceTriangle, currentListenerImagePosition ) );
-					
-					// If we have not already visited this path, check for any valid
-					// reflection paths.
-					if ( pathHasNotBeenVisited )
+					if ( foundIntersection )
 					{
-						if ( reflectionIsEnabled )
+						// We have intersected a triangle. Add this triangle to the probe path array.
+						probePath.addTriangle( closestTriangle );
+						
+						// Test to see if we have already visited this same probe path, either on a
+						// previous frame or earlier on this thread. The listener's cache is only read here,
+						// paths found by several threads are resolved when the threads are merged.
+						Bool pathHasNotBeenVisited = !probePathCache.containsPath( probePath ) &&
+													!thread.newProbePaths.containsPath( probePath );
+						
+#if GSOUND_PROPAGATION_STATISTICS
+						if ( pathHasNotBeenVisited )
+							thread.numProbePathCacheMisses++;
+						else
+							thread.numProbePathCacheHits++;
+#endif
+						
+						// Transform the closest triangle into world space.
+						const internal::WorldSpaceTriangle worldSpaceTriangle( closestTriangle );
+						const Vector3& normal = worldSpaceTriangle.plane.normal;
+						
+						Real rayDotNormal = math::dot( ray.direction, normal );
+						
+						// Stage this triangle to be added to the listener's cache of probed triangles.
+						thread.probedTriangles.add( ListenerProbeThread::StagedProbedTriangle( closestTriangle,
+									SoundListener::ProbeVisibilityRecord( rayDotNormal, firstRayDirection, timeStamp ) ) );
+						
+						// Calculate the intersection point of the ray with the triangle in world space.
+						Vector3 intersectionPoint = ray.origin + ray.direction*closestIntersection;
+						
+						// Calculate the direction of the ray reflected off of the closest triangle in world space.
+						Vector3 reflectedDirection = ray.direction - Real(2)*normal*rayDotNormal;
+						
+						// Bias the intersection point by a small amount in order to avoid floating point precision problems.
+						Vector3 bias = normal*rayEpsilon;
+						intersectionPoint += rayDotNormal < Real(0) ? bias : -bias;
+						
+						// Draw the probe ray if debug drawing is enabled.
+						if ( debugDrawingCache != NULL && debugDrawingCache->getFiniteProbeRaysAreEnabled() && d == 0 )
+							debugDrawingCache->addFiniteProbeRay( ray.origin, intersectionPoint );
+						
+						ray = Ray3( intersectionPoint, reflectedDirection );
+						
+						Bool foundPaths = false;
+						
+						// If we have not already visited this path, check the intersected triangle
+						// for possible diffraction paths.
+						if ( pathHasNotBeenVisited && diffractionIsEnabled )
+						{
+							foundPaths = addDiffractionPaths( tracer, thread.occlusionCache, description,
+															listener, worldSpaceTriangle,
+															path, thread.propagationPaths );
+						}
+						
+						// Reflect the current listener image position over the intersected triangle
+						// and store the result for the next depth.
+						currentListenerImagePosition = worldSpaceTriangle.plane.getReflection( currentListenerImagePosition );
+						
+						path.add( ProbeIntersectionRecord( worldSpaceTriangle, currentListenerImagePosition ) );
+						
+						// If we have not already visited this path, check for any valid
+						// reflection paths.
+						if ( pathHasNotBeenVisited )
 						{
-							for ( Index s = 0; s < numSources; s++ )
+							if ( reflectionIsEnabled )
 							{
-								SoundSource& source = *scene->getSource(s);
-								
-								if ( !source.getIsEnabled() )
-									continue;
-								
-								pathDescription.clearPoints();
-								pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::SOURCE, &source ) );
+								// Only validate paths to the sources which can be reached through the last triangle.
+								sourceBatchTree.getBatchesInBeam( path.getLast().imagePosition, path.getLast().triangle,
+																rayEpsilon, thread.sourceBatches );
 								
-								if ( validateReflectionPath( source.getPosition(), listener.getPosition(), 
-															source.getRadius(), path, totalDistance,
-															directionFromListener, directionToSource, 
-															attenuation ) )
+								for ( Index b = 0; b < thread.sourceBatches.getSize(); b++ )
 								{
-									pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::LISTENER, &listener ) );
+									const internal::SourceBatch& sources = sourceBatchTree.getBatch( thread.sourceBatches[b] );
 									
-									Real relativeSpeed = getRelativeSpeed( listener, directionFromListener, source, directionToSource );
-									attenuation *= getSourceFrequencyResponse( source, directionToSource );
+									UInt32 validPaths = validateReflectionPaths( tracer, thread.occlusionCache, sources,
+																				listener.getPosition(), path, totalDistances,
+																				directionsFromListener, directionsToSource,
+																				attenuation );
 									
-									pathBuffer.getSourceBuffer(s).addPropagationPath(
-											PropagationPath( directionFromListener*listener.getOrientation(),
-																totalDistance, relativeSpeed, 
-																scene->getSpeedOfSound(),
-																attenuation, pathDescription )  );
-									foundPaths = true;
+									for ( Index l = 0; validPaths != 0; l++, validPaths >>= 1 )
+									{
+										if ( (validPaths & 1) == 0 )
+											continue;
+										
+										const Index s = sources.sourceIndices[l];
+										const SoundSource& source = *scene->getSource(s);
+										const Vector3 directionFromListener( directionsFromListener.x[l], directionsFromListener.y[l],
+																			directionsFromListener.z[l] );
+										const Vector3 directionToSource( directionsToSource.x[l], directionsToSource.y[l],
+																		directionsToSource.z[l] );
+										
+										setReflectionPathPoints( description, source, listener, path );
+										
+										Real relativeSpeed = getRelativeSpeed( listener, directionFromListener, source, directionToSource );
+										
+										thread.propagationPaths.add( SourcePropagationPath( s,
+												PropagationPath( directionFromListener*listener.getOrientation(),
+																	totalDistances[l], relativeSpeed, 
+																	scene->getSpeedOfSound(),
+																	attenuation*getSourceFrequencyResponse( source, directionToSource ),
+																	description ) ) );
+										foundPaths = true;
+									}
 								}
 							}
+							
+							distributionCell.increaseRayAffinity();
+							
+							probePath.setFoundPaths( foundPaths );
+							thread.newProbePaths.addPath( probePath );
+							thread.probePaths.add( ListenerProbeThread::StagedProbePath( probePath,
+																						thread.propagationPaths.getSize() ) );
 						}
+					}
+					else
+					{
+						distributionCell.decreaseRayAffinity();
 						
-						distributionCell.increaseRayAffinity();
+						if ( debugDrawingCache != NULL && debugDrawingCache->getInfiniteProbeRaysAreEnabled() && d == 0 )
+							debugDrawingCache->addInfiniteProbeRay( ray );
 						
-						probePath.setFoundPaths( foundPaths );
-						probePathCache.addPath( probePath );
+						// Break if there was no intersection for the probe ray.
+						break;
 					}
 				}
-				else
-				{
-					distributionCell.decreaseRayAffinity();
-					
-					if ( debugDrawingCache != NULL && debugDrawingCache->getInfiniteProbeRaysAreEnabled() && d == 0 )
-						debugDrawingCache->addInfiniteProbeRay( ray );
-					
-					// Break if there was no intersection for the probe ray.
-					break;
-				}
 			}
 		}
-		
-		distributionCell++;
 	}
+}
+
+
+
+
+void SoundPropagator:: listenerProbeThreadEntry( void* thread )
+{
+	ListenerProbeThread* probeThread = (ListenerProbeThread*)thread;
 	
-	//***************************************************************************
-	// Update the status of all listener probed triangles, removing those that are
-	// older than the maximum age.
+	probeThread->propagator->traceListenerProbeRays( *probeThread );
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Listener Probe Thread Merge Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagator:: mergeListenerProbeThread( ListenerProbeThread& thread, const SoundListener& listener,
+												SoundPropagationPathBuffer& pathBuffer )
+{
+	internal::ProbePathCache& probePathCache = listener.probePathCache;
+	internal::ProbedTriangleCache<SoundListener::ProbeVisibilityRecord>& probedTriangles = listener.probedTriangles;
+	
+	// Add each new probe path to the listener's cache along with its propagation paths.
+	Index pathIndex = 0;
 	
+	for ( Index i = 0; i < thread.probePaths.getSize(); i++ )
 	{
-		internal::ProbedTriangleCache<SoundListener::ProbeVisibilityRecord>::Iterator i = probedTriangles.getIterator();
+		const ListenerProbeThread::StagedProbePath& stagedPath = thread.probePaths[i];
 		
-		while ( i )
+		// If a thread with earlier cells already found this probe path, its propagation paths
+		// are duplicates and are discarded.
+		if ( probePathCache.addPath( stagedPath.probePath ) )
 		{
-			if ( timeStamp - i.getData().timeStamp >= maxReverbCacheAge )
-				i.remove();
-			else
-				i++;
+			for ( ; pathIndex < stagedPath.pathsEnd; pathIndex++ )
+			{
+				const SourcePropagationPath& sourcePath = thread.propagationPaths[pathIndex];
+				pathBuffer.getSourceBuffer( sourcePath.sourceIndex ).addPropagationPath( sourcePath.path );
+				
+#if GSOUND_PROPAGATION_STATISTICS
+				if ( isDiffractionPath( sourcePath.path ) )
+					statistics.numDiffractionPaths++;
+				else
+					statistics.numReflectionPaths++;
+#endif
+			}
 		}
+		
+		pathIndex = stagedPath.pathsEnd;
 	}
+	
+	// Add the probed triangles to the listener's cache in the order in which they were hit.
+	for ( Index i = 0; i < thread.probedTriangles.getSize(); i++ )
+	{
+		const ListenerProbeThread::StagedProbedTriangle& stagedTriangle = thread.probedTriangles[i];
+		probedTriangles.add( stagedTriangle.triangle, stagedTriangle.record );
+	}
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	// Add the thread's statistics to the statistics for this frame.
+	const internal::RayTracer::Statistics& tracerStatistics = thread.rayTracer.getStatistics();
+	statistics.numRaysTraced += tracerStatistics.numRaysTraced;
+	statistics.numNodesVisited += tracerStatistics.numNodesVisited;
+	statistics.numTrianglesTested += tracerStatistics.numTrianglesTested;
+	statistics.numProbePathCacheHits += thread.numProbePathCacheHits;
+	statistics.numProbePathCacheMisses += thread.numProbePathCacheMisses;
+	statistics.numOcclusionCacheHits += thread.occlusionCache.getNumberOfHits();
+	statistics.numOcclusionCacheMisses += thread.occlusionCache.getNumberOfMisses();
+#endif
 }
 
 
@@ -554,31 +1178,59 @@ void SoundPropagator:: doSourcePropagation( const SoundListener& listener,
 {
 	internal::ProbedTriangleCache<SoundListener::ProbeVisibilityRecord>& listenerProbedTriangles = listener.probedTriangles;
 	
+	// Time stamps start over when a listener or source is used with a different propagator,
+	// so discard any triangles that were probed on frames this propagator hasn't reached yet.
+	if ( listenerProbedTriangles.getNewestTimeStamp() > timeStamp )
+		listenerProbedTriangles.clear();
+	
 	Size numSources = scene->getNumberOfSources();
 	
-	for ( Index s = 0; s < numSources; s++ )
+	// The low-discrepancy sequence which chooses the directions of the source probe rays.
+	internal::ProbeDirectionSequence directionSequence;
+	
+	for ( Index k = 0; k < numSources; k++ )
 	{
+		// Start with a different source on each frame so that the reverb of every
+		// source is eventually updated if the time budget runs out.
+		const Index s = (k + timeStamp) % numSources;
 		const SoundSource& source = *scene->getSource(s);
 		
 		if ( !source.getIsEnabled() )
 			continue;
 		
 		internal::ProbedTriangleCache<SoundSource::ProbeVisibilityRecord>& probedTriangles = source.probedTriangles;
+		SoundSource::ProbedAreaSums& areaSums = source.probedAreaSums;
+		
+		if ( probedTriangles.getNewestTimeStamp() > timeStamp )
+		{
+			probedTriangles.clear();
+			areaSums.reset();
+			areaSums.listener = NULL;
+		}
 		
 		// The number of probe rays that were shot and hit something.
 		Size numValidRays = 0;
 		
-		// The total number of probe rays that will be cast for this source.
-		Size totalNumProbeRays = numSourceProbeRays*maxSourceProbeDepth;
+		// The number of initial probe rays that were traced before the time budget ran out.
+		Size numTracedRays = 0;
 		
 		// The total distance traveled by all probe rays in the scene that hit a triangle.
 		Real totalFreePath = 0;
 		
-		for ( Index i = 0; i < numSourceProbeRays; i++ )
+		// Spread the source's probe rays evenly over the sphere, rotated by a new random amount each frame.
+		probeRandomVariable.sample();
+		const UInt32 rotationU = probeRandomVariable.getSeed();
+		probeRandomVariable.sample();
+		const UInt32 rotationV = probeRandomVariable.getSeed();
+		directionSequence.setRotation( rotationU, rotationV );
+		
+		for ( ; numTracedRays < numSourceProbeRays; numTracedRays++ )
 		{
-			Ray3 ray( source.getPosition(), Vector3( probeRandomVariable.sample( Real(-1), Real(1) ),
-													probeRandomVariable.sample( Real(-1), Real(1) ),
-													probeRandomVariable.sample( Real(-1), Real(1) ) ).normalize() );
+			// Stop tracing if the time budget has run out.
+			if ( propagationMustStop() )
+				break;
+			
+			Ray3 ray( source.getPosition(), directionSequence.getDirection( numTracedRays ) );
 			
 			// Bias the ray's starting position by the source's radius.
 			ray.origin += source.getRadius();
@@ -625,7 +1277,26 @@ void SoundPropagator:: doSourcePropagation( const SoundListener& listener,
 					{
 						totalFreePath += closestIntersection;
 						
-						probedTriangles.add( closestTriangle, SoundSource::ProbeVisibilityRecord( rayDotNormal, timeStamp ) );
+						SoundSource::ProbeVisibilityRecord sourceTriangleRecord( rayDotNormal, timeStamp );
+						SoundSource::ProbeVisibilityRecord* oldSourceTriangleRecord;
+						
+						// Replace the previous contribution of the triangle to the reverb sums.
+						if ( probedTriangles.find( closestTriangle, oldSourceTriangleRecord ) )
+							areaSums.removeTriangle( closestTriangle, *oldSourceTriangleRecord );
+						
+						// Scale the triangle's area into world space.
+						sourceTriangleRecord.area = math::square(closestTriangle.object->getTransformation().scale)*
+													closestTriangle.triangle->getArea();
+						
+						const SoundListener::ProbeVisibilityRecord* listenerTriangleRecord;
+						
+						if ( !listenerProbedTriangles.find( closestTriangle, listenerTriangleRecord ) )
+							listenerTriangleRecord = NULL;
+						
+						setProbedTriangleOverlap( sourceTriangleRecord, listenerTriangleRecord );
+						
+						probedTriangles.add( closestTriangle, sourceTriangleRecord );
+						areaSums.addTriangle( closestTriangle, sourceTriangleRecord );
 					}
 				}
 				else
@@ -639,75 +1310,146 @@ void SoundPropagator:: doSourcePropagation( const SoundListener& listener,
 			}
 		}
 		
+		// If no rays could be traced for this source, keep its previous reverb response.
+		if ( numTracedRays == 0 )
+			continue;
+		
+		// The total number of probe rays that were cast for this source.
+		Size totalNumProbeRays = numTracedRays*maxSourceProbeDepth;
+		
 		
 		//**************************************************************************************
-		// Iterate over the source probed triangles and calculate the overlap area
-		// with the listener probed triangles and the approximate scene surface area.
+		// Remove the source probed triangles that are older than the maximum age and
+		// subtract their contributions from the reverb sums.
 		
 		
-		// The approximate total surface area of the space that the source is in.
-		Real totalSurfaceArea = Real(0);
+		probedTriangles.removeExpired( getMinReverbTimeStamp( timeStamp ) );
+		
+		for ( Index i = 0; i < probedTriangles.getNumberOfExpiredTriangles(); i++ )
+		{
+			const internal::ProbedTriangleCache<SoundSource::ProbeVisibilityRecord>::ExpiredTriangle& expiredTriangle =
+													probedTriangles.getExpiredTriangle(i);
+			
+			areaSums.removeTriangle( expiredTriangle.triangle, expiredTriangle.data );
+		}
 		
-		// The total area of the triangles that have been touched by both the listener's and this source's rays.
-		Real listenerOverlapArea = Real(0);
+		// Clear any accumulated error once all of the triangles have expired.
+		if ( probedTriangles.getNumberOfTriangles() == 0 )
+			areaSums.reset();
 		
-		FrequencyResponse attenuationArea( 0 );
 		
+		//**************************************************************************************
+		// Update the overlap of the source probed triangles with the listener probed triangles.
 		
+		
+		// The sums can only be updated incrementally if they were brought up to date on the
+		// previous frame with the same listener. The listener propagation runs before the
+		// source propagation, so since then the listener's triangles have only changed
+		// during this frame's listener propagation.
+		if ( areaSums.listener == &listener && areaSums.timeStamp + 1 == timeStamp &&
+			areaSums.numIncrementalUpdates < MAX_INCREMENTAL_REVERB_UPDATES )
 		{
-			internal::ProbedTriangleCache<SoundSource::ProbeVisibilityRecord>::Iterator i = probedTriangles.getIterator();
+			// Remove the overlap of the triangles that the listener stopped probing on this frame.
+			if ( listenerProbedTriangles.getExpiryTimeStamp() == getMinReverbTimeStamp( timeStamp ) )
+			{
+				for ( Index i = 0; i < listenerProbedTriangles.getNumberOfExpiredTriangles(); i++ )
+				{
+					const internal::ObjectSpaceTriangle& triangle = listenerProbedTriangles.getExpiredTriangle(i).triangle;
+					SoundSource::ProbeVisibilityRecord* sourceTriangleRecord;
+					
+					if ( probedTriangles.find( triangle, sourceTriangleRecord ) )
+					{
+						areaSums.removeOverlap( *sourceTriangleRecord );
+						setProbedTriangleOverlap( *sourceTriangleRecord, NULL );
+					}
+				}
+			}
 			
-			while ( i )
+			// Update the overlap of the triangles that the listener probed on this frame.
+			// These are the newest generation of the listener's triangles.
+			for ( Index i = listenerProbedTriangles.getNumberOfUpdates(); i > 0; i-- )
 			{
-				const internal::ObjectSpaceTriangle& triangle = i.getTriangle();
-				const SoundSource::ProbeVisibilityRecord& sourceTriangleRecord = i.getData();
+				const internal::ProbedTriangleCache<SoundListener::ProbeVisibilityRecord>::Update& update =
+													listenerProbedTriangles.getUpdate( i - 1 );
 				
-				Size sourceTriangleAge = timeStamp - sourceTriangleRecord.timeStamp;
+				if ( update.timeStamp != timeStamp )
+					break;
+				
+				SoundSource::ProbeVisibilityRecord* sourceTriangleRecord;
+				const SoundListener::ProbeVisibilityRecord* listenerTriangleRecord;
 				
-				if ( sourceTriangleAge >= maxReverbCacheAge )
+				if ( probedTriangles.find( update.triangle, sourceTriangleRecord ) &&
+					listenerProbedTriangles.find( update.triangle, listenerTriangleRecord ) )
 				{
-					i.remove();
-					continue;
+					areaSums.removeOverlap( *sourceTriangleRecord );
+					setProbedTriangleOverlap( *sourceTriangleRecord, listenerTriangleRecord );
+					areaSums.addOverlap( *sourceTriangleRecord );
+				}
+			}
+			
+			areaSums.numIncrementalUpdates++;
+		}
+		else
+		{
+			// Recompute the sums from scratch by visiting every source probed triangle.
+			areaSums.reset();
+			areaSums.listener = NULL;
+			
+			// Whether or not the time budget ran out before all of the triangles were visited.
+			Bool trianglesAreIncomplete = false;
+			
+			internal::ProbedTriangleCache<SoundSource::ProbeVisibilityRecord>::Iterator i = probedTriangles.getIterator();
+			
+			while ( i )
+			{
+				if ( propagationMustStop() )
+				{
+					trianglesAreIncomplete = true;
+					break;
 				}
 				
+				const internal::ObjectSpaceTriangle& triangle = i.getTriangle();
+				SoundSource::ProbeVisibilityRecord& sourceTriangleRecord = i.getData();
+				
 				// Scale the triangle's area into world space.
-				Real triangleArea = math::square(triangle.object->getTransformation().scale)*triangle.triangle->getArea();
+				sourceTriangleRecord.area = math::square(triangle.object->getTransformation().scale)*triangle.triangle->getArea();
 				
-				// Add this triangle's area to the total surface area of the scene.
-				totalSurfaceArea += triangleArea;
-				attenuationArea += triangle.triangle->getMaterial().getReflectionAttenuation()*triangleArea;
+				// Test to see if the listener also probed this triangle recently.
+				const SoundListener::ProbeVisibilityRecord* listenerTriangleRecord;
 				
+				if ( !listenerProbedTriangles.find( triangle, listenerTriangleRecord ) )
+					listenerTriangleRecord = NULL;
 				
-				// Test to see if the listener also probed this triangle recently.
-				SoundListener::ProbeVisibilityRecord* listenerTriangleRecord;
+				setProbedTriangleOverlap( sourceTriangleRecord, listenerTriangleRecord );
 				
-				if ( listenerProbedTriangles.find( triangle, listenerTriangleRecord ) )
-				{
-					// Make sure that the same side of the triangle was probed by the source and listener.
-					if ( (sourceTriangleRecord.rayDotNormal < Real(0) && listenerTriangleRecord->rayDotNormal < Real(0)) || 
-						(sourceTriangleRecord.rayDotNormal > Real(0) && listenerTriangleRecord->rayDotNormal > Real(0)) )
-					{
-						// Compute the contribution of this triangle based on its age.
-						// Older triangles are weighted so that they have less effect.
-						Real sourceTriangleAgeAttenuation = Real(1) - Real(sourceTriangleAge) / Real(maxReverbCacheAge);
-						
-						// Compute the contribution of this triangle based on its age.
-						// Older triangles are weighted so that they have less effect.
-						Size listenerTriangleAge = timeStamp - listenerTriangleRecord->timeStamp;
-						Real listenerTriangleAgeAttenuation = Real(1) - Real(listenerTriangleAge) / Real(maxReverbCacheAge);
-						
-						// Average the attenuation from the source and listener to find the actual attenuation.
-						Real triangleAgeAttenuation = Real(0.5)*(sourceTriangleAgeAttenuation + listenerTriangleAgeAttenuation);
-						
-						// Add the adjusted triangle area to the total area touched by both the source and listener.
-						listenerOverlapArea += triangleArea*triangleAgeAttenuation;
-					}
-				}
+				areaSums.addTriangle( triangle, sourceTriangleRecord );
 				
 				i++;
 			}
+			
+			// The estimate would be wrong for a partial set of triangles, so keep the previous
+			// reverb response and recompute the sums on a later frame.
+			if ( trianglesAreIncomplete )
+				continue;
+			
+			areaSums.listener = &listener;
+			areaSums.numIncrementalUpdates = 0;
 		}
 		
+		areaSums.timeStamp = timeStamp;
+		
+		// The approximate total surface area of the space that the source is in.
+		const Real totalSurfaceArea = Real(areaSums.totalArea);
+		
+		// Each overlapping triangle's area is weighted by the average of its source and listener age
+		// attenuations, 1 - (timeStamp - triangleTimeStamp)/maxAge, so that older triangles have
+		// less effect. This sum of weighted areas is computed from the time-stamp-weighted sums.
+		const Double maxAge = Double(maxReverbCacheAge);
+		const Real listenerOverlapArea = Real(areaSums.overlapArea*(Double(1) - Double(timeStamp)/maxAge) +
+												areaSums.overlapTimeStampArea/(Double(2)*maxAge));
+		
+		const FrequencyResponse& attenuationArea = areaSums.attenuationArea;
+		
 		Real voidFraction = Real(numValidRays) / Real(totalNumProbeRays);
 		
 		Real meanFreePath = (totalFreePath / numValidRays);
@@ -758,21 +1500,43 @@ void SoundPropagator:: doSourcePropagation( const SoundListener& listener,
 
 void SoundPropagator:: validateCachedPaths( const SoundListener& listener, SoundPropagationPathBuffer& pathBuffer )
 {
-	ArrayList<ProbeIntersectionRecord> path;
+	// Reuse the propagator's temporary lists so that their storage is kept between frames.
+	ArrayList<ProbeIntersectionRecord>& path = cachedProbePath;
+	ArrayList<SourcePropagationPath>& diffractionPaths = cachedDiffractionPaths;
+	
+	diffractionPaths.clear();
+	
+	// The scene may have changed since the last frame, so forget the previous occlusion results.
+	cachedPathOcclusionCache.clear();
 	
-	Real totalDistance;
-	Vector3 directionToSource;
-	Vector3 directionFromListener;
+	SIMDFloat totalDistances;
+	SIMDVector3 directionsToSource;
+	SIMDVector3 directionsFromListener;
 	FrequencyResponse attenuation;
 	
 	
+	// Paths which are added or produce contributions on this frame are stamped with the
+	// current time so that the cache evicts the paths which have gone unused the longest.
+	listener.probePathCache.setMaximumNumberOfPaths( maxNumProbePaths );
+	listener.probePathCache.setTimeStamp( timeStamp );
+	
 	// Iterate through all previously detected probe paths and add any valid
 	// contributions and removing any paths that no longer produce any contributions.
+	// Start where the validation stopped if the time budget ran out on a previous frame,
+	// so that the paths at the end of the cache aren't starved.
 	
-	internal::ProbePathCache::Iterator i = listener.probePathCache.getIterator();
+	internal::ProbePathCache::Iterator i = listener.probePathCache.getIterator( listener.probePathCache.getResumeIndex() );
 	
 	while ( i )
 	{
+		// Stop validating if the time budget has run out. The remaining probe paths
+		// are kept in the cache and validated first on the next frame.
+		if ( propagationMustStop() )
+		{
+			listener.probePathCache.setResumeIndex( i.getIndex() );
+			break;
+		}
+		
 		// If no propagation paths were found for the current probe path on the previous frame, remove it.
 		if ( !i->getFoundPaths() )
 		{
@@ -798,34 +1562,46 @@ void SoundPropagator:: validateCachedPaths( const SoundListener& listener, Sound
 		// Validate potential reflection paths.
 		if ( reflectionIsEnabled )
 		{
-			Size numSources = scene->getNumberOfSources();
+			// Only validate paths to the sources which can be reached through the last triangle.
+			sourceBatchTree.getBatchesInBeam( path.getLast().imagePosition, path.getLast().triangle,
+											rayEpsilon, cachedPathSourceBatches );
 			
-			for ( Index s = 0; s < numSources; s++ )
+			for ( Index b = 0; b < cachedPathSourceBatches.getSize(); b++ )
 			{
-				SoundSource& source = *scene->getSource(s);
-				
-				if ( !source.getIsEnabled() )
-					continue;
+				const internal::SourceBatch& sources = sourceBatchTree.getBatch( cachedPathSourceBatches[b] );
 				
-				pathDescription.clearPoints();
-				pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::SOURCE, &source ) );
+				UInt32 validPaths = validateReflectionPaths( *rayTracer, cachedPathOcclusionCache, sources,
+															listener.getPosition(), path, totalDistances,
+															directionsFromListener, directionsToSource,
+															attenuation );
 				
-				if ( validateReflectionPath( source.getPosition(), listener.getPosition(),
-											source.getRadius(), path, totalDistance,
-											directionFromListener, directionToSource, 
-											attenuation ) )
+				for ( Index l = 0; validPaths != 0; l++, validPaths >>= 1 )
 				{
-					pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::LISTENER, &listener ) );
+					if ( (validPaths & 1) == 0 )
+						continue;
+					
+					const Index s = sources.sourceIndices[l];
+					const SoundSource& source = *scene->getSource(s);
+					const Vector3 directionFromListener( directionsFromListener.x[l], directionsFromListener.y[l],
+														directionsFromListener.z[l] );
+					const Vector3 directionToSource( directionsToSource.x[l], directionsToSource.y[l],
+													directionsToSource.z[l] );
+					
+					setReflectionPathPoints( pathDescription, source, listener, path );
 					
 					Real relativeSpeed = getRelativeSpeed( listener, directionFromListener, source, directionToSource );
-					attenuation *= getSourceFrequencyResponse( source, directionToSource );
 					
 					pathBuffer.getSourceBuffer(s).addPropagationPath(
 							PropagationPath( directionFromListener*listener.getOrientation(),
-												totalDistance, relativeSpeed, 
+												totalDistances[l], relativeSpeed, 
 												scene->getSpeedOfSound(),
-												attenuation, pathDescription )  );
+												attenuation*getSourceFrequencyResponse( source, directionToSource ),
+												pathDescription )  );
 					foundPaths = true;
+					
+#if GSOUND_PROPAGATION_STATISTICS
+					statistics.numReflectionPaths++;
+#endif
 				}
 			}
 		}
@@ -837,13 +1613,29 @@ void SoundPropagator:: validateCachedPaths( const SoundListener& listener, Sound
 			internal::WorldSpaceTriangle lastTriangle = path.getLast().triangle;
 			path.removeLast();
 			
-			foundPaths |= addDiffractionPaths( listener, lastTriangle, path, pathBuffer );
+			foundPaths |= addDiffractionPaths( *rayTracer, cachedPathOcclusionCache, pathDescription,
+												listener, lastTriangle,
+												path, diffractionPaths );
 		}
 		
 		probePath.setFoundPaths( foundPaths );
 		
+		if ( foundPaths )
+			i.updateTimeStamp();
+		
 		i++;
 	}
+	
+	// Add the diffraction paths to the path buffer.
+	for ( Index j = 0; j < diffractionPaths.getSize(); j++ )
+	{
+		const SourcePropagationPath& sourcePath = diffractionPaths[j];
+		pathBuffer.getSourceBuffer( sourcePath.sourceIndex ).addPropagationPath( sourcePath.path );
+	}
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	statistics.numDiffractionPaths += diffractionPaths.getSize();
+#endif
 }
 
 
@@ -862,10 +1654,20 @@ void SoundPropagator:: validateCachedPaths( const SoundListener& listener, Sound
 
 void SoundPropagator:: addDirectPaths( const SoundListener& listener, SoundPropagationPathBuffer& pathBuffer )
 {
+	if ( !directSoundIsEnabled && !transmissionIsEnabled )
+		return;
+	
 	const Vector3& listenerPosition = listener.getPosition();
 	const Size numSources = scene->getNumberOfSources();
 	
-	// Shoot out direct transmission rays from the listener to each source.
+	// The number of rays from the listener to the sources that are traced together.
+	const Size PACKET_SIZE = internal::RayTracer::PROBE_RAY_PACKET_SIZE;
+	
+	// Group the sources by the octant of their direction from the listener so that
+	// the rays to the sources in each group form coherent packets.
+	for ( Index o = 0; o < 8; o++ )
+		directPathSources[o].clear();
+	
 	for ( Index i = 0; i < numSources; i++ )
 	{
 		const SoundSource& source = *scene->getSource(i);
@@ -873,60 +1675,112 @@ void SoundPropagator:: addDirectPaths( const SoundListener& listener, SoundPropa
 		if ( !source.getIsEnabled() )
 			continue;
 		
-		Vector3 transmissionVector = source.getPosition() - listenerPosition;
-		
-		Real distanceToSource = transmissionVector.getMagnitude();
-		Real sourceRadius = source.getRadius();
-		transmissionVector /= distanceToSource;
-		
-		// Create a vector to hold the frequency-dependent attenuation.
-		FrequencyResponse attenuation;
+		const Vector3 offset = source.getPosition() - listenerPosition;
 		
-		// Trace an occlusion ray from the listener to the source and determine
-		// how much sound was transmitted.
+		directPathSources[Index(offset.x > Real(0)) | (Index(offset.y > Real(0)) << 1) |
+							(Index(offset.z > Real(0)) << 2)].add( i );
+	}
+	
+	Ray3 rays[PACKET_SIZE];
+	Real distances[PACKET_SIZE];
+	Real maxDistances[PACKET_SIZE];
+	Bool occluded[PACKET_SIZE];
+	
+	Ray3 transmissionRays[PACKET_SIZE];
+	Real transmissionDistances[PACKET_SIZE];
+	Index transmissionLanes[PACKET_SIZE];
+	
+	for ( Index o = 0; o < 8; o++ )
+	{
+		const ArrayList<Index>& octantSources = directPathSources[o];
 		
-		if ( directSoundIsEnabled &&
-			!rayTracer->traceBinaryOcclusionRay( Ray3( listenerPosition, transmissionVector),
-												distanceToSource - sourceRadius ) )
+		for ( Index start = 0; start < octantSources.getSize(); start += PACKET_SIZE )
 		{
-			pathDescription.clearPoints();
-			pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::SOURCE, &source ) );
-			pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::LISTENER, &listener ) );
+			// Stop if the time budget has run out.
+			if ( propagationMustStop() )
+				return;
+			
+			const Size numRays = math::min( PACKET_SIZE, octantSources.getSize() - start );
+			
+			for ( Index r = 0; r < numRays; r++ )
+			{
+				const SoundSource& source = *scene->getSource( octantSources[start + r] );
+				
+				Vector3 transmissionVector = source.getPosition() - listenerPosition;
+				
+				distances[r] = transmissionVector.getMagnitude();
+				transmissionVector /= distances[r];
+				
+				rays[r] = Ray3( listenerPosition, transmissionVector );
+				maxDistances[r] = distances[r] - source.getRadius();
+			}
+			
+			// Trace occlusion rays from the listener to the sources. The rays which are occluded,
+			// or all rays if direct sound is disabled, are traced again to find the transmitted sound.
+			if ( directSoundIsEnabled )
+				rayTracer->traceBinaryOcclusionRayPacket( rays, maxDistances, numRays, occluded );
+			else
+			{
+				for ( Index r = 0; r < numRays; r++ )
+					occluded[r] = true;
+			}
+			
+			Size numTransmissionRays = 0;
 			
-			Real relativeSpeed = getRelativeSpeed( listener, transmissionVector, source, transmissionVector );
-			attenuation *= getSourceFrequencyResponse( source, transmissionVector );
+			for ( Index r = 0; r < numRays; r++ )
+			{
+				if ( occluded[r] )
+				{
+					if ( transmissionIsEnabled )
+					{
+						transmissionRays[numTransmissionRays] = rays[r];
+						transmissionDistances[numTransmissionRays] = distances[r];
+						transmissionLanes[numTransmissionRays] = r;
+						numTransmissionRays++;
+					}
+					
+					continue;
+				}
+				
+				const Index sourceIndex = octantSources[start + r];
+				
+				addDirectPath( listener, sourceIndex, rays[r].direction, distances[r], FrequencyResponse(), pathBuffer );
+				
+				if ( debugDrawingCache != NULL && debugDrawingCache->getDirectPathsAreEnabled() )
+					debugDrawingCache->addDirectPath( scene->getSource(sourceIndex)->getPosition(), listenerPosition );
+				
+#if GSOUND_PROPAGATION_STATISTICS
+				statistics.numDirectPaths++;
+#endif
+			}
 			
-			pathBuffer.getSourceBuffer(i).addPropagationPath(
-						PropagationPath( transmissionVector*listener.getOrientation(),
-											distanceToSource, relativeSpeed,
-											scene->getSpeedOfSound(),
-											attenuation, pathDescription ) );
+			if ( numTransmissionRays == 0 )
+				continue;
 			
-			if ( debugDrawingCache != NULL && debugDrawingCache->getDirectPathsAreEnabled() )
-				debugDrawingCache->addDirectPath( source.getPosition(), listenerPosition );
-		}
-		else if ( transmissionIsEnabled )
-		{
-			Bool foundIntersection = traceTransmissionRay( Ray3( listenerPosition, transmissionVector ), 
-															distanceToSource, attenuation );
+			// Find all intersections along the transmission rays, sorted by distance. The rays
+			// whose transmitted sound is inaudible stop early and find no intersections.
+			rayTracer->traceTransmissionRayPacket( transmissionRays, transmissionDistances, numTransmissionRays,
+													transmissionThreshold, transmissionIntersections );
 			
-			if ( foundIntersection )
+			for ( Index t = 0; t < numTransmissionRays; t++ )
 			{
-				pathDescription.clearPoints();
-				pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::SOURCE, &source ) );
-				pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::LISTENER, &listener ) );
+				if ( transmissionIntersections[t].getSize() == 0 )
+					continue;
 				
-				Real relativeSpeed = getRelativeSpeed( listener, transmissionVector, source, transmissionVector );
-				attenuation *= getSourceFrequencyResponse( source, transmissionVector );
+				const Index sourceIndex = octantSources[start + transmissionLanes[t]];
+				FrequencyResponse attenuation;
 				
-				pathBuffer.getSourceBuffer(i).addPropagationPath(
-							PropagationPath( transmissionVector*listener.getOrientation(),
-												distanceToSource, relativeSpeed,
-												scene->getSpeedOfSound(),
-												attenuation, pathDescription ) );
+				getTransmissionAttenuation( transmissionIntersections[t], attenuation );
+				
+				addDirectPath( listener, sourceIndex, transmissionRays[t].direction, transmissionDistances[t],
+								attenuation, pathBuffer );
 				
 				if ( debugDrawingCache != NULL && debugDrawingCache->getTransmissionPathsAreEnabled() )
-					debugDrawingCache->addTransmissionPath( source.getPosition(), listenerPosition );
+					debugDrawingCache->addTransmissionPath( scene->getSource(sourceIndex)->getPosition(), listenerPosition );
+				
+#if GSOUND_PROPAGATION_STATISTICS
+				statistics.numTransmissionPaths++;
+#endif
 			}
 		}
 	}
@@ -935,6 +1789,29 @@ void SoundPropagator:: addDirectPaths( const SoundListener& listener, SoundPropa
 
 
 
+void SoundPropagator:: addDirectPath( const SoundListener& listener, Index sourceIndex,
+									const Vector3& directionToSource, Real distanceToSource,
+									const FrequencyResponse& attenuation, SoundPropagationPathBuffer& pathBuffer )
+{
+	const SoundSource& source = *scene->getSource(sourceIndex);
+	
+	pathDescription.clearPoints();
+	pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::SOURCE, &source ) );
+	pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::LISTENER, &listener ) );
+	
+	Real relativeSpeed = getRelativeSpeed( listener, directionToSource, source, directionToSource );
+	
+	pathBuffer.getSourceBuffer(sourceIndex).addPropagationPath(
+				PropagationPath( directionToSource*listener.getOrientation(),
+									distanceToSource, relativeSpeed,
+									scene->getSpeedOfSound(),
+									attenuation*getSourceFrequencyResponse( source, directionToSource ),
+									pathDescription ) );
+}
+
+
+
+
 //##########################################################################################
 //##########################################################################################
 //############		
@@ -946,7 +1823,9 @@ void SoundPropagator:: addDirectPaths( const SoundListener& listener, SoundPropa
 
 
 
-Bool SoundPropagator:: validateReflectionPath( const Vector3& sourcePosition, const Vector3& listenerPosition,
+Bool SoundPropagator:: validateReflectionPath( internal::RayTracer& tracer, internal::OcclusionCache& occlusionCache,
+												PropagationPathDescription& description,
+												const Vector3& sourcePosition, const Vector3& listenerPosition,
 												Real sourceRadius,
 												const ArrayList<ProbeIntersectionRecord>& path, Real& totalDistance,
 												Vector3& directionFromListener, Vector3& directionToSource,
@@ -996,8 +1875,9 @@ Bool SoundPropagator:: validateReflectionPath( const Vector3& sourcePosition, co
 		
 		// Trace a ray from this intersection point to the source to make sure that
 		// the source is reachable from this location.
-		if ( rayTracer->traceBinaryOcclusionRay( Ray3( virtualSourcePosition, rayDirection ), 
-												rayDistance - distanceAlongRay - rayEpsilon - virtualSourceRadius ) )
+		// Paths which share geometry trace many of the same rays, so use the cached result if there is one.
+		if ( occlusionCache.traceBinaryOcclusionRay( tracer, Ray3( virtualSourcePosition, rayDirection ), 
+													rayDistance - distanceAlongRay - rayEpsilon - virtualSourceRadius ) )
 			return false;
 		
 		if ( debugDrawingCache != NULL && debugDrawingCache->getReflectionPathsAreEnabled() )
@@ -1005,7 +1885,7 @@ Bool SoundPropagator:: validateReflectionPath( const Vector3& sourcePosition, co
 		
 		attenuation *= triangle.objectSpaceTriangle->getMaterial().getReflectionAttenuation();
 		totalDistance += rayDistance - distanceAlongRay;
-		pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::TRIANGLE_REFLECTION, triangle.objectSpaceTriangle ) );
+		description.addPoint( PropagationPathPoint( PropagationPathPoint::TRIANGLE_REFLECTION, triangle.objectSpaceTriangle ) );
 		
 		if ( i == path.getSize() )
 		{
@@ -1021,7 +1901,7 @@ Bool SoundPropagator:: validateReflectionPath( const Vector3& sourcePosition, co
 	Real rayDistance = directionFromListener.getMagnitude();
 	directionFromListener /= rayDistance;
 	
-	if ( rayTracer->traceBinaryOcclusionRay( Ray3( listenerPosition, directionFromListener ), rayDistance ) )
+	if ( occlusionCache.traceBinaryOcclusionRay( tracer, Ray3( listenerPosition, directionFromListener ), rayDistance ) )
 		return false;
 	
 	totalDistance += rayDistance;
@@ -1038,6 +1918,168 @@ Bool SoundPropagator:: validateReflectionPath( const Vector3& sourcePosition, co
 
 
 
+UInt32 SoundPropagator:: validateReflectionPaths( internal::RayTracer& tracer, internal::OcclusionCache& occlusionCache,
+													const internal::SourceBatch& sources, const Vector3& listenerPosition,
+													const ArrayList<ProbeIntersectionRecord>& path, SIMDFloat& totalDistance,
+													SIMDVector3& directionFromListener, SIMDVector3& directionToSource,
+													FrequencyResponse& attenuation )
+{
+	// This follows the same steps as validateReflectionPath() for each source in the batch.
+	SIMDBool validPaths = sources.getMask();
+	UInt32 laneMask = UInt32(validPaths.getMask());
+	
+	totalDistance = SIMDFloat( Real(0) );
+	attenuation = FrequencyResponse();
+	
+	SIMDVector3 virtualSourcePosition = sources.getPositions();
+	SIMDFloat virtualSourceRadius = sources.getRadii();
+	
+	// Paths are only drawn when probe rays are traced on the calling thread, so the point lists can be shared.
+	const Bool drawPaths = debugDrawingCache != NULL && debugDrawingCache->getReflectionPathsAreEnabled();
+	
+	if ( drawPaths )
+	{
+		for ( Index l = 0; l < internal::SourceBatch::WIDTH; l++ )
+		{
+			reflectionPathPoints[l].clear();
+			reflectionPathPoints[l].add( Vector3( virtualSourcePosition.x[l], virtualSourcePosition.y[l], virtualSourcePosition.z[l] ) );
+		}
+	}
+	
+	for ( Index i = path.getSize(); i > 0; i-- )
+	{
+		const internal::WorldSpaceTriangle& triangle = path[i-1].triangle;
+		const Vector3& listenerImagePosition = path[i-1].imagePosition;
+		
+		// Calculate the vectors from the listener image position to the virtual sources.
+		SIMDVector3 rayDirection = virtualSourcePosition - SIMDVector3( listenerImagePosition );
+		
+		SIMDFloat rayDistance = math::sqrt( math::dot( rayDirection, rayDirection ) );
+		rayDirection = rayDirection / rayDistance;
+		
+		// Make sure that the vectors pass through the triangle before reaching the virtual sources.
+		SIMDFloat distanceAlongRay;
+		
+		validPaths = validPaths & rayIntersectsTriangle( listenerImagePosition, rayDirection, triangle, distanceAlongRay );
+		validPaths = validPaths & (distanceAlongRay <= rayDistance);
+		laneMask = UInt32(validPaths.getMask());
+		
+		if ( laneMask == 0 )
+			return 0;
+		
+		// Calculate the intersection points of the rays with the triangle.
+		virtualSourcePosition = SIMDVector3( listenerImagePosition ) + rayDirection*distanceAlongRay;
+		
+		// Bias the intersection points to avoid precision errors.
+		const Vector3 bias = triangle.plane.normal*rayEpsilon;
+		const SIMDBool rayIsInFront = math::dot( rayDirection, SIMDVector3( triangle.plane.normal ) ) > Real(0);
+		
+		virtualSourcePosition = virtualSourcePosition + SIMDVector3( math::select( rayIsInFront, SIMDFloat(bias.x), SIMDFloat(-bias.x) ),
+																	math::select( rayIsInFront, SIMDFloat(bias.y), SIMDFloat(-bias.y) ),
+																	math::select( rayIsInFront, SIMDFloat(bias.z), SIMDFloat(-bias.z) ) );
+		
+		// Trace occlusion rays from the intersection points to the virtual sources, only for the paths that are still valid.
+		const SIMDFloat occlusionDistance = rayDistance - distanceAlongRay - rayEpsilon - virtualSourceRadius;
+		
+		for ( Index l = 0; l < internal::SourceBatch::WIDTH; l++ )
+		{
+			if ( (laneMask & (UInt32(1) << l)) == 0 )
+				continue;
+			
+			const Ray3 ray( Vector3( virtualSourcePosition.x[l], virtualSourcePosition.y[l], virtualSourcePosition.z[l] ),
+							Vector3( rayDirection.x[l], rayDirection.y[l], rayDirection.z[l] ) );
+			
+			if ( occlusionCache.traceBinaryOcclusionRay( tracer, ray, occlusionDistance[l] ) )
+				laneMask &= ~(UInt32(1) << l);
+			else if ( drawPaths )
+				reflectionPathPoints[l].add( ray.origin );
+		}
+		
+		if ( laneMask == 0 )
+			return 0;
+		
+		validPaths = SIMDBool( (laneMask & 1) != 0, (laneMask & 2) != 0, (laneMask & 4) != 0, (laneMask & 8) != 0 );
+		
+		attenuation *= triangle.objectSpaceTriangle->getMaterial().getReflectionAttenuation();
+		totalDistance += rayDistance - distanceAlongRay;
+		
+		if ( i == path.getSize() )
+		{
+			// After the first reflection, set the virtual sources' radii to zero because virtual sources have no radius.
+			virtualSourceRadius = SIMDFloat( Real(0) );
+			directionToSource = rayDirection;
+		}
+	}
+	
+	// Calculate the vectors from the listener position to the virtual sources.
+	directionFromListener = virtualSourcePosition - SIMDVector3( listenerPosition );
+	
+	SIMDFloat rayDistance = math::sqrt( math::dot( directionFromListener, directionFromListener ) );
+	directionFromListener = directionFromListener / rayDistance;
+	
+	for ( Index l = 0; l < internal::SourceBatch::WIDTH; l++ )
+	{
+		if ( (laneMask & (UInt32(1) << l)) == 0 )
+			continue;
+		
+		const Ray3 ray( listenerPosition, Vector3( directionFromListener.x[l], directionFromListener.y[l],
+													directionFromListener.z[l] ) );
+		
+		if ( occlusionCache.traceBinaryOcclusionRay( tracer, ray, rayDistance[l] ) )
+			laneMask &= ~(UInt32(1) << l);
+		else if ( drawPaths )
+		{
+			reflectionPathPoints[l].add( listenerPosition );
+			debugDrawingCache->addReflectionPath( reflectionPathPoints[l] );
+		}
+	}
+	
+	totalDistance += rayDistance;
+	
+	return laneMask;
+}
+
+
+
+
+void SoundPropagator:: setReflectionPathPoints( PropagationPathDescription& description,
+												const SoundSource& source, const SoundListener& listener,
+												const ArrayList<ProbeIntersectionRecord>& path )
+{
+	description.clearPoints();
+	description.addPoint( PropagationPathPoint( PropagationPathPoint::SOURCE, &source ) );
+	
+	// The reflections are ordered from the source to the listener.
+	for ( Index i = path.getSize(); i > 0; i-- )
+		description.addPoint( PropagationPathPoint( PropagationPathPoint::TRIANGLE_REFLECTION, path[i-1].triangle.objectSpaceTriangle ) );
+	
+	description.addPoint( PropagationPathPoint( PropagationPathPoint::LISTENER, &listener ) );
+}
+
+
+
+
+void SoundPropagator:: updateSourceBatches()
+{
+	sourceBatchTree.clearSources();
+	
+	const Size numSources = scene->getNumberOfSources();
+	
+	for ( Index s = 0; s < numSources; s++ )
+	{
+		const SoundSource& source = *scene->getSource(s);
+		
+		if ( source.getIsEnabled() )
+			sourceBatchTree.addSource( s, source.getPosition(), source.getRadius() );
+	}
+	
+	// Group nearby sources into the same batches so that whole batches can be culled.
+	sourceBatchTree.rebuild();
+}
+
+
+
+
 //##########################################################################################
 //##########################################################################################
 //############		
@@ -1049,10 +2091,12 @@ Bool SoundPropagator:: validateReflectionPath( const Vector3& sourcePosition, co
 
 
 
-Bool SoundPropagator:: addDiffractionPaths( const SoundListener& listener,
+Bool SoundPropagator:: addDiffractionPaths( internal::RayTracer& tracer, internal::OcclusionCache& occlusionCache,
+											PropagationPathDescription& description,
+											const SoundListener& listener,
 											const internal::WorldSpaceTriangle& probedTriangle,
 											const ArrayList<ProbeIntersectionRecord>& path, 
-											SoundPropagationPathBuffer& pathBuffer )
+											ArrayList<SourcePropagationPath>& outputPaths )
 {
 	const Vector3& listenerPosition = listener.getPosition();
 	const internal::InternalSoundTriangle* objectSpaceTriangle = probedTriangle.objectSpaceTriangle;
@@ -1200,17 +2244,17 @@ Bool SoundPropagator:: addDiffractionPaths( const SoundListener& listener,
 			diffractionPointToSource /= rayDistance;
 			
 			// Verify that the diffraction point is visible to the sound source.
-			if ( rayTracer->traceBinaryOcclusionRay( Ray3( diffractionPoint + diffractionPointToSource*rayEpsilon,
-															diffractionPointToSource ), 
-													rayDistance - source.getRadius() ) )
+			if ( occlusionCache.traceBinaryOcclusionRay( tracer, Ray3( diffractionPoint + diffractionPointToSource*rayEpsilon,
+																		diffractionPointToSource ), 
+														rayDistance - source.getRadius() ) )
 				continue;
 			
 			
 			Vector3 diffractionPointToListener = (listenerImagePosition - diffractionPoint).normalize();
 			
-			pathDescription.clearPoints();
-			pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::SOURCE, &source ) );
-			pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::EDGE_DIFFRACTION, &objectSpaceTriangle->getNeighbor(e) ) );
+			description.clearPoints();
+			description.addPoint( PropagationPathPoint( PropagationPathPoint::SOURCE, &source ) );
+			description.addPoint( PropagationPathPoint( PropagationPathPoint::EDGE_DIFFRACTION, &objectSpaceTriangle->getNeighbor(e) ) );
 			
 			// Validate the backwards reflection path for the diffracion point.
 			Real totalDistance;
@@ -1218,7 +2262,8 @@ Bool SoundPropagator:: addDiffractionPaths( const SoundListener& listener,
 			Vector3 fakeDirectionToSource;
 			FrequencyResponse attenuation;
 			
-			if ( validateReflectionPath( diffractionPoint + diffractionPointToListener*rayEpsilon,
+			if ( validateReflectionPath( tracer, occlusionCache, description,
+										diffractionPoint + diffractionPointToListener*rayEpsilon,
 										listenerPosition, Real(0), path, totalDistance,
 										directionFromListener, fakeDirectionToSource, attenuation ) )
 			{
@@ -1248,13 +2293,13 @@ Bool SoundPropagator:: addDiffractionPaths( const SoundListener& listener,
 				
 				attenuation *= getSourceFrequencyResponse( source, diffractionPointToSource );
 				
-				pathDescription.addPoint( PropagationPathPoint( PropagationPathPoint::LISTENER, &listener ) );
+				description.addPoint( PropagationPathPoint( PropagationPathPoint::LISTENER, &listener ) );
 				
-				pathBuffer.getSourceBuffer(s).addPropagationPath(
+				outputPaths.add( SourcePropagationPath( s,
 							PropagationPath( directionFromListener*listener.getOrientation(),
 												totalDistance, sourceSpeed - listenerSpeed,
 												scene->getSpeedOfSound(),
-												attenuation, pathDescription ) );
+												attenuation, description ) ) );
 				foundContributions = true;
 			}
 		}
@@ -1269,7 +2314,7 @@ Bool SoundPropagator:: addDiffractionPaths( const SoundListener& listener,
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Ray-Triangle Intersection Method
+//############		Transmission Attenuation Method
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -1277,60 +2322,81 @@ Bool SoundPropagator:: addDiffractionPaths( const SoundListener& listener,
 
 
 
-Bool SoundPropagator:: traceTransmissionRay( const Ray3& ray, Real maxDistance, FrequencyResponse& transmissionAttenuation )
+void SoundPropagator:: getTransmissionAttenuation( const ArrayList<internal::RayTracer::RayIntersection>& intersections,
+													FrequencyResponse& transmissionAttenuation )
 {
-	ArrayList<internal::RayTracer::RayIntersection> intersections;
+	// Set the transmission attenuation to be initially 1 for all frequency bands.
+	transmissionAttenuation = FrequencyResponse();
 	
-	if ( rayTracer->traceTransmissionRay( ray, maxDistance, intersections ) )
+	if ( intersections.getSize() == 1 )
 	{
-		if ( intersections.getSize() == 1 )
+		const SoundMaterial& material = intersections[0].triangle.triangle->getMaterial();
+		const FrequencyResponse& materialReflectionAttenuation = material.getReflectionAttenuation();
+		const FrequencyResponse& materialAbsorptionAttenuation = material.getAbsorptionAttenuation();
+		
+		for ( Index i = 0; i < transmissionAttenuation.getNumberOfBands(); i++ )
 		{
-			const SoundMaterial& material = intersections[0].triangle.triangle->getMaterial();
-			const FrequencyResponse& materialReflectionAttenuation = material.getReflectionAttenuation();
-			const FrequencyResponse& materialAbsorptionAttenuation = material.getAbsorptionAttenuation();
+			// The amount of sound that gets transmitted at each medium boundary.
+			Real absorption = (Real(1) - materialReflectionAttenuation[i])*materialAbsorptionAttenuation[i];
 			
-			for ( Index i = 0; i < transmissionAttenuation.getNumberOfBands(); i++ )
-			{
-				// The amount of sound that gets transmitted at each medium boundary.
-				Real absorption = (Real(1) - materialReflectionAttenuation[i])*materialAbsorptionAttenuation[i];
-				
-				transmissionAttenuation[i] = absorption*absorption;
-			}
+			transmissionAttenuation[i] = absorption*absorption;
 		}
-		else
+	}
+	else
+	{
+		// The intersections are in order of distance along the ray, so each consecutive
+		// pair is where the ray enters and leaves an object.
+		for ( Index i = 0; i + 1 < intersections.getSize(); i += 2 )
 		{
-			// Sort the array of intersections in order of distance along the ray.
-			std::qsort( intersections.getArrayPointer(), intersections.getSize(),
-						sizeof(internal::RayTracer::RayIntersection), compareIntersectionsByDistance );
+			Real distance = intersections[i+1].distanceAlongRay - intersections[i].distanceAlongRay;
 			
-			// Set the transmission attenuation to be initially 1 for all frequency bands.
-			transmissionAttenuation = FrequencyResponse();
-			Index i;
+			const SoundMaterial& material1 = intersections[i].triangle.triangle->getMaterial();
+			const SoundMaterial& material2 = intersections[i+1].triangle.triangle->getMaterial();
 			
-			// Find the total transmission attenuation based on all intersections.
-			for ( i = 0; i < intersections.getSize() - 1; i += 2 )
+			for ( Index i = 0; i < transmissionAttenuation.getNumberOfBands(); i++ )
 			{
-				Real distance = intersections[i+1].distanceAlongRay - intersections[i].distanceAlongRay;
+				// The amount of sound that gets transmitted at each medium boundary.
+				Real absorption1 = (Real(1) - material1.getReflectionAttenuation()[i])*
+															material1.getAbsorptionAttenuation()[i];
+				Real absorption2 = (Real(1) - material2.getReflectionAttenuation()[i])*
+															material2.getAbsorptionAttenuation()[i];
 				
-				const SoundMaterial& material1 = intersections[i].triangle.triangle->getMaterial();
-				const SoundMaterial& material2 = intersections[i+1].triangle.triangle->getMaterial();
+				Real attenuation = (material1.getTransmissionAttenuation()[i] + 
+									material2.getTransmissionAttenuation()[i])*Real(0.5);
 				
-				for ( Index i = 0; i < transmissionAttenuation.getNumberOfBands(); i++ )
-				{
-					// The amount of sound that gets transmitted at each medium boundary.
-					Real absorption1 = (Real(1) - material1.getReflectionAttenuation()[i])*
-																material1.getAbsorptionAttenuation()[i];
-					Real absorption2 = (Real(1) - material2.getReflectionAttenuation()[i])*
-																material2.getAbsorptionAttenuation()[i];
-					
-					Real attenuation = (material1.getTransmissionAttenuation()[i] + 
-										material2.getTransmissionAttenuation()[i])*Real(0.5);
-					
-					transmissionAttenuation[i] *= math::pow( attenuation, distance )*absorption1*absorption2;
-				}
+				transmissionAttenuation[i] *= math::pow( attenuation, distance )*absorption1*absorption2;
 			}
 		}
-		
+	}
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Time Budget Helper Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Bool SoundPropagator:: propagationTimeHasExpired() const
+{
+	return hasPropagationDeadline && util::Timer::getTime() >= propagationDeadline;
+}
+
+
+
+
+Bool SoundPropagator:: propagationMustStop()
+{
+	if ( propagationTimeHasExpired() )
+	{
+		propagationWasCutShort = true;
 		return true;
 	}
 	
@@ -1340,15 +2406,21 @@ Bool SoundPropagator:: traceTransmissionRay( const Ray3& ray, Real maxDistance,
 
 
 
-int SoundPropagator:: compareIntersectionsByDistance( const void* a, const void* b )
+int SoundPropagator:: compareCellsByDecreasingRayAffinity( const void* a, const void* b )
 {
-	const internal::RayTracer::RayIntersection* i1 = (const internal::RayTracer::RayIntersection*)a;
-	const internal::RayTracer::RayIntersection* i2 = (const internal::RayTracer::RayIntersection*)b;
+	const ListenerProbeCell* c1 = (const ListenerProbeCell*)a;
+	const ListenerProbeCell* c2 = (const ListenerProbeCell*)b;
 	
-	if ( i1->distanceAlongRay > i2->distanceAlongRay )
+	if ( c1->rayAffinity > c2->rayAffinity )
+		return -1;
+	else if ( c1->rayAffinity < c2->rayAffinity )
 		return 1;
-	else if ( i1->distanceAlongRay < i2->distanceAlongRay )
+	
+	// Break ties by cell index so that the order doesn't depend on the sorting algorithm.
+	if ( c1->cellIndex < c2->cellIndex )
 		return -1;
+	else if ( c1->cellIndex > c2->cellIndex )
+		return 1;
 	else
 		return 0;
 }
@@ -1356,6 +2428,57 @@ int SoundPropagator:: compareIntersectionsByDistance( const void* a, const void*
 
 
 
+
+#if GSOUND_PROPAGATION_STATISTICS
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Statistics Helper Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundPropagator:: finishStatistics( Double propagationStartTime )
+{
+	// Add the work done by the calling thread's ray tracer.
+	const internal::RayTracer::Statistics& tracerStatistics = rayTracer->getStatistics();
+	statistics.numRaysTraced += tracerStatistics.numRaysTraced;
+	statistics.numNodesVisited += tracerStatistics.numNodesVisited;
+	statistics.numTrianglesTested += tracerStatistics.numTrianglesTested;
+	statistics.numOcclusionCacheHits += cachedPathOcclusionCache.getNumberOfHits();
+	statistics.numOcclusionCacheMisses += cachedPathOcclusionCache.getNumberOfMisses();
+	
+	statistics.totalTime = util::Timer::getTime() - propagationStartTime;
+}
+
+
+
+
+Bool SoundPropagator:: isDiffractionPath( const PropagationPath& path )
+{
+	const PropagationPathDescription& description = path.getID().getDescription();
+	const Size numPoints = description.getNumberOfPoints();
+	
+	for ( Index i = 0; i < numPoints; i++ )
+	{
+		if ( description.getPoint(i).getType() == PropagationPathPoint::EDGE_DIFFRACTION )
+			return true;
+	}
+	
+	return false;
+}
+
+
+
+
+#endif
+
+
+
+
 //##########################################################################################
 //##########################################################################################
 //############		
@@ -1406,6 +2529,42 @@ Bool SoundPropagator:: rayIntersectsTriangle( const Ray3& ray, const internal::W
 
 
 
+SIMDBool SoundPropagator:: rayIntersectsTriangle( const Vector3& origin, const SIMDVector3& directions,
+													const internal::WorldSpaceTriangle& triangle,
+													SIMDFloat& distanceAlongRay )
+{
+	// This is the same test as the single ray version, done for each ray at once.
+	Vector3 v1ToV2 = triangle.v2 - triangle.v1;
+	Vector3 v1ToV3 = triangle.v3 - triangle.v1;
+	
+	SIMDVector3 pvec = math::cross( directions, SIMDVector3( v1ToV3 ) );
+	
+	SIMDFloat det = math::dot( SIMDVector3( v1ToV2 ), pvec );
+	
+	SIMDBool hits = math::abs(det) >= math::epsilon<Real>();
+	
+	SIMDFloat inverseDet = Real(1) / det;
+	
+	// The origin is the same for all rays, so these vectors only need to be computed once.
+	Vector3 v1ToSource = origin - triangle.v1;
+	Vector3 qvec = math::cross( v1ToSource, v1ToV2 );
+	
+	SIMDFloat u = math::dot( SIMDVector3( v1ToSource ), pvec ) * inverseDet;
+	
+	hits = hits & (u >= Real(0)) & (u <= Real(1));
+	
+	SIMDFloat v = math::dot( directions, SIMDVector3( qvec ) ) * inverseDet;
+	
+	hits = hits & (v >= Real(0)) & (u + v <= Real(1));
+	
+	distanceAlongRay = SIMDFloat( math::dot( v1ToV3, qvec ) ) * inverseDet;
+	
+	return hits & (distanceAlongRay > Real(0));
+}
+
+
+
+
 //##########################################################################################
 //##########################################################################################
 //############		
@@ -1433,6 +2592,90 @@ void SoundPropagator:: preparePropagationPathBuffer( SoundPropagationPathBuffer&
 
 
 
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Ray Distribution Cell Helper Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Size SoundPropagator:: getNumberOfCellRays( Real rayAffinity, Real raysPerCell, Real roundingOffset )
+{
+	// Cells with a low affinity may get less than one ray. Rounding with an offset
+	// that is uniform in [0,1) traces the expected number of rays on average
+	// rather than spending at least one ray on every cell.
+	return Size(rayAffinity*raysPerCell + roundingOffset);
+}
+
+
+
+
+UInt32 SoundPropagator:: getCellRandomSeed( UInt32 frameSeed, Index cellIndex )
+{
+	// Mix the bits of the frame seed and cell index so that neighboring cells
+	// don't get correlated random streams.
+	UInt32 seed = frameSeed ^ (UInt32(cellIndex)*UInt32(0x9E3779B9));
+	
+	seed ^= seed >> 16;
+	seed *= UInt32(0x85EBCA6B);
+	seed ^= seed >> 13;
+	seed *= UInt32(0xC2B2AE35);
+	seed ^= seed >> 16;
+	
+	return seed;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Reverb Estimation Helper Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Index SoundPropagator:: getMinReverbTimeStamp( Index frameTimeStamp ) const
+{
+	// Triangles are removed once their age reaches the maximum age.
+	if ( frameTimeStamp + 1 >= maxReverbCacheAge )
+		return frameTimeStamp + 1 - maxReverbCacheAge;
+	else
+		return 0;
+}
+
+
+
+
+void SoundPropagator:: setProbedTriangleOverlap( SoundSource::ProbeVisibilityRecord& sourceRecord,
+												const SoundListener::ProbeVisibilityRecord* listenerRecord )
+{
+	// Make sure that the same side of the triangle was probed by the source and listener.
+	if ( listenerRecord != NULL &&
+		((sourceRecord.rayDotNormal < Real(0) && listenerRecord->rayDotNormal < Real(0)) || 
+		(sourceRecord.rayDotNormal > Real(0) && listenerRecord->rayDotNormal > Real(0))) )
+	{
+		sourceRecord.overlapArea = sourceRecord.area;
+		sourceRecord.listenerTimeStamp = listenerRecord->timeStamp;
+	}
+	else
+	{
+		sourceRecord.overlapArea = Real(0);
+		sourceRecord.listenerTimeStamp = 0;
+	}
+}
+
+
+
+
 //##########################################################################################
 //##########################################################################################
 //############		
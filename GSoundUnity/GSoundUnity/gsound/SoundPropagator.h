@@ -66,10 +66,13 @@
 
 
 #include "internal/RayTracer.h"
+#include "internal/OcclusionCache.h"
+#include "internal/SourceBatchTree.h"
 #include "internal/WorldSpaceTriangle.h"
 #include "SoundScene.h"
 #include "SoundPropagationPathBuffer.h"
 #include "DebugDrawingCache.h"
+#include "SoundPropagationStatistics.h"
 
 
 //##########################################################################################
@@ -192,7 +195,53 @@ class SoundPropagator
 			{
 				this->propagateSound( scene, listener, maxListenerProbeDepth, numListenerProbeRays,
 									maxSourceProbeDepth, numSourceProbeRays, propagationPathBuffer,
-									NULL );
+									NULL, math::infinity<Double>() );
+			}
+			
+			
+			
+			
+			/// Perform sound propagation in the specified scene with the given listener, stopping when a time budget runs out.
+			/**
+			  * The propagation is performed in order of importance and the time budget is
+			  * checked cooperatively as it runs. Direct and transmitted paths are found first,
+			  * then previously cached probe paths are validated. Listener probe rays are then
+			  * traced for the cells of the listener's ray distribution in order of decreasing
+			  * ray affinity until the time that is needed to merge their output into the path
+			  * buffer and to trace the source probe rays used for reverb estimation is all that
+			  * remains. The source propagation's time is estimated from previous calls, and at
+			  * most half of the remaining time is kept back for it.
+			  *
+			  * Once the budget has run out, the remaining work is skipped. Everything found before
+			  * that point is output as usual, so the propagation path buffer still contains a usable
+			  * partial result. Cached probe paths that weren't validated are kept and validated
+			  * first on the next call, and the reverb response of a source for which no source
+			  * probe rays could be traced is left unchanged in the path buffer.
+			  *
+			  * The time budget is only checked between units of work (a source, a cached probe path,
+			  * or a packet of probe rays), so the call may overrun it by the time for one such unit.
+			  * The time needed to merge the listener probe output is estimated from previous calls,
+			  * so the first few calls with a time budget may also overrun it slightly. Whether or
+			  * not any work was skipped is given afterwards by getPropagationWasCutShort().
+			  * 
+			  * @param scene - the scene where sound propagation should be performed.
+			  * @param listener - the listener from whose perspective sound propagation is to be performed.
+			  * @param maxListenerProbeDepth - the maximum depth to which listener probe rays should be propagated.
+			  * @param numListenerProbeRays - the number of initial listener probe rays to trace.
+			  * @param maxSourceProbeDepth - the maximum depth to which source probe rays should be propagated.
+			  * @param numSourceProbeRays - the number of initial source probe rays to trace per source.
+			  * @param propagationPathBuffer - a buffer where output of the propagation should be placed.
+			  * @param maxPropagationTime - the time in seconds after which the propagation should stop.
+			  */
+			GSOUND_INLINE void propagateSound( const SoundScene& scene, const SoundListener& listener,
+												Size maxListenerProbeDepth, Size numListenerProbeRays,
+												Size maxSourceProbeDepth, Size numSourceProbeRays,
+												SoundPropagationPathBuffer& propagationPathBuffer,
+												Double maxPropagationTime )
+			{
+				this->propagateSound( scene, listener, maxListenerProbeDepth, numListenerProbeRays,
+									maxSourceProbeDepth, numSourceProbeRays, propagationPathBuffer,
+									NULL, maxPropagationTime );
 			}
 			
 			
@@ -222,7 +271,37 @@ class SoundPropagator
 			{
 				this->propagateSound( scene, listener, maxListenerProbeDepth, numListenerProbeRays,
 									maxSourceProbeDepth, numSourceProbeRays, propagationPathBuffer,
-									&debugCache );
+									&debugCache, math::infinity<Double>() );
+			}
+			
+			
+			
+			
+			/// Perform time-limited sound propagation in the specified scene, caching debug drawing information.
+			/**
+			  * The propagation stops once the specified time budget has run out, keeping
+			  * the results found up to that point. See the other time-limited propagateSound()
+			  * method for the order in which the propagation is performed.
+			  * 
+			  * @param scene - the scene where sound propagation should be performed.
+			  * @param listener - the listener from whose perspective sound propagation is to be performed.
+			  * @param maxListenerProbeDepth - the maximum depth to which listener probe rays should be propagated.
+			  * @param numListenerProbeRays - the number of initial listener probe rays to trace.
+			  * @param maxSourceProbeDepth - the maximum depth to which source probe rays should be propagated.
+			  * @param numSourceProbeRays - the number of initial source probe rays to trace per source.
+			  * @param propagationPathBuffer - a buffer where output of the propagation should be placed.
+			  * @param debugCache - a DebugDrawingCache in which to place debug drawing information.
+			  * @param maxPropagationTime - the time in seconds after which the propagation should stop.
+			  */
+			GSOUND_INLINE void propagateSound( const SoundScene& scene, const SoundListener& listener,
+												Size maxListenerProbeDepth, Size numListenerProbeRays,
+												Size maxSourceProbeDepth, Size numSourceProbeRays,
+												SoundPropagationPathBuffer& propagationPathBuffer,
+												DebugDrawingCache& debugCache, Double maxPropagationTime )
+			{
+				this->propagateSound( scene, listener, maxListenerProbeDepth, numListenerProbeRays,
+									maxSourceProbeDepth, numSourceProbeRays, propagationPathBuffer,
+									&debugCache, maxPropagationTime );
 			}
 			
 			
@@ -280,6 +359,39 @@ class SoundPropagator
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Transmission Threshold Accessor Methods
+			
+			
+			
+			
+			/// Get the gain below which sound transmitted directly from a source to a listener is inaudible.
+			GSOUND_INLINE Real getTransmissionThreshold() const
+			{
+				return transmissionThreshold;
+			}
+			
+			
+			
+			
+			/// Set the gain below which sound transmitted directly from a source to a listener is inaudible.
+			/**
+			  * A transmission ray stops looking for more intersections once the sound it transmits
+			  * is known to be below this gain in every frequency band, and no transmission path is
+			  * produced for it. This makes transmission through thick or layered geometry much cheaper.
+			  * The default value of zero never stops transmission rays early. The supplied value
+			  * must be greater than or equal to zero.
+			  */
+			GSOUND_INLINE void setTransmissionThreshold( Real newTransmissionThreshold )
+			{
+				transmissionThreshold = math::max( Real(0), newTransmissionThreshold );
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -394,6 +506,143 @@ class SoundPropagator
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Thread Count Accessor Methods
+			
+			
+			
+			
+			/// Get the number of threads that are used to trace listener probe rays.
+			GSOUND_INLINE Size getNumberOfThreads() const
+			{
+				return numThreads;
+			}
+			
+			
+			
+			
+			/// Set the number of threads that are used to trace listener probe rays.
+			/**
+			  * The cells of the listener's ray distribution are divided among this many
+			  * threads, one of which is the thread that calls propagateSound(). Each thread
+			  * stages its results separately and they are merged in a fixed order, so the
+			  * output for a given number of threads is deterministic. The number of threads
+			  * is clamped to be at least 1. Listener probe rays are always traced on the
+			  * calling thread when a DebugDrawingCache is being used.
+			  */
+			GSOUND_INLINE void setNumberOfThreads( Size newNumThreads )
+			{
+				numThreads = math::max( newNumThreads, Size(1) );
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Probe Path Cache Size Accessor Methods
+			
+			
+			
+			
+			/// Get the maximum number of probe paths that are cached for each listener.
+			GSOUND_INLINE Size getMaxNumberOfProbePaths() const
+			{
+				return maxNumProbePaths;
+			}
+			
+			
+			
+			
+			/// Set the maximum number of probe paths that are cached for each listener.
+			/**
+			  * Probe paths which produced propagation paths are cached and revalidated
+			  * on later frames without retracing them. When a listener's cache is full,
+			  * the probe paths which have gone the longest without producing propagation
+			  * paths are evicted first. This bounds the memory used by the cache and the
+			  * time spent revalidating it. The value is clamped to be at least 1.
+			  */
+			GSOUND_INLINE void setMaxNumberOfProbePaths( Size newMaxNumProbePaths )
+			{
+				maxNumProbePaths = math::max( newMaxNumProbePaths, Size(1) );
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Random Seed Accessor Method
+			
+			
+			
+			
+			/// Set the seed used to generate the directions of probe rays.
+			/**
+			  * The seed is initialized from the current time when the propagator is created.
+			  * Setting the same seed before propagating the same scene with the same
+			  * parameters makes the results repeatable, which is useful for comparing
+			  * the performance or output of different runs.
+			  */
+			GSOUND_INLINE void setRandomSeed( UInt32 newSeed )
+			{
+				probeRandomVariable.setSeed( newSeed );
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Time Budget Accessor Method
+			
+			
+			
+			
+			/// Return whether or not the most recent call to propagateSound() ran out of time before finishing.
+			/**
+			  * This is TRUE if any of the propagation work was skipped because the time
+			  * budget passed to propagateSound() ran out, so the output of that call is
+			  * only a partial result. It is always FALSE if there was no time budget.
+			  */
+			GSOUND_INLINE Bool getPropagationWasCutShort() const
+			{
+				return propagationWasCutShort;
+			}
+			
+			
+			
+			
+#if GSOUND_PROPAGATION_STATISTICS
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Statistics Accessor Method
+			
+			
+			
+			
+			/// Get statistics about the most recent call to propagateSound().
+			/**
+			  * The statistics include the time spent in each stage of the propagation,
+			  * the amount of ray tracing work that was done, and the number of paths of each
+			  * type that were found. They are only collected when GSOUND_PROPAGATION_STATISTICS
+			  * is enabled.
+			  */
+			GSOUND_INLINE const SoundPropagationStatistics& getStatistics() const
+			{
+				return statistics;
+			}
+			
+			
+			
+			
+#endif
 	private:
 		
 		//********************************************************************************
@@ -410,6 +659,24 @@ class SoundPropagator
 			
 			
 			
+			/// A class which stores a propagation path and the index of the source that it belongs to.
+			class SourcePropagationPath;
+			
+			
+			
+			
+			/// A class which holds the per-thread state used to trace a range of listener probe rays.
+			class ListenerProbeThread;
+			
+			
+			
+			
+			/// A class which stores the index and ray affinity of a cell of the listener's ray distribution.
+			class ListenerProbeCell;
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -423,7 +690,7 @@ class SoundPropagator
 								Size maxListenerProbeDepth, Size numListenerProbeRays,
 								Size maxSourceProbeDepth, Size numSourceProbeRays,
 								SoundPropagationPathBuffer& propagationPathBuffer,
-								DebugDrawingCache* debugCache );
+								DebugDrawingCache* debugCache, Double maxPropagationTime );
 			
 			
 			
@@ -436,6 +703,25 @@ class SoundPropagator
 			
 			
 			
+			/// Trace the listener probe rays for one thread's range of ray distribution cells.
+			void traceListenerProbeRays( ListenerProbeThread& thread );
+			
+			
+			
+			
+			/// Trace the listener probe rays for the ListenerProbeThread pointed to by the parameter.
+			static void listenerProbeThreadEntry( void* thread );
+			
+			
+			
+			
+			/// Merge the staged probe paths, propagation paths, and probed triangles from a thread.
+			void mergeListenerProbeThread( ListenerProbeThread& thread, const SoundListener& listener,
+											SoundPropagationPathBuffer& pathBuffer );
+			
+			
+			
+			
 			/// Do sound propagation from each sources's perspective, adding all paths to the propagation path buffer.
 			void doSourcePropagation( const SoundListener& listener,
 										Size maxSourceProbeDepth, Size numSourceProbeRays,
@@ -456,7 +742,9 @@ class SoundPropagator
 			
 			
 			
-			Bool validateReflectionPath( const Vector3& sourcePosition, const Vector3& listenerPosition,
+			Bool validateReflectionPath( internal::RayTracer& tracer, internal::OcclusionCache& occlusionCache,
+										PropagationPathDescription& description,
+										const Vector3& sourcePosition, const Vector3& listenerPosition,
 										Real sourceRadius,
 										const ArrayList<ProbeIntersectionRecord>& path, Real& totalDistance,
 										Vector3& directionFromListener, Vector3& directionToSource,
@@ -465,11 +753,44 @@ class SoundPropagator
 			
 			
 			
-			/// Add any valid diffraction propagation paths for the specified triangle to the propagation path buffer.
-			Bool addDiffractionPaths( const SoundListener& listener,
+			/// Validate the reflection paths for a probe path from each source in a batch to the listener at once.
+			/**
+			  * The image source test at each depth is done for all of the batch's sources
+			  * with SIMD operations, and occlusion rays are only traced for the sources
+			  * whose paths are still valid. Bit i of the returned mask is set if the source
+			  * in lane i of the batch has a valid path. All of the paths reflect off the same
+			  * triangles, so they share the same reflection attenuation, which is only computed once.
+			  */
+			UInt32 validateReflectionPaths( internal::RayTracer& tracer, internal::OcclusionCache& occlusionCache,
+											const internal::SourceBatch& sources, const Vector3& listenerPosition,
+											const ArrayList<ProbeIntersectionRecord>& path, SIMDFloat& totalDistance,
+											SIMDVector3& directionFromListener, SIMDVector3& directionToSource,
+											FrequencyResponse& attenuation );
+			
+			
+			
+			
+			/// Add the points of a reflection path from a source to the listener to a path description.
+			GSOUND_INLINE static void setReflectionPathPoints( PropagationPathDescription& description,
+															const SoundSource& source, const SoundListener& listener,
+															const ArrayList<ProbeIntersectionRecord>& path );
+			
+			
+			
+			
+			/// Rebuild the tree of source batches from the enabled sources in the scene.
+			void updateSourceBatches();
+			
+			
+			
+			
+			/// Add any valid diffraction propagation paths for the specified triangle to the output path list.
+			Bool addDiffractionPaths( internal::RayTracer& tracer, internal::OcclusionCache& occlusionCache,
+									PropagationPathDescription& description,
+									const SoundListener& listener,
 									const internal::WorldSpaceTriangle& probedTriangle,
 									const ArrayList<ProbeIntersectionRecord>& path,
-									SoundPropagationPathBuffer& pathBuffer );
+									ArrayList<SourcePropagationPath>& outputPaths );
 			
 			
 		
@@ -490,6 +811,14 @@ class SoundPropagator
 															Real& distanceAlongRay );
 			
 			
+			
+			
+			/// Intersect a group of rays with a common origin against a triangle and return which rays hit it.
+			GSOUND_INLINE static SIMDBool rayIntersectsTriangle( const Vector3& origin, const SIMDVector3& directions,
+																const internal::WorldSpaceTriangle& triangle,
+																SIMDFloat& distanceAlongRay );
+			
+			
 		
 			
 		//********************************************************************************
@@ -500,17 +829,73 @@ class SoundPropagator
 			
 			
 			
-			/// Trace a transmission ray through the scene in order to find the transmission attenuation.
-			Bool traceTransmissionRay( const Ray3& ray, Real maxDistance, FrequencyResponse& transmissionAttenuation );
+			/// Compute the attenuation of sound transmitted along a ray from its intersections, sorted by distance.
+			static void getTransmissionAttenuation( const ArrayList<internal::RayTracer::RayIntersection>& intersections,
+													FrequencyResponse& transmissionAttenuation );
+			
+			
+			
+			
+			/// Add a direct or transmitted propagation path from a source to the listener to the path buffer.
+			void addDirectPath( const SoundListener& listener, Index sourceIndex,
+								const Vector3& directionToSource, Real distanceToSource,
+								const FrequencyResponse& attenuation, SoundPropagationPathBuffer& pathBuffer );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Time Budget Helper Methods
+			
+			
+			
+			
+			/// Return whether or not the time budget for the current propagation has run out.
+			GSOUND_INLINE Bool propagationTimeHasExpired() const;
+			
+			
+			
 			
+			/// Return whether or not the time budget has run out, marking the current propagation as cut short if it has.
+			/**
+			  * This is used by the calling thread wherever work is skipped once the
+			  * budget runs out. The listener probe threads keep their own flags instead.
+			  */
+			GSOUND_INLINE Bool propagationMustStop();
+			
+			
+			
+			
+			/// Compare two listener probe cells so that cells with higher ray affinity come first.
+			static int compareCellsByDecreasingRayAffinity( const void* a, const void* b );
+			
+			
+			
+			
+#if GSOUND_PROPAGATION_STATISTICS
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Statistics Helper Methods
+			
+			
+			
+			
+			/// Add the calling thread's ray tracing work and the total time to the statistics for this frame.
+			void finishStatistics( Double propagationStartTime );
 			
 			
 			
-			static int compareIntersectionsByDistance( const void* a, const void* b );
 			
+			/// Return whether or not the specified propagation path contains an edge diffraction point.
+			static Bool isDiffractionPath( const PropagationPath& path );
 			
 			
 			
+			
+#endif
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -534,6 +919,38 @@ class SoundPropagator
 			
 			
 			
+			/// Return the number of probe rays to trace for a ray distribution cell with the given ray affinity.
+			/**
+			  * The expected number of rays is rounded down after adding the rounding
+			  * offset, which should be in [0,1).
+			  */
+			GSOUND_INLINE static Size getNumberOfCellRays( Real rayAffinity, Real raysPerCell, Real roundingOffset );
+			
+			
+			
+			
+			/// Return the seed for the random stream of the ray distribution cell with the specified index.
+			GSOUND_INLINE static UInt32 getCellRandomSeed( UInt32 frameSeed, Index cellIndex );
+			
+			
+			
+			
+			/// Return the oldest time stamp that a probed triangle can have and still affect the reverb on the specified frame.
+			GSOUND_INLINE Index getMinReverbTimeStamp( Index frameTimeStamp ) const;
+			
+			
+			
+			
+			/// Set the listener overlap area of a source's probed triangle from the listener's record for the triangle.
+			/**
+			  * The listener record may be NULL if the listener hasn't probed the triangle.
+			  */
+			GSOUND_INLINE static void setProbedTriangleOverlap( SoundSource::ProbeVisibilityRecord& sourceRecord,
+																const SoundListener::ProbeVisibilityRecord* listenerRecord );
+			
+			
+			
+			
 			/// Find the points of closest approach on two lines.
 			GSOUND_INLINE static void computePointsOfClosestApproach( const Vector3& p1, const Vector3& v1,
 																	const Vector3& p2, const Vector3& v2,
@@ -600,6 +1017,120 @@ class SoundPropagator
 			
 			
 			
+			/// The number of threads that are used to trace listener probe rays.
+			Size numThreads;
+			
+			
+			
+			
+			/// The maximum number of probe paths that are cached for each listener.
+			Size maxNumProbePaths;
+			
+			
+			
+			
+			/// The per-thread state for each thread that traces listener probe rays, created as needed.
+			ArrayList<ListenerProbeThread*> listenerProbeThreads;
+			
+			
+			
+			
+			/// A temporary list of the listener's ray distribution cells, sorted by decreasing ray affinity.
+			ArrayList<ListenerProbeCell> listenerProbeCells;
+			
+			
+			
+			
+			/// A temporary probe path which is rebuilt for each cached probe path when it is validated.
+			ArrayList<ProbeIntersectionRecord> cachedProbePath;
+			
+			
+			
+			
+			/// A temporary list of the diffraction paths found while validating the cached probe paths.
+			ArrayList<SourcePropagationPath> cachedDiffractionPaths;
+			
+			
+			
+			
+			/// The enabled sources in the scene for the current frame, packed into batches of SIMD width.
+			internal::SourceBatchTree sourceBatchTree;
+			
+			
+			
+			
+			/// A temporary list of the source batches that may be reached by a cached probe path.
+			ArrayList<Index> cachedPathSourceBatches;
+			
+			
+			
+			
+			/// The results of the occlusion rays traced while validating the cached probe paths on the current frame.
+			internal::OcclusionCache cachedPathOcclusionCache;
+			
+			
+			
+			
+			/// Temporary lists of the intersections found along each ray of a transmission ray packet.
+			ArrayList<internal::RayTracer::RayIntersection> transmissionIntersections[internal::RayTracer::PROBE_RAY_PACKET_SIZE];
+			
+			
+			
+			
+			/// Temporary lists of the points along each reflection path of a source batch which is drawn for debugging.
+			ArrayList<Vector3> reflectionPathPoints[internal::SourceBatch::WIDTH];
+			
+			
+			
+			
+			/// Temporary lists of the enabled sources, grouped by the octant of their direction from the listener.
+			ArrayList<Index> directPathSources[8];
+			
+			
+			
+			
+			/// The time, as returned by util::Timer::getTime(), at which the current propagation should stop.
+			Double propagationDeadline;
+			
+			
+			
+			
+			/// Whether or not the current propagation has a time budget, given by the propagation deadline.
+			Bool hasPropagationDeadline;
+			
+			
+			
+			
+			/// An estimate of the time needed to merge the listener probe output, as a fraction of the tracing time.
+			Double listenerMergeTimeRatio;
+			
+			
+			
+			
+			/// The time that the source propagation took on the last frame where it wasn't cut short.
+			/**
+			  * If there is a time budget, this much time is left for the source propagation
+			  * when the listener propagation's deadline is chosen.
+			  */
+			Double sourcePropagationTime;
+			
+			
+			
+			
+			/// Whether or not the most recent propagation skipped any work because its time budget ran out.
+			Bool propagationWasCutShort;
+			
+			
+			
+			
+#if GSOUND_PROPAGATION_STATISTICS
+			/// Statistics about the most recent call to propagateSound().
+			SoundPropagationStatistics statistics;
+			
+			
+			
+			
+#endif
 			Index timeStamp;
 			
 			
@@ -628,6 +1159,12 @@ class SoundPropagator
 			
 			
 			
+			/// The gain below which transmitted sound is inaudible and transmission rays stop early.
+			Real transmissionThreshold;
+			
+			
+			
+			
 			/// Whether or not reflected contributions are found.
 			Bool reflectionIsEnabled;
 			
@@ -650,6 +1187,24 @@ class SoundPropagator
 			
 			
 			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Data Members
+			
+			
+			
+			
+			/// The number of frames that a source's reverb sums are updated incrementally before being recomputed.
+			/**
+			  * Recomputing the sums periodically removes accumulated floating point error
+			  * and picks up changes to the materials and scales of the probed triangles.
+			  */
+			static const Size MAX_INCREMENTAL_REVERB_UPDATES = 128;
+			
+			
+			
 };
 
 
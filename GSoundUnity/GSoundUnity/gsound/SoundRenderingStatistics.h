@@ -0,0 +1,226 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/SoundRenderingStatistics.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::SoundRenderingStatistics class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_SOUND_RENDERING_STATISTICS_H
+#define INCLUDE_GSOUND_SOUND_RENDERING_STATISTICS_H
+
+
+#include "GSoundBase.h"
+
+
+//##########################################################################################
+//******************************  Start GSound Namespace  **********************************
+GSOUND_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which records where the time was spent while a SoundPropagationRenderer produced audio.
+/**
+  * A SoundPropagationRenderer adds to one of these objects on every call to fillBuffer()
+  * when GSOUND_RENDERING_STATISTICS is enabled. Unlike SoundPropagationStatistics,
+  * which describes a single frame, these statistics accumulate over every buffer
+  * rendered since they were last reset, so that the cost per buffer can be averaged
+  * over many small audio blocks.
+  *
+  * All times are in seconds. The statistics are written by the audio rendering
+  * thread, so they should only be read while that thread is not rendering.
+  */
+class SoundRenderingStatistics
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			/// Create a sound rendering statistics object with all statistics set to zero.
+			GSOUND_INLINE SoundRenderingStatistics()
+			{
+				this->reset();
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Reset Method
+			
+			
+			
+			
+			/// Set all of the statistics to zero.
+			GSOUND_INLINE void reset()
+			{
+				totalTime = Double(0);
+				targetUpdateTime = Double(0);
+				crossoverTime = Double(0);
+				delayLineTime = Double(0);
+				reverbTime = Double(0);
+				
+				numBuffersRendered = 0;
+				numSamplesRendered = 0;
+				numSourcesRendered = 0;
+				numPathsRendered = 0;
+				numInterpolatedPaths = 0;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Stage Timing Data Members
+			
+			
+			
+			
+			/// The total time spent in fillBuffer().
+			Double totalTime;
+			
+			
+			
+			
+			/// The time spent applying newly published propagation paths to the render states of the sources.
+			Double targetUpdateTime;
+			
+			
+			
+			
+			/// The time spent splitting each source's input audio into frequency bands and writing it to its delay buffer.
+			Double crossoverTime;
+			
+			
+			
+			
+			/// The time spent rendering propagation paths from the delay buffers to the output.
+			Double delayLineTime;
+			
+			
+			
+			
+			/// The time spent rendering the comb and all pass reverb filters and mixing them with the output.
+			Double reverbTime;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Rendering Work Data Members
+			
+			
+			
+			
+			/// The number of calls to fillBuffer() that were made.
+			Size numBuffersRendered;
+			
+			
+			
+			
+			/// The total number of sample frames that were rendered.
+			Size numSamplesRendered;
+			
+			
+			
+			
+			/// The number of times that a sound source was rendered, summed over all buffers.
+			Size numSourcesRendered;
+			
+			
+			
+			
+			/// The number of times that a propagation path was rendered, summed over all buffers.
+			Size numPathsRendered;
+			
+			
+			
+			
+			/// The number of rendered paths whose delay time changed and had to be interpolated.
+			Size numInterpolatedPaths;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//******************************  End GSound Namespace  ************************************
+GSOUND_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_SOUND_RENDERING_STATISTICS_H
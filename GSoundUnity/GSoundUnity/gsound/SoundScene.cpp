@@ -81,6 +81,9 @@ GSOUND_NAMESPACE_START
 
 SoundScene:: SoundScene()
 	:	objectBVH( NULL ),
+		objectBVHNeedsRebuild( false ),
+		objectBVHBuildCost( 0 ),
+		objectBVHRebuildThreshold( 1.5 ),
 		speedOfSound( 343 ),
 		userData( NULL )
 {
@@ -147,7 +150,7 @@ void SoundScene:: addObject( SoundObject* newObject )
 		return;
 	
 	objects.add( newObject );
-	rebuildObjectBVH();
+	objectBVHNeedsRebuild = true;
 }
 
 
@@ -161,7 +164,7 @@ Bool SoundScene:: removeObject( SoundObject* object )
 	Bool result = objects.remove( object );
 	
 	if ( result )
-		rebuildObjectBVH();
+		objectBVHNeedsRebuild = true;
 	
 	return result;
 }
@@ -173,7 +176,43 @@ void SoundScene:: removeAllObjects()
 {
 	objects.clear();
 	
-	rebuildObjectBVH();
+	objectBVHNeedsRebuild = true;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		BVH Update Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SoundScene:: updateObjectBVH() const
+{
+	// If the set of objects has changed, the structure of the BVH is no longer valid.
+	if ( objectBVHNeedsRebuild )
+	{
+		rebuildObjectBVH();
+		return;
+	}
+	
+	if ( objectBVH == NULL )
+		return;
+	
+	// Refit the existing BVH to the current object transformations. If no
+	// object has moved, there is nothing else to do.
+	if ( !objectBVH->update() )
+		return;
+	
+	// Rebuild the BVH if refitting has degraded its quality too much.
+	if ( objectBVH->getTraversalCost() > objectBVHBuildCost*objectBVHRebuildThreshold )
+		rebuildObjectBVH();
 }
 
 
@@ -200,8 +239,11 @@ void SoundScene:: rebuildObjectBVH() const
 	else
 	{
 		objectBVH = util::allocate<ObjectBVHType>();
-		new (objectBVH) ObjectBVHType( const_cast<SoundScene*>(this)->objects );
+		new (objectBVH) ObjectBVHType( objects );
 	}
+	
+	objectBVHBuildCost = objectBVH != NULL ? objectBVH->getTraversalCost() : Real(0);
+	objectBVHNeedsRebuild = false;
 }
 
 
@@ -65,7 +65,7 @@
 #include "GSoundBase.h"
 
 
-#include "internal/SphereTree.h"
+#include "internal/ObjectQBVHArrayTree.h"
 #include "SoundSource.h"
 #include "SoundListener.h"
 #include "SoundObject.h"
@@ -106,7 +106,7 @@ class SoundScene
 			
 			
 			/// The type of bounding volume hierarchy to use for the objects in the scene.
-			typedef internal::SphereTree ObjectBVHType;
+			typedef internal::ObjectQBVHArrayTree ObjectBVHType;
 			
 			
 			
@@ -206,8 +206,8 @@ class SoundScene
 			/// Add a new object to this sound scene.
 			/**
 			  * If the new object is NULL, the method has no effect. The
-			  * object bounding volume heirarchy for this scene is then rebuilt
-			  * with the new object, incurring the cost of this operation.
+			  * object bounding volume heirarchy for this scene is marked as
+			  * needing a rebuild, which is performed the next time it is accessed.
 			  * 
 			  * @param newObject - an object to be added to the sound scene.
 			  */
@@ -223,8 +223,8 @@ class SoundScene
 			  * in the scene and removes it if it is found. A value of TRUE is
 			  * returned if the object was found and removed. Otherwise, FALSE
 			  * is returned. If the object was removed successfully, the object
-			  * bounding volume hierarchy is rebuilt, incurring the cost of this
-			  * operation.
+			  * bounding volume hierarchy is marked as needing a rebuild, which
+			  * is performed the next time it is accessed.
 			  * 
 			  * @param object - an object to remove from the sound scene.
 			  * @return whether or not the object was successfully removed.
@@ -236,9 +236,9 @@ class SoundScene
 			
 			/// Remove all objects from this sound scene.
 			/**
-			  * This method removes all objects in this scene in constant time
-			  * and then deallocates any bounding volume hierarchy for the objects
-			  * that previously existed.
+			  * This method removes all objects in this scene in constant time.
+			  * Any bounding volume hierarchy for the objects that previously existed
+			  * is deallocated the next time the hierarchy is accessed.
 			  */
 			void removeAllObjects();
 			
@@ -284,11 +284,16 @@ class SoundScene
 			/**
 			  * If there are no objects in the scene, a NULL pointer is returned.
 			  * 
+			  * If objects have been added to or removed from the scene since the last
+			  * call, the hierarchy is rebuilt. Otherwise, the existing hierarchy is refit
+			  * to the current object transformations, and it is only rebuilt if the refit
+			  * hierarchy's traversal cost has grown beyond the rebuild threshold.
+			  * 
 			  * @return a const pointer to the root node of the object bounding volume heirarchy or NULL.
 			  */
 			GSOUND_INLINE const ObjectBVHType* getObjectBVH() const
 			{
-				rebuildObjectBVH();
+				updateObjectBVH();
 				
 				return objectBVH;
 			}
@@ -296,6 +301,35 @@ class SoundScene
 			
 			
 			
+			/// Get the factor by which a refit object BVH's traversal cost can grow before the BVH is rebuilt.
+			/**
+			  * The cost of the object BVH is recorded each time it is rebuilt. When objects move,
+			  * the BVH is refit rather than rebuilt. If the cost of the refit BVH exceeds
+			  * the recorded cost multiplied by this factor, the BVH is rebuilt from scratch.
+			  */
+			GSOUND_FORCE_INLINE Real getObjectBVHRebuildThreshold() const
+			{
+				return objectBVHRebuildThreshold;
+			}
+			
+			
+			
+			
+			/// Set the factor by which a refit object BVH's traversal cost can grow before the BVH is rebuilt.
+			/**
+			  * The new threshold is clamped to the range of [1,+infinity]. A value of 1
+			  * causes the BVH to be rebuilt whenever refitting it makes it any worse.
+			  * 
+			  * @param newRebuildThreshold - the new object BVH rebuild threshold.
+			  */
+			GSOUND_INLINE void setObjectBVHRebuildThreshold( Real newRebuildThreshold )
+			{
+				objectBVHRebuildThreshold = math::max( newRebuildThreshold, Real(1) );
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -366,6 +400,12 @@ class SoundScene
 			
 			
 			
+			/// Rebuild or refit the bounding volume hierarchy of objects in the scene, whichever is necessary.
+			void updateObjectBVH() const;
+			
+			
+			
+			
 			/// Rebuild the bounding volume hierarchy of objects in the scene.
 			void rebuildObjectBVH() const;
 			
@@ -398,6 +438,24 @@ class SoundScene
 			
 			
 			
+			/// Whether or not objects have been added or removed since the object BVH was last built.
+			mutable Bool objectBVHNeedsRebuild;
+			
+			
+			
+			
+			/// The traversal cost of the object BVH when it was last built.
+			mutable Real objectBVHBuildCost;
+			
+			
+			
+			
+			/// The factor by which a refit object BVH's traversal cost can grow before the BVH is rebuilt.
+			Real objectBVHRebuildThreshold;
+			
+			
+			
+			
 			/// The speed of sound in this scene, specified in world units per second.
 			Real speedOfSound;
 			
@@ -80,6 +80,11 @@ GSOUND_NAMESPACE_START
 
 
 
+class SoundListener;
+
+
+
+
 //********************************************************************************
 //********************************************************************************
 //********************************************************************************
@@ -592,7 +597,10 @@ class SoundSource
 					
 					GSOUND_INLINE ProbeVisibilityRecord( Real newRayDotNormal, Index newTimeStamp )
 						:	rayDotNormal( newRayDotNormal ),
-							timeStamp( newTimeStamp )
+							timeStamp( newTimeStamp ),
+							area( 0 ),
+							overlapArea( 0 ),
+							listenerTimeStamp( 0 )
 					{
 					}
 					
@@ -606,6 +614,125 @@ class SoundSource
 					Index timeStamp;
 					
 					
+					/// The world-space area of the triangle that was added to the source's reverb area sums.
+					Real area;
+					
+					
+					/// The area that was added to the listener overlap sums, or 0 if the listener didn't probe the same side.
+					Real overlapArea;
+					
+					
+					/// The time stamp of the listener's record for the triangle when the overlap area was computed.
+					Index listenerTimeStamp;
+					
+					
+			};
+			
+			
+			
+			
+			/// A class which holds running sums over the probed triangles that determine the source's reverb.
+			/**
+			  * The sums are updated as triangles are probed and expire so that the reverb
+			  * can be estimated without visiting every probed triangle on every frame.
+			  * The listener overlap is stored as the sum of the overlapping areas and the
+			  * sum of the areas weighted by the source and listener time stamps, which
+			  * together give the age-weighted overlap area for any frame.
+			  */
+			class ProbedAreaSums
+			{
+				public:
+					
+					GSOUND_INLINE ProbedAreaSums()
+						:	listener( NULL ),
+							timeStamp( 0 ),
+							numIncrementalUpdates( 0 ),
+							totalArea( 0 ),
+							attenuationArea( 0 ),
+							overlapArea( 0 ),
+							overlapTimeStampArea( 0 )
+					{
+					}
+					
+					
+					
+					/// Reset all of the sums to zero.
+					GSOUND_INLINE void reset()
+					{
+						totalArea = Double(0);
+						attenuationArea = FrequencyResponse( 0 );
+						overlapArea = Double(0);
+						overlapTimeStampArea = Double(0);
+					}
+					
+					
+					
+					/// Add the area and overlap contributions of the specified triangle record to the sums.
+					GSOUND_INLINE void addTriangle( const internal::ObjectSpaceTriangle& triangle, const ProbeVisibilityRecord& record )
+					{
+						totalArea += record.area;
+						attenuationArea += triangle.triangle->getMaterial().getReflectionAttenuation()*record.area;
+						addOverlap( record );
+					}
+					
+					
+					
+					/// Remove the area and overlap contributions of the specified triangle record from the sums.
+					GSOUND_INLINE void removeTriangle( const internal::ObjectSpaceTriangle& triangle, const ProbeVisibilityRecord& record )
+					{
+						totalArea -= record.area;
+						attenuationArea += triangle.triangle->getMaterial().getReflectionAttenuation()*(-record.area);
+						removeOverlap( record );
+					}
+					
+					
+					
+					/// Add the listener overlap contribution of the specified triangle record to the sums.
+					GSOUND_INLINE void addOverlap( const ProbeVisibilityRecord& record )
+					{
+						overlapArea += record.overlapArea;
+						overlapTimeStampArea += Double(record.overlapArea)*Double(record.timeStamp + record.listenerTimeStamp);
+					}
+					
+					
+					
+					/// Remove the listener overlap contribution of the specified triangle record from the sums.
+					GSOUND_INLINE void removeOverlap( const ProbeVisibilityRecord& record )
+					{
+						overlapArea -= record.overlapArea;
+						overlapTimeStampArea -= Double(record.overlapArea)*Double(record.timeStamp + record.listenerTimeStamp);
+					}
+					
+					
+					
+					/// The listener whose probed triangles the overlap sums were computed with, or NULL if the sums are invalid.
+					const SoundListener* listener;
+					
+					
+					/// The time stamp of the last frame when the sums were brought up to date.
+					Index timeStamp;
+					
+					
+					/// The number of frames since the sums were last recomputed from scratch.
+					Size numIncrementalUpdates;
+					
+					
+					/// The total world-space area of the probed triangles.
+					Double totalArea;
+					
+					
+					/// The sum of the probed triangles' areas weighted by their reflection attenuation.
+					FrequencyResponse attenuationArea;
+					
+					
+					/// The total area of the probed triangles that the listener probed on the same side.
+					Double overlapArea;
+					
+					
+					/// The sum of the overlapping areas weighted by the sum of their source and listener time stamps.
+					Double overlapTimeStampArea;
+					
+					
 			};
 			
 			
@@ -730,6 +857,12 @@ class SoundSource
 			
 			
 			
+			/// Running sums over this source's probed triangles which are used to estimate its reverb.
+			mutable ProbedAreaSums probedAreaSums;
+			
+			
+			
+			
 };
 
 
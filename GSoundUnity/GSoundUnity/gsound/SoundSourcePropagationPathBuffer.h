@@ -272,6 +272,15 @@ class SoundSourcePropagationPathBuffer
 
 
 
+namespace util
+{
+	/// A source path buffer only points to its paths and source, so it can be relocated by copying its bytes.
+	GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( SoundSourcePropagationPathBuffer )
+};
+
+
+
+
 //##########################################################################################
 //******************************  End GSound Namespace  ************************************
 GSOUND_NAMESPACE_END
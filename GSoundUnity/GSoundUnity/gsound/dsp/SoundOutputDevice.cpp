@@ -114,8 +114,8 @@ class SoundOutputDevice:: SoundOutputDeviceWrapper
 			
 			
 			GSOUND_INLINE SoundOutputDeviceWrapper( const SoundDeviceID& newDeviceID )
-				:	internalDeviceID( newDeviceID ),
-					isRunning( false )
+				:	isRunning( false ),
+					internalDeviceID( newDeviceID )
 			{
 				// If the device ID is not valid, do nothing to initialize the device and go into 'dummy' mode.
 				if ( internalDeviceID == SoundDeviceID::INVALID_DEVICE_ID )
@@ -387,6 +387,11 @@ class SoundOutputDevice:: SoundOutputDeviceWrapper
 			// A handle to an event object which signals when an output buffer is available.
 			HANDLE bufferFreeEvent;
 			
+#else
+			
+			// There is no audio API on other platforms, so devices are always in 'dummy' mode.
+			SoundDeviceID internalDeviceID;
+			
 #endif
 			
 			
@@ -0,0 +1,290 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/dsp/VirtualSoundOutputDevice.cpp
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::dsp::VirtualSoundOutputDevice class implementation
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#include "VirtualSoundOutputDevice.h"
+
+
+//##########################################################################################
+//****************************  Start GSound DSP Namespace  ********************************
+GSOUND_DSP_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Constructor
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+VirtualSoundOutputDevice:: VirtualSoundOutputDevice( Size newBlockSize )
+	:	input( NULL ),
+		encoder( NULL ),
+		blockSize( math::max( newBlockSize, Size(1) ) ),
+		currentSampleIndex( 0 ),
+		currentTime( 0 ),
+		isRealTime( false ),
+		realTimeStartTime( -1 ),
+		realTimeStartClockTime( 0 ),
+		numBlocksRendered( 0 ),
+		renderedDuration( 0 ),
+		totalBlockTime( 0 ),
+		maxBlockTime( 0 )
+{
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Rendering Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Size VirtualSoundOutputDevice:: renderBlock()
+{
+	const Float sampleRate = this->getSampleRate();
+	Size numSamplesRead = 0;
+	
+	// Get the block from the input and time how long it takes.
+	const Double blockStartTime = util::Timer::getTime();
+	
+	if ( input != NULL )
+		numSamplesRead = input->getSamples( stream, 0, blockSize );
+	
+	const Double blockTime = util::Timer::getTime() - blockStartTime;
+	
+	// Make sure the stream holds a full block, then silence the part that the input didn't produce.
+	if ( stream.getNumberOfBuffers() == 0 )
+		stream.setNumberOfBuffers( 1 );
+	
+	if ( stream.getSize() < blockSize )
+		stream.setSize( blockSize );
+	
+	if ( numSamplesRead < blockSize )
+		stream.zero( numSamplesRead, blockSize - numSamplesRead );
+	
+	// Write the block to the encoder if there is one.
+	if ( encoder != NULL )
+		encoder->write( stream.getBuffer(0), 0, blockSize );
+	
+	// Update the render timing.
+	const Double blockDuration = Double(blockSize) / Double(sampleRate);
+	
+	numBlocksRendered++;
+	renderedDuration += blockDuration;
+	totalBlockTime += blockTime;
+	maxBlockTime = math::max( maxBlockTime, blockTime );
+	
+	// Advance the clock.
+	if ( isRealTime && realTimeStartTime < Double(0) )
+	{
+		realTimeStartTime = blockStartTime;
+		realTimeStartClockTime = currentTime;
+	}
+	
+	currentSampleIndex += blockSize;
+	currentTime += blockDuration;
+	
+	// Wait until the wall-clock time reaches the end of the block.
+	if ( isRealTime )
+	{
+		const Double waitTime = realTimeStartTime + (currentTime - realTimeStartClockTime) - util::Timer::getTime();
+		
+		if ( waitTime > Double(0) )
+			util::Thread::sleep( waitTime );
+	}
+	
+	return numSamplesRead;
+}
+
+
+
+
+SoundSize VirtualSoundOutputDevice:: render( Double duration )
+{
+	const SoundSize startSampleIndex = currentSampleIndex;
+	const Double endTime = currentTime + duration;
+	
+	while ( currentTime < endTime )
+		renderBlock();
+	
+	return currentSampleIndex - startSampleIndex;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Clock Accessor Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Float VirtualSoundOutputDevice:: getSampleRate() const
+{
+	if ( input != NULL && input->getSampleRate() > Float(0) )
+		return input->getSampleRate();
+	else
+		return Float(44100);
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Render Timing Accessor Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Double VirtualSoundOutputDevice:: getRealTimeFactor() const
+{
+	if ( renderedDuration > Double(0) )
+		return totalBlockTime / renderedDuration;
+	else
+		return Double(0);
+}
+
+
+
+
+void VirtualSoundOutputDevice:: resetTiming()
+{
+	numBlocksRendered = 0;
+	renderedDuration = 0;
+	totalBlockTime = 0;
+	maxBlockTime = 0;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Input Accessor Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+SoundOutput* VirtualSoundOutputDevice:: getInput() const
+{
+	return input;
+}
+
+
+
+
+void VirtualSoundOutputDevice:: setInput( SoundOutput* newInput )
+{
+	input = newInput;
+}
+
+
+
+
+void VirtualSoundOutputDevice:: removeInput()
+{
+	input = NULL;
+}
+
+
+
+
+Bool VirtualSoundOutputDevice:: hasInput() const
+{
+	return input != NULL;
+}
+
+
+
+
+//##########################################################################################
+//****************************  End GSound DSP Namespace  **********************************
+GSOUND_DSP_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
@@ -0,0 +1,468 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/dsp/VirtualSoundOutputDevice.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::dsp::VirtualSoundOutputDevice class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_VIRTUAL_SOUND_OUTPUT_DEVICE_H
+#define INCLUDE_GSOUND_VIRTUAL_SOUND_OUTPUT_DEVICE_H
+
+
+#include "GSoundDSPConfig.h"
+
+
+#include "SoundInput.h"
+#include "SoundOutput.h"
+#include "SoundStream.h"
+#include "WaveEncoder.h"
+
+
+//##########################################################################################
+//****************************  Start GSound DSP Namespace  ********************************
+GSOUND_DSP_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which pulls audio from its input on a virtual clock instead of a hardware device.
+/**
+  * A VirtualSoundOutputDevice takes the place of a SoundOutputDevice when there is
+  * no audio hardware, such as when baking audio offline or benchmarking a renderer.
+  * Audio is requested from the input in fixed-size blocks on the thread that calls
+  * renderBlock() or render(), and the device's clock advances by one block each time.
+  * The clock runs at the sample rate of the input.
+  *
+  * By default, blocks are rendered as fast as possible. In real-time mode, the device
+  * waits after each block until the wall-clock time has caught up with the virtual
+  * clock, which simulates the timing of a hardware device.
+  *
+  * The rendered audio can optionally be written to a WaveEncoder. The device also
+  * keeps track of how long the input takes to produce each block, so that the
+  * cost of rendering can be measured.
+  */
+class VirtualSoundOutputDevice : public SoundInput
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			/// Create a virtual output device which renders blocks of the specified size, in samples.
+			VirtualSoundOutputDevice( Size newBlockSize = 512 );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Rendering Methods
+			
+			
+			
+			
+			/// Request one block of audio from the input and advance the clock by one block.
+			/**
+			  * If the input produces fewer samples than the block size or there is no input,
+			  * the rest of the block is silent. The block is written to the encoder if there
+			  * is one. In real-time mode, this method doesn't return until the wall-clock
+			  * time has reached the end of the block.
+			  * 
+			  * @return the number of samples that the input produced.
+			  */
+			Size renderBlock();
+			
+			
+			
+			
+			/// Render whole blocks until the clock has advanced by at least the specified number of seconds.
+			/**
+			  * @return the number of samples that the clock advanced.
+			  */
+			SoundSize render( Double duration );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Clock Accessor Methods
+			
+			
+			
+			
+			/// Get the sample rate of the device's clock.
+			/**
+			  * This is the sample rate of the input, or 44100 Hz if there is no input.
+			  */
+			Float getSampleRate() const;
+			
+			
+			
+			
+			/// Get the number of samples that the device's clock has advanced since it was created.
+			GSOUND_INLINE SoundSize getCurrentSampleIndex() const
+			{
+				return currentSampleIndex;
+			}
+			
+			
+			
+			
+			/// Get the time in seconds of the device's clock.
+			GSOUND_INLINE Double getCurrentTime() const
+			{
+				return currentTime;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Block Size Accessor Methods
+			
+			
+			
+			
+			/// Get the number of samples that are requested from the input for each block.
+			GSOUND_INLINE Size getBlockSize() const
+			{
+				return blockSize;
+			}
+			
+			
+			
+			
+			/// Set the number of samples that are requested from the input for each block.
+			/**
+			  * The block size is clamped to be at least 1.
+			  */
+			GSOUND_INLINE void setBlockSize( Size newBlockSize )
+			{
+				blockSize = math::max( newBlockSize, Size(1) );
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Real-Time Mode Accessor Methods
+			
+			
+			
+			
+			/// Return whether or not rendering is paced to match the wall-clock time.
+			GSOUND_INLINE Bool getIsRealTime() const
+			{
+				return isRealTime;
+			}
+			
+			
+			
+			
+			/// Set whether or not rendering is paced to match the wall-clock time.
+			/**
+			  * When real-time mode is enabled, the wall-clock time is matched starting
+			  * from the next block that is rendered.
+			  */
+			GSOUND_INLINE void setIsRealTime( Bool newIsRealTime )
+			{
+				isRealTime = newIsRealTime;
+				realTimeStartTime = -1;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Encoder Accessor Methods
+			
+			
+			
+			
+			/// Get the encoder which rendered audio is written to, or NULL if there is none.
+			GSOUND_INLINE WaveEncoder* getEncoder() const
+			{
+				return encoder;
+			}
+			
+			
+			
+			
+			/// Set the encoder which rendered audio is written to.
+			/**
+			  * The device doesn't take ownership of the encoder. If the encoder is NULL,
+			  * rendered audio is discarded.
+			  */
+			GSOUND_INLINE void setEncoder( WaveEncoder* newEncoder )
+			{
+				encoder = newEncoder;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Render Timing Accessor Methods
+			
+			
+			
+			
+			/// Get the number of blocks that have been rendered since the timing was last reset.
+			GSOUND_INLINE Size getNumberOfBlocksRendered() const
+			{
+				return numBlocksRendered;
+			}
+			
+			
+			
+			
+			/// Get the total time in seconds that the input has spent rendering blocks since the timing was last reset.
+			GSOUND_INLINE Double getTotalBlockTime() const
+			{
+				return totalBlockTime;
+			}
+			
+			
+			
+			
+			/// Get the longest time in seconds that the input has spent rendering one block since the timing was last reset.
+			GSOUND_INLINE Double getMaxBlockTime() const
+			{
+				return maxBlockTime;
+			}
+			
+			
+			
+			
+			/// Get the average time in seconds that the input has spent rendering one block since the timing was last reset.
+			GSOUND_INLINE Double getAverageBlockTime() const
+			{
+				return numBlocksRendered > 0 ? totalBlockTime / Double(numBlocksRendered) : Double(0);
+			}
+			
+			
+			
+			
+			/// Get the ratio of the time spent rendering to the duration of the audio that was rendered.
+			/**
+			  * A real-time factor less than 1 means that the input renders audio faster than
+			  * real time, and a factor greater than 1 means that it couldn't keep up with a
+			  * hardware device. Time spent waiting in real-time mode is not included.
+			  */
+			Double getRealTimeFactor() const;
+			
+			
+			
+			
+			/// Reset the render timing so that it only includes blocks rendered after this call.
+			void resetTiming();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Input Accessor Methods
+			
+			
+			
+			
+			/// Get the audio output that is providing audio to the device.
+			virtual SoundOutput* getInput() const;
+			
+			
+			
+			
+			/// Set the audio output that will provide audio to the device.
+			virtual void setInput( SoundOutput* newInput );
+			
+			
+			
+			
+			/// Clear any object that was previously providing audio for the device.
+			virtual void removeInput();
+			
+			
+			
+			
+			/// Return whether or not the device has an object to provide audio.
+			virtual Bool hasInput() const;
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// A pointer to the object which is producing audio to be output.
+			SoundOutput* input;
+			
+			
+			
+			
+			/// A pointer to the encoder which rendered audio is written to, or NULL if there is none.
+			WaveEncoder* encoder;
+			
+			
+			
+			
+			/// The stream which holds the block of audio currently being rendered.
+			SoundStream stream;
+			
+			
+			
+			
+			/// The number of samples that are requested from the input for each block.
+			Size blockSize;
+			
+			
+			
+			
+			/// The number of samples that the device's clock has advanced.
+			SoundSize currentSampleIndex;
+			
+			
+			
+			
+			/// The time in seconds of the device's clock.
+			Double currentTime;
+			
+			
+			
+			
+			/// Whether or not rendering is paced to match the wall-clock time.
+			Bool isRealTime;
+			
+			
+			
+			
+			/// The wall-clock time at which real-time pacing started, or a negative value if it hasn't started.
+			Double realTimeStartTime;
+			
+			
+			
+			
+			/// The clock time of the device when real-time pacing started.
+			Double realTimeStartClockTime;
+			
+			
+			
+			
+			/// The number of blocks that have been rendered since the timing was last reset.
+			Size numBlocksRendered;
+			
+			
+			
+			
+			/// The duration in seconds of the audio that has been rendered since the timing was last reset.
+			Double renderedDuration;
+			
+			
+			
+			
+			/// The total time in seconds that the input has spent rendering blocks.
+			Double totalBlockTime;
+			
+			
+			
+			
+			/// The longest time in seconds that the input has spent rendering one block.
+			Double maxBlockTime;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//****************************  End GSound DSP Namespace  **********************************
+GSOUND_DSP_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_VIRTUAL_SOUND_OUTPUT_DEVICE_H
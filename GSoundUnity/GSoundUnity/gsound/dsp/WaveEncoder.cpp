@@ -0,0 +1,308 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/dsp/WaveEncoder.cpp
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::dsp::WaveEncoder class implementation
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#include "WaveEncoder.h"
+
+
+#include "SampleMath.h"
+
+
+#define WAVE_HEADER_SIZE 44
+
+
+//##########################################################################################
+//****************************  Start GSound DSP Namespace  ********************************
+GSOUND_DSP_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Constructor
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+WaveEncoder:: WaveEncoder( const String& newFileName, Size newNumChannels, Float newSampleRate )
+	:	fileName( newFileName ),
+		numChannels( newNumChannels ),
+		sampleRate( newSampleRate ),
+		lengthInSamples( SoundSize(0) ),
+		file( NULL ),
+		outputBuffer( NULL ),
+		outputBufferSize( 0 )
+{
+	// Attempt to open the file.
+	file = std::fopen( fileName.c_str(), "wb" );
+	
+	// Write a header for an empty file so that the samples start at the right offset.
+	if ( file != NULL )
+		writeHeader();
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Destructor
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+WaveEncoder:: ~WaveEncoder()
+{
+	close();
+	
+	if ( outputBuffer != NULL )
+		util::deallocate( outputBuffer );
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Sample Write Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Size WaveEncoder:: write( const SoundBuffer& buffer, Index startIndex, Size numSamples )
+{
+	if ( file == NULL || numChannels == 0 )
+		return 0;
+	
+	// Don't read past the end of the buffer.
+	if ( startIndex >= buffer.getSize() )
+		return 0;
+	
+	numSamples = math::min( numSamples, buffer.getSize() - startIndex );
+	
+	const Size bytesPerSample = 2;
+	const Size stride = bytesPerSample*numChannels;
+	const Size numBytesToWrite = numSamples*stride;
+	
+	// If the output buffer has not been allocated yet or is too small, increase its size.
+	if ( outputBufferSize < numBytesToWrite )
+	{
+		// Deallocate the old buffer if necessary.
+		if ( outputBuffer != NULL )
+			util::deallocate( outputBuffer );
+		
+		// Allocate a new buffer and change the buffer size.
+		outputBuffer = util::allocate<UByte>( numBytesToWrite );
+		outputBufferSize = numBytesToWrite;
+	}
+	
+	// Interleave the channels and convert them to little-endian 16-bit samples.
+	const Size numBufferChannels = buffer.getNumberOfChannels();
+	
+	for ( Index i = 0; i < numChannels; i++ )
+	{
+		UByte* destination = outputBuffer + i*bytesPerSample;
+		
+		if ( i < numBufferChannels )
+		{
+			const Sample* source = buffer.getChannelStart(i) + startIndex;
+			const Sample* const sourceEnd = source + numSamples;
+			
+			while ( source != sourceEnd )
+			{
+				Sample16 encoded = sample::convert<Sample16>( math::clamp( *source, Sample(-1), Sample(1) ) );
+				
+				destination[0] = (UByte)(encoded & 0xFF);
+				destination[1] = (UByte)((encoded >> 8) & 0xFF);
+				
+				source++;
+				destination += stride;
+			}
+		}
+		else
+		{
+			for ( Index j = 0; j < numSamples; j++, destination += stride )
+				destination[0] = destination[1] = 0;
+		}
+	}
+	
+	Size numBytesWritten = std::fwrite( outputBuffer, sizeof(UByte), numBytesToWrite, file );
+	Size numSamplesWritten = numBytesWritten / stride;
+	
+	lengthInSamples += numSamplesWritten;
+	
+	return numSamplesWritten;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		File Close Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void WaveEncoder:: close()
+{
+	if ( file == NULL )
+		return;
+	
+	// Rewrite the header now that the length of the file is known.
+	std::fseek( file, 0, SEEK_SET );
+	writeHeader();
+	
+	std::fclose( file );
+	file = NULL;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Private Helper Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// Store a 16-bit value in little-endian byte order.
+GSOUND_FORCE_INLINE static void writeLittleEndian16( UByte* destination, UInt32 value )
+{
+	destination[0] = (UByte)(value & 0xFF);
+	destination[1] = (UByte)((value >> 8) & 0xFF);
+}
+
+
+
+
+/// Store a 32-bit value in little-endian byte order.
+GSOUND_FORCE_INLINE static void writeLittleEndian32( UByte* destination, UInt32 value )
+{
+	destination[0] = (UByte)(value & 0xFF);
+	destination[1] = (UByte)((value >> 8) & 0xFF);
+	destination[2] = (UByte)((value >> 16) & 0xFF);
+	destination[3] = (UByte)((value >> 24) & 0xFF);
+}
+
+
+
+
+void WaveEncoder:: writeHeader()
+{
+	const UInt32 bytesPerSample = 2;
+	const UInt32 blockAlign = bytesPerSample*UInt32(numChannels);
+	const UInt32 dataSize = UInt32(lengthInSamples)*blockAlign;
+	
+	UByte header[WAVE_HEADER_SIZE];
+	
+	// The RIFF chunk.
+	header[0] = 'R'; header[1] = 'I'; header[2] = 'F'; header[3] = 'F';
+	writeLittleEndian32( header + 4, dataSize + WAVE_HEADER_SIZE - 8 );
+	header[8] = 'W'; header[9] = 'A'; header[10] = 'V'; header[11] = 'E';
+	
+	// The format chunk for PCM audio.
+	header[12] = 'f'; header[13] = 'm'; header[14] = 't'; header[15] = ' ';
+	writeLittleEndian32( header + 16, 16 );
+	writeLittleEndian16( header + 20, 1 );
+	writeLittleEndian16( header + 22, UInt32(numChannels) );
+	writeLittleEndian32( header + 24, UInt32(sampleRate) );
+	writeLittleEndian32( header + 28, UInt32(sampleRate)*blockAlign );
+	writeLittleEndian16( header + 32, blockAlign );
+	writeLittleEndian16( header + 34, bytesPerSample*8 );
+	
+	// The data chunk.
+	header[36] = 'd'; header[37] = 'a'; header[38] = 't'; header[39] = 'a';
+	writeLittleEndian32( header + 40, dataSize );
+	
+	std::fwrite( header, sizeof(UByte), WAVE_HEADER_SIZE, file );
+}
+
+
+
+
+//##########################################################################################
+//****************************  End GSound DSP Namespace  **********************************
+GSOUND_DSP_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
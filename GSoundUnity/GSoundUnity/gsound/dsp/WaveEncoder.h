@@ -0,0 +1,314 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/dsp/WaveEncoder.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::dsp::WaveEncoder class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_WAVE_ENCODER_H
+#define INCLUDE_GSOUND_WAVE_ENCODER_H
+
+
+#include "GSoundDSPConfig.h"
+
+
+#include "SoundBuffer.h"
+#include <cstdio>
+
+
+//##########################################################################################
+//****************************  Start GSound DSP Namespace  ********************************
+GSOUND_DSP_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which encodes audio and writes it to a 16-bit PCM WAVE file on mass storage.
+/**
+  * Samples are appended to the file as they are written. The sizes in the WAVE
+  * header are only correct once the file has been closed, either explicitly using
+  * close() or when the encoder is destroyed. Files written by this class can be
+  * read by a WaveDecoder.
+  */
+class WaveEncoder
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructors
+			
+			
+			
+			
+			/// Create a WaveEncoder which writes audio with the specified format to the WAVE file with the given path.
+			/**
+			  * If the file can't be opened for writing, the encoder is not valid and
+			  * all writes to it have no effect.
+			  */
+			WaveEncoder( const String& fileName, Size numChannels, Float sampleRate );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Destructor
+			
+			
+			
+			
+			/// Close the WAVE file, finishing its header, and release all resources associated with the encoder.
+			~WaveEncoder();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Sample Write Method
+			
+			
+			
+			
+			/// Encode the specified number of samples from a sound buffer and append them to the WAVE file.
+			/**
+			  * The samples are read from the buffer starting at the specified start index.
+			  * If the buffer has fewer channels than the file, the missing channels are
+			  * written as silence. Any extra channels in the buffer are ignored. Samples
+			  * are clamped to the range [-1,1] before they are converted to 16 bits.
+			  * 
+			  * @param buffer - the buffer containing the samples to write.
+			  * @param startIndex - the index of the first sample in the buffer to write.
+			  * @param numSamples - the number of samples from each channel to write.
+			  * @return the number of samples that were written to the file.
+			  */
+			Size write( const SoundBuffer& buffer, Index startIndex, Size numSamples );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	File Close Method
+			
+			
+			
+			
+			/// Finish the WAVE file's header and close the file.
+			/**
+			  * After the file is closed, further writes have no effect.
+			  */
+			void close();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Accessor Methods
+			
+			
+			
+			
+			/// Return whether or not the WAVE file is open and can be written to.
+			GSOUND_INLINE Bool isOpen() const
+			{
+				return file != NULL;
+			}
+			
+			
+			
+			
+			/// Get the path to the WAVE file being written.
+			GSOUND_INLINE const String& getFileName() const
+			{
+				return fileName;
+			}
+			
+			
+			
+			
+			/// Get the number of channels in the WAVE file being written.
+			GSOUND_INLINE Size getNumberOfChannels() const
+			{
+				return numChannels;
+			}
+			
+			
+			
+			
+			/// Get the sample rate of the WAVE file being written.
+			GSOUND_INLINE Float getSampleRate() const
+			{
+				return sampleRate;
+			}
+			
+			
+			
+			
+			/// Get the number of samples per channel that have been written to the WAVE file.
+			GSOUND_INLINE SoundSize getLengthInSamples() const
+			{
+				return lengthInSamples;
+			}
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Copy Operations
+			
+			
+			
+			
+			/// Declared but not defined so that encoders can't be copied.
+			WaveEncoder( const WaveEncoder& other );
+			WaveEncoder& operator = ( const WaveEncoder& other );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Helper Methods
+			
+			
+			
+			
+			/// Write the WAVE header for the current length of the file at the start of the file.
+			void writeHeader();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// The path to the WAVE file being written.
+			String fileName;
+			
+			
+			
+			
+			/// The number of channels in the WAVE file.
+			Size numChannels;
+			
+			
+			
+			
+			/// The sample rate of the WAVE file.
+			Float sampleRate;
+			
+			
+			
+			
+			/// The number of samples per channel that have been written to the WAVE file.
+			SoundSize lengthInSamples;
+			
+			
+			
+			
+			/// A handle to the WAVE file being written.
+			std::FILE* file;
+			
+			
+			
+			
+			/// A buffer used to hold interleaved encoded data before it is written to the file.
+			UByte* outputBuffer;
+			
+			
+			
+			
+			/// The length in bytes of the buffer used to hold encoded data.
+			Size outputBufferSize;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//****************************  End GSound DSP Namespace  **********************************
+GSOUND_DSP_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_WAVE_ENCODER_H
@@ -116,6 +116,26 @@ class GSOUND_ALIGN(16) FatSIMDRay3D : public math::SIMDRay3D<T,dimension>
 			
 			
 			
+			/// Create a SIMD ray packet from the 4 specified rays.
+			/**
+			  * The signs of the packet's direction are taken from the first ray. The rays
+			  * should all point into the same octant, otherwise box tests with the packet
+			  * are not correct for the rays whose direction signs differ.
+			  */
+			GSOUND_INLINE FatSIMDRay3D( const Ray3D<T>& ray1, const Ray3D<T>& ray2,
+										const Ray3D<T>& ray3, const Ray3D<T>& ray4 )
+				:	SIMDRay3D<T,dimension>( ray1, ray2, ray3, ray4 ),
+					inverseDirection( T(1) / ray1.direction, T(1) / ray2.direction,
+									T(1) / ray3.direction, T(1) / ray4.direction )
+			{
+				sign[0] = ray1.direction.x > T(0);
+				sign[1] = ray1.direction.y > T(0);
+				sign[2] = ray1.direction.z > T(0);
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
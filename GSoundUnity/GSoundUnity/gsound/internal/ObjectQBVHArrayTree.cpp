@@ -0,0 +1,794 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/ObjectQBVHArrayTree.cpp
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::ObjectQBVHArrayTree class implementation
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#include "ObjectQBVHArrayTree.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		ObjectAABB Class Definition
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+class ObjectQBVHArrayTree:: ObjectAABB
+{
+	public:
+		
+		GSOUND_FORCE_INLINE ObjectAABB( SoundObject* newObject )
+			:	volume( newObject->getBoundingBox() ),
+				object( newObject )
+		{
+			centroid = volume.getCenter();
+		}
+		
+		
+		
+		
+		/// The world-space axis-aligned bounding box of the object.
+		AABB3 volume;
+		
+		
+		
+		
+		/// The centroid of the object's axis-aligned bounding box.
+		Vector3 centroid;
+		
+		
+		
+		
+		/// A pointer to the object from which this object AABB was computed.
+		SoundObject* object;
+		
+		
+		
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		SplitBin Class Definition
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+class ObjectQBVHArrayTree:: SplitBin
+{
+	public:
+		
+		GSOUND_FORCE_INLINE SplitBin()
+			:	volume( math::max<Real>(), math::min<Real>(),
+						math::max<Real>(), math::min<Real>(),
+						math::max<Real>(), math::min<Real>() ),
+				numObjects( 0 )
+		{
+		}
+		
+		AABB3 volume;
+		
+		
+		Size numObjects;
+		
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Constructors
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+ObjectQBVHArrayTree:: ObjectQBVHArrayTree( const ArrayList<SoundObject*>& newObjects )
+	:	nodes( NULL ),
+		numNodes( 0 ),
+		objects( NULL ),
+		numObjects( 0 )
+{
+	if ( newObjects.getSize() != 0 )
+		buildTree( newObjects );
+}
+
+
+
+
+ObjectQBVHArrayTree:: ObjectQBVHArrayTree( const ObjectQBVHArrayTree& other )
+	:	nodes( util::copyArrayAligned( other.nodes, other.numNodes, sizeof(NodeType) ) ),
+		numNodes( other.numNodes ),
+		objects( util::copyArray( other.objects, other.numObjects ) ),
+		numObjects( other.numObjects )
+{
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Destructor
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+ObjectQBVHArrayTree:: ~ObjectQBVHArrayTree()
+{
+	// Deallocate the tree.
+	destroyTree();
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Assignment Operator
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+ObjectQBVHArrayTree& ObjectQBVHArrayTree:: operator = ( const ObjectQBVHArrayTree& other )
+{
+	if ( this != &other )
+	{
+		destroyTree();
+		
+		nodes = util::copyArrayAligned( other.nodes, other.numNodes, sizeof(NodeType) );
+		numNodes = other.numNodes;
+		objects = util::copyArray( other.objects, other.numObjects );
+		numObjects = other.numObjects;
+	}
+	
+	return *this;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Tree Destruction Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void ObjectQBVHArrayTree:: destroyTree()
+{
+	if ( nodes != NULL )
+		util::deallocateAligned( nodes );
+	
+	if ( objects != NULL )
+		util::deallocate( objects );
+	
+	nodes = NULL;
+	numNodes = 0;
+	objects = NULL;
+	numObjects = 0;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Tree Update Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Bool ObjectQBVHArrayTree:: update()
+{
+	if ( nodes == NULL )
+		return false;
+	
+	AABB3 rootVolume;
+	
+	return refitNode( nodes, rootVolume );
+}
+
+
+
+
+Bool ObjectQBVHArrayTree:: refitNode( NodeType* node, AABB3& volume )
+{
+	StaticArray<AABB3,4> childVolumes;
+	Bool changed = false;
+	Bool foundChild = false;
+	
+	for ( Index i = 0; i < 4; i++ )
+	{
+		childVolumes[i] = node->getVolume(i);
+		
+		// Empty children keep their inverted bounding box so that they are never intersected.
+		if ( node->isEmpty(i) )
+			continue;
+		
+		if ( node->isLeaf(i) )
+		{
+			const AABB3 objectVolume = objects[node->getObjectIndex(i)]->getBoundingBox();
+			
+			if ( objectVolume.min != childVolumes[i].min || objectVolume.max != childVolumes[i].max )
+			{
+				childVolumes[i] = objectVolume;
+				changed = true;
+			}
+		}
+		else
+		{
+			// Refit all children, even if an earlier one didn't change.
+			AABB3 subtreeVolume;
+			
+			if ( refitNode( node->getChild(i), subtreeVolume ) )
+			{
+				childVolumes[i] = subtreeVolume;
+				changed = true;
+			}
+		}
+		
+		if ( foundChild )
+			volume += childVolumes[i];
+		else
+		{
+			volume = childVolumes[i];
+			foundChild = true;
+		}
+	}
+	
+	// Only write the node's volumes if they are different.
+	if ( changed )
+		node->setVolumes( childVolumes );
+	
+	return changed;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Tree Quality Accessor Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Real ObjectQBVHArrayTree:: getTraversalCost() const
+{
+	if ( nodes == NULL )
+		return Real(0);
+	
+	// Compute the bounding box of the whole tree from the root's children.
+	AABB3 rootVolume;
+	Bool foundChild = false;
+	
+	for ( Index i = 0; i < 4; i++ )
+	{
+		if ( nodes->isEmpty(i) )
+			continue;
+		
+		if ( foundChild )
+			rootVolume += nodes->getVolume(i);
+		else
+		{
+			rootVolume = nodes->getVolume(i);
+			foundChild = true;
+		}
+	}
+	
+	Real rootSurfaceArea = getAABBSurfaceArea( rootVolume );
+	
+	if ( rootSurfaceArea <= Real(0) )
+		return Real(0);
+	
+	return getChildSurfaceAreaSum( nodes ) / rootSurfaceArea;
+}
+
+
+
+
+Real ObjectQBVHArrayTree:: getChildSurfaceAreaSum( const NodeType* node )
+{
+	Real sum = Real(0);
+	
+	for ( Index i = 0; i < 4; i++ )
+	{
+		if ( node->isEmpty(i) )
+			continue;
+		
+		sum += getAABBSurfaceArea( node->getVolume(i) );
+		
+		if ( !node->isLeaf(i) )
+			sum += getChildSurfaceAreaSum( node->getChild(i) );
+	}
+	
+	return sum;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Tree Construction Start Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void ObjectQBVHArrayTree:: buildTree( const ArrayList<SoundObject*>& newObjects )
+{
+	// Destroy the previous tree if there was one.
+	destroyTree();
+	
+	const Size newNumObjects = newObjects.getSize();
+	
+	//**************************************************************************************
+	
+	// Allocate an array to hold the list of ObjectAABB objects.
+	ObjectAABB* objectAABBs = util::allocate<ObjectAABB>( newNumObjects );
+	
+	for ( Index i = 0; i < newNumObjects; i++ )
+		new (objectAABBs + i) ObjectAABB( newObjects[i] );
+	
+	//**************************************************************************************
+	
+	// Every inner node has at least 2 children, so there are at most N - 1 inner nodes.
+	// A tree with a single object still needs a root node.
+	Size maxNumNodes = newNumObjects > 1 ? newNumObjects - 1 : 1;
+	
+	// Allocate space for the nodes in this tree.
+	nodes = util::allocateAligned<NodeType>( maxNumNodes, sizeof(NodeType) );
+	
+	// Build the tree, starting with the root node.
+	numNodes = buildTreeRecursive( nodes, objectAABBs, 0, newNumObjects );
+	
+	//**************************************************************************************
+	
+	// Copy the final order of the objects into the tree's list of objects.
+	numObjects = newNumObjects;
+	objects = util::allocate<SoundObject*>( numObjects );
+	
+	for ( Index i = 0; i < numObjects; i++ )
+		objects[i] = objectAABBs[i].object;
+	
+	util::deallocate( objectAABBs );
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Recursive Tree Construction Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Size ObjectQBVHArrayTree:: buildTreeRecursive( NodeType* node, ObjectAABB* objectAABBs,
+												Index start, Size numObjects )
+{
+	// The number of objects in each child node (leaf or not).
+	StaticArray<Size,4> numChildObjects;
+	
+	ObjectAABB* const objectAABBStart = objectAABBs + start;
+	
+	//***************************************************************************
+	// Partition the objects into 4 sets with two levels of binary splits.
+	
+	if ( numObjects <= 4 )
+	{
+		// Each object gets its own leaf.
+		for ( Index i = 0; i < 4; i++ )
+			numChildObjects[i] = i < numObjects ? 1 : 0;
+	}
+	else
+	{
+		Size numLesserObjects;
+		partitionObjectsSAH( objectAABBStart, numObjects, numLesserObjects );
+		
+		Size numGreaterObjects = numObjects - numLesserObjects;
+		
+		if ( numLesserObjects > 1 )
+			partitionObjectsSAH( objectAABBStart, numLesserObjects, numChildObjects[0] );
+		else
+			numChildObjects[0] = numLesserObjects;
+		
+		if ( numGreaterObjects > 1 )
+			partitionObjectsSAH( objectAABBStart + numLesserObjects, numGreaterObjects, numChildObjects[2] );
+		else
+			numChildObjects[2] = numGreaterObjects;
+		
+		numChildObjects[1] = numLesserObjects - numChildObjects[0];
+		numChildObjects[3] = numGreaterObjects - numChildObjects[2];
+	}
+	
+	//***************************************************************************
+	// Determine the type and attributes for each child.
+	
+	StaticArray<AABB3,4> volumes;
+	StaticArray<Index,4> indices;
+	StaticArray<Bool,4> isALeaf( false );
+	StaticArray<Bool,4> isEmpty( false );
+	
+	// Keep track of the total number of nodes in the subtree.
+	Size numTreeNodes = 1;
+	Index objectStartIndex = start;
+	
+	for ( Index i = 0; i < 4; i++ )
+	{
+		if ( numChildObjects[i] == 0 )
+		{
+			// Give empty children an inverted box that no ray can intersect.
+			isALeaf[i] = true;
+			isEmpty[i] = true;
+			indices[i] = 0;
+			volumes[i] = AABB3( math::max<Real>(), math::min<Real>(),
+								math::max<Real>(), math::min<Real>(),
+								math::max<Real>(), math::min<Real>() );
+		}
+		else if ( numChildObjects[i] == 1 )
+		{
+			// This child is a leaf node that refers to a single object.
+			isALeaf[i] = true;
+			indices[i] = objectStartIndex;
+			volumes[i] = objectAABBs[objectStartIndex].volume;
+		}
+		else
+		{
+			// This child is an inner node, construct it recursively.
+			Size numChildNodes = buildTreeRecursive( node + numTreeNodes, objectAABBs,
+													objectStartIndex, numChildObjects[i] );
+			
+			// The relative index of this child from the parent node.
+			indices[i] = numTreeNodes;
+			volumes[i] = computeObjectAABB( objectAABBs + objectStartIndex, numChildObjects[i] );
+			
+			numTreeNodes += numChildNodes;
+		}
+		
+		objectStartIndex += numChildObjects[i];
+	}
+	
+	//***************************************************************************
+	// Create the node.
+	
+	new (node) NodeType( volumes, indices, isALeaf, isEmpty );
+	
+	// Return the number of nodes in this subtree.
+	return numTreeNodes;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Object Partition Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void ObjectQBVHArrayTree:: partitionObjectsSAH( ObjectAABB* objectAABBs, Size numObjects,
+												Size& numLesserObjects )
+{
+	// We use the centroids as the 'keys' in splitting objects.
+	const AABB3 centroidAABB = computeCentroidAABB( objectAABBs, numObjects );
+	const Vector3 aabbDimension = centroidAABB.max - centroidAABB.min;
+	
+	//**************************************************************************************
+	// Find the bin boundary with the smallest SAH cost along any axis.
+	
+	const Real binningConstant1 = Real(NUM_SPLIT_BINS)*(Real(1) - Real(0.00001));
+	Real minSplitCost = math::max<Real>();
+	Index splitAxis = 0;
+	Index splitBin = 0;
+	numLesserObjects = 0;
+	
+	SplitBin splitBins[NUM_SPLIT_BINS];
+	Real greaterSurfaceAreas[NUM_SPLIT_BINS];
+	Size numGreaterObjects[NUM_SPLIT_BINS];
+	
+	for ( Index axis = 0; axis < 3; axis++ )
+	{
+		// If all centroids are at the same coordinate along this axis, it can't be split.
+		if ( aabbDimension[axis] <= Real(0) )
+			continue;
+		
+		const Real binningConstant = binningConstant1 / aabbDimension[axis];
+		const Real binsStart = centroidAABB.min[axis];
+		
+		// Initialize the split bins to their starting values.
+		for ( Index i = 0; i < NUM_SPLIT_BINS; i++ )
+			new (splitBins + i) SplitBin();
+		
+		// For each object, determine which bin its centroid is in and add it to that bin.
+		for ( Index i = 0; i < numObjects; i++ )
+		{
+			const ObjectAABB& o = objectAABBs[i];
+			SplitBin& bin = splitBins[(Index)(binningConstant*(o.centroid[axis] - binsStart))];
+			
+			bin.numObjects++;
+			bin.volume += o.volume;
+		}
+		
+		// Sweep from the greater side to compute the cost of the objects above each split.
+		{
+			AABB3 greaterVolume = splitBins[NUM_SPLIT_BINS - 1].volume;
+			Size numGreater = splitBins[NUM_SPLIT_BINS - 1].numObjects;
+			
+			for ( Index i = NUM_SPLIT_BINS - 1; i > 0; i-- )
+			{
+				greaterSurfaceAreas[i] = getAABBSurfaceArea( greaterVolume );
+				numGreaterObjects[i] = numGreater;
+				
+				greaterVolume += splitBins[i - 1].volume;
+				numGreater += splitBins[i - 1].numObjects;
+			}
+		}
+		
+		// Sweep from the lesser side, evaluating the split after each bin.
+		AABB3 lesserVolume = splitBins[0].volume;
+		Size numLesser = 0;
+		
+		for ( Index i = 0; i < NUM_SPLIT_BINS - 1; i++ )
+		{
+			lesserVolume += splitBins[i].volume;
+			numLesser += splitBins[i].numObjects;
+			
+			if ( numLesser == 0 || numGreaterObjects[i + 1] == 0 )
+				continue;
+			
+			Real splitCost = Real(numLesser)*getAABBSurfaceArea( lesserVolume ) +
+							Real(numGreaterObjects[i + 1])*greaterSurfaceAreas[i + 1];
+			
+			if ( splitCost < minSplitCost )
+			{
+				minSplitCost = splitCost;
+				splitAxis = axis;
+				splitBin = i;
+				numLesserObjects = numLesser;
+			}
+		}
+	}
+	
+	//**************************************************************************************
+	
+	// If no split separated the objects, use a median split which is guaranteed to split them.
+	if ( numLesserObjects == 0 )
+	{
+		// Choose to split along the axis with the largest extent.
+		Index medianAxis = aabbDimension[0] > aabbDimension[1] ? 
+							aabbDimension[0] > aabbDimension[2] ? 0 : 2 :
+							aabbDimension[1] > aabbDimension[2] ? 1 : 2;
+		
+		partitionObjectsMedian( objectAABBs, numObjects, medianAxis, numLesserObjects );
+		return;
+	}
+	
+	//**************************************************************************************
+	// Partition the objects into two sets using the same binning as the split evaluation.
+	
+	const Real binningConstant = binningConstant1 / aabbDimension[splitAxis];
+	const Real binsStart = centroidAABB.min[splitAxis];
+	
+	Index left = 0;
+	Index right = numObjects;
+	
+	while ( left < right )
+	{
+		if ( (Index)(binningConstant*(objectAABBs[left].centroid[splitAxis] - binsStart)) <= splitBin )
+			left++;
+		else
+		{
+			// Swap the objects because they are out of order.
+			right--;
+			const ObjectAABB temp = objectAABBs[left];
+			objectAABBs[left] = objectAABBs[right];
+			objectAABBs[right] = temp;
+		}
+	}
+	
+	numLesserObjects = left;
+}
+
+
+
+
+void ObjectQBVHArrayTree:: partitionObjectsMedian( ObjectAABB* objectAABBs, Size numObjects,
+													Index splitAxis, Size& numLesserObjects )
+{
+	// Select the median object so that the first half of the objects have smaller centroids.
+	const Index middle = numObjects / 2;
+	Index first = 0;
+	Index last = numObjects - 1;
+	
+	while ( first < last )
+	{
+		const Real pivot = objectAABBs[last].centroid[splitAxis];
+		Index mid = first;
+		
+		for ( Index j = first; j < last; j++ )
+		{
+			if ( objectAABBs[j].centroid[splitAxis] < pivot )
+			{
+				const ObjectAABB temp = objectAABBs[mid];
+				objectAABBs[mid] = objectAABBs[j];
+				objectAABBs[j] = temp;
+				mid++;
+			}
+		}
+		
+		// Move the pivot to its final position.
+		const ObjectAABB temp = objectAABBs[mid];
+		objectAABBs[mid] = objectAABBs[last];
+		objectAABBs[last] = temp;
+		
+		if ( mid == middle )
+			break;
+		else if ( mid < middle )
+			first = mid + 1;
+		else
+			last = mid - 1;
+	}
+	
+	numLesserObjects = middle;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Bounding Box Computation Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+AABB3 ObjectQBVHArrayTree:: computeObjectAABB( const ObjectAABB* objectAABBs, Size numObjects )
+{
+	AABB3 result = objectAABBs[0].volume;
+	
+	for ( Index i = 1; i < numObjects; i++ )
+	{
+		result += objectAABBs[i].volume;
+	}
+	
+	return result;
+}
+
+
+
+
+AABB3 ObjectQBVHArrayTree:: computeCentroidAABB( const ObjectAABB* objectAABBs, Size numObjects )
+{
+	AABB3 result( objectAABBs[0].centroid, objectAABBs[0].centroid );
+	
+	for ( Index i = 1; i < numObjects; i++ )
+	{
+		result += objectAABBs[i].centroid;
+	}
+	
+	return result;
+}
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
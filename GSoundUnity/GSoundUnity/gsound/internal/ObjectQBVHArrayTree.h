@@ -0,0 +1,402 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/ObjectQBVHArrayTree.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::ObjectQBVHArrayTree class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+
+#ifndef INCLUDE_GSOUND_OBJECT_QBVH_ARRAY_TREE_H
+#define INCLUDE_GSOUND_OBJECT_QBVH_ARRAY_TREE_H
+
+
+#include "GSoundInternalConfig.h"
+
+
+#include "../SoundObject.h"
+#include "ObjectQBVHArrayTreeNode.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+/// A 4-wide bounding volume hierarchy of axis-aligned boxes that contains the objects in a scene.
+/**
+  * The tree is built top-down using the surface area heuristic on the world-space
+  * bounding boxes of the objects. Each leaf refers to a single object, so that the
+  * per-object transformations can be applied when a ray reaches the object's triangle BVH.
+  * The nodes are stored in a single contiguous array so that the tree can be traversed
+  * with the same SIMD ray-box test that is used for the triangle QBVH.
+  */
+class ObjectQBVHArrayTree
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Public Type Definitions
+			
+			
+			
+			
+			/// Define the type of node used in this tree.
+			typedef ObjectQBVHArrayTreeNode NodeType;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructors
+			
+			
+			
+			
+			/// Create an ObjectQBVHArrayTree for the specified list of objects.
+			ObjectQBVHArrayTree( const ArrayList<SoundObject*>& objects );
+			
+			
+			
+			
+			/// Create an ObjectQBVHArrayTree that is an exact copy of another tree.
+			ObjectQBVHArrayTree( const ObjectQBVHArrayTree& other );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Destructor
+			
+			
+			
+			
+			~ObjectQBVHArrayTree();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Assignment Operator
+			
+			
+			
+			
+			ObjectQBVHArrayTree& operator = ( const ObjectQBVHArrayTree& other );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Accessor Methods
+			
+			
+			
+			
+			/// Get the root node of this tree.
+			GSOUND_FORCE_INLINE const NodeType* getRoot() const
+			{
+				return nodes;
+			}
+			
+			
+			
+			
+			/// Get a pointer to the list of objects that the leaves of this tree refer to.
+			/**
+			  * A leaf child of a node refers to the object in this list at the index
+			  * returned by NodeType::getObjectIndex().
+			  */
+			GSOUND_FORCE_INLINE SoundObject* const* getObjects() const
+			{
+				return objects;
+			}
+			
+			
+			
+			
+			/// Get the number of objects in this tree.
+			GSOUND_FORCE_INLINE Size getNumberOfObjects() const
+			{
+				return numObjects;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Tree Update Method
+			
+			
+			
+			
+			/// Update the bounding volumes of this BVH so that they are consistent with new object sizes/positions.
+			/**
+			  * This method does not change the internal structure of the tree and thus
+			  * will not provide an optimally-split BVH. However, it is much faster to call
+			  * this method than to rebuild the entire BVH.
+			  * 
+			  * @return whether or not any bounding volume in the tree was changed.
+			  */
+			Bool update();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Tree Quality Accessor Method
+			
+			
+			
+			
+			/// Get the expected number of node tests performed by a ray which intersects the root of this tree.
+			/**
+			  * This cost is the sum of the surface areas of all boxes below the root, divided
+			  * by the surface area of the root's bounding box. Refitting the tree after objects have
+			  * moved generally increases this value, so it can be compared with the cost of the
+			  * tree when it was built in order to decide when a full rebuild is worthwhile.
+			  */
+			Real getTraversalCost() const;
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Class Declarations
+			
+			
+			
+			
+			/// A class which stores the bounding box and centroid of an object during tree construction.
+			class ObjectAABB;
+			
+			
+			
+			
+			/// A class which accumulates the objects whose centroids fall in one SAH split bin.
+			class SplitBin;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Tree Construction Methods
+			
+			
+			
+			
+			/// Build a tree for the specified list of objects, replacing the current tree.
+			void buildTree( const ArrayList<SoundObject*>& newObjects );
+			
+			
+			
+			
+			/// Build the subtree for the specified objects at the given node and return the number of nodes used.
+			static Size buildTreeRecursive( NodeType* node, ObjectAABB* objectAABBs,
+											Index start, Size numObjects );
+			
+			
+			
+			
+			/// Partition the specified objects into two sets using the surface area heuristic.
+			static void partitionObjectsSAH( ObjectAABB* objectAABBs, Size numObjects,
+											Size& numLesserObjects );
+			
+			
+			
+			
+			/// Partition the specified objects into two equal-size sets along the specified axis.
+			static void partitionObjectsMedian( ObjectAABB* objectAABBs, Size numObjects,
+												Index splitAxis, Size& numLesserObjects );
+			
+			
+			
+			
+			/// Compute the bounding box of the specified objects.
+			static AABB3 computeObjectAABB( const ObjectAABB* objectAABBs, Size numObjects );
+			
+			
+			
+			
+			/// Compute the bounding box of the centroids of the specified objects.
+			static AABB3 computeCentroidAABB( const ObjectAABB* objectAABBs, Size numObjects );
+			
+			
+			
+			
+			/// Return the surface area of the specified bounding box.
+			GSOUND_FORCE_INLINE static Real getAABBSurfaceArea( const AABB3& box )
+			{
+				const Vector3 aabbDimension = box.max - box.min;
+				
+				return Real(2)*(aabbDimension.x*aabbDimension.y +
+								aabbDimension.x*aabbDimension.z +
+								aabbDimension.y*aabbDimension.z);
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Tree Update Helper Methods
+			
+			
+			
+			
+			/// Refit the subtree at the specified node and return whether or not any of its volumes changed.
+			/**
+			  * The bounding box of the whole subtree is placed in the output volume parameter.
+			  */
+			Bool refitNode( NodeType* node, AABB3& volume );
+			
+			
+			
+			
+			/// Return the sum of the surface areas of all of the child boxes in the subtree at the specified node.
+			static Real getChildSurfaceAreaSum( const NodeType* node );
+			
+			
+			
+			
+			/// Deallocate the nodes and objects of this tree.
+			void destroyTree();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// A contiguous array of the nodes of this tree, the first of which is the root.
+			NodeType* nodes;
+			
+			
+			
+			
+			/// The number of nodes in this tree.
+			Size numNodes;
+			
+			
+			
+			
+			/// The objects in this tree, in the order that they are referenced by the leaves.
+			SoundObject** objects;
+			
+			
+			
+			
+			/// The number of objects in this tree.
+			Size numObjects;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Data Members
+			
+			
+			
+			
+			/// The number of bins used to evaluate SAH split candidates along each axis.
+			static const Size NUM_SPLIT_BINS = 16;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_OBJECT_QBVH_ARRAY_TREE_H
@@ -0,0 +1,316 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/ObjectQBVHArrayTreeNode.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::ObjectQBVHArrayTreeNode class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+
+#ifndef INCLUDE_GSOUND_OBJECT_QBVH_ARRAY_TREE_NODE_H
+#define INCLUDE_GSOUND_OBJECT_QBVH_ARRAY_TREE_NODE_H
+
+
+#include "GSoundInternalConfig.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+/// A node of a 4-wide bounding volume hierarchy of sound objects.
+/**
+  * Each node stores the axis-aligned bounding boxes of its 4 children so that
+  * a ray can be tested against all of them at once. A child is either an inner
+  * node, a leaf which refers to a single object, or empty.
+  */
+class GSOUND_ALIGN(128) ObjectQBVHArrayTreeNode
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Public Type Definitions
+			
+			
+			
+			
+			/// Define the type of data structure to use for SIMD axis-aligned bounding boxes.
+			typedef math::SIMDAABB3D<Float,4> SIMDAABB3;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Children Accessor Method
+			
+			
+			
+			
+			/// Get the child of this node with the specified index.
+			GSOUND_FORCE_INLINE const ObjectQBVHArrayTreeNode* getChild( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < 4, "Cannot get ObjectQBVHArrayTreeNode child with invalid index." );
+				return this + indices[child];
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Node Attribute Accessor Methods
+			
+			
+			
+			
+			/// Return whether or not the specified child is a leaf node.
+			GSOUND_FORCE_INLINE Bool isLeaf( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < 4, "Cannot get ObjectQBVHArrayTreeNode leaf status with invalid index." );
+				
+				return (flags[child] & LEAF_NODE_FLAG) != 0;
+			}
+			
+			
+			
+			
+			/// Return whether or not the specified child is an empty node.
+			GSOUND_FORCE_INLINE Bool isEmpty( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < 4, "Cannot get ObjectQBVHArrayTreeNode empty status with invalid index." );
+				
+				return (flags[child] & EMPTY_NODE_FLAG) != 0;
+			}
+			
+			
+			
+			
+			/// Get the index within the tree's object list of the object for the specified leaf child.
+			GSOUND_FORCE_INLINE UInt32 getObjectIndex( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < 4, "Cannot get ObjectQBVHArrayTreeNode object index with invalid child index." );
+				
+				return indices[child];
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Volume Accessor Methods
+			
+			
+			
+			
+			/// Get the set of SIMD axis-aligned bounding boxes for this quad node.
+			GSOUND_FORCE_INLINE const SIMDAABB3& getVolumes() const
+			{
+				return volumes;
+			}
+			
+			
+			
+			
+			/// Get the axis-aligned bounding box of the child with the specified index.
+			GSOUND_FORCE_INLINE AABB3 getVolume( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < 4, "Cannot get ObjectQBVHArrayTreeNode child volume with invalid index." );
+				
+				return AABB3( volumes.min.x[child], volumes.max.x[child],
+							volumes.min.y[child], volumes.max.y[child],
+							volumes.min.z[child], volumes.max.z[child] );
+			}
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Constructor
+			
+			
+			
+			
+			/// Create a node with the specified child volumes, indices and child types.
+			/**
+			  * The index of an inner child is its offset in the node array from this node,
+			  * while the index of a leaf child is the index of its object in the tree's list of objects.
+			  */
+			GSOUND_INLINE ObjectQBVHArrayTreeNode( const StaticArray<AABB3,4>& newVolumes, const StaticArray<Index,4>& newIndices,
+													const StaticArray<Bool,4>& isALeaf, const StaticArray<Bool,4>& isEmpty )
+				:	volumes( newVolumes[0], newVolumes[1], newVolumes[2], newVolumes[3] )
+			{
+				for ( Index i = 0; i < 4; i++ )
+				{
+					indices[i] = (UInt32)newIndices[i];
+					flags[i] = isEmpty[i] ? (LEAF_NODE_FLAG | EMPTY_NODE_FLAG) : isALeaf[i] ? LEAF_NODE_FLAG : 0;
+				}
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Accessor Methods
+			
+			
+			
+			
+			/// Get the child of this node with the specified index.
+			GSOUND_FORCE_INLINE ObjectQBVHArrayTreeNode* getChild( Index child )
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < 4, "Cannot get ObjectQBVHArrayTreeNode child with invalid index." );
+				return this + indices[child];
+			}
+			
+			
+			
+			
+			/// Replace the bounding boxes of all 4 children of this node.
+			GSOUND_FORCE_INLINE void setVolumes( const StaticArray<AABB3,4>& newVolumes )
+			{
+				volumes = SIMDAABB3( newVolumes[0], newVolumes[1], newVolumes[2], newVolumes[3] );
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// A set of SIMD axis-aligned bounding boxes for this quad node.
+			SIMDAABB3 volumes;
+			
+			
+			
+			
+			/// The relative offset of each inner child, or the object index of each leaf child.
+			UInt32 indices[4];
+			
+			
+			
+			
+			/// Flags which indicate whether each child is a leaf or empty.
+			UInt8 flags[4];
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Data Members
+			
+			
+			
+			
+			static const UInt8 LEAF_NODE_FLAG = 0x80;
+			
+			
+			
+			
+			static const UInt8 EMPTY_NODE_FLAG = 0x40;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Friend Declaration
+			
+			
+			
+			
+			/// Declare the ObjectQBVHArrayTree class as a friend so that it can build and refit nodes.
+			friend class ObjectQBVHArrayTree;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_OBJECT_QBVH_ARRAY_TREE_NODE_H
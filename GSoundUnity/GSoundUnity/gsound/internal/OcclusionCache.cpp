@@ -1,11 +1,11 @@
 /*
  * Project:     GSound
  * 
- * File:        gsound/internal/SphereTree.cpp
+ * File:        gsound/internal/OcclusionCache.cpp
  * 
  * Version:     1.0.0
  * 
- * Contents:    gsound::internal::SphereTree class implementation
+ * Contents:    gsound::internal::OcclusionCache class implementation
  * 
  * License:
  * 
@@ -58,7 +58,7 @@
  */
 
 
-#include "SphereTree.h"
+#include "OcclusionCache.h"
 
 
 //##########################################################################################
@@ -73,7 +73,7 @@ GSOUND_INTERNAL_NAMESPACE_START
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Destructor
+//############		Constructors
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -81,54 +81,52 @@ GSOUND_INTERNAL_NAMESPACE_START
 
 
 
-SphereTree:: ~SphereTree()
+OcclusionCache:: OcclusionCache()
+	:	capacity( DEFAULT_CAPACITY ),
+		generation( 1 )
 {
-	if ( left != NULL )
-		util::destruct(left);
+	entries = util::allocate<Entry>( capacity );
+	
+	for ( Index i = 0; i < capacity; i++ )
+		entries[i].generation = 0;
 	
-	if ( right != NULL )
-		util::destruct(right);
+#if GSOUND_PROPAGATION_STATISTICS
+	resetStatistics();
+#endif
 }
 
 
 
 
-//##########################################################################################
-//##########################################################################################
-//############		
-//############		Tree Update Method
-//############		
-//##########################################################################################
-//##########################################################################################
+OcclusionCache:: OcclusionCache( Size newCapacity )
+	:	capacity( 1 ),
+		generation( 1 )
+{
+	while ( capacity < newCapacity )
+		capacity *= 2;
+	
+	entries = util::allocate<Entry>( capacity );
+	
+	for ( Index i = 0; i < capacity; i++ )
+		entries[i].generation = 0;
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	resetStatistics();
+#endif
+}
 
 
 
 
-void SphereTree:: update()
+OcclusionCache:: OcclusionCache( const OcclusionCache& other )
+	:	entries( util::copyArray( other.entries, other.capacity ) ),
+		capacity( other.capacity ),
+		generation( other.generation )
 {
-	if ( left != NULL )
-	{
-		left->update();
-		
-		if ( right != NULL )
-		{
-			right->update();
-			
-			boundingVolume = left->boundingVolume + right->boundingVolume;
-		}
-		else
-			boundingVolume = left->boundingVolume;
-	}
-	else if ( right != NULL )
-	{
-		right->update();
-		
-		boundingVolume = right->boundingVolume;
-	}
-	else
-	{
-		boundingVolume = object->getBoundingSphere();
-	}
+#if GSOUND_PROPAGATION_STATISTICS
+	numHits = other.numHits;
+	numMisses = other.numMisses;
+#endif
 }
 
 
@@ -137,7 +135,7 @@ void SphereTree:: update()
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Tree Generation Method
+//############		Destructor
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -145,9 +143,9 @@ void SphereTree:: update()
 
 
 
-void SphereTree:: generateTree( ArrayList<SoundObject*>& objects )
+OcclusionCache:: ~OcclusionCache()
 {
-	generateNode( objects, 0, objects.getSize() - 1, 0 );
+	util::deallocate( entries );
 }
 
 
@@ -156,7 +154,7 @@ void SphereTree:: generateTree( ArrayList<SoundObject*>& objects )
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Node Generation Method
+//############		Assignment Operator
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -164,48 +162,23 @@ void SphereTree:: generateTree( ArrayList<SoundObject*>& objects )
 
 
 
-void SphereTree:: generateNode( ArrayList<SoundObject*>& objects,
-								Index start, Index end, Index splitAxis )
+OcclusionCache& OcclusionCache:: operator = ( const OcclusionCache& other )
 {
-	Size numberOfObjects = end - start + 1;
-	
-	if ( numberOfObjects == 1 )
+	if ( this != &other )
 	{
-		// This node encapsulates a single object.
-		object = objects[start];
-		left = NULL;
-		right = NULL;
-		boundingVolume = object->getBoundingSphere();
+		util::deallocate( entries );
 		
-		return;
-	}
-	else if ( numberOfObjects == 2 )
-	{
-		object = NULL;
+		entries = util::copyArray( other.entries, other.capacity );
+		capacity = other.capacity;
+		generation = other.generation;
 		
-		left = util::allocate<SphereTree>();
-		new (left) SphereTree( objects[start], objects[start]->getBoundingSphere() );
-		
-		right = util::allocate<SphereTree>();
-		new (right) SphereTree( objects[end], objects[end]->getBoundingSphere() );
-	}
-	else
-	{
-		object = NULL;
-		
-		left = util::allocate<SphereTree>();
-		new (left) SphereTree();
-		
-		right = util::allocate<SphereTree>();
-		new (right) SphereTree();
-		
-		medianPointSplit( objects, start, end, splitAxis );
-		Index medianIndex = (start + end)/2;
-		left->generateNode( objects, start, medianIndex, (splitAxis + 1) % 3 );
-		right->generateNode( objects, medianIndex + 1, end, (splitAxis + 1) % 3 );
+#if GSOUND_PROPAGATION_STATISTICS
+		numHits = other.numHits;
+		numMisses = other.numMisses;
+#endif
 	}
 	
-	boundingVolume = left->boundingVolume + right->boundingVolume;
+	return *this;
 }
 
 
@@ -214,7 +187,7 @@ void SphereTree:: generateNode( ArrayList<SoundObject*>& objects,
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Median Point Split Method
+//############		Cache Manipulation Method
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -222,48 +195,23 @@ void SphereTree:: generateNode( ArrayList<SoundObject*>& objects,
 
 
 
-void SphereTree:: medianPointSplit( ArrayList<SoundObject*>& objects,
-									Index start, Index end, Size dimension )
+void OcclusionCache:: clear()
 {
-	Index first = start;
-	Index last = end;
-	Index middle = (first + last)/2;
+	generation++;
 	
-	while ( 1 )
+	// If the generation wrapped around, entries from an old generation could appear valid, so reset them.
+	if ( generation == 0 )
 	{
-		Index mid = first;
-		Vector3 key = objects[mid]->getBoundingSphere().position;
+		for ( Index i = 0; i < capacity; i++ )
+			entries[i].generation = 0;
 		
-		for ( Index j = first + 1; j <= last; j ++)
-		{
-			if ( objects[j]->getBoundingSphere().position[dimension] > key[dimension] )
-			{
-				mid++;
-				
-				// interchange values.
-				SoundObject* temp = objects[mid];
-				objects[mid] = objects[j];
-				objects[j] = temp;
-			}
-		}
-		
-		// interchange the first and mid value.
-		SoundObject* temp = objects[mid];
-		objects[mid] = objects[first];
-		objects[first] = temp;
-		
-		if ( mid + 1 == middle )
-			return;
-		
-		if ( mid + 1 > middle )
-			last = mid - 1;
-		else
-			first = mid + 1;
+		generation = 1;
 	}
 }
 
 
 
+
 //##########################################################################################
 //**************************  End GSound Internal Namespace  *******************************
 GSOUND_INTERNAL_NAMESPACE_END
@@ -0,0 +1,442 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/OcclusionCache.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::OcclusionCache class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_OCCLUSION_CACHE_H
+#define INCLUDE_GSOUND_OCCLUSION_CACHE_H
+
+
+#include "GSoundInternalConfig.h"
+
+
+#include "RayTracer.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+/// A class which remembers the results of recently traced binary occlusion rays.
+/**
+  * When several probe paths share geometry, such as paths which differ only by
+  * which of two coplanar triangles they hit, their validation traces exactly the
+  * same occlusion rays. The cache stores the result of each traced ray in a
+  * direct-mapped table indexed by a hash of the ray's origin, direction and
+  * maximum distance, so that a repeated ray is answered without being traced.
+  * 
+  * Rays are only considered the same if all of these values are exactly equal,
+  * so a cached result is always the same as the result of tracing the ray.
+  * Since the scene can change between frames, all results are discarded when the
+  * cache is cleared, which only increments a generation counter. A new result
+  * replaces whichever result was stored in its table entry, so the memory used
+  * by the cache is fixed.
+  */
+class OcclusionCache
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructors
+			
+			
+			
+			
+			/// Create an empty occlusion cache with the default capacity.
+			OcclusionCache();
+			
+			
+			
+			
+			/// Create an empty occlusion cache with the specified capacity, rounded up to a power of two.
+			OcclusionCache( Size newCapacity );
+			
+			
+			
+			
+			/// Create a copy of another occlusion cache.
+			OcclusionCache( const OcclusionCache& other );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Destructor
+			
+			
+			
+			
+			/// Destroy an occlusion cache object and deallocate all resources that it has allocated.
+			~OcclusionCache();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Assignment Operator
+			
+			
+			
+			
+			/// Copy the contents of one occlusion cache to this cache, replacing this cache's state.
+			OcclusionCache& operator = ( const OcclusionCache& other );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Occlusion Ray Tracing Method
+			
+			
+			
+			
+			/// Return whether or not the ray hits anything before the maximum distance.
+			/**
+			  * If the same ray has been traced since the cache was last cleared and its
+			  * result is still in the cache, that result is returned. Otherwise, the ray
+			  * is traced with the specified ray tracer and the result is stored in the cache.
+			  * 
+			  * @param tracer - the ray tracer which traces the ray if its result is not cached.
+			  * @param ray - the ray to test for occlusion.
+			  * @param maxDistance - the distance along the ray beyond which intersections are ignored.
+			  * @return whether or not the ray is occluded.
+			  */
+			GSOUND_INLINE Bool traceBinaryOcclusionRay( RayTracer& tracer, const Ray3& ray, Real maxDistance );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Cache Manipulation Method
+			
+			
+			
+			
+			/// Discard all of the occlusion results that are stored in the cache.
+			/**
+			  * This should be called whenever the scene may have changed, such as at
+			  * the start of each frame.
+			  */
+			void clear();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Capacity Accessor Method
+			
+			
+			
+			
+			/// Return the number of occlusion results that the cache can store.
+			GSOUND_INLINE Size getCapacity() const
+			{
+				return capacity;
+			}
+			
+			
+			
+			
+#if GSOUND_PROPAGATION_STATISTICS
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Statistics Accessor Methods
+			
+			
+			
+			
+			/// Return the number of occlusion rays that were answered from the cache since the statistics were last reset.
+			GSOUND_INLINE Size getNumberOfHits() const
+			{
+				return numHits;
+			}
+			
+			
+			
+			
+			/// Return the number of occlusion rays that had to be traced since the statistics were last reset.
+			GSOUND_INLINE Size getNumberOfMisses() const
+			{
+				return numMisses;
+			}
+			
+			
+			
+			
+			/// Reset the number of cache hits and misses to zero.
+			GSOUND_INLINE void resetStatistics()
+			{
+				numHits = 0;
+				numMisses = 0;
+			}
+			
+			
+			
+			
+#endif
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Entry Class Declaration
+			
+			
+			
+			
+			/// A class which stores the occlusion result for one ray.
+			class Entry
+			{
+				public:
+					
+					/// The origin of the ray.
+					Vector3 origin;
+					
+					/// The direction of the ray.
+					Vector3 direction;
+					
+					/// The distance along the ray beyond which intersections were ignored.
+					Real maxDistance;
+					
+					/// The generation of the cache in which the result was stored.
+					Index generation;
+					
+					/// Whether or not the ray was occluded.
+					Bool occluded;
+			};
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Helper Methods
+			
+			
+			
+			
+			/// Return a hash code for a ray and its maximum distance, computed from the bits of their values.
+			GSOUND_FORCE_INLINE static Hash getRayHash( const Ray3& ray, Real maxDistance )
+			{
+				Hash hashCode = getRealHash( ray.origin.x );
+				hashCode = hashCode*Hash(0x8DA6B343) ^ getRealHash( ray.origin.y );
+				hashCode = hashCode*Hash(0x8DA6B343) ^ getRealHash( ray.origin.z );
+				hashCode = hashCode*Hash(0x8DA6B343) ^ getRealHash( ray.direction.x );
+				hashCode = hashCode*Hash(0x8DA6B343) ^ getRealHash( ray.direction.y );
+				hashCode = hashCode*Hash(0x8DA6B343) ^ getRealHash( ray.direction.z );
+				hashCode = hashCode*Hash(0x8DA6B343) ^ getRealHash( maxDistance );
+				
+				// Mix the bits so that the low bits, which index the table, depend on all of the values.
+				hashCode ^= hashCode >> 16;
+				hashCode *= Hash(0x85EBCA6B);
+				hashCode ^= hashCode >> 13;
+				hashCode *= Hash(0xC2B2AE35);
+				hashCode ^= hashCode >> 16;
+				
+				return hashCode;
+			}
+			
+			
+			
+			
+			/// Return a hash code for the bits of a real number.
+			GSOUND_FORCE_INLINE static Hash getRealHash( Real value )
+			{
+				UInt32 words[sizeof(Real)/sizeof(UInt32)];
+				std::memcpy( words, &value, sizeof(Real) );
+				
+				Hash hashCode = 0;
+				
+				for ( Index i = 0; i < sizeof(Real)/sizeof(UInt32); i++ )
+					hashCode ^= Hash(words[i]);
+				
+				return hashCode;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// A pointer to the table of cached occlusion results.
+			Entry* entries;
+			
+			
+			
+			
+			/// The number of entries in the table, which is always a power of two.
+			Size capacity;
+			
+			
+			
+			
+			/// The current generation of the cache. Only entries with this generation are valid.
+			Index generation;
+			
+			
+			
+			
+#if GSOUND_PROPAGATION_STATISTICS
+			/// The number of occlusion rays answered from the cache since the statistics were last reset.
+			Size numHits;
+			
+			
+			
+			
+			/// The number of occlusion rays traced since the statistics were last reset.
+			Size numMisses;
+			
+			
+			
+			
+#endif
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Data Members
+			
+			
+			
+			
+			/// The default number of occlusion results that the cache can store.
+			static const Size DEFAULT_CAPACITY = 16384;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Inline Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+GSOUND_INLINE Bool OcclusionCache:: traceBinaryOcclusionRay( RayTracer& tracer, const Ray3& ray, Real maxDistance )
+{
+	Entry& entry = entries[getRayHash( ray, maxDistance ) & (capacity - 1)];
+	
+	if ( entry.generation == generation && entry.maxDistance == maxDistance &&
+		entry.origin == ray.origin && entry.direction == ray.direction )
+	{
+#if GSOUND_PROPAGATION_STATISTICS
+		numHits++;
+#endif
+		return entry.occluded;
+	}
+	
+#if GSOUND_PROPAGATION_STATISTICS
+	numMisses++;
+#endif
+	
+	entry.origin = ray.origin;
+	entry.direction = ray.direction;
+	entry.maxDistance = maxDistance;
+	entry.generation = generation;
+	entry.occluded = tracer.traceBinaryOcclusionRay( ray, maxDistance );
+	
+	return entry.occluded;
+}
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_OCCLUSION_CACHE_H
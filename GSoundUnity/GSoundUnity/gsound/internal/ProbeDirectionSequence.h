@@ -0,0 +1,276 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/ProbeDirectionSequence.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::ProbeDirectionSequence class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_PROBE_DIRECTION_SEQUENCE_H
+#define INCLUDE_GSOUND_PROBE_DIRECTION_SEQUENCE_H
+
+
+#include "GSoundInternalConfig.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which generates evenly distributed probe ray directions from a low-discrepancy sequence.
+/**
+  * Points in the unit square are taken from the first two dimensions of the Sobol
+  * sequence. Every run of 2^k consecutive points starting at index 0 places exactly one
+  * point in each cell of any 2^k-cell grid of the unit square that is made of
+  * power-of-two intervals, so even a handful of rays covers an area more evenly
+  * than random samples.
+  *
+  * The sequence is shifted by a random offset modulo 1 (a Cranley-Patterson rotation),
+  * which should be chosen anew on each frame. This keeps the stratification of the
+  * points while letting successive frames probe different directions.
+  *
+  * Points are mapped to directions so that equal areas of the unit square map
+  * to equal solid angles of the sphere.
+  */
+class ProbeDirectionSequence
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			/// Create a probe direction sequence which is not rotated.
+			GSOUND_INLINE ProbeDirectionSequence()
+				:	rotationU( 0 ),
+					rotationV( 0 )
+			{
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Rotation Accessor Method
+			
+			
+			
+			
+			/// Set the offset that is added to each coordinate of every point in the sequence, modulo 1.
+			/**
+			  * The offsets are given as fractions of 2^32, so any 32-bit random number
+			  * is a valid offset.
+			  */
+			GSOUND_FORCE_INLINE void setRotation( UInt32 newRotationU, UInt32 newRotationV )
+			{
+				rotationU = newRotationU;
+				rotationV = newRotationV;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Sequence Point Accessor Methods
+			
+			
+			
+			
+			/// Return the point in [0,1)x[0,1) with the specified index in the rotated sequence.
+			GSOUND_FORCE_INLINE Vector2 getPoint( Index index ) const
+			{
+				// Adding the rotation to the fixed-point coordinates wraps around modulo 1.
+				return Vector2( toUnitInterval( reverseBits( UInt32(index) ) + rotationU ),
+								toUnitInterval( getSobolDimension2( UInt32(index) ) + rotationV ) );
+			}
+			
+			
+			
+			
+			/// Return the direction with the specified index that lies inside the given range of longitudes and heights.
+			/**
+			  * The longitudes are measured in radians around the Y axis and the heights
+			  * are Y coordinates in [-1,1]. Because a band of the sphere between two
+			  * heights has an area proportional to the difference in height, directions
+			  * that are uniform in longitude and height are uniform in solid angle.
+			  */
+			GSOUND_FORCE_INLINE Vector3 getDirection( Index index, const AABB1& longitudes, const AABB1& heights ) const
+			{
+				const Vector2 point = getPoint( index );
+				
+				const Real longitude = longitudes.min + point.x*(longitudes.max - longitudes.min);
+				const Real height = heights.min + point.y*(heights.max - heights.min);
+				const Real radius = math::sqrt( math::max( Real(1) - height*height, Real(0) ) );
+				
+				return Vector3( math::cos(longitude)*radius, height, math::sin(longitude)*radius );
+			}
+			
+			
+			
+			
+			/// Return the direction with the specified index on the whole sphere.
+			GSOUND_FORCE_INLINE Vector3 getDirection( Index index ) const
+			{
+				return getDirection( index, AABB1( Real(0), Real(2)*math::pi<Real>() ), AABB1( Real(-1), Real(1) ) );
+			}
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Helper Methods
+			
+			
+			
+			
+			/// Return the specified 32-bit number with the order of its bits reversed.
+			/**
+			  * This is the base-2 radical inverse of the number as a 32-bit fixed-point
+			  * fraction, which is the first dimension of the Sobol sequence.
+			  */
+			GSOUND_FORCE_INLINE static UInt32 reverseBits( UInt32 bits )
+			{
+				bits = (bits << 16) | (bits >> 16);
+				bits = ((bits & 0x00FF00FF) << 8) | ((bits & 0xFF00FF00) >> 8);
+				bits = ((bits & 0x0F0F0F0F) << 4) | ((bits & 0xF0F0F0F0) >> 4);
+				bits = ((bits & 0x33333333) << 2) | ((bits & 0xCCCCCCCC) >> 2);
+				bits = ((bits & 0x55555555) << 1) | ((bits & 0xAAAAAAAA) >> 1);
+				
+				return bits;
+			}
+			
+			
+			
+			
+			/// Return the second dimension of the Sobol sequence for the specified index as a 32-bit fixed-point fraction.
+			GSOUND_FORCE_INLINE static UInt32 getSobolDimension2( UInt32 index )
+			{
+				UInt32 result = 0;
+				
+				// The direction numbers of this dimension are the rows of Pascal's triangle modulo 2.
+				for ( UInt32 v = UInt32(1) << 31; index != 0; index >>= 1, v ^= v >> 1 )
+				{
+					if ( index & 1 )
+						result ^= v;
+				}
+				
+				return result;
+			}
+			
+			
+			
+			
+			/// Convert a 32-bit fixed-point fraction to a real number in [0,1).
+			GSOUND_FORCE_INLINE static Real toUnitInterval( UInt32 fraction )
+			{
+				// Only keep as many bits as a float can represent exactly so that the result is never rounded up to 1.
+				return Real(fraction >> 8)*Real(1.0/16777216.0);
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// The offset which is added to the first coordinate of every point, as a fraction of 2^32.
+			UInt32 rotationU;
+			
+			
+			
+			
+			/// The offset which is added to the second coordinate of every point, as a fraction of 2^32.
+			UInt32 rotationV;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_PROBE_DIRECTION_SEQUENCE_H
@@ -82,45 +82,60 @@ GSOUND_INTERNAL_NAMESPACE_START
 
 
 ProbePathCache:: ProbePathCache()
-	:	numBuckets( DEFAULT_NUMBER_OF_BUCKETS ),
-		numPaths( 0 ),
-		loadFactor( DEFAULT_LOAD_FACTOR ),
-		buckets( util::constructArray<Bucket>( DEFAULT_NUMBER_OF_BUCKETS, DEFAULT_BUCKET_SIZE ) )
+	:	numPaths( 0 ),
+		capacity( DEFAULT_CAPACITY ),
+		maxNumPaths( DEFAULT_MAX_NUMBER_OF_PATHS ),
+		numDeletedSlots( 0 ),
+		evictionIndex( 0 ),
+		resumeIndex( 0 ),
+		timeStamp( 0 ),
+		loadFactor( DEFAULT_LOAD_FACTOR )
 {
+	paths = util::allocate<ProbePath>( capacity );
+	pathSlots = util::allocate<Index>( capacity );
+	pathTimeStamps = util::allocate<Index>( capacity );
+	
+	numSlots = GROUP_SIZE;
+	
+	while ( Size(numSlots*loadFactor) < capacity )
+		numSlots *= 2;
+	
+	slotTags = util::constructArray<UByte>( numSlots, UByte(EMPTY_SLOT) );
+	slotPaths = util::allocate<Index>( numSlots );
 }
 
 
 
 
-ProbePathCache:: ProbePathCache( Hash newNumBuckets, Float newLoadFactor )
-	:	numBuckets( nextPrime( newNumBuckets ) ),
-		numPaths( 0 ),
-		loadFactor( math::max( newLoadFactor, Float(0.1) ) )
+ProbePathCache:: ProbePathCache( Size newMaxNumPaths, Float newLoadFactor )
+	:	numPaths( 0 ),
+		maxNumPaths( math::max( newMaxNumPaths, Size(1) ) ),
+		numDeletedSlots( 0 ),
+		evictionIndex( 0 ),
+		resumeIndex( 0 ),
+		timeStamp( 0 ),
+		loadFactor( math::clamp( newLoadFactor, Float(0.1), Float(0.9) ) )
 {
-	buckets = util::constructArray<Bucket>( numBuckets, DEFAULT_BUCKET_SIZE );
+	capacity = math::min( Size(DEFAULT_CAPACITY), maxNumPaths );
+	paths = util::allocate<ProbePath>( capacity );
+	pathSlots = util::allocate<Index>( capacity );
+	pathTimeStamps = util::allocate<Index>( capacity );
+	
+	numSlots = GROUP_SIZE;
+	
+	while ( Size(numSlots*loadFactor) < capacity )
+		numSlots *= 2;
+	
+	slotTags = util::constructArray<UByte>( numSlots, UByte(EMPTY_SLOT) );
+	slotPaths = util::allocate<Index>( numSlots );
 }
 
 
 
 
 ProbePathCache:: ProbePathCache( const ProbePathCache& other )
-	:	numBuckets( other.numBuckets ),
-		numPaths( other.numPaths ),
-		loadFactor( other.loadFactor ),
-		buckets( util::allocate<Bucket>( other.numBuckets ) )
 {
-	register Bucket* bucket = buckets;
-	register const Bucket* otherBucket = other.buckets;
-	register const Bucket* const otherBucketsEnd = other.buckets + other.numBuckets;
-	
-	while ( otherBucket != otherBucketsEnd )
-	{
-		// Copy each bucket.
-		new (bucket) Bucket( *otherBucket );
-		
-		otherBucket++;
-		bucket++;
-	}
+	copyCache( other );
 }
 
 
@@ -139,7 +154,7 @@ ProbePathCache:: ProbePathCache( const ProbePathCache& other )
 
 ProbePathCache:: ~ProbePathCache()
 {
-	util::destructArray( buckets, numBuckets );
+	destroyCache();
 }
 
 
@@ -160,29 +175,8 @@ ProbePathCache& ProbePathCache:: operator = ( const ProbePathCache& other )
 {
 	if ( this != &other )
 	{
-		// Destroy the old bucket array.
-		util::destructArray( buckets, numBuckets );
-		
-		// Initialize the state for this cache from the other bucket.
-		numBuckets = other.numBuckets;
-		numPaths = other.numPaths;
-		loadFactor = other.loadFactor;
-		buckets = util::allocate<Bucket>( other.numBuckets );
-		
-		
-		// Copy the buckets from the other cache.
-		register Bucket* bucket = buckets;
-		register const Bucket* otherBucket = other.buckets;
-		register const Bucket* const otherBucketsEnd = other.buckets + other.numBuckets;
-		
-		while ( otherBucket != otherBucketsEnd )
-		{
-			// Copy each bucket.
-			new (bucket) Bucket( *otherBucket );
-			
-			otherBucket++;
-			bucket++;
-		}
+		destroyCache();
+		copyCache( other );
 	}
 	
 	return *this;
@@ -191,7 +185,6 @@ ProbePathCache& ProbePathCache:: operator = ( const ProbePathCache& other )
 
 
 
-
 //##########################################################################################
 //##########################################################################################
 //############		
@@ -205,78 +198,83 @@ ProbePathCache& ProbePathCache:: operator = ( const ProbePathCache& other )
 
 void ProbePathCache:: clear()
 {
-	register Bucket* bucket = buckets;
-	register const Bucket* const bucketsEnd = buckets + numBuckets;
+	for ( Index i = 0; i < numPaths; i++ )
+		paths[i].~ProbePath();
 	
-	while ( bucket != bucketsEnd )
-	{
-		bucket->clear();
-		bucket++;
-	}
+	for ( Index i = 0; i < numSlots; i++ )
+		slotTags[i] = EMPTY_SLOT;
 	
 	numPaths = 0;
+	numDeletedSlots = 0;
+	evictionIndex = 0;
+	resumeIndex = 0;
 }
 
 
 
 
-//##########################################################################################
-//##########################################################################################
-//############		
-//############		Load Factor Check Method
-//############		
-//##########################################################################################
-//##########################################################################################
+void ProbePathCache:: removePathAtIndex( Index pathIndex )
+{
+	const Index slot = pathSlots[pathIndex];
+	const Index groupStart = slot - slot % GROUP_SIZE;
+	
+	// If the slot's group has an empty slot, no probe sequence has ever continued past
+	// the group, so the slot can be made empty. Otherwise it must be marked as deleted
+	// so that lookups for paths in later groups still probe past it.
+	if ( getGroupMatches( slotTags + groupStart, EMPTY_SLOT ) != 0 )
+		slotTags[slot] = EMPTY_SLOT;
+	else
+	{
+		slotTags[slot] = DELETED_SLOT;
+		numDeletedSlots++;
+	}
+	
+	paths[pathIndex].~ProbePath();
+	numPaths--;
+	
+	// Move the last path in the array into the hole so that the paths stay contiguous.
+	if ( pathIndex != numPaths )
+	{
+		util::relocate( paths + pathIndex, paths + numPaths, 1 );
+		
+		pathSlots[pathIndex] = pathSlots[numPaths];
+		pathTimeStamps[pathIndex] = pathTimeStamps[numPaths];
+		slotPaths[pathSlots[pathIndex]] = pathIndex;
+	}
+}
 
 
 
 
-void ProbePathCache:: checkLoadFactor()
+void ProbePathCache:: evictPath()
 {
-	// Caculate the maximum number of paths that can be in the cache before it must be resized.
-	Size maxNumPaths = Size(loadFactor*numBuckets);
-	
-	// Check to see if the number of paths is below the limit.
-	if ( numPaths <= maxNumPaths )
+	if ( numPaths == 0 )
 		return;
-	else
+	
+	// Sample a few consecutive paths, continuing where the last search stopped,
+	// and evict the one that has gone unused for the longest time.
+	if ( evictionIndex >= numPaths )
+		evictionIndex = 0;
+	
+	const Size numSamples = math::min( Size(EVICTION_SAMPLE_SIZE), numPaths );
+	Index oldestIndex = evictionIndex;
+	Index oldestAge = timeStamp - pathTimeStamps[evictionIndex];
+	
+	for ( Index i = 1; i < numSamples; i++ )
 	{
-		// Otherise, reallocate the buckets in the cache and reinsert all paths.
-		
-		// Save the current state of the cache.
-		Bucket* oldBuckets = buckets;
-		Hash oldNumBuckets = numBuckets;
-		
-		// Compute the new number of buckets.
-		numBuckets = nextPrime( Hash(numPaths/loadFactor) );
+		const Index pathIndex = (evictionIndex + i) % numPaths;
+		const Index age = timeStamp - pathTimeStamps[pathIndex];
 		
-		// Allocate a new bucket array.
-		buckets = util::constructArray<Bucket>( numBuckets, DEFAULT_BUCKET_SIZE );
-		
-		// Reinsert all paths into the new buckets.
-		register const Bucket* oldBucket = oldBuckets;
-		register const Bucket* const oldBucketsEnd = oldBuckets + oldNumBuckets;
-		
-		while ( oldBucket != oldBucketsEnd )
+		if ( age > oldestAge )
 		{
-			// For each path in the bucket, add it to the new buckets.
-			register const ProbePath* path = oldBucket->entries;
-			register const ProbePath* pathsEnd = path + oldBucket->numEntries;
-			
-			while ( path != pathsEnd )
-			{
-				Bucket* bucket = buckets + (path->getHashCode() % numBuckets);
-				bucket->add( *path );
-				
-				path++;
-			}
-			
-			oldBucket++;
+			oldestIndex = pathIndex;
+			oldestAge = age;
 		}
-		
-		// Deallocate the old bucket array.
-		util::destructArray( oldBuckets, oldNumBuckets );
 	}
+	
+	evictionIndex += numSamples;
+	
+	removePathAtIndex( oldestIndex );
 }
 
 
@@ -285,7 +283,7 @@ void ProbePathCache:: checkLoadFactor()
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Private Static Prime Number Finding Method
+//############		Capacity Accessor Methods
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -293,15 +291,12 @@ void ProbePathCache:: checkLoadFactor()
 
 
 
-GSOUND_INLINE Hash ProbePathCache:: nextPrime( Hash n )
+void ProbePathCache:: setMaximumNumberOfPaths( Size newMaxNumPaths )
 {
-	for ( Index i = 0; i < 28; i++ )
-	{
-		if ( Primes[i] > n )
-			return Primes[i];
-	}
+	maxNumPaths = math::max( newMaxNumPaths, Size(1) );
 	
-	return n;
+	while ( numPaths > maxNumPaths )
+		evictPath();
 }
 
 
@@ -310,7 +305,7 @@ GSOUND_INLINE Hash ProbePathCache:: nextPrime( Hash n )
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Hash Table Size Prime Numbers
+//############		Storage Management Methods
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -318,37 +313,112 @@ GSOUND_INLINE Hash ProbePathCache:: nextPrime( Hash n )
 
 
 
-const Hash ProbePathCache:: Primes [] =
+void ProbePathCache:: growCapacity( Size newCapacity )
+{
+	ProbePath* oldPaths = paths;
+	Index* oldPathSlots = pathSlots;
+	Index* oldPathTimeStamps = pathTimeStamps;
+	
+	capacity = math::max( newCapacity, Size(1) );
+	paths = util::allocate<ProbePath>( capacity );
+	pathSlots = util::allocate<Index>( capacity );
+	pathTimeStamps = util::allocate<Index>( capacity );
+	
+	// Move the paths to the new array. Their indices don't change, so the hash table is still valid.
+	util::relocate( paths, oldPaths, numPaths );
+	util::relocate( pathSlots, oldPathSlots, numPaths );
+	util::relocate( pathTimeStamps, oldPathTimeStamps, numPaths );
+	
+	util::deallocate( oldPaths );
+	util::deallocate( oldPathSlots );
+	util::deallocate( oldPathTimeStamps );
+}
+
+
+
+
+void ProbePathCache:: reserveSlot()
+{
+	// Deleted slots lengthen probe sequences just like full ones, so count them too.
+	if ( numPaths + numDeletedSlots + 1 <= Size(numSlots*loadFactor) )
+		return;
+	
+	// Leave room for at least as many paths again before the table must be rebuilt.
+	Size newNumSlots = numSlots;
+	
+	while ( Size(newNumSlots*loadFactor) < 2*(numPaths + 1) )
+		newNumSlots *= 2;
+	
+	rebuildSlots( newNumSlots );
+}
+
+
+
+
+void ProbePathCache:: rebuildSlots( Size newNumSlots )
+{
+	if ( newNumSlots != numSlots )
+	{
+		util::deallocate( slotTags );
+		util::deallocate( slotPaths );
+		
+		numSlots = newNumSlots;
+		slotTags = util::allocate<UByte>( numSlots );
+		slotPaths = util::allocate<Index>( numSlots );
+	}
+	
+	for ( Index i = 0; i < numSlots; i++ )
+		slotTags[i] = EMPTY_SLOT;
+	
+	numDeletedSlots = 0;
+	
+	for ( Index i = 0; i < numPaths; i++ )
+		pathSlots[i] = insertSlot( getSlotHash( paths[i].getHashCode() ), i );
+}
+
+
+
+
+void ProbePathCache:: copyCache( const ProbePathCache& other )
+{
+	numPaths = other.numPaths;
+	capacity = other.capacity;
+	maxNumPaths = other.maxNumPaths;
+	numSlots = other.numSlots;
+	numDeletedSlots = other.numDeletedSlots;
+	evictionIndex = other.evictionIndex;
+	resumeIndex = other.resumeIndex;
+	timeStamp = other.timeStamp;
+	loadFactor = other.loadFactor;
+	
+	paths = util::allocate<ProbePath>( capacity );
+	pathSlots = util::allocate<Index>( capacity );
+	pathTimeStamps = util::allocate<Index>( capacity );
+	slotTags = util::copyArray( other.slotTags, numSlots );
+	slotPaths = util::copyArray( other.slotPaths, numSlots );
+	
+	for ( Index i = 0; i < numPaths; i++ )
+	{
+		new (paths + i) ProbePath( other.paths[i] );
+		pathSlots[i] = other.pathSlots[i];
+		pathTimeStamps[i] = other.pathTimeStamps[i];
+	}
+}
+
+
+
+
+void ProbePathCache:: destroyCache()
 {
-	11,				//	Between 2^3 and 2^4
-	23,				//	Between 2^4 and 2^5
-	53,				//	Between 2^5 and 2^6
-	97,				//	Between 2^6 and 2^7
-	193,			//	Between 2^7 and 2^8
-	389,			//	Between 2^8 and 2^9
-	769,			//	Between 2^9 and 2^10
-	1543,			//	Between 2^10 and 2^11
-	3079,			//	Between 2^11 and 2^12
-	6151,			//	Between 2^12 and 2^13
-	12289,			//	Between 2^13 and 2^14
-	24593,			//	Between 2^14 and 2^15
-	49157,			//	Between 2^15 and 2^16
-	98317,			//	Between 2^16 and 2^17
-	196613,			//	Between 2^17 and 2^18
-	393241,			//	Between 2^18 and 2^19
-	786433,			//	Between 2^19 and 2^20
-	1572869,		//	Between 2^20 and 2^21
-	3145739,		//	Between 2^21 and 2^22
-	6291469,		//	Between 2^22 and 2^23
-	12582917,		//	Between 2^23 and 2^24
-	25165843,		//	Between 2^24 and 2^25
-	50331653,		//	Between 2^25 and 2^26
-	100663319,		//	Between 2^26 and 2^27
-	201326611,		//	Between 2^27 and 2^28
-	402653189,		//	Between 2^28 and 2^29
-	805306457,		//	Between 2^29 and 2^30
-	1610612741,		//	Between 2^30 and 2^31
-};
+	for ( Index i = 0; i < numPaths; i++ )
+		paths[i].~ProbePath();
+	
+	util::deallocate( paths );
+	util::deallocate( pathSlots );
+	util::deallocate( pathTimeStamps );
+	util::deallocate( slotTags );
+	util::deallocate( slotPaths );
+}
 
 
 
@@ -369,11 +439,6 @@ const Float ProbePathCache:: DEFAULT_LOAD_FACTOR = 0.75;
 
 
 
-const Size ProbePathCache:: DEFAULT_BUCKET_SIZE = 2;
-
-
-
-
 //##########################################################################################
 //**************************  End GSound Internal Namespace  *******************************
 GSOUND_INTERNAL_NAMESPACE_END
@@ -77,6 +77,19 @@ GSOUND_INTERNAL_NAMESPACE_START
 
 
 
+/// A class which stores a bounded set of unique probe paths in a hash table.
+/**
+  * All of the paths in the cache are stored contiguously in a single array.
+  * They are found through an open-addressing hash table whose slots are grouped
+  * into runs of 16. Each slot has a one-byte tag in a separate array which holds
+  * 7 bits of the path's hash, so a lookup compares a whole group of tags at once
+  * and only touches the paths whose tags match.
+  * 
+  * The cache holds at most a maximum number of paths. When it is full, adding
+  * a path evicts one of the least recently used paths, as given by the time
+  * stamps of the paths, so the cache's memory use and lookup time stay bounded
+  * no matter how long propagation runs.
+  */
 class ProbePathCache
 {
 	public:
@@ -102,14 +115,14 @@ class ProbePathCache
 			
 			
 			
-			/// Create an empy propagation path cache with the default number of hash table buckets.
+			/// Create an empty probe path cache with the default maximum number of paths.
 			ProbePathCache();
 			
 			
 			
 			
-			/// Create an empy propagation path cache with the specified number of hash table buckets and loadFactor.
-			ProbePathCache( Hash newNumBuckets, Float newLoadFactor );
+			/// Create an empty probe path cache with the specified maximum number of paths and load factor.
+			ProbePathCache( Size newMaxNumPaths, Float newLoadFactor );
 			
 			
 			
@@ -160,7 +173,9 @@ class ProbePathCache
 			/**
 			  * If the probe path was already in the cache, return FALSE and leave the
 			  * cache unmodified. Otherwise, return TRUE and add the probe path to the
-			  * cache.
+			  * cache with the cache's current time stamp. If the cache already holds
+			  * the maximum number of paths, one of the least recently used paths is
+			  * removed to make room for the new path.
 			  * 
 			  * @param newProbePath - the probe path to try to add to this probe path cache.
 			  * @return whether or not the path was added to the cache.
@@ -184,6 +199,10 @@ class ProbePathCache
 			
 			
 			/// Remove all probe paths from this cache.
+			/**
+			  * The storage for the paths is kept so that the cache can be refilled
+			  * without allocating memory.
+			  */
 			void clear();
 			
 			
@@ -192,12 +211,39 @@ class ProbePathCache
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Load Factor Constraint Methods
+		//******	Capacity Accessor Methods
+			
 			
 			
 			
+			/// Get the maximum number of paths that this probe path cache can hold.
+			GSOUND_INLINE Size getMaximumNumberOfPaths() const
+			{
+				return maxNumPaths;
+			}
 			
-			/// Get the load factor used by this probe path cache to avoid bucket clustering.
+			
+			
+			
+			/// Set the maximum number of paths that this probe path cache can hold.
+			/**
+			  * The value is clamped to be at least 1. If the cache holds more paths
+			  * than the new maximum, the least recently used paths are removed.
+			  */
+			void setMaximumNumberOfPaths( Size newMaxNumPaths );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Load Factor Accessor Methods
+			
+			
+			
+			
+			/// Get the maximum fraction of the hash table's slots that can be used before the table is resized.
 			GSOUND_INLINE Float getLoadFactor() const
 			{
 				return loadFactor;
@@ -206,28 +252,45 @@ class ProbePathCache
 			
 			
 			
-			/// Set the load factor used by this probe path cache to avoid bucket clustering.
+			/// Set the maximum fraction of the hash table's slots that can be used before the table is resized.
 			/**
-			  * The input value is clamped to the range [0.1,+infinity].
+			  * The input value is clamped to the range [0.1,0.9]. The new load factor takes
+			  * effect the next time that the table is rebuilt.
 			  */
 			GSOUND_INLINE void setLoadFactor( Float newLoadFactor )
 			{
-				loadFactor = math::max( newLoadFactor, Float(0.1) );
+				loadFactor = math::clamp( newLoadFactor, Float(0.1), Float(0.9) );
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Time Stamp Accessor Methods
+			
+			
+			
+			
+			/// Get the time stamp which is given to paths when they are added to the cache or used.
+			GSOUND_INLINE Index getTimeStamp() const
+			{
+				return timeStamp;
 			}
 			
 			
 			
 			
-			/// Check to see if the hash table should be resized, and if necessary, resize it.
+			/// Set the time stamp which is given to paths when they are added to the cache or used.
 			/**
-			  * If the number of paths in the cache is greater than the load factor multiplied
-			  * by the number of buckets in the cache's hash table, the cache is resized
-			  * to a prime number of buckets at least twice the current size and great enough
-			  * to satisfy the load factor constraint. This is a potentially expensive operation
-			  * and should only performed once per sound propagation frame to avoid massive
-			  * reallocation.
+			  * This should be updated once per propagation frame. Paths whose time
+			  * stamps are furthest behind this value are the first to be evicted.
 			  */
-			void checkLoadFactor();
+			GSOUND_INLINE void setTimeStamp( Index newTimeStamp )
+			{
+				timeStamp = newTimeStamp;
+			}
 			
 			
 			
@@ -257,138 +320,158 @@ class ProbePathCache
 			
 			
 			
+			/// Return an iterator over all of the paths in this cache.
 			Iterator getIterator();
 			
 			
 			
 			
-	private:
-		
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Private Bucket Class Declaration
-			
-			
-			
-			
-			class Bucket;
+			/// Return an iterator over all of the paths in this cache, starting with the path at the specified index.
+			/**
+			  * The iterator wraps around to the start of the cache after the last path, so
+			  * every path is still visited exactly once, even if paths are removed through
+			  * the iterator. If the start index is past the last path, the iteration starts
+			  * with the first path.
+			  */
+			Iterator getIterator( Index startIndex );
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Private Bucket Class Declaration
+			/// Get the index of the path where an interrupted iteration over the cache should resume.
+			GSOUND_INLINE Index getResumeIndex() const
+			{
+				return resumeIndex;
+			}
 			
 			
 			
 			
-			GSOUND_INLINE static Hash nextPrime( Hash n );
+			/// Set the index of the path where an interrupted iteration over the cache should resume.
+			/**
+			  * This lets an iteration which doesn't have time to visit every path continue
+			  * where it stopped on a later frame, rather than always starting over with
+			  * the first paths.
+			  */
+			GSOUND_INLINE void setResumeIndex( Index newResumeIndex )
+			{
+				resumeIndex = newResumeIndex;
+			}
 			
 			
 			
 			
+	private:
+		
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Private Data Members
+		//******	Private Helper Methods
 			
 			
 			
 			
-			Bucket* buckets;
+			/// Return the index of the path in this cache that is equal to the specified path, or NULL_PATH if there is none.
+			GSOUND_INLINE Index findPath( const ProbePath& probePath, Hash slotHash ) const;
 			
 			
 			
 			
-			Hash numBuckets;
+			/// Store a path with the given slot hash in the first free slot of its probe sequence and return the slot.
+			GSOUND_INLINE Index insertSlot( Hash slotHash, Index pathIndex );
 			
 			
 			
 			
-			Size numPaths;
+			/// Remove the path at the specified index, moving the last path in the cache to its place.
+			void removePathAtIndex( Index pathIndex );
 			
 			
 			
 			
-			Float loadFactor;
+			/// Remove one of the least recently used paths from the cache.
+			void evictPath();
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Private Static Data Members
+			/// Increase the capacity of the path storage so that it can hold the specified number of paths.
+			void growCapacity( Size newCapacity );
 			
 			
 			
 			
-			static const Hash Primes[28];
+			/// Make sure that the hash table has room for one more path, resizing or rebuilding it if necessary.
+			void reserveSlot();
 			
 			
 			
 			
-			static const Size DEFAULT_NUMBER_OF_BUCKETS = 97;
+			/// Resize the hash table to the specified number of slots and reinsert every path.
+			void rebuildSlots( Size newNumSlots );
 			
 			
 			
 			
-			static const Size DEFAULT_BUCKET_SIZE;
+			/// Copy the paths and settings of another cache to this cache, which must be uninitialized.
+			void copyCache( const ProbePathCache& other );
 			
 			
 			
 			
-			static const Float DEFAULT_LOAD_FACTOR;
+			/// Destroy the paths in this cache and deallocate its storage.
+			void destroyCache();
+			
 			
 			
 			
-};
-
-
-
-
-//##########################################################################################
-//##########################################################################################
-//############		
-//############		Private Bucket Class Definition
-//############		
-//##########################################################################################
-//##########################################################################################
-
-
-
-
-class ProbePathCache:: Bucket
-{
-	public:
-		
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Constructors
+		//******	Private Static Helper Methods
+			
+			
+			
+			
+			/// Scramble the bits of a probe path's hash code so that they can be used to choose a slot and tag.
+			GSOUND_FORCE_INLINE static Hash getSlotHash( Hash hashCode )
+			{
+				hashCode ^= hashCode >> 16;
+				hashCode *= Hash(0x85EBCA6B);
+				hashCode ^= hashCode >> 13;
+				hashCode *= Hash(0xC2B2AE35);
+				hashCode ^= hashCode >> 16;
+				
+				return hashCode;
+			}
 			
 			
 			
 			
-			GSOUND_INLINE Bucket( Size newCapacity )
-				:	entries( util::allocate<ProbePath>( newCapacity ) ),
-					capacity( newCapacity ),
-					numEntries( 0 )
+			/// Return the tag for a full slot with the given slot hash. The high bit of the tag is always set.
+			GSOUND_FORCE_INLINE static UByte getSlotTag( Hash slotHash )
 			{
+				return UByte(0x80 | (slotHash >> 25));
 			}
 			
 			
 			
 			
-			GSOUND_INLINE Bucket( const Bucket& other )
-				:	entries( util::allocate<ProbePath>( other.capacity ) ),
-					capacity( other.capacity ),
-					numEntries( other.numEntries )
+			/// Return a bit mask of the slots in a group whose tags are equal to the specified tag.
+			GSOUND_FORCE_INLINE static UInt32 getGroupMatches( const UByte* groupTags, UByte tag )
 			{
-				copyObjects( entries, other.entries, numEntries );
+#if GSOUND_USE_SIMD && defined(GSOUND_SIMD_SSE) && GSOUND_SSE_VERSION_IS_SUPPORTED(2,0)
+				__m128i tags = _mm_loadu_si128( (const __m128i*)groupTags );
+				
+				return UInt32(_mm_movemask_epi8( _mm_cmpeq_epi8( tags, _mm_set1_epi8( (char)tag ) ) ));
+#else
+				UInt32 matches = 0;
+				
+				for ( Index i = 0; i < GROUP_SIZE; i++ )
+					matches |= UInt32(groupTags[i] == tag) << i;
+				
+				return matches;
+#endif
 			}
 			
 			
@@ -397,269 +480,146 @@ class ProbePathCache:: Bucket
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Destructor
+		//******	Private Data Members
 			
 			
 			
 			
-			GSOUND_INLINE ~Bucket()
-			{
-				callDestructors( entries, numEntries );
-				util::deallocate( entries );
-			}
+			/// The contiguous array of paths that are in the cache.
+			ProbePath* paths;
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Assignment Operator
+			/// For each path, the index of the hash table slot which refers to it.
+			Index* pathSlots;
 			
 			
 			
 			
-			GSOUND_INLINE Bucket& operator = ( const Bucket& other )
-			{
-				if ( this != &other )
-				{
-					callDestructors( entries, numEntries );
-					
-					if ( capacity < other.numEntries )
-					{
-						util::deallocate( entries );
-						entries = util::allocate<ProbePath>( other.capacity );
-						capacity = other.capacity;
-					}
-					
-					copyObjects( entries, other.entries, other.numEntries );
-					
-					numEntries = other.numEntries;
-				}
-				
-				return *this;
-			}
+			/// For each path, the time stamp when the path was last added or used.
+			Index* pathTimeStamps;
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Probe Path Add Methods
+			/// The number of paths that are currently in the cache.
+			Size numPaths;
 			
 			
 			
 			
-			GSOUND_INLINE Bool conditionalAdd( const ProbePath& newEntry )
-			{
-				ProbePath* entry = entries;
-				const ProbePath* const entriesEnd = entries + numEntries;
-				
-				while ( entry != entriesEnd )
-				{
-					if ( *entry == newEntry )
-						return false;
-					
-					entry++;
-				}
-				
-				if ( numEntries == capacity )
-					doubleCapacity();
-				
-				new (entries + numEntries) ProbePath(newEntry);
-				numEntries++;
-				
-				return true;
-			}
+			/// The number of paths that the path storage can hold before it must be reallocated.
+			Size capacity;
 			
 			
 			
 			
-			GSOUND_INLINE void add( const ProbePath& newEntry )
-			{
-				if ( numEntries == capacity )
-					doubleCapacity();
-				
-				new (entries + numEntries) ProbePath(newEntry);
-				numEntries++;
-			}
+			/// The maximum number of paths that the cache can hold before paths are evicted.
+			Size maxNumPaths;
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Probe Path Contains Method
+			/// For each hash table slot, EMPTY_SLOT, DELETED_SLOT, or the tag of the path in the slot.
+			UByte* slotTags;
 			
 			
 			
 			
-			GSOUND_INLINE Bool contains( const ProbePath& probePath )
-			{
-				ProbePath* entry = entries;
-				const ProbePath* const entriesEnd = entries + numEntries;
-				
-				while ( entry != entriesEnd )
-				{
-					if ( *entry == probePath )
-						return true;
-					
-					entry++;
-				}
-				
-				return false;
-			}
+			/// For each hash table slot, the index of the path in the slot if the slot is full.
+			Index* slotPaths;
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Probe Path Remove Methods
+			/// The number of slots in the hash table, always a power-of-two multiple of the group size.
+			Size numSlots;
 			
 			
 			
 			
-			GSOUND_INLINE void removeAtIndex( Index pathIndex )
-			{
-				// Make sure that the path index is within the valid bounds.
-				GSOUND_DEBUG_ASSERT( pathIndex < numEntries );
-				
-				ProbePath* removedPath = entries + pathIndex;
-				
-				// Call the removed object's destructor.
-				removedPath->~ProbePath();
-				
-				// Decrement the number of entries in this bucket.
-				numEntries--;
-				
-				// Move the last elemnt in the bucket to the location of the removed bucket if necessary.
-				if ( pathIndex != numEntries )
-				{
-					ProbePath* lastPath = entries + numEntries;
-					
-					new (removedPath) ProbePath( *lastPath );
-					lastPath->~ProbePath();
-				}
-			}
+			/// The number of slots that held paths that have since been removed.
+			Size numDeletedSlots;
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Bucket Clear Method
+			/// The index of the path where the search for a path to evict starts.
+			Index evictionIndex;
 			
 			
 			
 			
-			GSOUND_INLINE void clear()
-			{
-				callDestructors( entries, numEntries );
-			}
+			/// The index of the path where an interrupted iteration over the cache should resume.
+			Index resumeIndex;
+			
+			
+			
+			
+			/// The time stamp which is given to paths when they are added or used.
+			Index timeStamp;
+			
+			
+			
+			
+			/// The maximum fraction of the hash table's slots that can be used before the table is resized.
+			Float loadFactor;
 			
 			
 			
 			
-	private:
-		
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Private Helper Methods
+		//******	Private Static Data Members
 			
 			
 			
 			
-			void doubleCapacity()
-			{
-				// Update the capacity and allocate a new array.
-				capacity *= 2;
-				ProbePath* oldEntries = entries;
-				entries = util::allocate<ProbePath>( capacity );
-				
-				// Move the objects from the old array to the new one.
-				moveObjects( entries, oldEntries, numEntries );
-				
-				// Deallocate the old array.
-				util::deallocate( oldEntries );
-			}
+			/// The number of slots whose tags are compared together.
+			static const Size GROUP_SIZE = 16;
 			
 			
 			
 			
-			GSOUND_INLINE static void callDestructors( ProbePath* array, Size number )
-			{
-				const ProbePath* const arrayEnd = array + number;
-				
-				while ( array != arrayEnd )
-				{
-					array->~ProbePath();
-					array++;
-				}
-			}
+			/// The tag of a slot which has never held a path since the table was last rebuilt.
+			static const UByte EMPTY_SLOT = 0x00;
 			
 			
 			
 			
-			GSOUND_INLINE static void copyObjects( ProbePath* destination, const ProbePath* source, Size number )
-			{
-				const ProbePath* const sourceEnd = source + number;
-				
-				while ( source != sourceEnd )
-				{
-					new (destination) ProbePath(*source);
-					destination++;
-					source++;
-				}
-			}
+			/// The tag of a slot whose path was removed.
+			static const UByte DELETED_SLOT = 0x01;
 			
 			
 			
 			
-			GSOUND_INLINE static void moveObjects( ProbePath* destination, const ProbePath* source, Size number )
-			{
-				const ProbePath* const sourceEnd = source + number;
-				
-				while ( source != sourceEnd )
-				{
-					// copy the object from the source to destination
-					new (destination) ProbePath(*source);
-					
-					// call the destructors on the source
-					source->~ProbePath();
-					
-					destination++;
-					source++;
-				}
-			}
+			/// The number of paths whose time stamps are compared when choosing a path to evict.
+			static const Size EVICTION_SAMPLE_SIZE = 8;
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Private Data Members
+			/// The default maximum number of paths that a cache can hold.
+			static const Size DEFAULT_MAX_NUMBER_OF_PATHS = 65536;
 			
 			
 			
 			
-			ProbePath* entries;
+			/// The number of paths that a new cache has room for before it allocates more storage.
+			static const Size DEFAULT_CAPACITY = 64;
 			
 			
 			
 			
-			Size numEntries;
+			/// The index which is returned when a path is not in the cache.
+			static const Index NULL_PATH = Index(-1);
 			
 			
 			
 			
-			Size capacity;
+			static const Float DEFAULT_LOAD_FACTOR;
 			
 			
 			
@@ -672,12 +632,10 @@ class ProbePathCache:: Bucket
 			
 			
 			
-			friend class ProbePathCache;
 			friend class ProbePathCache::Iterator;
 			
 			
 			
-			
 };
 
 
@@ -706,13 +664,13 @@ class ProbePathCache:: Iterator
 			
 			
 			
-			GSOUND_INLINE Iterator( ProbePathCache& newCache )
-				:	currentBucket( newCache.buckets ),
-					bucketsEnd( newCache.buckets + newCache.numBuckets ),
-					cache( &newCache )
+			GSOUND_INLINE Iterator( ProbePathCache& newCache, Index newStartIndex )
+				:	cache( &newCache ),
+					startIndex( newStartIndex < newCache.numPaths ? newStartIndex : 0 ),
+					numRemainingPaths( newCache.numPaths ),
+					hasWrapped( false )
 			{
-				// Advance until the first path in the cache.
-				advanceToNextFullBucket();
+				currentIndex = startIndex;
 			}
 			
 			
@@ -729,15 +687,10 @@ class ProbePathCache:: Iterator
 			/// Increment the location of a probe path cache iterator by one element.
 			GSOUND_INLINE void operator ++ ()
 			{
-				GSOUND_DEBUG_ASSERT( currentPath != NULL );
-				
-				currentPath++;
+				GSOUND_DEBUG_ASSERT( numRemainingPaths > 0 );
 				
-				if ( currentPath == pathsEnd )
-				{
-					currentBucket++;
-					advanceToNextFullBucket();
-				}
+				numRemainingPaths--;
+				advance();
 			}
 			
 			
@@ -767,7 +720,7 @@ class ProbePathCache:: Iterator
 			  */
 			GSOUND_INLINE operator Bool () const
 			{
-				return currentPath != NULL;
+				return numRemainingPaths > 0;
 			}
 			
 			
@@ -776,9 +729,9 @@ class ProbePathCache:: Iterator
 			/// Get a reference to the probe path that this iterator currently points to.
 			GSOUND_INLINE ProbePath& operator * () const
 			{
-				GSOUND_DEBUG_ASSERT( currentPath != NULL );
+				GSOUND_DEBUG_ASSERT( currentIndex < cache->numPaths );
 				
-				return *currentPath;
+				return cache->paths[currentIndex];
 			}
 			
 			
@@ -787,9 +740,37 @@ class ProbePathCache:: Iterator
 			/// Access the current path pointed to by the iterator as if the iterator was a pointer to that path.
 			GSOUND_INLINE ProbePath* operator -> () const
 			{
-				GSOUND_DEBUG_ASSERT( currentPath != NULL );
+				GSOUND_DEBUG_ASSERT( currentIndex < cache->numPaths );
 				
-				return currentPath;
+				return cache->paths + currentIndex;
+			}
+			
+			
+			
+			
+			/// Get the index in the cache of the path that this iterator currently points to.
+			GSOUND_INLINE Index getIndex() const
+			{
+				return currentIndex;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Current Element Time Stamp Method
+			
+			
+			
+			
+			/// Mark the current path as used by giving it the cache's current time stamp.
+			GSOUND_INLINE void updateTimeStamp()
+			{
+				GSOUND_DEBUG_ASSERT( currentIndex < cache->numPaths );
+				
+				cache->pathTimeStamps[currentIndex] = cache->timeStamp;
 			}
 			
 			
@@ -804,49 +785,46 @@ class ProbePathCache:: Iterator
 			
 			
 			/// Remove the current path pointed to by this iterator and advance to the next path.
+			/**
+			  * The last path in the cache is moved to the current position, so it
+			  * becomes the next path that is iterated over, unless it was already
+			  * visited after the iteration wrapped around.
+			  */
 			GSOUND_INLINE void remove()
 			{
-				// Remove the path from the bucket.
-				currentBucket->removeAtIndex( currentPath - currentBucket->entries );
+				GSOUND_DEBUG_ASSERT( currentIndex < cache->numPaths );
 				
-				// Update the pointer to the end of the bucket.
-				pathsEnd--;
+				const Index lastIndex = cache->numPaths - 1;
 				
-				// Tell the path cache that there is one fewer element.
-				cache->numPaths--;
+				cache->removePathAtIndex( currentIndex );
+				numRemainingPaths--;
 				
-				// Advance to the next bucket if we've reached the end of this bucket.
-				if ( currentPath == pathsEnd )
-				{
-					currentBucket++;
-					advanceToNextFullBucket();
-				}
+				if ( currentIndex == lastIndex || (hasWrapped && lastIndex >= startIndex) )
+					advance();
 			}
 			
 			
 			
+			
 	private:
 		
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Private Helper Members
+		//******	Private Helper Method
 			
 			
 			
 			
-			/// Advance the iterator to the next non-empty bucket.
-			GSOUND_INLINE void advanceToNextFullBucket()
+			/// Move to the next path, wrapping around to the first path after the last one.
+			GSOUND_INLINE void advance()
 			{
-				while ( currentBucket != bucketsEnd && currentBucket->numEntries == 0 )
-					currentBucket++;
+				currentIndex++;
 				
-				if ( currentBucket == bucketsEnd )
-					currentPath = NULL;
-				else
+				if ( currentIndex >= cache->numPaths )
 				{
-					currentPath = currentBucket->entries;
-					pathsEnd = currentBucket->entries + currentBucket->numEntries;
+					currentIndex = 0;
+					hasWrapped = true;
 				}
 			}
 			
@@ -866,19 +844,25 @@ class ProbePathCache:: Iterator
 			
 			
 			
-			ProbePath* currentPath;
+			Index currentIndex;
 			
 			
 			
-			const ProbePath* pathsEnd;
 			
+			/// The index of the first path that was iterated over.
+			Index startIndex;
 			
 			
-			Bucket* currentBucket;
 			
 			
+			/// The number of paths which haven't been iterated over yet.
+			Size numRemainingPaths;
 			
-			const Bucket* const bucketsEnd;
+			
+			
+			
+			/// Whether or not the iteration has passed the last path and continued with the first one.
+			Bool hasWrapped;
 			
 			
 			
@@ -900,15 +884,25 @@ class ProbePathCache:: Iterator
 
 GSOUND_INLINE Bool ProbePathCache:: addPath( const ProbePath& newProbePath )
 {
-	Bucket* bucket = buckets + (newProbePath.getHashCode() % numBuckets);
+	const Hash slotHash = getSlotHash( newProbePath.getHashCode() );
 	
-	if ( bucket->conditionalAdd( newProbePath ) )
-	{
-		numPaths++;
-		return true;
-	}
-	else
+	if ( findPath( newProbePath, slotHash ) != NULL_PATH )
 		return false;
+	
+	if ( numPaths >= maxNumPaths )
+		evictPath();
+	else if ( numPaths == capacity )
+		growCapacity( math::min( 2*capacity, maxNumPaths ) );
+	
+	reserveSlot();
+	
+	// Store the path at the end of the path array.
+	new (paths + numPaths) ProbePath( newProbePath );
+	pathSlots[numPaths] = insertSlot( slotHash, numPaths );
+	pathTimeStamps[numPaths] = timeStamp;
+	numPaths++;
+	
+	return true;
 }
 
 
@@ -916,9 +910,74 @@ GSOUND_INLINE Bool ProbePathCache:: addPath( const ProbePath& newProbePath )
 
 GSOUND_INLINE Bool ProbePathCache:: containsPath( const ProbePath& probePath ) const
 {
-	Bucket* bucket = buckets + (probePath.getHashCode() % numBuckets);
+	return findPath( probePath, getSlotHash( probePath.getHashCode() ) ) != NULL_PATH;
+}
+
+
+
+
+GSOUND_INLINE Index ProbePathCache:: findPath( const ProbePath& probePath, Hash slotHash ) const
+{
+	const UByte tag = getSlotTag( slotHash );
+	const Size groupMask = numSlots/GROUP_SIZE - 1;
+	Index group = slotHash & groupMask;
+	
+	// Probe the groups in order until a group with an empty slot is reached.
+	for ( Index n = 0; n <= groupMask; n++ )
+	{
+		const Index groupStart = group*GROUP_SIZE;
+		UInt32 matches = getGroupMatches( slotTags + groupStart, tag );
+		
+		for ( Index slot = groupStart; matches != 0; slot++, matches >>= 1 )
+		{
+			if ( (matches & 1) && paths[slotPaths[slot]] == probePath )
+				return slotPaths[slot];
+		}
+		
+		if ( getGroupMatches( slotTags + groupStart, EMPTY_SLOT ) != 0 )
+			break;
+		
+		group = (group + 1) & groupMask;
+	}
+	
+	return NULL_PATH;
+}
+
+
+
+
+GSOUND_INLINE Index ProbePathCache:: insertSlot( Hash slotHash, Index pathIndex )
+{
+	const Size groupMask = numSlots/GROUP_SIZE - 1;
+	Index group = slotHash & groupMask;
 	
-	return bucket->contains( probePath );
+	while ( true )
+	{
+		const Index groupStart = group*GROUP_SIZE;
+		UInt32 freeSlots = getGroupMatches( slotTags + groupStart, EMPTY_SLOT ) |
+							getGroupMatches( slotTags + groupStart, DELETED_SLOT );
+		
+		if ( freeSlots != 0 )
+		{
+			Index slot = groupStart;
+			
+			while ( (freeSlots & 1) == 0 )
+			{
+				freeSlots >>= 1;
+				slot++;
+			}
+			
+			if ( slotTags[slot] == DELETED_SLOT )
+				numDeletedSlots--;
+			
+			slotTags[slot] = getSlotTag( slotHash );
+			slotPaths[slot] = pathIndex;
+			
+			return slot;
+		}
+		
+		group = (group + 1) & groupMask;
+	}
 }
 
 
@@ -926,7 +985,15 @@ GSOUND_INLINE Bool ProbePathCache:: containsPath( const ProbePath& probePath ) c
 
 GSOUND_INLINE ProbePathCache::Iterator ProbePathCache:: getIterator()
 {
-	return ProbePathCache::Iterator(*this);
+	return ProbePathCache::Iterator( *this, 0 );
+}
+
+
+
+
+GSOUND_INLINE ProbePathCache::Iterator ProbePathCache:: getIterator( Index startIndex )
+{
+	return ProbePathCache::Iterator( *this, startIndex );
 }
 
 
@@ -77,6 +77,13 @@ GSOUND_INTERNAL_NAMESPACE_START
 
 
 
+/// A class which keeps track of the triangles that were recently probed by a set of rays.
+/**
+  * Each entry stores user-defined data for a triangle. The data type must have a
+  * public 'timeStamp' member which indicates the frame when the triangle was last
+  * probed. The cache keeps the triangles in generations by time stamp so that the
+  * triangles which expire on a frame can be removed without visiting the others.
+  */
 template < typename DataType >
 class ProbedTriangleCache
 {
@@ -95,6 +102,74 @@ class ProbedTriangleCache
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Probed Triangle Update Class Declaration
+			
+			
+			
+			
+			/// A class which records that a triangle was added to the cache or given a new time stamp.
+			class Update
+			{
+				public:
+					
+					GSOUND_INLINE Update( const ObjectSpaceTriangle& newTriangle, Index newTimeStamp )
+						:	triangle( newTriangle ),
+							timeStamp( newTimeStamp )
+					{
+					}
+					
+					
+					
+					/// The triangle which was updated.
+					ObjectSpaceTriangle triangle;
+					
+					
+					/// The time stamp which the triangle was given.
+					Index timeStamp;
+					
+					
+			};
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Expired Triangle Class Declaration
+			
+			
+			
+			
+			/// A class which holds a triangle that was removed from the cache because it expired.
+			class ExpiredTriangle
+			{
+				public:
+					
+					GSOUND_INLINE ExpiredTriangle( const ObjectSpaceTriangle& newTriangle, const DataType& newData )
+						:	triangle( newTriangle ),
+							data( newData )
+					{
+					}
+					
+					
+					
+					/// The triangle which expired.
+					ObjectSpaceTriangle triangle;
+					
+					
+					/// The data that was stored for the triangle when it expired.
+					DataType data;
+					
+					
+			};
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -104,6 +179,8 @@ class ProbedTriangleCache
 			
 			
 			GSOUND_INLINE ProbedTriangleCache()
+				:	firstUpdate( 0 ),
+					expiryTimeStamp( 0 )
 			{
 			}
 			
@@ -118,9 +195,31 @@ class ProbedTriangleCache
 			
 			
 			
+			/// Add or replace the data for the specified triangle.
+			/**
+			  * The method returns TRUE if the triangle was not previously in the cache.
+			  * Otherwise the method returns FALSE.
+			  */
 			GSOUND_INLINE Bool add( const ObjectSpaceTriangle& triangle, const DataType& data )
 			{
-				return triangleMap.set( triangle.getHashCode(), triangle, data );
+				const Hash hashCode = triangle.getHashCode();
+				DataType* oldData;
+				
+				if ( triangleMap.find( hashCode, triangle, oldData ) )
+				{
+					// Only start a new generation entry if the triangle's time stamp changed.
+					if ( oldData->timeStamp != data.timeStamp )
+						updates.add( Update( triangle, data.timeStamp ) );
+					
+					*oldData = data;
+					
+					return false;
+				}
+				
+				triangleMap.add( hashCode, triangle, data );
+				updates.add( Update( triangle, data.timeStamp ) );
+				
+				return true;
 			}
 			
 			
@@ -149,13 +248,62 @@ class ProbedTriangleCache
 			
 			
 			
+			
+			/// Remove all triangles whose time stamp is less than the specified minimum time stamp.
+			/**
+			  * Only the generations of triangles which are older than the minimum time stamp
+			  * are visited, so the cost is proportional to the number of updates that expired
+			  * rather than the size of the cache. The removed triangles are kept until the
+			  * next call to this method and can be accessed with getExpiredTriangle().
+			  */
+			GSOUND_INLINE void removeExpired( Index minTimeStamp )
+			{
+				expiredTriangles.clear();
+				expiryTimeStamp = minTimeStamp;
+				
+				const Size numUpdates = updates.getSize();
+				
+				while ( firstUpdate < numUpdates && updates[firstUpdate].timeStamp < minTimeStamp )
+				{
+					const Update& update = updates[firstUpdate];
+					const Hash hashCode = update.triangle.getHashCode();
+					DataType* data;
+					
+					// If the triangle has been updated since, a later generation refers to it.
+					if ( triangleMap.find( hashCode, update.triangle, data ) && data->timeStamp == update.timeStamp )
+					{
+						expiredTriangles.add( ExpiredTriangle( update.triangle, *data ) );
+						triangleMap.remove( hashCode, update.triangle );
+					}
+					
+					firstUpdate++;
+				}
+				
+				// Shift the remaining updates to the front of the list once over half of it has expired.
+				if ( firstUpdate > numUpdates / 2 )
+				{
+					for ( Index i = firstUpdate; i < numUpdates; i++ )
+						updates[i - firstUpdate] = updates[i];
+					
+					updates.removeLast( firstUpdate );
+					firstUpdate = 0;
+				}
+			}
+			
+			
+			
+			
 			GSOUND_INLINE void clear()
 			{
 				triangleMap.clear();
+				updates.clear();
+				expiredTriangles.clear();
+				firstUpdate = 0;
 			}
 			
 			
 			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -163,6 +311,7 @@ class ProbedTriangleCache
 			
 			
 			
+			
 			GSOUND_INLINE Size getNumberOfTriangles() const
 			{
 				return triangleMap.getSize();
@@ -171,6 +320,83 @@ class ProbedTriangleCache
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Update Accessor Methods
+			
+			
+			
+			
+			/// Return the number of triangle updates that have not yet expired.
+			GSOUND_INLINE Size getNumberOfUpdates() const
+			{
+				return updates.getSize() - firstUpdate;
+			}
+			
+			
+			
+			
+			/// Return the time stamp of the newest update, or 0 if there are no updates.
+			GSOUND_INLINE Index getNewestTimeStamp() const
+			{
+				if ( firstUpdate < updates.getSize() )
+					return updates.getLast().timeStamp;
+				else
+					return 0;
+			}
+			
+			
+			
+			
+			/// Return the update at the specified index, ordered from oldest to newest.
+			/**
+			  * A triangle which was updated more than once has an update for each time stamp
+			  * that it was given, so only the newest of its updates reflects its current data.
+			  */
+			GSOUND_INLINE const Update& getUpdate( Index index ) const
+			{
+				return updates[firstUpdate + index];
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Expired Triangle Accessor Methods
+			
+			
+			
+			
+			/// Return the minimum time stamp that was passed to the last call to removeExpired().
+			GSOUND_INLINE Index getExpiryTimeStamp() const
+			{
+				return expiryTimeStamp;
+			}
+			
+			
+			
+			
+			/// Return the number of triangles that were removed by the last call to removeExpired().
+			GSOUND_INLINE Size getNumberOfExpiredTriangles() const
+			{
+				return expiredTriangles.getSize();
+			}
+			
+			
+			
+			
+			/// Return the expired triangle at the specified index.
+			GSOUND_INLINE const ExpiredTriangle& getExpiredTriangle( Index index ) const
+			{
+				return expiredTriangles[index];
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -197,6 +423,34 @@ class ProbedTriangleCache
 			
 			
 			
+			
+			/// A list of the updates to the triangles in the cache in the order they were made.
+			/**
+			  * Since time stamps only increase, the updates are grouped into generations
+			  * by time stamp, with the oldest generation at the front of the list.
+			  */
+			ArrayList<Update> updates;
+			
+			
+			
+			
+			/// The index of the oldest update in the list which has not expired.
+			Index firstUpdate;
+			
+			
+			
+			
+			/// The triangles that were removed by the last call to removeExpired().
+			ArrayList<ExpiredTriangle> expiredTriangles;
+			
+			
+			
+			
+			/// The minimum time stamp that was passed to the last call to removeExpired().
+			Index expiryTimeStamp;
+			
+			
+			
 };
 
 
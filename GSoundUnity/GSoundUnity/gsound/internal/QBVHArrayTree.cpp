@@ -181,6 +181,10 @@ QBVHArrayTree:: QBVHArrayTree( const ArrayList<TriangleType>& newTriangles,
 		numNodes( 0 ),
 		triangles( NULL ),
 		numTriangles( 0 )
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+		,	wideNodes( NULL ),
+		numWideNodes( 0 )
+#endif
 {
 	if ( newTriangles.getSize() != 0 )
 		buildTree( newTriangles.getArrayPointer(), newTriangles.getSize(), numSplitCandidates, maxNumTrianglesPerLeaf );
@@ -195,6 +199,10 @@ QBVHArrayTree:: QBVHArrayTree( const TriangleType* newTriangles, Size newNumTria
 		numNodes( 0 ),
 		triangles( NULL ),
 		numTriangles( 0 )
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+		,	wideNodes( NULL ),
+		numWideNodes( 0 )
+#endif
 {
 	if ( newTriangles != NULL && newNumTriangles != 0 )
 		buildTree( newTriangles, newNumTriangles, numSplitCandidates, maxNumTrianglesPerLeaf );
@@ -208,6 +216,10 @@ QBVHArrayTree:: QBVHArrayTree( const QBVHArrayTree& other )
 		numNodes( other.numNodes ),
 		triangles( util::copyArrayAligned( other.triangles, other.numTriangles, 16 ) ),
 		numTriangles( other.numTriangles )
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+		,	wideNodes( util::copyArrayAligned( other.wideNodes, other.numWideNodes, 16 ) ),
+		numWideNodes( other.numWideNodes )
+#endif
 {
 }
 
@@ -255,6 +267,11 @@ QBVHArrayTree& QBVHArrayTree:: operator = ( const QBVHArrayTree& other )
 		numNodes = other.numNodes;
 		triangles = util::copyArrayAligned( other.triangles, other.numTriangles, 16 );
 		numTriangles = other.numTriangles;
+		
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+		wideNodes = util::copyArrayAligned( other.wideNodes, other.numWideNodes, 16 );
+		numWideNodes = other.numWideNodes;
+#endif
 	}
 	
 	return *this;
@@ -284,6 +301,14 @@ void QBVHArrayTree:: destroyTree()
 	
 	nodes = NULL;
 	triangles = NULL;
+	
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+	if ( wideNodes != NULL )
+		util::deallocateAligned( wideNodes );
+	
+	wideNodes = NULL;
+	numWideNodes = 0;
+#endif
 }
 
 
@@ -355,6 +380,11 @@ void QBVHArrayTree:: buildTree( const TriangleType* newTriangles, Size newNumTri
 	// Copy the current order of the TriangleAABB list into the tree's list of triangle pointers.
 	fillTriangleArray( triangles, triangleAABBs, nodes, 0 );
 	
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+	// Collapse the finished tree into a wide tree for ray tracing.
+	buildWideTree();
+#endif
+	
 	//**************************************************************************************
 	// Clean up the temporary arrays of TriangleAABB objects and split bins.
 	
@@ -532,7 +562,7 @@ void QBVHArrayTree:: partitionTrianglesSAH( TriangleAABB* triangleAABBs, Size nu
 	
 	const Real binningConstant1 = Real(numSplitBins)*(Real(1) - Real(0.00001));
 	Real minSplitCost = math::max<Real>();
-	Real minSplitPlane = 0;
+	Index minSplitBin = 0;
 	SIMDScalar<float,4> lesserMin;
 	SIMDScalar<float,4> lesserMax;
 	SIMDScalar<float,4> greaterMin;
@@ -545,7 +575,6 @@ void QBVHArrayTree:: partitionTrianglesSAH( TriangleAABB* triangleAABBs, Size nu
 	{
 		// Compute some constants that are valid for all bins/triangles.
 		const Real binningConstant = binningConstant1 / aabbDimension[axis];
-		const Real binWidth = aabbDimension[axis] / Real(numSplitBins);
 		const Real binsStart = centroidAABB.min[axis];
 		
 		// Initialize the split bins to their starting values.
@@ -609,7 +638,7 @@ void QBVHArrayTree:: partitionTrianglesSAH( TriangleAABB* triangleAABBs, Size nu
 			if ( splitCost <= minSplitCost )
 			{
 				minSplitCost = splitCost;
-				minSplitPlane = binsStart + binWidth*Float(i + 1);
+				minSplitBin = i;
 				
 				// Save the bounding boxes for this split candidate.
 				lesserMin = leftMin;
@@ -643,7 +672,11 @@ void QBVHArrayTree:: partitionTrianglesSAH( TriangleAABB* triangleAABBs, Size nu
 	}
 	
 	//**************************************************************************************
-	// Partition the triangles into two sets based on the minimal cost split plane.
+	// Partition the triangles into two sets using the same binning as the split evaluation,
+	// so that each triangle ends up on the side whose bounding box was computed from its bin.
+	
+	const Real binningConstant = binningConstant1 / aabbDimension[splitAxis];
+	const Real binsStart = centroidAABB.min[splitAxis];
 	
 	Index left = 0;
 	Index right = numTriangles - 1;
@@ -651,11 +684,11 @@ void QBVHArrayTree:: partitionTrianglesSAH( TriangleAABB* triangleAABBs, Size nu
 	while ( left < right )
 	{
 		// Move right while triangle < split plane.
-		while ( triangleAABBs[left].centroid[splitAxis] <= minSplitPlane && left < right )
+		while ( (Index)(binningConstant*(triangleAABBs[left].centroid[splitAxis] - binsStart)) <= minSplitBin && left < right )
 			left++;
 		
 		// Move left while triangle > split plane.
-		while ( triangleAABBs[right].centroid[splitAxis] > minSplitPlane && left < right )
+		while ( (Index)(binningConstant*(triangleAABBs[right].centroid[splitAxis] - binsStart)) > minSplitBin && left < right )
 			right--;
 		
 		if ( left < right )
@@ -927,6 +960,137 @@ Size QBVHArrayTree:: fillTriangleArray( FatSIMDTriangle3* triangles, const Trian
 
 
 
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Wide Tree Construction Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void QBVHArrayTree:: buildWideTree()
+{
+	// Each wide node is made from a different QBVH node, so there can't be more wide nodes than QBVH nodes.
+	WideNodeType* tempNodes = util::allocateAligned<WideNodeType>( numNodes, 16 );
+	
+	numWideNodes = buildWideTreeRecursive( tempNodes, nodes );
+	
+	// Copy the nodes to an array that is exactly the right size.
+	wideNodes = util::copyArrayAligned( tempNodes, numWideNodes, 16 );
+	
+	util::deallocateAligned( tempNodes );
+}
+
+
+
+
+Size QBVHArrayTree:: buildWideTreeRecursive( WideNodeType* wideNode, const QBVHArrayTreeNode* node )
+{
+	const Size wideNodeWidth = WideNodeType::getWidth();
+	
+	// The QBVH nodes and child indices of the children that the wide node will have.
+	const QBVHArrayTreeNode* parents[GSOUND_TRIANGLE_BVH_WIDTH];
+	Index childIndices[GSOUND_TRIANGLE_BVH_WIDTH];
+	Size numChildren = 0;
+	
+	for ( Index i = 0; i < 4; i++ )
+	{
+		if ( !node->isEmpty(i) )
+		{
+			parents[numChildren] = node;
+			childIndices[numChildren] = i;
+			numChildren++;
+		}
+	}
+	
+	//***************************************************************************
+	// Repeatedly replace the inner child with the largest surface area by its own
+	// children, as long as they fit in the wide node.
+	
+	while ( true )
+	{
+		Index bestChild = numChildren;
+		Real bestSurfaceArea = Real(-1);
+		
+		for ( Index c = 0; c < numChildren; c++ )
+		{
+			if ( parents[c]->isLeaf( childIndices[c] ) )
+				continue;
+			
+			const QBVHArrayTreeNode* child = parents[c]->getChild( childIndices[c] );
+			Size numGrandchildren = 0;
+			
+			for ( Index i = 0; i < 4; i++ )
+				numGrandchildren += !child->isEmpty(i);
+			
+			if ( numChildren - 1 + numGrandchildren > wideNodeWidth )
+				continue;
+			
+			AABB3 volume = parents[c]->getVolume( childIndices[c] );
+			Vector3 extent = volume.max - volume.min;
+			Real surfaceArea = extent.x*extent.y + extent.y*extent.z + extent.z*extent.x;
+			
+			if ( surfaceArea > bestSurfaceArea )
+			{
+				bestChild = c;
+				bestSurfaceArea = surfaceArea;
+			}
+		}
+		
+		if ( bestChild == numChildren )
+			break;
+		
+		// Replace the child with its first non-empty child and append the others.
+		const QBVHArrayTreeNode* child = parents[bestChild]->getChild( childIndices[bestChild] );
+		Bool replaced = false;
+		
+		for ( Index i = 0; i < 4; i++ )
+		{
+			if ( child->isEmpty(i) )
+				continue;
+			
+			Index c = replaced ? numChildren++ : bestChild;
+			parents[c] = child;
+			childIndices[c] = i;
+			replaced = true;
+		}
+	}
+	
+	//***************************************************************************
+	// Fill in the wide node and build the wide nodes of its inner children after it.
+	
+	new (wideNode) WideNodeType();
+	
+	Size numSubtreeNodes = 1;
+	
+	for ( Index c = 0; c < numChildren; c++ )
+	{
+		const QBVHArrayTreeNode* parent = parents[c];
+		const Index i = childIndices[c];
+		
+		if ( parent->isLeaf(i) )
+		{
+			wideNode->setLeafChild( c, parent->getVolume(i), parent->getTriangleStartIndex(i),
+									parent->getNumberOfTriangles(i) );
+		}
+		else
+		{
+			wideNode->setInnerChild( c, parent->getVolume(i), (UInt32)numSubtreeNodes );
+			numSubtreeNodes += buildWideTreeRecursive( wideNode + numSubtreeNodes, parent->getChild(i) );
+		}
+	}
+	
+	return numSubtreeNodes;
+}
+
+
+
+
+#endif
 //##########################################################################################
 //**************************  End GSound Internal Namespace  *******************************
 GSOUND_INTERNAL_NAMESPACE_END
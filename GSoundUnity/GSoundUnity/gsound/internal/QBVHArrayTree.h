@@ -66,6 +66,7 @@
 
 
 #include "QBVHArrayTreeNode.h"
+#include "WideBVHArrayTreeNode.h"
 #include "FatSIMDTriangle3D.h"
 
 
@@ -102,6 +103,14 @@ class QBVHArrayTree
 			
 			
 			
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			/// The type of node used in the wide version of this tree.
+			typedef WideBVHArrayTreeNode<GSOUND_TRIANGLE_BVH_WIDTH> WideNodeType;
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -175,6 +184,22 @@ class QBVHArrayTree
 			
 			
 			
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			/// Get a pointer to the root node of the wide version of this QBVHArrayTree.
+			/**
+			  * The wide tree is built by collapsing this tree's nodes so that each node has up
+			  * to GSOUND_TRIANGLE_BVH_WIDTH children. Its leaves index into the same
+			  * triangle array as this tree.
+			  */
+			GSOUND_FORCE_INLINE const WideNodeType* getWideRoot() const
+			{
+				return wideNodes;
+			}
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -270,6 +295,23 @@ class QBVHArrayTree
 			
 			
 			
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			/// Build the wide version of this tree by collapsing the levels of this tree.
+			void buildWideTree();
+			
+			
+			
+			
+			/// Build a wide node from the specified QBVH node and recursively build its children after it.
+			/**
+			  * This method returns the number of wide nodes in the subtree created.
+			  */
+			static Size buildWideTreeRecursive( WideNodeType* wideNode, const QBVHArrayTreeNode* node );
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -387,6 +429,20 @@ class QBVHArrayTree
 			
 			
 			
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			/// A pointer to the array of nodes in the wide version of this QBVHArrayTree.
+			WideNodeType* wideNodes;
+			
+			
+			
+			
+			/// The number of nodes in the wide version of this QBVHArrayTree.
+			Size numWideNodes;
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -176,10 +176,9 @@ class GSOUND_ALIGN(128) QBVHArrayTreeNode
 			/// Return a SIMD mask indicating whether or not each node is a leaf.
 			GSOUND_FORCE_INLINE SIMDBool getLeafMask() const
 			{
-				const SIMDInt leafMask( LEAF_NODE_FLAG, LEAF_NODE_FLAG << 8,
-										LEAF_NODE_FLAG << 16, LEAF_NODE_FLAG << 24 );
+				const SIMDInt leafMask( LEAF_NODE_FLAG );
 				
-				return (SIMDInt(*(const int*)flags) & leafMask) == leafMask;
+				return (getFlags() & leafMask) == leafMask;
 			}
 			
 			
@@ -223,6 +222,19 @@ class GSOUND_ALIGN(128) QBVHArrayTreeNode
 			
 			
 			
+			/// Get the axis-aligned bounding box of the child with the specified index.
+			GSOUND_FORCE_INLINE AABB3 getVolume( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < 4, "Cannot get QBVHArrayTreeNode child volume with invalid index." );
+				
+				return AABB3( volumes.min.x[child], volumes.max.x[child],
+							volumes.min.y[child], volumes.max.y[child],
+							volumes.min.z[child], volumes.max.z[child] );
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -254,12 +266,7 @@ class GSOUND_ALIGN(128) QBVHArrayTreeNode
 			/// Get a SIMD integer representing the number of triangles that each child node contains (if it is a leaf).
 			GSOUND_FORCE_INLINE SIMDInt getNumberOfTriangles() const
 			{
-				SIMDInt triangleCountMask( TRIANGLE_COUNT_MASK, TRIANGLE_COUNT_MASK << 8,
-											TRIANGLE_COUNT_MASK << 16, TRIANGLE_COUNT_MASK << 24 );
-				
-				SIMDInt counts = SIMDInt(*(const int*)flags) & triangleCountMask;
-				
-				return (counts | (counts >> 8) | (counts >> 16) | (counts >> 24)) & SIMDInt(TRIANGLE_COUNT_MASK);
+				return getFlags() & SIMDInt(TRIANGLE_COUNT_MASK);
 			}
 			
 			
@@ -310,6 +317,15 @@ class GSOUND_ALIGN(128) QBVHArrayTreeNode
 			
 			
 			
+			/// Return a SIMD integer containing the flags byte of each child node.
+			GSOUND_FORCE_INLINE SIMDInt getFlags() const
+			{
+				return SIMDInt( flags[0], flags[1], flags[2], flags[3] );
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
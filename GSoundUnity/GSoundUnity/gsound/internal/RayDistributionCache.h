@@ -372,6 +372,28 @@ class RayDistributionCache::Iterator
 			
 			
 			
+			/// Create a ray distribution iterator which starts at the cell with the specified index.
+			/**
+			  * Cells are ordered by latitude within each longitudinal sector, the same
+			  * order in which they are visited by an iterator that starts at the first cell.
+			  * This allows disjoint ranges of cells to be iterated over independently.
+			  */
+			GSOUND_INLINE Iterator( RayDistributionCache& newCache, Index cellIndex )
+				:	cache( newCache ),
+					cell( newCache.cells + cellIndex ),
+					halfNumDivisions( newCache.getNumberOfDivisions() >> 1 )
+			{
+				GSOUND_DEBUG_ASSERT( cellIndex < newCache.getNumberOfCells() );
+				
+				heightIndex = cellIndex % halfNumDivisions;
+				longitudeIndex = cellIndex / halfNumDivisions;
+				height = Real(1) - Real(2)*Real(heightIndex)/Real(halfNumDivisions);
+				longitude = Real(longitudeIndex)*math::pi<Real>() / Real(halfNumDivisions);
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -467,6 +489,23 @@ class RayDistributionCache::Iterator
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Cell Index Accessor Method
+			
+			
+			
+			
+			/// Return the index of the current cell within the ray distribution cache.
+			GSOUND_FORCE_INLINE Index getCellIndex() const
+			{
+				return Index(cell - cache.cells);
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -495,6 +534,22 @@ class RayDistributionCache::Iterator
 			
 			
 			
+			
+			/// Return the range of Y coordinates of the unit directions which the current distribution cell represents.
+			/**
+			  * This is the cosine of the cell's range of latitudes. Since the cells
+			  * have equal heights, uniform sampling of this range and the range of
+			  * longitudes is uniform over the cell's solid angle.
+			  */
+			GSOUND_FORCE_INLINE AABB1 getCellHeights() const
+			{
+				Real height2 = Real(1) - Real(2)*Real(heightIndex + 1)/Real(halfNumDivisions);
+				
+				return AABB1( -height, -height2 );
+			}
+			
+			
+			
 	private:
 		
 		//********************************************************************************
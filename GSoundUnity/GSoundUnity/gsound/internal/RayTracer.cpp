@@ -61,6 +61,14 @@
 #include "RayTracer.h"
 
 
+#if GSOUND_PROPAGATION_STATISTICS
+	/// Add the specified amount to one of the ray tracer's statistics counters.
+	#define GSOUND_COUNT_STATISTIC( counter, amount ) (statistics.counter += Size(amount))
+#else
+	#define GSOUND_COUNT_STATISTIC( counter, amount )
+#endif
+
+
 //##########################################################################################
 //**************************  Start GSound Internal Namespace  *****************************
 GSOUND_INTERNAL_NAMESPACE_START
@@ -171,44 +179,58 @@ RayTracer& RayTracer:: operator = ( const RayTracer& other )
 
 Bool RayTracer:: traceProbeRay( const Ray3& ray, Real& closestIntersection, ObjectSpaceTriangle& objectTriangle )
 {
+	GSOUND_COUNT_STATISTIC( numRaysTraced, 1 );
+	
 	if ( objectBVH == NULL )
 		return false;
 	
+	// Stack entries which point into the BVH's object list are leaves, all others are nodes.
+	SoundObject* const* const objectsStart = objectBVH->getObjects();
+	SoundObject* const* const objectsEnd = objectsStart + objectBVH->getNumberOfObjects();
+	
 	// Setup the first element in the stack with the root node of the object hierarchy.
 	const void** stackElement = stack + 1;
-	*stackElement = objectBVH;
+	*stackElement = objectBVH->getRoot();
+	
+	// A SIMD copy of the ray which is tested against all 4 children of a node at once.
+	const FatSIMDRay3 simdRay( ray );
 	
 	// Keep track of the parameter along the ray's direction where the closest intersection has occurred.
 	closestIntersection = math::max<Real>();
 	Bool foundIntersection = false;
 	
-	// A temporary variable used to hold the ray parameter of the ray's intersection with a BVH node.
-	Real temporaryIntersectionT;
+	// A temporary variable used to hold the ray parameters of the ray's intersections with a node's children.
+	SIMDFloat temporaryIntersectionT;
 	
 	// Trace ray through the object BVH tree.
 	do
 	{
-		register ObjectBVHType* objectNode = ((ObjectBVHType*)*stackElement);
+		const void* stackEntry = *stackElement;
 		stackElement--;
 		
-		// Does the ray intersect the current node, and if it does, is the intersection closer than
-		// the current closest intersection?
-		if ( rayIntersectsSphere( ray, objectNode->getVolume(), temporaryIntersectionT ) && 
-			temporaryIntersectionT < closestIntersection )
+		if ( stackEntry >= objectsStart && stackEntry < objectsEnd )
 		{
-			if ( objectNode->isLeaf() )
-			{
-				const SoundObject* object = objectNode->getObject();
-				
-				foundIntersection |= traceObjectSpaceProbeRay( ray, object, (const TriangleNodeType**)stackElement,
+			const SoundObject* object = *(SoundObject* const*)stackEntry;
+			
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			foundIntersection |= traceObjectSpaceProbeRayWide( ray, object, (const WideTriangleNodeType**)stackElement,
 																closestIntersection, objectTriangle );
-			}
-			else
-			{
-				// Push the right child on the stack first, then the left child.
-				*(++stackElement) = objectNode->getRightChild();
-				*(++stackElement) = objectNode->getLeftChild();
-			}
+#else
+			foundIntersection |= traceObjectSpaceProbeRay( ray, object, (const TriangleNodeType**)stackElement,
+															closestIntersection, objectTriangle );
+#endif
+		}
+		else
+		{
+			const ObjectNodeType* objectNode = (const ObjectNodeType*)stackEntry;
+			GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+			
+			// Find the children that the ray intersects closer than the current closest intersection.
+			SIMDBool intersectionResults = rayIntersectsBoxSIMD( simdRay, objectNode->getVolumes(), temporaryIntersectionT );
+			intersectionResults &= temporaryIntersectionT < SIMDFloat(closestIntersection);
+			
+			// Visit the intersected children from nearest to farthest.
+			stackElement = pushObjectNodeChildren( objectNode, intersectionResults, temporaryIntersectionT, stackElement );
 		}
 	}
 	while ( stackElement != stack );
@@ -260,6 +282,7 @@ Bool RayTracer:: traceObjectSpaceProbeRay( const Ray3& worldSpaceRay, const Soun
 	{
 		const TriangleNodeType* triangleNode = *stackElement;
 		stackElement--;
+		GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
 		
 		// Test to see if the ray intersects the bounding boxes of this node's children.
 		SIMDBool intersectionResults = rayIntersectsBoxSIMD( ray, triangleNode->getVolumes(), temporaryIntersectionT ); 
@@ -287,6 +310,7 @@ Bool RayTracer:: traceObjectSpaceProbeRay( const Ray3& worldSpaceRay, const Soun
 				*(++stackElement) = triangleNode + innerNodeOffsets[i];
 			else if ( numLeafTriangles[i] )
 			{
+				GSOUND_COUNT_STATISTIC( numTrianglesTested, 4*numLeafTriangles[i] );
 				foundIntersection |= rayIntersectsTriangles( ray, triangles + offsets[i],
 															numLeafTriangles[i],
 															objectSpaceClosestT, objectSpaceClosestTriangle );
@@ -308,10 +332,11 @@ Bool RayTracer:: traceObjectSpaceProbeRay( const Ray3& worldSpaceRay, const Soun
 
 
 
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Binary Occlusion Ray Tracing Methods
+//############		Wide BVH Ray Tracing Methods
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -319,21 +344,176 @@ Bool RayTracer:: traceObjectSpaceProbeRay( const Ray3& worldSpaceRay, const Soun
 
 
 
-Bool RayTracer:: traceBinaryOcclusionRay( const Ray3& ray, Real tMax )
+Bool RayTracer:: traceObjectSpaceProbeRayWide( const Ray3& worldSpaceRay, const SoundObject* object,
+												const WideTriangleNodeType** stackBase,
+												Real& closestIntersection, ObjectSpaceTriangle& closestTriangle )
+{
+	//***********************************************************************************
+	// Transform the ray and the closest intersection into object space.
+	
+	// Get the transformation from the object.
+	const Transformation3& objectTransformation = object->getTransformation();
+	
+	// Transform the ray and closest T.
+	FatSIMDRay3 ray( objectTransformation.transformToObjectSpace( worldSpaceRay ) );
+	SIMDFloat objectSpaceClosestT( objectTransformation.transformToObjectSpace( closestIntersection ) );
+	
+	// Declare a pointer to keep track of the closest triangle.
+	const TriangleType* objectSpaceClosestTriangle = nullptr;
+	
+	//***********************************************************************************
+	// Prepare the ray tracing stack for traversing the object's wide triangle BVH.
+	
+	// Get the triangle BVH.
+	const TriangleTreeType* triangleBVH = object->getMesh()->getBVH();
+	
+	// Get a pointer to the start of the internal triangle array so that we can index into it.
+	const FatSIMDTriangle3* triangles = triangleBVH->getTriangles();
+	
+	// Push the root of the wide triangle BVH onto the stack.
+	const WideTriangleNodeType** stackElement = stackBase + 1;
+	*stackElement = triangleBVH->getWideRoot();
+	
+	// A temporary variable used to hold the ray parameters of the ray's intersections with the children of a node.
+	SIMDFloatN temporaryIntersectionT;
+	
+	// Whether or not an intersection has been encountered.
+	Bool foundIntersection = false;
+	
+	do
+	{
+		const WideTriangleNodeType* triangleNode = *stackElement;
+		stackElement--;
+		GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+		
+		// Test the ray against the bounding boxes of all of this node's children at once.
+		SIMDBoolN intersectionResults = rayIntersectsBoxesWide( ray, triangleNode, temporaryIntersectionT );
+		
+		// Avoid looking at nodes that are farther away than intersections that are already detected.
+		intersectionResults &= temporaryIntersectionT < SIMDFloatN( objectSpaceClosestT[0] );
+		
+		if ( !intersectionResults )
+			continue;
+		
+		//**************************************************************************************
+		// Push the intersected inner children onto the stack and intersect the triangles
+		// of the intersected leaves.
+		
+		// Take the intersected children from a bit mask rather than reading the vector's lanes.
+		const UInt32 childMask = intersectionResults.getMask();
+		
+		for ( Index i = 0; i < GSOUND_TRIANGLE_BVH_WIDTH; i++ )
+		{
+			if ( !(childMask & (UInt32(1) << i)) )
+				continue;
+			
+			if ( !triangleNode->isLeaf(i) )
+				*(++stackElement) = triangleNode->getChild(i);
+			else
+			{
+				GSOUND_COUNT_STATISTIC( numTrianglesTested, 4*triangleNode->getNumberOfTriangles(i) );
+				foundIntersection |= rayIntersectsTriangles( ray, triangles + triangleNode->getTriangleStartIndex(i),
+															triangleNode->getNumberOfTriangles(i),
+															objectSpaceClosestT, objectSpaceClosestTriangle );
+			}
+		}
+	}
+	while ( stackElement != stackBase );
+	
+	// If there was an intersection found, transform the intersection T and triangle into world space.
+	if ( foundIntersection )
+	{
+		closestTriangle = ObjectSpaceTriangle( objectSpaceClosestTriangle, object );
+		closestIntersection = objectTransformation.transformToWorldSpace( objectSpaceClosestT[0] );
+	}
+	
+	return foundIntersection;
+}
+
+
+
+
+Bool RayTracer:: traceObjectSpaceOcclusionRayWide( const Ray3& worldSpaceRay, const SoundObject* object,
+													const WideTriangleNodeType** stackBase, Real maxDistance )
 {
-	Real closestIntersection;
-	ObjectSpaceTriangle triangle;
+	//***********************************************************************************
+	// Transform the ray and the maximum distance into object space.
+	
+	// Get the transformation from the object.
+	const Transformation3& objectTransformation = object->getTransformation();
+	
+	// Transform the ray and maximum T.
+	FatSIMDRay3 ray( objectTransformation.transformToObjectSpace( worldSpaceRay ) );
+	Real objectSpaceMaxDistance = objectTransformation.transformToObjectSpace( maxDistance );
+	
+	//***********************************************************************************
+	// Prepare the ray tracing stack for traversing the object's wide triangle BVH.
+	
+	// Get the triangle BVH.
+	const TriangleTreeType* triangleBVH = object->getMesh()->getBVH();
+	
+	// Get a pointer to the start of the internal triangle array so that we can index into it.
+	const FatSIMDTriangle3* triangles = triangleBVH->getTriangles();
+	
+	// Push the root of the wide triangle BVH onto the stack.
+	const WideTriangleNodeType** stackElement = stackBase + 1;
+	*stackElement = triangleBVH->getWideRoot();
+	
+	// A temporary variable used to hold the ray parameters of the ray's intersections with the children of a node.
+	SIMDFloatN temporaryIntersectionT;
+	
+	do
+	{
+		const WideTriangleNodeType* triangleNode = *stackElement;
+		stackElement--;
+		GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+		
+		// Test the ray against the bounding boxes of all of this node's children at once.
+		SIMDBoolN intersectionResults = rayIntersectsBoxesWide( ray, triangleNode, temporaryIntersectionT );
+		
+		// Clamp the ray interval to the maximum occlusion distance.
+		intersectionResults &= temporaryIntersectionT < objectSpaceMaxDistance;
+		
+		if ( !intersectionResults )
+			continue;
+		
+		//**************************************************************************************
+		// Push the intersected inner children onto the stack. Stop at the first
+		// triangle of an intersected leaf that occludes the ray.
+		
+		// Take the intersected children from a bit mask rather than reading the vector's lanes.
+		const UInt32 childMask = intersectionResults.getMask();
+		
+		for ( Index i = 0; i < GSOUND_TRIANGLE_BVH_WIDTH; i++ )
+		{
+			if ( !(childMask & (UInt32(1) << i)) )
+				continue;
+			
+			if ( !triangleNode->isLeaf(i) )
+				*(++stackElement) = triangleNode->getChild(i);
+			else
+			{
+				GSOUND_COUNT_STATISTIC( numTrianglesTested, 4*triangleNode->getNumberOfTriangles(i) );
+				
+				if ( rayIntersectsAnyTriangle( ray, triangles + triangleNode->getTriangleStartIndex(i),
+												triangleNode->getNumberOfTriangles(i), SIMDFloat( objectSpaceMaxDistance ) ) )
+					return true;
+			}
+		}
+	}
+	while ( stackElement != stackBase );
 	
-	return traceProbeRay( ray, closestIntersection, triangle ) && closestIntersection < tMax;
+	return false;
 }
 
 
 
 
+#endif
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Transmission Ray Tracing Method
+//############		Probe Ray Packet Tracing Methods
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -341,68 +521,151 @@ Bool RayTracer:: traceBinaryOcclusionRay( const Ray3& ray, Real tMax )
 
 
 
-Bool RayTracer:: traceTransmissionRay( const Ray3& ray, Real maxDistance, ArrayList<RayIntersection>& intersections )
+Bool RayTracer:: traceProbeRayPacket( const Ray3* rays, Size numRays, Bool* hits,
+										Real* closestIntersections, ObjectSpaceTriangle* triangles )
 {
+	numRays = math::min( numRays, PROBE_RAY_PACKET_SIZE );
+	
+	// Fall back to tracing the rays one at a time if the packet isn't coherent.
+	if ( numRays < 2 || !rayPacketIsCoherent( rays, numRays ) )
+	{
+		Bool foundIntersection = false;
+		
+		for ( Index i = 0; i < numRays; i++ )
+		{
+			hits[i] = traceProbeRay( rays[i], closestIntersections[i], triangles[i] );
+			foundIntersection |= hits[i];
+		}
+		
+		return foundIntersection;
+	}
+	
+	for ( Index i = 0; i < numRays; i++ )
+		hits[i] = false;
+	
+	GSOUND_COUNT_STATISTIC( numRaysTraced, numRays );
+	
 	if ( objectBVH == NULL )
 		return false;
 	
+	// Fill the unused lanes of the packet with copies of the first ray and mask them out.
+	Ray3 packetRays[PROBE_RAY_PACKET_SIZE];
+	Real packetClosestIntersections[PROBE_RAY_PACKET_SIZE];
+	ObjectSpaceTriangle packetTriangles[PROBE_RAY_PACKET_SIZE];
+	
+	for ( Index i = 0; i < PROBE_RAY_PACKET_SIZE; i++ )
+	{
+		packetRays[i] = rays[i < numRays ? i : 0];
+		packetClosestIntersections[i] = math::max<Real>();
+	}
+	
+	const SIMDBool activeRays( numRays > 0, numRays > 1, numRays > 2, numRays > 3 );
+	
+	// Stack entries which point into the BVH's object list are leaves, all others are nodes.
+	SoundObject* const* const objectsStart = objectBVH->getObjects();
+	SoundObject* const* const objectsEnd = objectsStart + objectBVH->getNumberOfObjects();
+	
 	// Setup the first element in the stack with the root node of the object hierarchy.
 	const void** stackElement = stack + 1;
-	*stackElement = objectBVH;
+	*stackElement = objectBVH->getRoot();
 	
-	// Whether or not this ray has intersected any triangles.
-	Bool foundIntersection = false;
+	// A SIMD packet of the world-space rays which is tested against each child box of a node.
+	const FatSIMDRay3 packetRay( packetRays[0], packetRays[1], packetRays[2], packetRays[3] );
 	
-	// A temporary variable used to hold the ray parameter of the ray's intersection with a BVH node.
-	Real temporaryIntersectionT;
+	// The rays of the packet that have intersected a triangle.
+	SIMDBool foundIntersections( false );
 	
-	// Trace ray through the object BVH tree.
+	// A temporary variable used to hold the ray parameters of the rays' intersections with a child box.
+	SIMDFloat temporaryIntersectionT;
+	
+	// Trace the packet through the object BVH tree.
 	do
 	{
-		register ObjectBVHType* objectNode = ((ObjectBVHType*)*stackElement);
+		const void* stackEntry = *stackElement;
 		stackElement--;
 		
-		// Does the ray intersect the current node, and if it does, is the intersection closer than
-		// the maximum allowed intersection distance.
-		if ( rayIntersectsSphere( ray, objectNode->getVolume(), temporaryIntersectionT ) && 
-			temporaryIntersectionT < maxDistance )
+		if ( stackEntry >= objectsStart && stackEntry < objectsEnd )
+		{
+			foundIntersections |= traceObjectSpaceProbeRayPacket( packetRays, activeRays, *(SoundObject* const*)stackEntry,
+																(const TriangleNodeType**)stackElement,
+																packetClosestIntersections, packetTriangles );
+		}
+		else
 		{
-			if ( objectNode->isLeaf() )
+			const ObjectNodeType* objectNode = (const ObjectNodeType*)stackEntry;
+			GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+			
+			const SIMDFloat packetClosestT( packetClosestIntersections[0], packetClosestIntersections[1],
+											packetClosestIntersections[2], packetClosestIntersections[3] );
+			
+			// Visit a child if any ray of the packet intersects it closer than that ray's closest
+			// intersection. The child's distance is the nearest such intersection.
+			Bool childHits[4];
+			Real childDistances[4];
+			
+			for ( Index i = 0; i < 4; i++ )
 			{
-				const SoundObject* object = objectNode->getObject();
+				SIMDBool childRays = rayIntersectsBoxSIMD( packetRay, SIMDAABB3( objectNode->getVolume(i) ), temporaryIntersectionT );
+				childRays &= (temporaryIntersectionT < packetClosestT) & activeRays;
 				
-				foundIntersection |= traceObjectSpaceTransmissionRay( ray, object, (const TriangleNodeType**)stackElement,
-																	maxDistance, intersections );
-			}
-			else
-			{
-				// Push the right child on the stack first, then the left child.
-				*(++stackElement) = objectNode->getRightChild();
-				*(++stackElement) = objectNode->getLeftChild();
+				childHits[i] = childRays;
+				childDistances[i] = math::max<Real>();
+				
+				for ( Index j = 0; j < PROBE_RAY_PACKET_SIZE; j++ )
+				{
+					if ( childRays[j] )
+						childDistances[i] = math::min( childDistances[i], temporaryIntersectionT[j] );
+				}
 			}
+			
+			// Visit the intersected children from nearest to farthest.
+			stackElement = pushObjectNodeChildren( objectNode, SIMDBool( childHits[0], childHits[1], childHits[2], childHits[3] ),
+													SIMDFloat( childDistances[0], childDistances[1], childDistances[2], childDistances[3] ),
+													stackElement );
 		}
 	}
 	while ( stackElement != stack );
 	
-	return foundIntersection;
+	// Copy the results for the used lanes to the output.
+	for ( Index i = 0; i < numRays; i++ )
+	{
+		if ( foundIntersections[i] )
+		{
+			hits[i] = true;
+			closestIntersections[i] = packetClosestIntersections[i];
+			triangles[i] = packetTriangles[i];
+		}
+	}
+	
+	return foundIntersections & activeRays;
 }
 
 
 
 
-Bool RayTracer:: traceObjectSpaceTransmissionRay( const Ray3& worldSpaceRay, const SoundObject* object, 
-												const TriangleNodeType** stackBase,
-												Real maxDistance, ArrayList<RayIntersection>& intersections )
+SIMDBool RayTracer:: traceObjectSpaceProbeRayPacket( const Ray3* worldSpaceRays, const SIMDBool& activeRays,
+													const SoundObject* object, const TriangleNodeType** stackBase,
+													Real* closestIntersections, ObjectSpaceTriangle* closestTriangles )
 {
 	//***********************************************************************************
-	// Transform the ray and the closest intersection into object space.
+	// Transform the rays and the closest intersections into object space.
 	
 	// Get the transformation from the object.
 	const Transformation3& objectTransformation = object->getTransformation();
 	
-	// Transform the ray and closest T.
-	FatSIMDRay3 ray( objectTransformation.transformToObjectSpace( worldSpaceRay ) );
-	SIMDFloat objectSpaceMaxDistance( objectTransformation.transformToObjectSpace( maxDistance ) );
+	// Transform the rays and closest T's.
+	FatSIMDRay3 rays( objectTransformation.transformToObjectSpace( worldSpaceRays[0] ),
+					objectTransformation.transformToObjectSpace( worldSpaceRays[1] ),
+					objectTransformation.transformToObjectSpace( worldSpaceRays[2] ),
+					objectTransformation.transformToObjectSpace( worldSpaceRays[3] ) );
+	
+	SIMDFloat objectSpaceClosestT( objectTransformation.transformToObjectSpace( closestIntersections[0] ),
+									objectTransformation.transformToObjectSpace( closestIntersections[1] ),
+									objectTransformation.transformToObjectSpace( closestIntersections[2] ),
+									objectTransformation.transformToObjectSpace( closestIntersections[3] ) );
+	
+	// Keep track of the closest triangle for each ray.
+	const TriangleType* objectSpaceClosestTriangles[PROBE_RAY_PACKET_SIZE] = { nullptr, nullptr, nullptr, nullptr };
 	
 	//***********************************************************************************
 	// Prepare the ray tracing stack for traversing the object's triangle BVH.
@@ -417,135 +680,87 @@ Bool RayTracer:: traceObjectSpaceTransmissionRay( const Ray3& worldSpaceRay, con
 	const TriangleNodeType** stackElement = stackBase + 1;
 	*stackElement = triangleBVH->getRoot();
 	
-	// A temporary variable used to hold the ray parameter of the ray's intersection with a BVH node.
+	// A temporary variable used to hold the ray parameters of the rays' intersections with a BVH node.
 	SIMDFloat temporaryIntersectionT;
 	
-	// Whether or not an intersection has been encountered.
-	Bool foundIntersection = false;
+	// The rays which have found a closer intersection in this object.
+	SIMDBool foundIntersections( false );
 	
 	do
 	{
 		const TriangleNodeType* triangleNode = *stackElement;
 		stackElement--;
+		GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
 		
-		// Test to see if the ray intersects the bounding boxes of this node's children.
-		SIMDBool intersectionResults = rayIntersectsBoxSIMD( ray, triangleNode->getVolumes(), temporaryIntersectionT ); 
-		
-		//**************************************************************************************
-		// Sort the child nodes in the order that we will visit them based on the ray's direction
-		// and the split axes of the node.
-		
-		// Avoid looking at nodes that are farther away than the maximum allowed distance.
-		intersectionResults &= temporaryIntersectionT < objectSpaceMaxDistance;
-		
+		const SIMDAABB3& childVolumes = triangleNode->getVolumes();
 		SIMDInt offsets = triangleNode->getChildOffsets();
 		SIMDInt numLeafTriangles = triangleNode->getNumberOfTriangles();
-		SIMDInt innerNodeOffsets = offsets & intersectionResults & (numLeafTriangles == SIMDInt(0));
-		
-		numLeafTriangles = numLeafTriangles & intersectionResults;
 		
 		//**************************************************************************************
-		// Push the child nodes onto the stack in sorted order if they are not leaves.
-		// If a child is a leaf, intersect its triangles with the ray.
+		// Test each child's bounding box against all rays of the packet. Push the child nodes
+		// that any ray hits onto the stack, or intersect their triangles if they are leaves.
 		
 		for ( Index i = 0; i < 4; i++ )
 		{
-			// If the child is an inner node, push it onto the stack.
-			if ( innerNodeOffsets[i] )
-				*(++stackElement) = triangleNode + innerNodeOffsets[i];
-			else if ( numLeafTriangles[i] )
+			// Skip empty child nodes.
+			if ( !offsets[i] && !numLeafTriangles[i] )
+				continue;
+			
+			SIMDAABB3 childVolume( AABB3( Vector3( childVolumes.min.x[i], childVolumes.min.y[i], childVolumes.min.z[i] ),
+										Vector3( childVolumes.max.x[i], childVolumes.max.y[i], childVolumes.max.z[i] ) ) );
+			
+			// Avoid looking at nodes that are farther away than each ray's closest intersection.
+			SIMDBool childRays = rayIntersectsBoxSIMD( rays, childVolume, temporaryIntersectionT );
+			childRays &= (temporaryIntersectionT < objectSpaceClosestT) & activeRays;
+			
+			if ( !childRays )
+				continue;
+			
+			if ( !numLeafTriangles[i] )
+				*(++stackElement) = triangleNode + offsets[i];
+			else
 			{
-				// This is a leaf node, test its triangles for intersections.
-				
-				const FatSIMDTriangle3* leafTriangles = triangles + offsets[i];
-				const FatSIMDTriangle3* const leafTrianglesEnd = leafTriangles + numLeafTriangles[i];
-				
-				while ( leafTriangles != leafTrianglesEnd )
-				{
-					// Find the intersection(s) of the ray with 4 triangles.
-					SIMDBool intersectionResults = rayIntersectsTriangleSIMD( ray, 
-														leafTriangles->v0, leafTriangles->v1, leafTriangles->v2,
-														temporaryIntersectionT );
-					
-					// Cull any intersections that are beyond the maximum allowed distance.
-					intersectionResults &= temporaryIntersectionT < objectSpaceMaxDistance;
-					
-					// If there were any intersections, update the variable which keeps track of that.
-					foundIntersection |= intersectionResults;
-					
-					// For each intersection, add it to the list of output intersections.
-					for ( Index i = 0; i < 4; i++ )
-					{
-						if ( intersectionResults[i] )
-						{
-							// Compute the world-space ray parameter of this intersection.
-							Real worldSpaceT = objectTransformation.transformToWorldSpace( temporaryIntersectionT[i] );
-							
-							// Add the intersection to the list of of output intersections.
-							intersections.add( RayIntersection( worldSpaceT,
-													ObjectSpaceTriangle( leafTriangles->getTrianglePointer(i), object ) ) );
-						}
-					}
-					
-					leafTriangles++;
-				}
+				// Each triangle is tested against all of the rays in the packet.
+				GSOUND_COUNT_STATISTIC( numTrianglesTested, 4*PROBE_RAY_PACKET_SIZE*numLeafTriangles[i] );
+				foundIntersections |= rayPacketIntersectsTriangles( rays, childRays, triangles + offsets[i],
+																	numLeafTriangles[i], objectSpaceClosestT,
+																	objectSpaceClosestTriangles );
 			}
 		}
 	}
 	while ( stackElement != stackBase );
 	
-	return foundIntersection;
+	// Transform the intersection T's and triangles of the rays that found a closer intersection into world space.
+	for ( Index i = 0; i < PROBE_RAY_PACKET_SIZE; i++ )
+	{
+		if ( foundIntersections[i] )
+		{
+			closestTriangles[i] = ObjectSpaceTriangle( objectSpaceClosestTriangles[i], object );
+			closestIntersections[i] = objectTransformation.transformToWorldSpace( objectSpaceClosestT[i] );
+		}
+	}
+	
+	return foundIntersections;
 }
 
 
 
 
-//##########################################################################################
-//##########################################################################################
-//############		
-//############		Ray-Sphere Intersection Methods
-//############		
-//##########################################################################################
-//##########################################################################################
-
-
-
-
-Bool RayTracer:: rayIntersectsSphere( const Ray3& ray, const BoundingSphere& sphere, Real& distanceAlongRay )
+Bool RayTracer:: rayPacketIsCoherent( const Ray3* rays, Size numRays )
 {
-	Vector3 d = sphere.position - ray.origin;
-	Real dSquared = d.getMagnitudeSquared();
-	Real rSquared = sphere.radius*sphere.radius;
+	const Vector3& firstDirection = rays[0].direction;
 	
-	if ( dSquared < rSquared )
-	{
-		// The ray starts inside the sphere and therefore we have an intersection.
-		distanceAlongRay = Real(0);
-		
-		return true;
-	}
-	else
+	for ( Index i = 1; i < numRays; i++ )
 	{
-		// Find the closest point on the ray to the sphere's center.
-		Real t1 = math::dot( d, ray.direction );
-		
-		if ( t1 < Real(0) )
-		{
-			// The ray points away from the sphere so there is no intersection.
-			return false;
-		}
+		const Vector3& direction = rays[i].direction;
 		
-		// Find the distance from the closest point to the sphere's surface.
-		Real t2Squared = rSquared - dSquared + t1*t1;
-		
-		if ( t2Squared < Real(0) )
+		if ( (direction.x > Real(0)) != (firstDirection.x > Real(0)) ||
+			(direction.y > Real(0)) != (firstDirection.y > Real(0)) ||
+			(direction.z > Real(0)) != (firstDirection.z > Real(0)) )
 			return false;
-		
-		// Compute the distance along the ray of the intersection.
-		distanceAlongRay = t1 - math::sqrt(t2Squared);
-		
-		return true;
 	}
+	
+	return true;
 }
 
 
@@ -554,7 +769,7 @@ Bool RayTracer:: rayIntersectsSphere( const Ray3& ray, const BoundingSphere& sph
 //##########################################################################################
 //##########################################################################################
 //############		
-//############		Ray-Box Intersection Methods
+//############		Binary Occlusion Ray Tracing Methods
 //############		
 //##########################################################################################
 //##########################################################################################
@@ -562,10 +777,950 @@ Bool RayTracer:: rayIntersectsSphere( const Ray3& ray, const BoundingSphere& sph
 
 
 
-SIMDBool RayTracer:: rayIntersectsBoxSIMD( const FatSIMDRay3& ray, const SIMDAABB3& box,
-										SIMDFloat& distanceAlongRay )
+Bool RayTracer:: traceBinaryOcclusionRay( const Ray3& ray, Real tMax )
 {
-	SIMDFloat tmin = (box.getMinMax(1 - ray.sign[0]).x - ray.origin.x) * ray.inverseDirection.x;
+	GSOUND_COUNT_STATISTIC( numRaysTraced, 1 );
+	
+	if ( objectBVH == NULL )
+		return false;
+	
+	// Stack entries which point into the BVH's object list are leaves, all others are nodes.
+	SoundObject* const* const objectsStart = objectBVH->getObjects();
+	SoundObject* const* const objectsEnd = objectsStart + objectBVH->getNumberOfObjects();
+	
+	// Setup the first element in the stack with the root node of the object hierarchy.
+	const void** stackElement = stack + 1;
+	*stackElement = objectBVH->getRoot();
+	
+	// A SIMD copy of the ray which is tested against all 4 children of a node at once.
+	const FatSIMDRay3 simdRay( ray );
+	const SIMDFloat simdTMax( tMax );
+	
+	// A temporary variable used to hold the ray parameters of the ray's intersections with a node's children.
+	SIMDFloat temporaryIntersectionT;
+	
+	// Trace ray through the object BVH tree.
+	do
+	{
+		const void* stackEntry = *stackElement;
+		stackElement--;
+		
+		if ( stackEntry >= objectsStart && stackEntry < objectsEnd )
+		{
+			const SoundObject* object = *(SoundObject* const*)stackEntry;
+			
+			// Stop as soon as any object occludes the ray.
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			if ( traceObjectSpaceOcclusionRayWide( ray, object, (const WideTriangleNodeType**)stackElement, tMax ) )
+				return true;
+#else
+			if ( traceObjectSpaceOcclusionRay( ray, object, (const TriangleNodeType**)stackElement, tMax ) )
+				return true;
+#endif
+		}
+		else
+		{
+			const ObjectNodeType* objectNode = (const ObjectNodeType*)stackEntry;
+			GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+			
+			// Find the children that the ray intersects closer than the maximum occlusion distance.
+			SIMDBool intersectionResults = rayIntersectsBoxSIMD( simdRay, objectNode->getVolumes(), temporaryIntersectionT );
+			intersectionResults &= temporaryIntersectionT < simdTMax;
+			
+			stackElement = pushObjectNodeChildren( objectNode, intersectionResults, temporaryIntersectionT, stackElement );
+		}
+	}
+	while ( stackElement != stack );
+	
+	return false;
+}
+
+
+
+
+Bool RayTracer:: traceObjectSpaceOcclusionRay( const Ray3& worldSpaceRay, const SoundObject* object,
+												const TriangleNodeType** stackBase, Real maxDistance )
+{
+	//***********************************************************************************
+	// Transform the ray and the maximum distance into object space.
+	
+	// Get the transformation from the object.
+	const Transformation3& objectTransformation = object->getTransformation();
+	
+	// Transform the ray and maximum T.
+	FatSIMDRay3 ray( objectTransformation.transformToObjectSpace( worldSpaceRay ) );
+	SIMDFloat objectSpaceMaxDistance( objectTransformation.transformToObjectSpace( maxDistance ) );
+	
+	//***********************************************************************************
+	// Prepare the ray tracing stack for traversing the object's triangle BVH.
+	
+	// Get the root of the triangle BVH.
+	const TriangleTreeType* triangleBVH = object->getMesh()->getBVH();
+	
+	// Get a pointer to the start of the internal triangle array so that we can index into it.
+	const FatSIMDTriangle3* triangles = triangleBVH->getTriangles();
+	
+	// Push the root of the triangle BVH onto the stack.
+	const TriangleNodeType** stackElement = stackBase + 1;
+	*stackElement = triangleBVH->getRoot();
+	
+	// A temporary variable used to hold the ray parameter of the ray's intersection with a BVH node.
+	SIMDFloat temporaryIntersectionT;
+	
+	do
+	{
+		const TriangleNodeType* triangleNode = *stackElement;
+		stackElement--;
+		GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+		
+		// Test to see if the ray intersects the bounding boxes of this node's children.
+		SIMDBool intersectionResults = rayIntersectsBoxSIMD( ray, triangleNode->getVolumes(), temporaryIntersectionT ); 
+		
+		// Clamp the ray interval to the maximum occlusion distance.
+		intersectionResults &= temporaryIntersectionT < objectSpaceMaxDistance;
+		
+		SIMDInt offsets = triangleNode->getChildOffsets();
+		SIMDInt numLeafTriangles = triangleNode->getNumberOfTriangles();
+		SIMDInt innerNodeOffsets = offsets & intersectionResults & (numLeafTriangles == SIMDInt(0));
+		
+		numLeafTriangles = numLeafTriangles & intersectionResults;
+		
+		//**************************************************************************************
+		// Push the child nodes onto the stack if they are not leaves.
+		// If a child is a leaf, stop at the first of its triangles that occludes the ray.
+		
+		for ( Index i = 0; i < 4; i++ )
+		{
+			if ( innerNodeOffsets[i] )
+				*(++stackElement) = triangleNode + innerNodeOffsets[i];
+			else if ( numLeafTriangles[i] )
+			{
+				GSOUND_COUNT_STATISTIC( numTrianglesTested, 4*numLeafTriangles[i] );
+				
+				if ( rayIntersectsAnyTriangle( ray, triangles + offsets[i], numLeafTriangles[i], objectSpaceMaxDistance ) )
+					return true;
+			}
+		}
+	}
+	while ( stackElement != stackBase );
+	
+	return false;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Transmission Ray Tracing Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Bool RayTracer:: traceTransmissionRay( const Ray3& ray, Real maxDistance, Real audibilityThreshold,
+										ArrayList<RayIntersection>& intersections )
+{
+	GSOUND_COUNT_STATISTIC( numRaysTraced, 1 );
+	
+	if ( objectBVH == NULL )
+		return false;
+	
+	// Stack entries which point into the BVH's object list are leaves, all others are nodes.
+	SoundObject* const* const objectsStart = objectBVH->getObjects();
+	SoundObject* const* const objectsEnd = objectsStart + objectBVH->getNumberOfObjects();
+	
+	// Setup the first element in the stack with the root node of the object hierarchy.
+	const void** stackElement = stack + 1;
+	*stackElement = objectBVH->getRoot();
+	
+	// A SIMD copy of the ray which is tested against all 4 children of a node at once.
+	const FatSIMDRay3 simdRay( ray );
+	const SIMDFloat simdMaxDistance( maxDistance );
+	
+	// Whether or not this ray has intersected any triangles.
+	Bool foundIntersection = false;
+	
+	// A bound on the attenuation of the sound transmitted along the ray.
+	TransmissionBound bound( audibilityThreshold );
+	
+	// A temporary variable used to hold the ray parameters of the ray's intersections with a node's children.
+	SIMDFloat temporaryIntersectionT;
+	
+	// Trace ray through the object BVH tree.
+	do
+	{
+		const void* stackEntry = *stackElement;
+		stackElement--;
+		
+		if ( stackEntry >= objectsStart && stackEntry < objectsEnd )
+		{
+			const SoundObject* object = *(SoundObject* const*)stackEntry;
+			
+			foundIntersection |= traceObjectSpaceTransmissionRay( ray, object, (const TriangleNodeType**)stackElement,
+																maxDistance, bound, intersections );
+			
+			// Stop as soon as no audible sound can be transmitted along the ray.
+			if ( !bound.isAudible() )
+			{
+				intersections.clear();
+				return false;
+			}
+		}
+		else
+		{
+			const ObjectNodeType* objectNode = (const ObjectNodeType*)stackEntry;
+			GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+			
+			// Find the children that the ray intersects closer than the maximum allowed intersection distance.
+			SIMDBool intersectionResults = rayIntersectsBoxSIMD( simdRay, objectNode->getVolumes(), temporaryIntersectionT );
+			intersectionResults &= temporaryIntersectionT < simdMaxDistance;
+			
+			stackElement = pushObjectNodeChildren( objectNode, intersectionResults, temporaryIntersectionT, stackElement );
+		}
+	}
+	while ( stackElement != stack );
+	
+	return foundIntersection;
+}
+
+
+
+
+Bool RayTracer:: traceObjectSpaceTransmissionRay( const Ray3& worldSpaceRay, const SoundObject* object, 
+												const TriangleNodeType** stackBase, Real maxDistance,
+												TransmissionBound& bound, ArrayList<RayIntersection>& intersections )
+{
+	//***********************************************************************************
+	// Transform the ray and the closest intersection into object space.
+	
+	// Get the transformation from the object.
+	const Transformation3& objectTransformation = object->getTransformation();
+	
+	// Transform the ray and closest T.
+	FatSIMDRay3 ray( objectTransformation.transformToObjectSpace( worldSpaceRay ) );
+	SIMDFloat objectSpaceMaxDistance( objectTransformation.transformToObjectSpace( maxDistance ) );
+	
+	//***********************************************************************************
+	// Prepare the ray tracing stack for traversing the object's triangle BVH.
+	
+	// Get the root of the triangle BVH.
+	const TriangleTreeType* triangleBVH = object->getMesh()->getBVH();
+	
+	// Get a pointer to the start of the internal triangle array so that we can index into it.
+	const FatSIMDTriangle3* triangles = triangleBVH->getTriangles();
+	
+	// Push the root of the triangle BVH onto the stack.
+	const TriangleNodeType** stackElement = stackBase + 1;
+	*stackElement = triangleBVH->getRoot();
+	
+	// A temporary variable used to hold the ray parameter of the ray's intersection with a BVH node.
+	SIMDFloat temporaryIntersectionT;
+	
+	// Whether or not an intersection has been encountered.
+	Bool foundIntersection = false;
+	
+	do
+	{
+		const TriangleNodeType* triangleNode = *stackElement;
+		stackElement--;
+		GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+		
+		// Test to see if the ray intersects the bounding boxes of this node's children.
+		SIMDBool intersectionResults = rayIntersectsBoxSIMD( ray, triangleNode->getVolumes(), temporaryIntersectionT ); 
+		
+		//**************************************************************************************
+		// Sort the child nodes in the order that we will visit them based on the ray's direction
+		// and the split axes of the node.
+		
+		// Avoid looking at nodes that are farther away than the maximum allowed distance.
+		intersectionResults &= temporaryIntersectionT < objectSpaceMaxDistance;
+		
+		SIMDInt offsets = triangleNode->getChildOffsets();
+		SIMDInt numLeafTriangles = triangleNode->getNumberOfTriangles();
+		SIMDInt innerNodeOffsets = offsets & intersectionResults & (numLeafTriangles == SIMDInt(0));
+		
+		numLeafTriangles = numLeafTriangles & intersectionResults;
+		
+		//**************************************************************************************
+		// Push the child nodes onto the stack in sorted order if they are not leaves.
+		// If a child is a leaf, intersect its triangles with the ray.
+		
+		for ( Index i = 0; i < 4; i++ )
+		{
+			// If the child is an inner node, push it onto the stack.
+			if ( innerNodeOffsets[i] )
+				*(++stackElement) = triangleNode + innerNodeOffsets[i];
+			else if ( numLeafTriangles[i] )
+			{
+				// This is a leaf node, test its triangles for intersections.
+				GSOUND_COUNT_STATISTIC( numTrianglesTested, 4*numLeafTriangles[i] );
+				
+				const FatSIMDTriangle3* leafTriangles = triangles + offsets[i];
+				const FatSIMDTriangle3* const leafTrianglesEnd = leafTriangles + numLeafTriangles[i];
+				
+				while ( leafTriangles != leafTrianglesEnd )
+				{
+					// Find the intersection(s) of the ray with 4 triangles.
+					SIMDBool intersectionResults = rayIntersectsTriangleSIMD( ray, 
+														leafTriangles->v0, leafTriangles->v1, leafTriangles->v2,
+														temporaryIntersectionT );
+					
+					// Cull any intersections that are beyond the maximum allowed distance.
+					intersectionResults &= temporaryIntersectionT < objectSpaceMaxDistance;
+					
+					// If there were any intersections, update the variable which keeps track of that.
+					foundIntersection |= intersectionResults;
+					
+					// For each intersection, add it to the list of output intersections.
+					for ( Index i = 0; i < 4; i++ )
+					{
+						if ( intersectionResults[i] )
+						{
+							// Compute the world-space ray parameter of this intersection.
+							Real worldSpaceT = objectTransformation.transformToWorldSpace( temporaryIntersectionT[i] );
+							
+							// Insert the intersection into the list of output intersections in order of distance.
+							insertIntersection( intersections, RayIntersection( worldSpaceT,
+													ObjectSpaceTriangle( leafTriangles->getTrianglePointer(i), object ) ) );
+							
+							// Stop as soon as the ray is inaudible.
+							bound.addIntersection( leafTriangles->getTrianglePointer(i)->getMaterial() );
+							
+							if ( !bound.isAudible() )
+								return true;
+						}
+					}
+					
+					leafTriangles++;
+				}
+			}
+		}
+	}
+	while ( stackElement != stackBase );
+	
+	return foundIntersection;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Occlusion and Transmission Ray Packet Tracing Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Bool RayTracer:: traceBinaryOcclusionRayPacket( const Ray3* rays, const Real* maxDistances, Size numRays, Bool* occluded )
+{
+	numRays = math::min( numRays, PROBE_RAY_PACKET_SIZE );
+	
+	// Fall back to tracing the rays one at a time if the packet isn't coherent.
+	if ( numRays < 2 || !rayPacketIsCoherent( rays, numRays ) )
+	{
+		Bool foundIntersection = false;
+		
+		for ( Index i = 0; i < numRays; i++ )
+		{
+			occluded[i] = traceBinaryOcclusionRay( rays[i], maxDistances[i] );
+			foundIntersection |= occluded[i];
+		}
+		
+		return foundIntersection;
+	}
+	
+	for ( Index i = 0; i < numRays; i++ )
+		occluded[i] = false;
+	
+	GSOUND_COUNT_STATISTIC( numRaysTraced, numRays );
+	
+	if ( objectBVH == NULL )
+		return false;
+	
+	// Fill the unused lanes of the packet with copies of the first ray and mask them out.
+	Ray3 packetRays[PROBE_RAY_PACKET_SIZE];
+	Real packetMaxDistances[PROBE_RAY_PACKET_SIZE];
+	
+	for ( Index i = 0; i < PROBE_RAY_PACKET_SIZE; i++ )
+	{
+		packetRays[i] = rays[i < numRays ? i : 0];
+		packetMaxDistances[i] = maxDistances[i < numRays ? i : 0];
+	}
+	
+	// The rays of the packet that have not been occluded yet.
+	SIMDBool activeRays( numRays > 0, numRays > 1, numRays > 2, numRays > 3 );
+	
+	// Stack entries which point into the BVH's object list are leaves, all others are nodes.
+	SoundObject* const* const objectsStart = objectBVH->getObjects();
+	SoundObject* const* const objectsEnd = objectsStart + objectBVH->getNumberOfObjects();
+	
+	// Setup the first element in the stack with the root node of the object hierarchy.
+	const void** stackElement = stack + 1;
+	*stackElement = objectBVH->getRoot();
+	
+	// A SIMD packet of the world-space rays which is tested against each child box of a node.
+	const FatSIMDRay3 packetRay( packetRays[0], packetRays[1], packetRays[2], packetRays[3] );
+	const SIMDFloat packetMaxT( packetMaxDistances[0], packetMaxDistances[1],
+								packetMaxDistances[2], packetMaxDistances[3] );
+	
+	// A temporary variable used to hold the ray parameters of the rays' intersections with a child box.
+	SIMDFloat temporaryIntersectionT;
+	
+	// Trace the packet through the object BVH tree.
+	do
+	{
+		const void* stackEntry = *stackElement;
+		stackElement--;
+		
+		if ( stackEntry >= objectsStart && stackEntry < objectsEnd )
+		{
+			const SoundObject* object = *(SoundObject* const*)stackEntry;
+			const SIMDBool objectRays = getObjectRays( packetRay, activeRays, packetMaxT, object );
+			
+			if ( objectRays )
+			{
+				activeRays &= ~traceObjectSpaceOcclusionRayPacket( packetRays, objectRays, packetMaxDistances,
+																	object, (const TriangleNodeType**)stackElement );
+				
+				// Stop as soon as every ray is occluded.
+				if ( !activeRays )
+					break;
+			}
+		}
+		else
+		{
+			const ObjectNodeType* objectNode = (const ObjectNodeType*)stackEntry;
+			GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+			
+			// Visit a child if any active ray intersects it closer than that ray's maximum distance.
+			// The child's distance is the nearest such intersection.
+			Bool childHits[4];
+			Real childDistances[4];
+			
+			for ( Index i = 0; i < 4; i++ )
+			{
+				SIMDBool childRays = rayIntersectsBoxSIMD( packetRay, SIMDAABB3( objectNode->getVolume(i) ), temporaryIntersectionT );
+				childRays &= (temporaryIntersectionT < packetMaxT) & activeRays;
+				
+				childHits[i] = childRays;
+				childDistances[i] = math::max<Real>();
+				
+				for ( Index j = 0; j < PROBE_RAY_PACKET_SIZE; j++ )
+				{
+					if ( childRays[j] )
+						childDistances[i] = math::min( childDistances[i], temporaryIntersectionT[j] );
+				}
+			}
+			
+			stackElement = pushObjectNodeChildren( objectNode, SIMDBool( childHits[0], childHits[1], childHits[2], childHits[3] ),
+													SIMDFloat( childDistances[0], childDistances[1], childDistances[2], childDistances[3] ),
+													stackElement );
+		}
+	}
+	while ( stackElement != stack );
+	
+	// The rays which are no longer active have been occluded.
+	const Int activeMask = activeRays.getMask();
+	Bool foundIntersection = false;
+	
+	for ( Index i = 0; i < numRays; i++ )
+	{
+		occluded[i] = (activeMask & (1 << i)) == 0;
+		foundIntersection |= occluded[i];
+	}
+	
+	return foundIntersection;
+}
+
+
+
+
+SIMDBool RayTracer:: traceObjectSpaceOcclusionRayPacket( const Ray3* worldSpaceRays, const SIMDBool& activeRays,
+														const Real* maxDistances, const SoundObject* object,
+														const TriangleNodeType** stackBase )
+{
+	//***********************************************************************************
+	// Transform the rays and the maximum distances into object space.
+	
+	// Get the transformation from the object.
+	const Transformation3& objectTransformation = object->getTransformation();
+	
+	Ray3 objectSpaceRays[PROBE_RAY_PACKET_SIZE];
+	
+	for ( Index i = 0; i < PROBE_RAY_PACKET_SIZE; i++ )
+		objectSpaceRays[i] = objectTransformation.transformToObjectSpace( worldSpaceRays[i] );
+	
+	// The object's rotation may split the packet into different octants, which the box test
+	// doesn't support, so trace the rays one at a time in that case.
+	if ( !rayPacketIsCoherent( objectSpaceRays, PROBE_RAY_PACKET_SIZE ) )
+	{
+		Bool occluded[PROBE_RAY_PACKET_SIZE];
+		
+		for ( Index i = 0; i < PROBE_RAY_PACKET_SIZE; i++ )
+		{
+			occluded[i] = activeRays[i] &&
+						traceObjectSpaceOcclusionRay( worldSpaceRays[i], object, stackBase, maxDistances[i] );
+		}
+		
+		return SIMDBool( occluded[0], occluded[1], occluded[2], occluded[3] );
+	}
+	
+	FatSIMDRay3 rays( objectSpaceRays[0], objectSpaceRays[1], objectSpaceRays[2], objectSpaceRays[3] );
+	
+	SIMDFloat objectSpaceMaxDistances( objectTransformation.transformToObjectSpace( maxDistances[0] ),
+										objectTransformation.transformToObjectSpace( maxDistances[1] ),
+										objectTransformation.transformToObjectSpace( maxDistances[2] ),
+										objectTransformation.transformToObjectSpace( maxDistances[3] ) );
+	
+	//***********************************************************************************
+	// Prepare the ray tracing stack for traversing the object's triangle BVH.
+	
+	// Get the root of the triangle BVH.
+	const TriangleTreeType* triangleBVH = object->getMesh()->getBVH();
+	
+	// Get a pointer to the start of the internal triangle array so that we can index into it.
+	const FatSIMDTriangle3* triangles = triangleBVH->getTriangles();
+	
+	// Push the root of the triangle BVH onto the stack.
+	const TriangleNodeType** stackElement = stackBase + 1;
+	*stackElement = triangleBVH->getRoot();
+	
+	// A temporary variable used to hold the ray parameters of the rays' intersections with a BVH node.
+	SIMDFloat temporaryIntersectionT;
+	
+	// The rays which have been occluded by this object, and the rays which still need to be tested.
+	SIMDBool occludedRays( false );
+	SIMDBool remainingRays = activeRays;
+	
+	do
+	{
+		const TriangleNodeType* triangleNode = *stackElement;
+		stackElement--;
+		GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+		
+		const SIMDAABB3& childVolumes = triangleNode->getVolumes();
+		SIMDInt offsets = triangleNode->getChildOffsets();
+		SIMDInt numLeafTriangles = triangleNode->getNumberOfTriangles();
+		
+		//**************************************************************************************
+		// Test each child's bounding box against all remaining rays of the packet. Push the child
+		// nodes that any ray hits onto the stack, or test their triangles if they are leaves.
+		
+		for ( Index i = 0; i < 4; i++ )
+		{
+			// Skip empty child nodes.
+			if ( !offsets[i] && !numLeafTriangles[i] )
+				continue;
+			
+			SIMDAABB3 childVolume( AABB3( Vector3( childVolumes.min.x[i], childVolumes.min.y[i], childVolumes.min.z[i] ),
+										Vector3( childVolumes.max.x[i], childVolumes.max.y[i], childVolumes.max.z[i] ) ) );
+			
+			// Clamp each ray's interval to its maximum occlusion distance.
+			SIMDBool childRays = rayIntersectsBoxSIMD( rays, childVolume, temporaryIntersectionT );
+			childRays &= (temporaryIntersectionT < objectSpaceMaxDistances) & remainingRays;
+			
+			if ( !childRays )
+				continue;
+			
+			if ( !numLeafTriangles[i] )
+				*(++stackElement) = triangleNode + offsets[i];
+			else
+			{
+				GSOUND_COUNT_STATISTIC( numTrianglesTested, 4*PROBE_RAY_PACKET_SIZE*numLeafTriangles[i] );
+				
+				const SIMDBool leafOccludedRays = rayPacketIntersectsAnyTriangle( rays, childRays, triangles + offsets[i],
+																				numLeafTriangles[i], objectSpaceMaxDistances );
+				
+				occludedRays |= leafOccludedRays;
+				remainingRays &= ~leafOccludedRays;
+				
+				// Stop as soon as every ray is occluded.
+				if ( !remainingRays )
+					return occludedRays;
+			}
+		}
+	}
+	while ( stackElement != stackBase );
+	
+	return occludedRays;
+}
+
+
+
+
+Bool RayTracer:: traceTransmissionRayPacket( const Ray3* rays, const Real* maxDistances, Size numRays,
+											Real audibilityThreshold, ArrayList<RayIntersection>* intersections )
+{
+	numRays = math::min( numRays, PROBE_RAY_PACKET_SIZE );
+	
+	for ( Index i = 0; i < numRays; i++ )
+		intersections[i].clear();
+	
+	// Fall back to tracing the rays one at a time if the packet isn't coherent.
+	if ( numRays < 2 || !rayPacketIsCoherent( rays, numRays ) )
+	{
+		Bool foundIntersection = false;
+		
+		for ( Index i = 0; i < numRays; i++ )
+			foundIntersection |= traceTransmissionRay( rays[i], maxDistances[i], audibilityThreshold, intersections[i] );
+		
+		return foundIntersection;
+	}
+	
+	GSOUND_COUNT_STATISTIC( numRaysTraced, numRays );
+	
+	if ( objectBVH == NULL )
+		return false;
+	
+	// Fill the unused lanes of the packet with copies of the first ray and mask them out.
+	Ray3 packetRays[PROBE_RAY_PACKET_SIZE];
+	Real packetMaxDistances[PROBE_RAY_PACKET_SIZE];
+	
+	for ( Index i = 0; i < PROBE_RAY_PACKET_SIZE; i++ )
+	{
+		packetRays[i] = rays[i < numRays ? i : 0];
+		packetMaxDistances[i] = maxDistances[i < numRays ? i : 0];
+	}
+	
+	// The rays of the packet whose transmitted sound may still be audible.
+	SIMDBool activeRays( numRays > 0, numRays > 1, numRays > 2, numRays > 3 );
+	
+	// Stack entries which point into the BVH's object list are leaves, all others are nodes.
+	SoundObject* const* const objectsStart = objectBVH->getObjects();
+	SoundObject* const* const objectsEnd = objectsStart + objectBVH->getNumberOfObjects();
+	
+	// Setup the first element in the stack with the root node of the object hierarchy.
+	const void** stackElement = stack + 1;
+	*stackElement = objectBVH->getRoot();
+	
+	// A SIMD packet of the world-space rays which is tested against each child box of a node.
+	const FatSIMDRay3 packetRay( packetRays[0], packetRays[1], packetRays[2], packetRays[3] );
+	const SIMDFloat packetMaxT( packetMaxDistances[0], packetMaxDistances[1],
+								packetMaxDistances[2], packetMaxDistances[3] );
+	
+	// The rays of the packet that have intersected a triangle.
+	SIMDBool foundIntersections( false );
+	
+	// Bounds on the attenuation of the sound transmitted along each ray.
+	TransmissionBound bounds[PROBE_RAY_PACKET_SIZE] = { TransmissionBound( audibilityThreshold ),
+														TransmissionBound( audibilityThreshold ),
+														TransmissionBound( audibilityThreshold ),
+														TransmissionBound( audibilityThreshold ) };
+	
+	// A temporary variable used to hold the ray parameters of the rays' intersections with a child box.
+	SIMDFloat temporaryIntersectionT;
+	
+	// Trace the packet through the object BVH tree.
+	do
+	{
+		const void* stackEntry = *stackElement;
+		stackElement--;
+		
+		if ( stackEntry >= objectsStart && stackEntry < objectsEnd )
+		{
+			const SoundObject* object = *(SoundObject* const*)stackEntry;
+			const SIMDBool objectRays = getObjectRays( packetRay, activeRays, packetMaxT, object );
+			
+			if ( objectRays )
+			{
+				foundIntersections |= traceObjectSpaceTransmissionRayPacket( packetRays, objectRays, packetMaxDistances,
+																			object, (const TriangleNodeType**)stackElement,
+																			bounds, intersections );
+				
+				// Stop tracing the rays which can no longer transmit audible sound.
+				activeRays &= SIMDBool( bounds[0].isAudible(), bounds[1].isAudible(),
+										bounds[2].isAudible(), bounds[3].isAudible() );
+				
+				if ( !activeRays )
+					break;
+			}
+		}
+		else
+		{
+			const ObjectNodeType* objectNode = (const ObjectNodeType*)stackEntry;
+			GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+			
+			// Visit a child if any ray intersects it closer than that ray's maximum distance.
+			Bool childHits[4];
+			Real childDistances[4];
+			
+			for ( Index i = 0; i < 4; i++ )
+			{
+				SIMDBool childRays = rayIntersectsBoxSIMD( packetRay, SIMDAABB3( objectNode->getVolume(i) ), temporaryIntersectionT );
+				childRays &= (temporaryIntersectionT < packetMaxT) & activeRays;
+				
+				childHits[i] = childRays;
+				childDistances[i] = math::max<Real>();
+				
+				for ( Index j = 0; j < PROBE_RAY_PACKET_SIZE; j++ )
+				{
+					if ( childRays[j] )
+						childDistances[i] = math::min( childDistances[i], temporaryIntersectionT[j] );
+				}
+			}
+			
+			stackElement = pushObjectNodeChildren( objectNode, SIMDBool( childHits[0], childHits[1], childHits[2], childHits[3] ),
+													SIMDFloat( childDistances[0], childDistances[1], childDistances[2], childDistances[3] ),
+													stackElement );
+		}
+	}
+	while ( stackElement != stack );
+	
+	// The inaudible rays don't transmit any sound.
+	for ( Index i = 0; i < numRays; i++ )
+	{
+		if ( !bounds[i].isAudible() )
+			intersections[i].clear();
+	}
+	
+	return foundIntersections & activeRays;
+}
+
+
+
+
+SIMDBool RayTracer:: traceObjectSpaceTransmissionRayPacket( const Ray3* worldSpaceRays, const SIMDBool& activeRays,
+															const Real* maxDistances, const SoundObject* object,
+															const TriangleNodeType** stackBase, TransmissionBound* bounds,
+															ArrayList<RayIntersection>* intersections )
+{
+	//***********************************************************************************
+	// Transform the rays and the maximum distances into object space.
+	
+	// Get the transformation from the object.
+	const Transformation3& objectTransformation = object->getTransformation();
+	
+	Ray3 objectSpaceRays[PROBE_RAY_PACKET_SIZE];
+	
+	for ( Index i = 0; i < PROBE_RAY_PACKET_SIZE; i++ )
+		objectSpaceRays[i] = objectTransformation.transformToObjectSpace( worldSpaceRays[i] );
+	
+	// The object's rotation may split the packet into different octants, which the box test
+	// doesn't support, so trace the rays one at a time in that case.
+	if ( !rayPacketIsCoherent( objectSpaceRays, PROBE_RAY_PACKET_SIZE ) )
+	{
+		Bool foundIntersections[PROBE_RAY_PACKET_SIZE];
+		
+		for ( Index i = 0; i < PROBE_RAY_PACKET_SIZE; i++ )
+		{
+			foundIntersections[i] = activeRays[i] &&
+									traceObjectSpaceTransmissionRay( worldSpaceRays[i], object, stackBase,
+																	maxDistances[i], bounds[i], intersections[i] );
+		}
+		
+		return SIMDBool( foundIntersections[0], foundIntersections[1], foundIntersections[2], foundIntersections[3] );
+	}
+	
+	FatSIMDRay3 rays( objectSpaceRays[0], objectSpaceRays[1], objectSpaceRays[2], objectSpaceRays[3] );
+	
+	SIMDFloat objectSpaceMaxDistances( objectTransformation.transformToObjectSpace( maxDistances[0] ),
+										objectTransformation.transformToObjectSpace( maxDistances[1] ),
+										objectTransformation.transformToObjectSpace( maxDistances[2] ),
+										objectTransformation.transformToObjectSpace( maxDistances[3] ) );
+	
+	//***********************************************************************************
+	// Prepare the ray tracing stack for traversing the object's triangle BVH.
+	
+	// Get the root of the triangle BVH.
+	const TriangleTreeType* triangleBVH = object->getMesh()->getBVH();
+	
+	// Get a pointer to the start of the internal triangle array so that we can index into it.
+	const FatSIMDTriangle3* triangles = triangleBVH->getTriangles();
+	
+	// Push the root of the triangle BVH onto the stack.
+	const TriangleNodeType** stackElement = stackBase + 1;
+	*stackElement = triangleBVH->getRoot();
+	
+	// A temporary variable used to hold the ray parameters of the rays' intersections with a BVH node.
+	SIMDFloat temporaryIntersectionT;
+	
+	// The rays which have intersected a triangle in this object.
+	SIMDBool foundIntersections( false );
+	
+	// The rays which are still traced because their transmitted sound may be audible.
+	SIMDBool audibleRays = activeRays;
+	
+	do
+	{
+		const TriangleNodeType* triangleNode = *stackElement;
+		stackElement--;
+		GSOUND_COUNT_STATISTIC( numNodesVisited, 1 );
+		
+		const SIMDAABB3& childVolumes = triangleNode->getVolumes();
+		SIMDInt offsets = triangleNode->getChildOffsets();
+		SIMDInt numLeafTriangles = triangleNode->getNumberOfTriangles();
+		
+		//**************************************************************************************
+		// Test each child's bounding box against all rays of the packet. Push the child nodes
+		// that any ray hits onto the stack, or intersect their triangles if they are leaves.
+		
+		for ( Index i = 0; i < 4; i++ )
+		{
+			// Skip empty child nodes.
+			if ( !offsets[i] && !numLeafTriangles[i] )
+				continue;
+			
+			SIMDAABB3 childVolume( AABB3( Vector3( childVolumes.min.x[i], childVolumes.min.y[i], childVolumes.min.z[i] ),
+										Vector3( childVolumes.max.x[i], childVolumes.max.y[i], childVolumes.max.z[i] ) ) );
+			
+			// Avoid looking at nodes that are farther away than each ray's maximum distance.
+			SIMDBool childRays = rayIntersectsBoxSIMD( rays, childVolume, temporaryIntersectionT );
+			childRays &= (temporaryIntersectionT < objectSpaceMaxDistances) & audibleRays;
+			
+			if ( !childRays )
+				continue;
+			
+			if ( !numLeafTriangles[i] )
+				*(++stackElement) = triangleNode + offsets[i];
+			else
+			{
+				// Each triangle is tested against all of the rays in the packet.
+				GSOUND_COUNT_STATISTIC( numTrianglesTested, 4*PROBE_RAY_PACKET_SIZE*numLeafTriangles[i] );
+				
+				const FatSIMDTriangle3* leafTriangles = triangles + offsets[i];
+				const FatSIMDTriangle3* const leafTrianglesEnd = leafTriangles + numLeafTriangles[i];
+				
+				while ( leafTriangles != leafTrianglesEnd )
+				{
+					for ( Index j = 0; j < 4; j++ )
+					{
+						SIMDBool result = rayIntersectsTriangleSIMD( rays,
+												SIMDVector3( Vector3( leafTriangles->v0.x[j], leafTriangles->v0.y[j], leafTriangles->v0.z[j] ) ),
+												SIMDVector3( Vector3( leafTriangles->v1.x[j], leafTriangles->v1.y[j], leafTriangles->v1.z[j] ) ),
+												SIMDVector3( Vector3( leafTriangles->v2.x[j], leafTriangles->v2.y[j], leafTriangles->v2.z[j] ) ),
+												temporaryIntersectionT );
+						
+						// Cull any intersections that are beyond each ray's maximum distance.
+						result &= (temporaryIntersectionT < objectSpaceMaxDistances) & childRays & audibleRays;
+						
+						if ( !result )
+							continue;
+						
+						foundIntersections |= result;
+						
+						// Insert each intersection into its ray's list in order of distance.
+						for ( Index k = 0; k < PROBE_RAY_PACKET_SIZE; k++ )
+						{
+							if ( result[k] )
+							{
+								Real worldSpaceT = objectTransformation.transformToWorldSpace( temporaryIntersectionT[k] );
+								
+								insertIntersection( intersections[k], RayIntersection( worldSpaceT,
+													ObjectSpaceTriangle( leafTriangles->getTrianglePointer(j), object ) ) );
+								
+								bounds[k].addIntersection( leafTriangles->getTrianglePointer(j)->getMaterial() );
+							}
+						}
+						
+						// Stop tracing the rays which have become inaudible.
+						audibleRays &= SIMDBool( bounds[0].isAudible(), bounds[1].isAudible(),
+												bounds[2].isAudible(), bounds[3].isAudible() );
+						
+						if ( !audibleRays )
+							return foundIntersections;
+					}
+					
+					leafTriangles++;
+				}
+			}
+		}
+	}
+	while ( stackElement != stackBase );
+	
+	return foundIntersections;
+}
+
+
+
+
+SIMDBool RayTracer:: getObjectRays( const FatSIMDRay3& rays, const SIMDBool& activeRays,
+									const SIMDFloat& maxDistances, const SoundObject* object )
+{
+	SIMDFloat distanceAlongRay;
+	SIMDBool objectRays = rayIntersectsBoxSIMD( rays, SIMDAABB3( object->getBoundingBox() ), distanceAlongRay );
+	
+	return objectRays & (distanceAlongRay < maxDistances) & activeRays;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Object BVH Child Ordering Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+const void** RayTracer:: pushObjectNodeChildren( const ObjectNodeType* node, const SIMDBool& intersectedChildren,
+												const SIMDFloat& distanceAlongRay, const void** stackElement ) const
+{
+	SoundObject* const* const objects = objectBVH->getObjects();
+	
+	// Sort the intersected children by decreasing distance along the ray.
+	const void* children[4];
+	Real childDistances[4];
+	Size numChildren = 0;
+	
+	for ( Index i = 0; i < 4; i++ )
+	{
+		if ( !intersectedChildren[i] || node->isEmpty(i) )
+			continue;
+		
+		// Leaves are pushed as a pointer to their entry in the object list.
+		const void* child = node->isLeaf(i) ? (const void*)(objects + node->getObjectIndex(i)) :
+												(const void*)node->getChild(i);
+		const Real distance = distanceAlongRay[i];
+		Index j = numChildren;
+		
+		for ( ; j > 0 && childDistances[j - 1] < distance; j-- )
+		{
+			children[j] = children[j - 1];
+			childDistances[j] = childDistances[j - 1];
+		}
+		
+		children[j] = child;
+		childDistances[j] = distance;
+		numChildren++;
+	}
+	
+	// Push the farthest child first so that the nearest child is popped first.
+	for ( Index i = 0; i < numChildren; i++ )
+		*(++stackElement) = children[i];
+	
+	return stackElement;
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Ray-Box Intersection Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+SIMDBool RayTracer:: rayIntersectsBoxSIMD( const FatSIMDRay3& ray, const SIMDAABB3& box,
+										SIMDFloat& distanceAlongRay )
+{
+	SIMDFloat tmin = (box.getMinMax(1 - ray.sign[0]).x - ray.origin.x) * ray.inverseDirection.x;
 	SIMDFloat tmax = (box.getMinMax(ray.sign[0]).x - ray.origin.x) * ray.inverseDirection.x;
 	SIMDFloat tymin = (box.getMinMax(1 - ray.sign[1]).y - ray.origin.y) * ray.inverseDirection.y;
 	SIMDFloat tymax = (box.getMinMax(ray.sign[1]).y - ray.origin.y) * ray.inverseDirection.y;
@@ -593,6 +1748,43 @@ SIMDBool RayTracer:: rayIntersectsBoxSIMD( const FatSIMDRay3& ray, const SIMDAAB
 
 
 
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+RayTracer::SIMDBoolN RayTracer:: rayIntersectsBoxesWide( const FatSIMDRay3& ray, const WideTriangleNodeType* node,
+														SIMDFloatN& distanceAlongRay )
+{
+	const Real originX = ray.origin.x[0], inverseDirectionX = ray.inverseDirection.x[0];
+	const Real originY = ray.origin.y[0], inverseDirectionY = ray.inverseDirection.y[0];
+	const Real originZ = ray.origin.z[0], inverseDirectionZ = ray.inverseDirection.z[0];
+	
+	SIMDFloatN tmin = (node->getMinMax(1 - ray.sign[0])[0] - originX) * inverseDirectionX;
+	SIMDFloatN tmax = (node->getMinMax(ray.sign[0])[0] - originX) * inverseDirectionX;
+	SIMDFloatN tymin = (node->getMinMax(1 - ray.sign[1])[1] - originY) * inverseDirectionY;
+	SIMDFloatN tymax = (node->getMinMax(ray.sign[1])[1] - originY) * inverseDirectionY;
+	
+	SIMDBoolN result = (tmin <= tymax) & (tymin <= tmax);
+	
+	// Refine the slab.
+	tmin = math::max( tmin, tymin );
+	tmax = math::min( tmax, tymax );
+	
+	SIMDFloatN tzmin = (node->getMinMax(1 - ray.sign[2])[2] - originZ) * inverseDirectionZ;
+	SIMDFloatN tzmax = (node->getMinMax(ray.sign[2])[2] - originZ) * inverseDirectionZ;
+	
+	result &= (tmin <= tzmax) & (tzmin <= tmax);
+	
+	// Refine the slab again.
+	tmin = math::max( tmin, tzmin );
+	tmax = math::min( tmax, tzmax );
+	
+	distanceAlongRay = tmin;
+	
+	return result & (tmin <= tmax) & (tmax > Real(0));
+}
+
+
+
+
+#endif
 //##########################################################################################
 //##########################################################################################
 //############		
@@ -666,6 +1858,122 @@ Bool RayTracer:: rayIntersectsTriangles( const SIMDRay3& ray, const FatSIMDTrian
 
 
 
+SIMDBool RayTracer:: rayPacketIntersectsTriangles( const SIMDRay3& rays, const SIMDBool& activeRays,
+													const FatSIMDTriangle3* triangles, Size numTriangles,
+													SIMDFloat& closestIntersections, const TriangleType** closestTriangles )
+{
+	const FatSIMDTriangle3* const trianglesEnd = triangles + numTriangles;
+	
+	// A temporary variable used to hold the ray parameters of the rays' intersections with a triangle.
+	SIMDFloat temporaryIntersectionT;
+	SIMDBool foundIntersections( false );
+	
+	while ( triangles != trianglesEnd )
+	{
+		for ( Index j = 0; j < 4; j++ )
+		{
+			// Test triangle j of this group against all rays of the packet.
+			SIMDBool result = rayIntersectsTriangleSIMD( rays,
+											SIMDVector3( Vector3( triangles->v0.x[j], triangles->v0.y[j], triangles->v0.z[j] ) ),
+											SIMDVector3( Vector3( triangles->v1.x[j], triangles->v1.y[j], triangles->v1.z[j] ) ),
+											SIMDVector3( Vector3( triangles->v2.x[j], triangles->v2.y[j], triangles->v2.z[j] ) ),
+											temporaryIntersectionT );
+			
+			// Only keep the intersections which are closer than each ray's closest intersection.
+			result &= (temporaryIntersectionT < closestIntersections) & activeRays;
+			
+			if ( result )
+			{
+				closestIntersections = math::select( result, temporaryIntersectionT, closestIntersections );
+				
+				for ( Index i = 0; i < 4; i++ )
+				{
+					if ( result[i] )
+						closestTriangles[i] = triangles->getTrianglePointer(j);
+				}
+				
+				foundIntersections |= result;
+			}
+		}
+		
+		triangles++;
+	}
+	
+	return foundIntersections;
+}
+
+
+
+
+Bool RayTracer:: rayIntersectsAnyTriangle( const SIMDRay3& ray, const FatSIMDTriangle3* triangles,
+											Size numTriangles, const SIMDFloat& maxDistance )
+{
+	const FatSIMDTriangle3* const trianglesEnd = triangles + numTriangles;
+	
+	// A temporary variable used to hold the ray parameters of the ray's intersection with 4 triangles.
+	SIMDFloat temporaryIntersectionT;
+	
+	while ( triangles != trianglesEnd )
+	{
+		SIMDBool result = rayIntersectsTriangleSIMD( ray, triangles->v0, triangles->v1, triangles->v2, temporaryIntersectionT );
+		
+		// Any intersection closer than the maximum distance occludes the ray, no need to find the closest one.
+		if ( result & (temporaryIntersectionT < maxDistance) )
+			return true;
+		
+		triangles++;
+	}
+	
+	return false;
+}
+
+
+
+
+SIMDBool RayTracer:: rayPacketIntersectsAnyTriangle( const SIMDRay3& rays, const SIMDBool& activeRays,
+													const FatSIMDTriangle3* triangles, Size numTriangles,
+													const SIMDFloat& maxDistances )
+{
+	const FatSIMDTriangle3* const trianglesEnd = triangles + numTriangles;
+	
+	// A temporary variable used to hold the ray parameters of the rays' intersections with a triangle.
+	SIMDFloat temporaryIntersectionT;
+	SIMDBool occludedRays( false );
+	SIMDBool remainingRays = activeRays;
+	
+	while ( triangles != trianglesEnd )
+	{
+		for ( Index j = 0; j < 4; j++ )
+		{
+			// Test triangle j of this group against all rays of the packet.
+			SIMDBool result = rayIntersectsTriangleSIMD( rays,
+											SIMDVector3( Vector3( triangles->v0.x[j], triangles->v0.y[j], triangles->v0.z[j] ) ),
+											SIMDVector3( Vector3( triangles->v1.x[j], triangles->v1.y[j], triangles->v1.z[j] ) ),
+											SIMDVector3( Vector3( triangles->v2.x[j], triangles->v2.y[j], triangles->v2.z[j] ) ),
+											temporaryIntersectionT );
+			
+			// Any intersection closer than a ray's maximum distance occludes that ray.
+			result &= (temporaryIntersectionT < maxDistances) & remainingRays;
+			
+			if ( result )
+			{
+				occludedRays |= result;
+				remainingRays &= ~result;
+				
+				if ( !remainingRays )
+					return occludedRays;
+			}
+		}
+		
+		triangles++;
+	}
+	
+	return occludedRays;
+}
+
+
+
+
 //##########################################################################################
 //##########################################################################################
 //############		
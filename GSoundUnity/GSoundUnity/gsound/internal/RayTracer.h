@@ -68,7 +68,7 @@
 #include "../SoundScene.h"
 #include "InternalSoundTriangle.h"
 #include "ObjectSpaceTriangle.h"
-#include "SphereTree.h"
+#include "ObjectQBVHArrayTree.h"
 #include "QBVHArrayTree.h"
 #include "FatSIMDRay3D.h"
 
@@ -101,7 +101,13 @@ class RayTracer
 			
 			
 			/// Define the type of object BVH to use.
-			typedef SphereTree ObjectBVHType;
+			typedef ObjectQBVHArrayTree ObjectBVHType;
+			
+			
+			
+			
+			/// Define the type of object BVH node to use.
+			typedef ObjectBVHType::NodeType ObjectNodeType;
 			
 			
 			
@@ -118,6 +124,26 @@ class RayTracer
 			
 			
 			
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			/// Define the type of wide triangle BVH node to use.
+			typedef TriangleTreeType::WideNodeType WideTriangleNodeType;
+			
+			
+			
+			
+			/// Define the type of SIMD scalar used to test a ray against all children of a wide node.
+			typedef math::SIMDScalar<Float32,GSOUND_TRIANGLE_BVH_WIDTH> SIMDFloatN;
+			
+			
+			
+			
+			/// Define the type of SIMD boolean used to store the results of wide node tests.
+			typedef math::SIMDScalar<Bool,GSOUND_TRIANGLE_BVH_WIDTH> SIMDBoolN;
+#endif
+			
+			
+			
+			
 			/// Define the type of ray to use internally.
 			typedef FatSIMDRay3D<float,4> FatSIMDRay3;
 			
@@ -130,6 +156,107 @@ class RayTracer
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Transmission Bound Class Definition
+			
+			
+			
+			
+			/// A class which bounds the attenuation of sound transmitted along a ray as its intersections are found.
+			/**
+			  * Each boundary that a transmission ray crosses multiplies the transmitted sound by
+			  * the fraction of it that is neither reflected nor absorbed there. Every intersection
+			  * but possibly the last one along the ray is paired into such a crossing, so the product
+			  * of those fractions for all intersections found so far, except the smallest one, is an
+			  * upper bound on the final attenuation, regardless of the order that the intersections
+			  * are found in. Once that bound is below the threshold in every frequency band,
+			  * no further intersections can make the transmitted sound audible.
+			  */
+			class TransmissionBound
+			{
+				public:
+					
+					/// Create a transmission bound for a ray with no intersections and the specified audibility threshold.
+					GSOUND_INLINE TransmissionBound( Real newThreshold )
+						:	threshold( newThreshold ),
+							audible( true )
+					{
+					}
+					
+					
+					
+					
+					/// Multiply the bound by the fraction of sound that is transmitted through the specified material.
+					GSOUND_FORCE_INLINE void addIntersection( const SoundMaterial& material )
+					{
+						const FrequencyResponse& reflection = material.getReflectionAttenuation();
+						const FrequencyResponse& absorption = material.getAbsorptionAttenuation();
+						Bool bandIsAudible = false;
+						
+						for ( Index i = 0; i < product.getNumberOfBands(); i++ )
+						{
+							Real fraction = (Real(1) - reflection[i])*absorption[i];
+							
+							// Keep the smallest fraction out of the product, since it may belong to the last intersection.
+							if ( fraction < smallest[i] )
+							{
+								product[i] *= smallest[i];
+								smallest[i] = fraction;
+							}
+							else
+								product[i] *= fraction;
+							
+							bandIsAudible |= product[i] >= threshold;
+						}
+						
+						audible = bandIsAudible;
+					}
+					
+					
+					
+					
+					/// Return whether or not the transmitted sound may still be above the threshold in any frequency band.
+					GSOUND_FORCE_INLINE Bool isAudible() const
+					{
+						return audible;
+					}
+					
+					
+					
+					
+				private:
+					
+					/// The product of the transmitted fractions of all intersections except the smallest one.
+					FrequencyResponse product;
+					
+					
+					
+					
+					/// The smallest transmitted fraction of all intersections in each frequency band.
+					FrequencyResponse smallest;
+					
+					
+					
+					
+					/// The gain below which the transmitted sound is inaudible.
+					Real threshold;
+					
+					
+					
+					
+					/// Whether or not the bound is above the threshold in any frequency band.
+					Bool audible;
+					
+					
+					
+					
+			};
+			
+			
+			
+			
 	public:
 		
 		//********************************************************************************
@@ -171,6 +298,20 @@ class RayTracer
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Public Static Data Members
+			
+			
+			
+			
+			/// The maximum number of rays that can be traced together in a ray packet.
+			static const Size PROBE_RAY_PACKET_SIZE = 4;
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -276,6 +417,30 @@ class RayTracer
 			
 			
 			
+			/// Trace a packet of rays through the current scene and return the closest triangle that each ray intersected.
+			/**
+			  * Up to PROBE_RAY_PACKET_SIZE rays are traced together through the scene, sharing
+			  * the traversal of the object and triangle hierarchies. The packet is only traced
+			  * together if all of its rays point into the same octant. Otherwise, each ray is
+			  * traced on its own with traceProbeRay().
+			  * 
+			  * For each ray, the output parameters at the ray's index are set as they would be
+			  * by traceProbeRay(). If a ray does not hit any triangle, its hit flag is set to FALSE
+			  * and its intersection distance and triangle are unspecified.
+			  * 
+			  * @param rays - The rays to be traced through the scene.
+			  * @param numRays - The number of rays in the packet, at most PROBE_RAY_PACKET_SIZE.
+			  * @param hits - An output array indicating whether or not each ray intersected a triangle.
+			  * @param closestIntersections - An output array of the distance along each ray of its first intersection.
+			  * @param triangles - An output array of the triangle which was hit by each ray.
+			  * @return whether or not any of the rays intersected a triangle.
+			  */
+			Bool traceProbeRayPacket( const Ray3* rays, Size numRays, Bool* hits,
+									Real* closestIntersections, ObjectSpaceTriangle* triangles );
+			
+			
+			
+			
 			/// Trace a single ray through the current scene and return whether or not any triangles were intersected.
 			/**
 			  * The ray is traced through the scene until it strikes a triangle or until
@@ -294,15 +459,133 @@ class RayTracer
 			/// Trace a single ray through the current scene and return all intersections with the scene.
 			/**
 			  * The ray is traced through the scene and every triangle which it intersects is
-			  * added to the parameter list of intersections. If any triangles are intersected,
+			  * inserted into the parameter list of intersections, which is kept sorted in order
+			  * of increasing distance along the ray. If any triangles are intersected,
 			  * TRUE is returned. Otherwise, FALSE is returned.
 			  * 
+			  * As the intersections are found, the fraction of sound transmitted through their
+			  * materials is multiplied into a bound on the ray's attenuation. If that bound falls
+			  * below the audibility threshold in every frequency band, tracing stops early,
+			  * the list of intersections is cleared, and FALSE is returned because no audible
+			  * sound is transmitted. A threshold of zero never stops the ray early.
+			  * 
 			  * @param ray - the ray to be traced through the scene.
 			  * @param maxDistance - the maximum distance along the ray that an intersection can be found.
+			  * @param audibilityThreshold - the gain below which transmitted sound is considered inaudible.
 			  * @param intersections - an output list of the detected ray-triangles intersections.
-			  * @return whether or not any triangles were intersected by the ray.
+			  * @return whether or not any triangles were intersected by the ray and the transmitted sound is audible.
+			  */
+			Bool traceTransmissionRay( const Ray3& ray, Real maxDistance, Real audibilityThreshold,
+										ArrayList<RayIntersection>& intersections );
+			
+			
+			
+			
+			/// Trace a packet of rays through the current scene and determine which of them are occluded.
+			/**
+			  * Up to PROBE_RAY_PACKET_SIZE rays are traced together through the scene, each with
+			  * its own maximum distance, sharing the traversal of the object and triangle hierarchies.
+			  * Rays stop being tested once they are occluded, and the traversal stops as soon as
+			  * all of them are. The packet is only traced together if all of its rays point into
+			  * the same octant. Otherwise, each ray is traced on its own with traceBinaryOcclusionRay().
+			  * 
+			  * @param rays - The rays to be traced through the scene.
+			  * @param maxDistances - The maximum distance along each ray that an intersection can be found.
+			  * @param numRays - The number of rays in the packet, at most PROBE_RAY_PACKET_SIZE.
+			  * @param occluded - An output array indicating whether or not each ray intersected a triangle.
+			  * @return whether or not any of the rays intersected a triangle.
+			  */
+			Bool traceBinaryOcclusionRayPacket( const Ray3* rays, const Real* maxDistances, Size numRays, Bool* occluded );
+			
+			
+			
+			
+			/// Trace a packet of rays through the current scene and return all intersections of each ray with the scene.
+			/**
+			  * Up to PROBE_RAY_PACKET_SIZE rays are traced together through the scene, each with
+			  * its own maximum distance, sharing the traversal of the object and triangle hierarchies.
+			  * The list of intersections for each ray is replaced with the intersections that
+			  * the ray found, in order of increasing distance along the ray. Rays stop being traced
+			  * once their transmitted sound is below the audibility threshold, as with traceTransmissionRay(),
+			  * and their lists are left empty. The packet is only traced together if all of its rays
+			  * point into the same octant. Otherwise, each ray is traced on its own with traceTransmissionRay().
+			  * 
+			  * @param rays - The rays to be traced through the scene.
+			  * @param maxDistances - The maximum distance along each ray that an intersection can be found.
+			  * @param numRays - The number of rays in the packet, at most PROBE_RAY_PACKET_SIZE.
+			  * @param audibilityThreshold - The gain below which transmitted sound is considered inaudible.
+			  * @param intersections - An array of output lists of the intersections found by each ray.
+			  * @return whether or not any of the rays intersected a triangle and transmitted audible sound.
 			  */
-			Bool traceTransmissionRay( const Ray3& ray, Real maxDistance, ArrayList<RayIntersection>& intersections );
+			Bool traceTransmissionRayPacket( const Ray3* rays, const Real* maxDistances, Size numRays,
+											Real audibilityThreshold, ArrayList<RayIntersection>* intersections );
+			
+			
+			
+			
+#if GSOUND_PROPAGATION_STATISTICS
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Public Statistics Class Definition
+			
+			
+			
+			
+			/// A class which counts the ray tracing work done by a ray tracer.
+			class Statistics
+			{
+				public:
+					
+					GSOUND_INLINE Statistics()
+						:	numRaysTraced( 0 ),
+							numNodesVisited( 0 ),
+							numTrianglesTested( 0 )
+					{
+					}
+					
+					
+					/// The number of rays that have been traced.
+					Size numRaysTraced;
+					
+					/// The number of BVH nodes whose children have been tested against a ray.
+					Size numNodesVisited;
+					
+					/// The number of ray-triangle intersection tests that have been performed.
+					Size numTrianglesTested;
+					
+			};
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Statistics Accessor Methods
+			
+			
+			
+			
+			/// Return the counts of the work done by this ray tracer since the statistics were last reset.
+			GSOUND_INLINE const Statistics& getStatistics() const
+			{
+				return statistics;
+			}
+			
+			
+			
+			
+			/// Reset the counts of the work done by this ray tracer to zero.
+			GSOUND_INLINE void resetStatistics()
+			{
+				statistics = Statistics();
+			}
+			
+			
+			
+			
+#endif
 			
 			
 			
@@ -318,21 +601,114 @@ class RayTracer
 			
 			
 			/// Trace a ray through an object's triangle BVH and return the closest intersection.
-			static Bool traceObjectSpaceProbeRay( const Ray3& worldSpaceRay, const SoundObject* object, 
+			Bool traceObjectSpaceProbeRay( const Ray3& worldSpaceRay, const SoundObject* object, 
 												const TriangleNodeType** stackBase,
 												Real& closestIntersection, ObjectSpaceTriangle& closestTriangle );
 			
 			
 			
 			
-			/// Trace a ray through an object's triangle BVH and return the closest intersection.
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			/// Trace a ray through an object's wide triangle BVH and return the closest intersection.
+			Bool traceObjectSpaceProbeRayWide( const Ray3& worldSpaceRay, const SoundObject* object, 
+													const WideTriangleNodeType** stackBase,
+													Real& closestIntersection, ObjectSpaceTriangle& closestTriangle );
+			
+			
+			
+			
+			/// Trace a ray through an object's wide triangle BVH and return whether any triangle is hit before the maximum distance.
+			Bool traceObjectSpaceOcclusionRayWide( const Ray3& worldSpaceRay, const SoundObject* object, 
+														const WideTriangleNodeType** stackBase, Real maxDistance );
+			
+			
+			
+			
+#endif
+			/// Trace a coherent packet of rays through an object's triangle BVH and return the closest intersection of each ray.
+			SIMDBool traceObjectSpaceProbeRayPacket( const Ray3* worldSpaceRays, const SIMDBool& activeRays,
+															const SoundObject* object, const TriangleNodeType** stackBase,
+															Real* closestIntersections, ObjectSpaceTriangle* closestTriangles );
+			
+			
+			
+			
+			/// Return whether or not all of the specified rays point into the same octant.
+			static Bool rayPacketIsCoherent( const Ray3* rays, Size numRays );
+			
+			
+			
+			
+			/// Trace a ray through an object's triangle BVH and return whether any triangle is hit before the maximum distance.
+			Bool traceObjectSpaceOcclusionRay( const Ray3& worldSpaceRay, const SoundObject* object, 
+													const TriangleNodeType** stackBase, Real maxDistance );
+			
+			
+			
+			
+			/// Trace a ray through an object's triangle BVH and add all of its intersections to the list until the ray is inaudible.
 			Bool traceObjectSpaceTransmissionRay( const Ray3& worldSpaceRay, const SoundObject* object, 
-												const TriangleNodeType** stackBase,
-												Real maxDistance, ArrayList<RayIntersection>& intersections );
+												const TriangleNodeType** stackBase, Real maxDistance,
+												TransmissionBound& bound, ArrayList<RayIntersection>& intersections );
 			
 			
 			
 			
+			/// Trace a coherent packet of rays through an object's triangle BVH and return which of them are occluded.
+			SIMDBool traceObjectSpaceOcclusionRayPacket( const Ray3* worldSpaceRays, const SIMDBool& activeRays,
+														const Real* maxDistances, const SoundObject* object,
+														const TriangleNodeType** stackBase );
+			
+			
+			
+			
+			/// Trace a coherent packet of rays through an object's triangle BVH and add each ray's intersections to its list until it is inaudible.
+			SIMDBool traceObjectSpaceTransmissionRayPacket( const Ray3* worldSpaceRays, const SIMDBool& activeRays,
+															const Real* maxDistances, const SoundObject* object,
+															const TriangleNodeType** stackBase, TransmissionBound* bounds,
+															ArrayList<RayIntersection>* intersections );
+			
+			
+			
+			
+			/// Return which active rays of a packet intersect an object's bounding box closer than their maximum distances.
+			/**
+			  * A single ray only visits the objects whose boxes it intersects, so the rays
+			  * of a packet are masked the same way before they are traced through an object.
+			  */
+			GSOUND_FORCE_INLINE static SIMDBool getObjectRays( const FatSIMDRay3& rays, const SIMDBool& activeRays,
+																const SIMDFloat& maxDistances, const SoundObject* object );
+			
+			
+			
+			
+			/// Insert an intersection into a list of intersections that is sorted by distance along the ray.
+			GSOUND_FORCE_INLINE static void insertIntersection( ArrayList<RayIntersection>& intersections,
+																const RayIntersection& intersection )
+			{
+				// Intersections tend to be found roughly in order, so search from the end of the list.
+				Index index = intersections.getSize();
+				
+				while ( index > 0 && intersections[index - 1].distanceAlongRay > intersection.distanceAlongRay )
+					index--;
+				
+				intersections.insert( intersection, index );
+			}
+			
+			
+			
+			
+			/// Push the intersected children of an object BVH node onto the stack so that the nearest is visited first.
+			/**
+			  * Inner children are pushed as node pointers, while leaf children are pushed
+			  * as pointers into the object list of the BVH. The new top of the stack is returned.
+			  */
+			GSOUND_FORCE_INLINE const void** pushObjectNodeChildren( const ObjectNodeType* node, const SIMDBool& intersectedChildren,
+																	const SIMDFloat& distanceAlongRay, const void** stackElement ) const;
+																	
+																	
+																	
+																	
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -341,26 +717,28 @@ class RayTracer
 			
 			
 			
-			/// Return whether or not the specified ray and sphere intersect.
+			/// Return whether or not the specified ray and box intersect.
 			/**
 			  * This method computes the distance along the ray of the intersection point.
 			  */
-			GSOUND_FORCE_INLINE static Bool rayIntersectsSphere( const Ray3& ray, const BoundingSphere& sphere,
-																Real& distanceAlongRay );
+			GSOUND_FORCE_INLINE static SIMDBool rayIntersectsBoxSIMD( const FatSIMDRay3& ray, const SIMDAABB3& box,
+																	SIMDFloat& distanceAlongRay );
 			
 			
 			
 			
-			/// Return whether or not the specified ray and box intersect.
+#if GSOUND_TRIANGLE_BVH_WIDTH > 4
+			/// Return whether or not the specified ray intersects the bounding boxes of each child of a wide node.
 			/**
-			  * This method computes the distance along the ray of the intersection point.
+			  * This method computes the distance along the ray of each intersection point.
 			  */
-			GSOUND_FORCE_INLINE static SIMDBool rayIntersectsBoxSIMD( const FatSIMDRay3& ray, const SIMDAABB3& box,
-																	SIMDFloat& distanceAlongRay );
+			GSOUND_FORCE_INLINE static SIMDBoolN rayIntersectsBoxesWide( const FatSIMDRay3& ray, const WideTriangleNodeType* node,
+																		SIMDFloatN& distanceAlongRay );
 			
 			
 			
 			
+#endif
 			/// Return whether or not the specified ray intersects any of the specified triangles.
 			GSOUND_NO_INLINE static Bool rayIntersectsTriangles( const SIMDRay3& ray,
 													const FatSIMDTriangle3* triangles, Size numTriangles, 
@@ -369,6 +747,34 @@ class RayTracer
 			
 			
 			
+			/// Return whether or not the specified ray intersects any of the specified triangles closer than the maximum distance.
+			GSOUND_NO_INLINE static Bool rayIntersectsAnyTriangle( const SIMDRay3& ray,
+													const FatSIMDTriangle3* triangles, Size numTriangles, 
+													const SIMDFloat& maxDistance );
+			
+			
+			
+			
+			/// Find the closest intersection of each active ray in a packet with the specified triangles.
+			/**
+			  * Each triangle is tested against all rays of the packet at once. The mask of rays
+			  * whose closest intersection was updated is returned.
+			  */
+			GSOUND_NO_INLINE static SIMDBool rayPacketIntersectsTriangles( const SIMDRay3& rays, const SIMDBool& activeRays,
+													const FatSIMDTriangle3* triangles, Size numTriangles, 
+													SIMDFloat& closestIntersections, const TriangleType** closestTriangles );
+			
+			
+			
+			
+			/// Return which active rays in a packet intersect any of the specified triangles closer than their maximum distances.
+			GSOUND_NO_INLINE static SIMDBool rayPacketIntersectsAnyTriangle( const SIMDRay3& rays, const SIMDBool& activeRays,
+													const FatSIMDTriangle3* triangles, Size numTriangles, 
+													const SIMDFloat& maxDistances );
+			
+			
+			
+			
 			/// Return whether or not the specified ray and triangle intersect.
 			/**
 			  * This method computes the distance along the ray of the intersection point.
@@ -406,6 +812,18 @@ class RayTracer
 			
 			
 			
+#if GSOUND_PROPAGATION_STATISTICS
+			/// The counts of the work done by this ray tracer since the statistics were last reset.
+			Statistics statistics;
+			
+			
+			
+			
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -415,7 +833,10 @@ class RayTracer
 			
 			
 			/// Define the size of the ray tracing stack.
-			static const Size TRAVERSAL_STACK_DEPTH = 100;
+			/**
+			  * Wider triangle BVH nodes push more children onto the stack at each level.
+			  */
+			static const Size TRAVERSAL_STACK_DEPTH = 25*GSOUND_TRIANGLE_BVH_WIDTH;
 			
 			
 			
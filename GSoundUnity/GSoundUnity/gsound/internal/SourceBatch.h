@@ -0,0 +1,168 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/SourceBatch.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::SourceBatch class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_SOURCE_BATCH_H
+#define INCLUDE_GSOUND_SOURCE_BATCH_H
+
+
+#include "GSoundInternalConfig.h"
+
+
+#include "../SoundSource.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+/// A class which stores the positions and radii of a group of sources in SIMD-friendly order.
+/**
+  * The coordinates of the sources are stored in separate arrays so that a whole
+  * batch can be loaded into SIMD registers and tested against a reflection path at once.
+  * Lanes past the number of sources in the batch are zero and must be masked out.
+  */
+class SourceBatch
+{
+	public:
+		
+		/// The number of sources in a full batch, which is the width of a SIMD register.
+		static const Size WIDTH = 4;
+		
+		
+		GSOUND_INLINE SourceBatch()
+			:	numSources( 0 )
+		{
+			for ( Index i = 0; i < WIDTH; i++ )
+			{
+				x[i] = y[i] = z[i] = radius[i] = Real(0);
+				sourceIndices[i] = 0;
+			}
+		}
+		
+		
+		/// Add a source with the specified index in the scene to this batch, which must not be full.
+		GSOUND_INLINE void addSource( Index sourceIndex, const Vector3& position, Real sourceRadius )
+		{
+			GSOUND_DEBUG_ASSERT_MESSAGE( numSources < WIDTH, "Cannot add source to a full source batch." );
+			
+			x[numSources] = position.x;
+			y[numSources] = position.y;
+			z[numSources] = position.z;
+			radius[numSources] = sourceRadius;
+			sourceIndices[numSources] = sourceIndex;
+			numSources++;
+		}
+		
+		
+		/// Return the positions of the sources in this batch.
+		GSOUND_INLINE SIMDVector3 getPositions() const
+		{
+			return SIMDVector3( SIMDFloat( x[0], x[1], x[2], x[3] ),
+								SIMDFloat( y[0], y[1], y[2], y[3] ),
+								SIMDFloat( z[0], z[1], z[2], z[3] ) );
+		}
+		
+		
+		/// Return the radii of the sources in this batch.
+		GSOUND_INLINE SIMDFloat getRadii() const
+		{
+			return SIMDFloat( radius[0], radius[1], radius[2], radius[3] );
+		}
+		
+		
+		/// Return a mask which indicates which of the batch's lanes hold sources.
+		GSOUND_INLINE SIMDBool getMask() const
+		{
+			return SIMDBool( numSources > 0, numSources > 1, numSources > 2, numSources > 3 );
+		}
+		
+		
+		/// The coordinates of the positions of the sources in this batch.
+		Float32 x[WIDTH];
+		Float32 y[WIDTH];
+		Float32 z[WIDTH];
+		
+		/// The radii of the sources in this batch.
+		Float32 radius[WIDTH];
+		
+		/// The index within the scene of each source in this batch.
+		Index sourceIndices[WIDTH];
+		
+		/// The number of sources in this batch.
+		Size numSources;
+		
+};
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_SOURCE_BATCH_H
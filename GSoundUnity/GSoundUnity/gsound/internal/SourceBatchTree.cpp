@@ -0,0 +1,320 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/SourceBatchTree.cpp
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::SourceBatchTree class implementation
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#include "SourceBatchTree.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Constructor
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+SourceBatchTree:: SourceBatchTree()
+{
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Tree Building Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SourceBatchTree:: rebuild()
+{
+	nodes.clear();
+	batches.clear();
+	
+	if ( sources.getSize() == 0 )
+		return;
+	
+	buildTreeRecursive( sources.getArrayPointer(), sources.getSize() );
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Beam Query Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SourceBatchTree:: getBatchesInBeam( const Vector3& apex, const WorldSpaceTriangle& triangle, Real tolerance,
+										ArrayList<Index>& batchIndices ) const
+{
+	batchIndices.clear();
+	
+	if ( nodes.getSize() == 0 )
+		return;
+	
+	// If the apex is on the triangle's plane, the beam is degenerate and can't be tested reliably.
+	const Real apexDistance = triangle.plane.getSignedDistanceTo( apex );
+	
+	if ( math::abs( apexDistance ) <= tolerance )
+	{
+		for ( Index i = 0; i < batches.getSize(); i++ )
+			batchIndices.add( i );
+		
+		return;
+	}
+	
+	// The beam is bounded by the triangle's plane, facing away from the apex, and by the planes
+	// that contain the apex and each edge of the triangle, facing toward the triangle's opposite vertex.
+	Plane3 beamPlanes[4];
+	Size numBeamPlanes = 0;
+	
+	beamPlanes[numBeamPlanes++] = apexDistance > Real(0) ? -triangle.plane : triangle.plane;
+	
+	const Vector3* vertices[3] = { &triangle.v1, &triangle.v2, &triangle.v3 };
+	
+	for ( Index i = 0; i < 3; i++ )
+	{
+		const Vector3& edgeV1 = *vertices[i];
+		const Vector3& edgeV2 = *vertices[(i + 1) % 3];
+		const Vector3& oppositeVertex = *vertices[(i + 2) % 3];
+		
+		Vector3 normal = math::cross( edgeV1 - apex, edgeV2 - apex );
+		const Real normalMagnitude = normal.getMagnitude();
+		
+		// Skip the plane if the apex is in line with the edge, since the box tests are still conservative without it.
+		if ( normalMagnitude < math::epsilon<Real>() )
+			continue;
+		
+		normal /= normalMagnitude;
+		
+		if ( math::dot( normal, oppositeVertex - apex ) < Real(0) )
+			normal = -normal;
+		
+		beamPlanes[numBeamPlanes++] = Plane3( normal, apex );
+	}
+	
+	// Traverse the tree, skipping the nodes which are entirely outside of any beam plane.
+	Index stack[MAX_TREE_DEPTH];
+	Size stackSize = 0;
+	stack[stackSize++] = 0;
+	
+	while ( stackSize > 0 )
+	{
+		const Index nodeIndex = stack[--stackSize];
+		const Node& node = nodes[nodeIndex];
+		Bool nodeIsInBeam = true;
+		
+		for ( Index i = 0; i < numBeamPlanes; i++ )
+		{
+			if ( boundsAreBehindPlane( node.bounds, beamPlanes[i], tolerance ) )
+			{
+				nodeIsInBeam = false;
+				break;
+			}
+		}
+		
+		if ( !nodeIsInBeam )
+			continue;
+		
+		if ( node.isLeaf )
+			batchIndices.add( node.index );
+		else
+		{
+			// Push the second child first so that the batches are found in increasing order.
+			stack[stackSize++] = node.index;
+			stack[stackSize++] = nodeIndex + 1;
+		}
+	}
+}
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Private Helper Methods
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+void SourceBatchTree:: buildTreeRecursive( Source* nodeSources, Size numNodeSources )
+{
+	const Index nodeIndex = nodes.getSize();
+	nodes.add( Node() );
+	
+	AABB3 bounds( nodeSources[0].position, nodeSources[0].position );
+	
+	for ( Index i = 1; i < numNodeSources; i++ )
+		bounds += nodeSources[i].position;
+	
+	nodes[nodeIndex].bounds = bounds;
+	
+	// Put the sources in a batch if they fit in one.
+	if ( numNodeSources <= SourceBatch::WIDTH )
+	{
+		SourceBatch batch;
+		
+		for ( Index i = 0; i < numNodeSources; i++ )
+			batch.addSource( nodeSources[i].sourceIndex, nodeSources[i].position, nodeSources[i].radius );
+		
+		nodes[nodeIndex].index = batches.getSize();
+		nodes[nodeIndex].isLeaf = true;
+		batches.add( batch );
+		return;
+	}
+	
+	// Split along the longest axis of the bounds, giving the first child half of the batches
+	// so that every batch except the last one is full and the tree is balanced.
+	const Vector3 extent = bounds.getDiagonal();
+	Index splitAxis = 0;
+	
+	if ( extent.y > extent[splitAxis] )
+		splitAxis = 1;
+	
+	if ( extent.z > extent[splitAxis] )
+		splitAxis = 2;
+	
+	const Size numNodeBatches = (numNodeSources + SourceBatch::WIDTH - 1) / SourceBatch::WIDTH;
+	const Size numLesserSources = (numNodeBatches / 2)*SourceBatch::WIDTH;
+	
+	partitionSources( nodeSources, numNodeSources, splitAxis, numLesserSources );
+	
+	buildTreeRecursive( nodeSources, numLesserSources );
+	
+	nodes[nodeIndex].index = nodes.getSize();
+	
+	buildTreeRecursive( nodeSources + numLesserSources, numNodeSources - numLesserSources );
+}
+
+
+
+
+void SourceBatchTree:: partitionSources( Source* nodeSources, Size numNodeSources,
+										Index splitAxis, Size numLesserSources )
+{
+	// Select the source at the split index so that the sources before it have smaller positions.
+	Index first = 0;
+	Index last = numNodeSources - 1;
+	
+	while ( first < last )
+	{
+		const Real pivot = nodeSources[last].position[splitAxis];
+		Index mid = first;
+		
+		for ( Index j = first; j < last; j++ )
+		{
+			if ( nodeSources[j].position[splitAxis] < pivot )
+			{
+				const Source temp = nodeSources[mid];
+				nodeSources[mid] = nodeSources[j];
+				nodeSources[j] = temp;
+				mid++;
+			}
+		}
+		
+		// Move the pivot to its final position.
+		const Source temp = nodeSources[mid];
+		nodeSources[mid] = nodeSources[last];
+		nodeSources[last] = temp;
+		
+		if ( mid == numLesserSources )
+			break;
+		else if ( mid < numLesserSources )
+			first = mid + 1;
+		else
+			last = mid - 1;
+	}
+}
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
@@ -0,0 +1,359 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/SourceBatchTree.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::SourceBatchTree class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_SOURCE_BATCH_TREE_H
+#define INCLUDE_GSOUND_SOURCE_BATCH_TREE_H
+
+
+#include "GSoundInternalConfig.h"
+
+
+#include "SourceBatch.h"
+#include "WorldSpaceTriangle.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+/// A class which groups nearby sources into batches and builds a bounding volume hierarchy over them.
+/**
+  * The tree is rebuilt from the current source positions once per frame. Sources
+  * are split at the median along the longest axis of their bounds until each leaf
+  * holds one full batch, so the sources in a batch are close to each other.
+  * 
+  * A reflection path can only reach a source if the ray from the last listener
+  * image position through the last reflecting triangle reaches the source.
+  * The tree can be queried for the batches which intersect the beam formed by the
+  * image position and the triangle, so that batches which cannot contain any valid
+  * sources are skipped without being tested.
+  */
+class SourceBatchTree
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			/// Create an empty source batch tree.
+			SourceBatchTree();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Source Accessor Methods
+			
+			
+			
+			
+			/// Add a source with the specified index in the scene to the tree.
+			/**
+			  * The tree is not updated to include the source until it is rebuilt.
+			  */
+			GSOUND_INLINE void addSource( Index sourceIndex, const Vector3& position, Real radius )
+			{
+				sources.add( Source( sourceIndex, position, radius ) );
+			}
+			
+			
+			
+			
+			/// Remove all sources from the tree.
+			/**
+			  * The tree is not updated until it is rebuilt.
+			  */
+			GSOUND_INLINE void clearSources()
+			{
+				sources.clear();
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Tree Building Method
+			
+			
+			
+			
+			/// Rebuild the batches and the tree from the sources that are currently in the tree.
+			void rebuild();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Batch Accessor Methods
+			
+			
+			
+			
+			/// Return the number of source batches in the tree.
+			GSOUND_INLINE Size getNumberOfBatches() const
+			{
+				return batches.getSize();
+			}
+			
+			
+			
+			
+			/// Return a reference to the source batch at the specified index.
+			GSOUND_INLINE const SourceBatch& getBatch( Index batchIndex ) const
+			{
+				return batches[batchIndex];
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Beam Query Method
+			
+			
+			
+			
+			/// Get the indices of the batches which may contain sources inside the beam from a point through a triangle.
+			/**
+			  * The beam contains the points which can be reached by a ray from the apex
+			  * that passes through the triangle. The test is conservative, so batches
+			  * which are within the tolerance distance of the beam are also returned.
+			  * If the apex is too close to the triangle's plane to form a beam, all
+			  * batches are returned. The indices are returned in increasing order.
+			  * 
+			  * @param apex - the point from which the beam is formed.
+			  * @param triangle - the triangle through which the beam passes.
+			  * @param tolerance - the distance outside the beam within which batches are still returned.
+			  * @param batchIndices - a list which is replaced with the indices of the batches in the beam.
+			  */
+			void getBatchesInBeam( const Vector3& apex, const WorldSpaceTriangle& triangle, Real tolerance,
+									ArrayList<Index>& batchIndices ) const;
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Class Declarations
+			
+			
+			
+			
+			/// A class which stores a source while the tree is being built.
+			class Source
+			{
+				public:
+					
+					GSOUND_INLINE Source( Index newSourceIndex, const Vector3& newPosition, Real newRadius )
+						:	sourceIndex( newSourceIndex ),
+							position( newPosition ),
+							radius( newRadius )
+					{
+					}
+					
+					/// The index of the source within the scene.
+					Index sourceIndex;
+					
+					/// The position of the source.
+					Vector3 position;
+					
+					/// The radius of the source.
+					Real radius;
+			};
+			
+			
+			
+			
+			/// A class which stores a node of the tree.
+			/**
+			  * The first child of an inner node is stored directly after the node,
+			  * so only the index of the second child is stored.
+			  */
+			class Node
+			{
+				public:
+					
+					GSOUND_INLINE Node()
+						:	index( 0 ),
+							isLeaf( false )
+					{
+					}
+					
+					/// The bounding box of the positions of the sources in this node.
+					AABB3 bounds;
+					
+					/// The index of the node's batch if it is a leaf, or of its second child otherwise.
+					Index index;
+					
+					/// Whether or not this node is a leaf.
+					Bool isLeaf;
+			};
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Helper Methods
+			
+			
+			
+			
+			/// Build the subtree for the specified sources, starting with a new node at the end of the node list.
+			void buildTreeRecursive( Source* nodeSources, Size numNodeSources );
+			
+			
+			
+			
+			/// Partition the sources so that the first sources have smaller positions along the split axis.
+			static void partitionSources( Source* nodeSources, Size numNodeSources,
+										Index splitAxis, Size numLesserSources );
+			
+			
+			
+			
+			/// Return whether or not a bounding box is entirely behind a plane by more than the tolerance.
+			GSOUND_FORCE_INLINE static Bool boundsAreBehindPlane( const AABB3& bounds, const Plane3& plane, Real tolerance )
+			{
+				// Test the corner of the box which is farthest in front of the plane.
+				const Vector3 corner( plane.normal.x >= Real(0) ? bounds.max.x : bounds.min.x,
+									plane.normal.y >= Real(0) ? bounds.max.y : bounds.min.y,
+									plane.normal.z >= Real(0) ? bounds.max.z : bounds.min.z );
+				
+				return plane.getSignedDistanceTo( corner ) < -tolerance;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// The sources from which the tree is built, in the order of the batches after the tree is built.
+			ArrayList<Source> sources;
+			
+			
+			
+			
+			/// The nodes of the tree in depth-first order, starting with the root.
+			ArrayList<Node> nodes;
+			
+			
+			
+			
+			/// The source batches of the tree's leaves, in depth-first order.
+			ArrayList<SourceBatch> batches;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Data Members
+			
+			
+			
+			
+			/// The maximum depth of the tree, which limits the size of the traversal stack.
+			static const Size MAX_TREE_DEPTH = 64;
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_SOURCE_BATCH_TREE_H
@@ -0,0 +1,347 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/internal/WideBVHArrayTreeNode.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::internal::WideBVHArrayTreeNode class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_WIDE_BVH_ARRAY_TREE_NODE_H
+#define INCLUDE_GSOUND_WIDE_BVH_ARRAY_TREE_NODE_H
+
+
+#include "GSoundInternalConfig.h"
+
+
+//##########################################################################################
+//**************************  Start GSound Internal Namespace  *****************************
+GSOUND_INTERNAL_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+/// A node of a BVH with up to N children per node that is stored in a flat array.
+/**
+  * A wide BVH is made by collapsing the levels of a QBVHArrayTree so that each node
+  * has up to N children. The bounding boxes of the children are stored in a
+  * structure-of-arrays format using N-wide SIMD scalars so that a ray can be tested
+  * against all children at once. The leaves refer to the SIMD triangles of the QBVHArrayTree.
+  */
+template < Size width >
+class GSOUND_ALIGN(16) WideBVHArrayTreeNode
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Public Type Definitions
+			
+			
+			
+			
+			/// Define the type of SIMD scalar used to store the coordinates of the children's bounding boxes.
+			typedef math::SIMDScalar<Float32,width> SIMDFloatN;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			/// Create a wide BVH node with all children empty.
+			GSOUND_INLINE WideBVHArrayTreeNode()
+			{
+				for ( Index axis = 0; axis < 3; axis++ )
+				{
+					// Use inverted boxes so that empty children are never intersected.
+					min[axis] = SIMDFloatN( math::max<Float32>() );
+					max[axis] = SIMDFloatN( -math::max<Float32>() );
+				}
+				
+				for ( Index i = 0; i < width; i++ )
+				{
+					indices[i] = 0;
+					flags[i] = LEAF_NODE_FLAG;
+				}
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Children Accessor Methods
+			
+			
+			
+			
+			/// Get the maximum number of children that a wide BVH node can have.
+			GSOUND_FORCE_INLINE static Size getWidth()
+			{
+				return width;
+			}
+			
+			
+			
+			
+			/// Get the child of this node with the specified index.
+			GSOUND_FORCE_INLINE const WideBVHArrayTreeNode* getChild( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < width, "Cannot get WideBVHArrayTreeNode child with invalid index." );
+				return this + indices[child];
+			}
+			
+			
+			
+			
+			/// Return whether or not the specified child is a leaf node.
+			GSOUND_FORCE_INLINE Bool isLeaf( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < width, "Cannot get WideBVHArrayTreeNode leaf status with invalid index." );
+				return (flags[child] & LEAF_NODE_FLAG) != 0;
+			}
+			
+			
+			
+			
+			/// Return whether or not the specified child is an empty node.
+			GSOUND_FORCE_INLINE Bool isEmpty( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < width, "Cannot get WideBVHArrayTreeNode empty status with invalid index." );
+				return flags[child] == LEAF_NODE_FLAG;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Volume Accessor Methods
+			
+			
+			
+			
+			/// Get either the minimal or maximal coordinates of the children's bounding boxes.
+			/**
+			  * If the index parameter is 0, the minimal coordinates are returned, if the
+			  * index parameter is 1, the maximal coordinates are returned. The returned
+			  * array contains the X, Y, and Z coordinates of all children.
+			  */
+			GSOUND_FORCE_INLINE const SIMDFloatN* getMinMax( Index i ) const
+			{
+				return i ? max : min;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Triangle Accessor Methods
+			
+			
+			
+			
+			/// Get the index of the first SIMD triangle of the specified leaf child in the tree's triangle array.
+			GSOUND_FORCE_INLINE UInt32 getTriangleStartIndex( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < width, "Cannot get WideBVHArrayTreeNode triangle start with invalid child index." );
+				return indices[child];
+			}
+			
+			
+			
+			
+			/// Get the number of SIMD triangles that the specified child contains (if it is a leaf).
+			GSOUND_FORCE_INLINE Size getNumberOfTriangles( Index child ) const
+			{
+				GSOUND_DEBUG_ASSERT_MESSAGE( child < width, "Cannot get WideBVHArrayTreeNode triangle count with invalid child index." );
+				return Size(flags[child] & TRIANGLE_COUNT_MASK);
+			}
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Child Setup Methods
+			
+			
+			
+			
+			/// Set the bounding box of the specified child.
+			GSOUND_INLINE void setVolume( Index child, const AABB3& volume )
+			{
+				min[0][child] = volume.min.x;	max[0][child] = volume.max.x;
+				min[1][child] = volume.min.y;	max[1][child] = volume.max.y;
+				min[2][child] = volume.min.z;	max[2][child] = volume.max.z;
+			}
+			
+			
+			
+			
+			/// Set the specified child to be an inner node at the specified offset from this node.
+			GSOUND_INLINE void setInnerChild( Index child, const AABB3& volume, UInt32 childOffset )
+			{
+				setVolume( child, volume );
+				indices[child] = childOffset;
+				flags[child] = 0;
+			}
+			
+			
+			
+			
+			/// Set the specified child to be a leaf with the specified range of SIMD triangles.
+			GSOUND_INLINE void setLeafChild( Index child, const AABB3& volume, UInt32 triangleStart, Size numTriangles )
+			{
+				setVolume( child, volume );
+				indices[child] = triangleStart;
+				flags[child] = LEAF_NODE_FLAG | (UInt8)numTriangles;
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// The minimum X, Y, and Z coordinates of the children's bounding boxes.
+			SIMDFloatN min[3];
+			
+			
+			
+			
+			/// The maximum X, Y, and Z coordinates of the children's bounding boxes.
+			SIMDFloatN max[3];
+			
+			
+			
+			
+			/// The relative index of each inner child, or the index of each leaf's first SIMD triangle.
+			UInt32 indices[width];
+			
+			
+			
+			
+			/// The leaf flag and SIMD triangle count of each child.
+			UInt8 flags[width];
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Data Members
+			
+			
+			
+			
+			static const UInt8 LEAF_NODE_FLAG = 0x80;
+			
+			
+			
+			
+			static const UInt8 TRIANGLE_COUNT_MASK = 0x7F;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Friend Declaration
+			
+			
+			
+			
+			/// Declare the QBVHArrayTree class as a friend so that it can build wide nodes from its nodes.
+			friend class QBVHArrayTree;
+			
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//**************************  End GSound Internal Namespace  *******************************
+GSOUND_INTERNAL_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_WIDE_BVH_ARRAY_TREE_NODE_H
@@ -333,14 +333,17 @@ class GSOUND_ALIGN(16) SIMDScalar<Bool,4>
 			
 			
 			/// Return a mask which indicates if each of the components are true.
+			/**
+			  * Bit i of the mask is set if component i is true, so the A component is the lowest bit.
+			  */
 			GSOUND_FORCE_INLINE Int getMask() const
 			{
 #if GSOUND_USE_SIMD && defined(GSOUND_SIMD_ALTIVEC)
-				return ((a & 0x80000000) << 3) | ((b & 0x80000000) << 2) | ((c & 0x80000000) << 1) | ((d & 0x80000000));
+				return Int((a >> 31) | ((b >> 31) << 1) | ((c >> 31) << 2) | ((d >> 31) << 3));
 #elif GSOUND_USE_SIMD && defined(GSOUND_SIMD_SSE) && GSOUND_SSE_VERSION_IS_SUPPORTED(1,0)
 				return _mm_movemask_ps( vFloat );
 #else
-				return ((a & 0x80000000) << 3) | ((b & 0x80000000) << 2) | ((c & 0x80000000) << 1) | ((d & 0x80000000));
+				return Int((a >> 31) | ((b >> 31) << 1) | ((c >> 31) << 2) | ((d >> 31) << 3));
 #endif
 			}
 			
@@ -358,7 +361,7 @@ class GSOUND_ALIGN(16) SIMDScalar<Bool,4>
 			/// Get the element at the specified index in the vector.
 			GSOUND_FORCE_INLINE Bool operator [] ( Index i ) const
 			{
-				return *(Bool*)(x + i);
+				return x[i] != 0;
 			}
 			
 			
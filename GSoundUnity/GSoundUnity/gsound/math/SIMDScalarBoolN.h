@@ -89,7 +89,7 @@ GSOUND_MATH_NAMESPACE_START
 template < Size width >
 class GSOUND_ALIGN(16) SIMDScalar<Bool,width>
 {
-	private:
+	public:
 		
 		//********************************************************************************
 		//********************************************************************************
@@ -130,7 +130,7 @@ class GSOUND_ALIGN(16) SIMDScalar<Bool,width>
 			/// Return a boolean value which indicates whether or not any of the components are true.
 			GSOUND_FORCE_INLINE operator Bool () const
 			{
-				Bool result;
+				Bool result = false;
 				
 				for ( Index i = 0; i < numIterations; i++ )
 					result |= v[i].getMask() != 0;
@@ -141,6 +141,32 @@ class GSOUND_ALIGN(16) SIMDScalar<Bool,width>
 			
 			
 			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Mask Operator
+			
+			
+			
+			
+			/// Return a mask which indicates if each of the components are true.
+			/**
+			  * Bit i of the mask is set if component i is true. The width of
+			  * the scalar must be at most 32 for every component to have a bit.
+			  */
+			GSOUND_FORCE_INLINE UInt32 getMask() const
+			{
+				UInt32 mask = 0;
+				
+				for ( Index i = 0; i < numIterations; i++ )
+					mask |= UInt32(v[i].getMask()) << (i*SIMD_WIDTH);
+				
+				return mask;
+			}
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -152,7 +178,7 @@ class GSOUND_ALIGN(16) SIMDScalar<Bool,width>
 			/// Get the element at the specified index in the vector.
 			GSOUND_FORCE_INLINE Bool operator [] ( Index i ) const
 			{
-				return (Bool)*((const UInt32*)&v);
+				return v[i / SIMD_WIDTH][i % SIMD_WIDTH];
 			}
 			
 			
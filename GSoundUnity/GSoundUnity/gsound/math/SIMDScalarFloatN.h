@@ -987,7 +987,7 @@ GSOUND_FORCE_INLINE SIMDScalar<Float32,width> max( const SIMDScalar<Float32,widt
 
 /// Select elements from the first SIMD scalar if the selector is TRUE, otherwise from the second.
 template < Size width >
-GSOUND_FORCE_INLINE SIMDScalar<Float32,4> select( const SIMDScalar<Bool,width>& selector,
+GSOUND_FORCE_INLINE SIMDScalar<Float32,width> select( const SIMDScalar<Bool,width>& selector,
 												const SIMDScalar<Float32,width>& scalar1, const SIMDScalar<Float32,width>& scalar2 )
 {
 	SIMDScalar<Float32,width> result;
@@ -188,7 +188,7 @@ class GSOUND_ALIGN(16) SIMDScalar<Int32,width>
 			  */
 			GSOUND_FORCE_INLINE const Int32* toArray() const
 			{
-				return (const Float32*)v;
+				return (const Int32*)v;
 			}
 			
 			
@@ -65,6 +65,9 @@
 #include "GSoundUtilitiesConfig.h"
 
 
+#include <cstring>
+
+
 //##########################################################################################
 //*************************  Start GSound Utilities Namespace  *****************************
 GSOUND_UTILITIES_NAMESPACE_START
@@ -747,6 +750,183 @@ GSOUND_INLINE void destructArray( T* objects, Size number )
 
 
 
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Trivial Relocation Type Trait
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// A class whose value indicates whether or not objects of type T can be relocated by copying their bytes.
+/**
+  * An object is trivially relocatable if moving it to a new address and never
+  * calling the destructor at the old address is the same as copying its bytes.
+  * This is true of most types, including types which own heap memory through a
+  * pointer, but not of types which store a pointer into themselves. The value is
+  * FALSE unless the trait is specialized for a type.
+  */
+template < typename T >
+class IsTriviallyRelocatable
+{
+	public:
+		
+		static const Bool value = false;
+};
+
+
+
+
+/// Declare that the specified type is trivially relocatable.
+/**
+  * This macro must be used within the gsound::util namespace.
+  */
+#define GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( Type ) \
+	template <> \
+	class IsTriviallyRelocatable< Type > \
+	{ \
+		public: \
+			static const Bool value = true; \
+	};
+
+
+
+
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( bool )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( char )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( signed char )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( unsigned char )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( short )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( unsigned short )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( int )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( unsigned int )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( long )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( unsigned long )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( long long )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( unsigned long long )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( float )
+GSOUND_DECLARE_TRIVIALLY_RELOCATABLE( double )
+
+
+
+
+/// Pointers are always trivially relocatable.
+template < typename T >
+class IsTriviallyRelocatable< T* >
+{
+	public:
+		
+		static const Bool value = true;
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Object Move Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+
+
+/// Return an rvalue reference to the specified object so that it can be moved from.
+template < typename T >
+GSOUND_FORCE_INLINE T&& move( T& object )
+{
+	return static_cast<T&&>( object );
+}
+
+
+#else
+
+
+/// Return a reference to the specified object. Objects are copied without rvalue references.
+template < typename T >
+GSOUND_FORCE_INLINE T& move( T& object )
+{
+	return object;
+}
+
+
+#endif
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Object Relocation Method
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// Move the specified number of objects from the source to the destination location.
+/**
+  * The objects at the source location are destroyed and the destination location
+  * must not contain constructed objects, except where it overlaps the source.
+  * Trivially relocatable objects are moved by copying their bytes. Other objects are
+  * move-constructed at the destination, or copy-constructed if rvalue references
+  * aren't supported, and then the source objects are destroyed.
+  * 
+  * @param destination - a pointer to the memory where the objects should be moved.
+  * @param source - a pointer to the objects which should be moved.
+  * @param number - the number of objects to move.
+  */
+template < typename T >
+GSOUND_INLINE void relocate( T* destination, T* source, Size number )
+{
+	if ( IsTriviallyRelocatable<T>::value )
+		std::memmove( (void*)destination, (const void*)source, number*sizeof(T) );
+	else if ( destination < source )
+	{
+		// Move the objects in order so that overlapping objects are moved before they are overwritten.
+		const T* const sourceEnd = source + number;
+		
+		while ( source != sourceEnd )
+		{
+			new (destination) T( util::move( *source ) );
+			source->~T();
+			
+			destination++;
+			source++;
+		}
+	}
+	else if ( destination > source )
+	{
+		// Move the objects in reverse order for a destination which is after the source.
+		const T* const sourceStart = source;
+		
+		destination += number;
+		source += number;
+		
+		while ( source != sourceStart )
+		{
+			destination--;
+			source--;
+			
+			new (destination) T( util::move( *source ) );
+			source->~T();
+		}
+	}
+}
+
+
+
+
 //##########################################################################################
 //*************************  End GSound Utilities Namespace  *******************************
 GSOUND_UTILITIES_NAMESPACE_END
@@ -140,7 +140,7 @@ class ArrayList
 			GSOUND_INLINE ArrayList( const ArrayList& arrayList ) 
 				:	numElements( arrayList.numElements ),
 					capacity( arrayList.capacity ),
-					array( util::allocate<T>(arrayList.capacity) )
+					array( arrayList.capacity > 0 ? util::allocate<T>(arrayList.capacity) : NULL )
 			{
 				// copy the elements from the old array to the new array.
 				ArrayList<T>::copyObjects( array, arrayList.array, numElements );
@@ -149,6 +149,22 @@ class ArrayList
 			
 			
 			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Create an array list which takes the elements of another array list, leaving the other list empty.
+			GSOUND_INLINE ArrayList( ArrayList&& arrayList ) 
+				:	numElements( arrayList.numElements ),
+					capacity( arrayList.capacity ),
+					array( arrayList.array )
+			{
+				arrayList.numElements = 0;
+				arrayList.capacity = 0;
+				arrayList.array = NULL;
+			}
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -184,6 +200,14 @@ class ArrayList
 			
 			
 			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Replace the contents of this array list with another's elements, leaving the other list empty.
+			ArrayList& operator = ( ArrayList&& other );
+#endif
+			
+			
+			
+			
 			
 		//********************************************************************************
 		//********************************************************************************
@@ -260,6 +284,24 @@ class ArrayList
 			
 			
 			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Add an element to the end of the list, moving it into the list.
+			/** 
+			  * @param newElement - the new element to move to the end of the list
+			  */
+			GSOUND_INLINE void add( T&& newElement )
+			{
+				if ( numElements == capacity )
+					doubleCapacity();
+				
+				new (array + numElements) T( util::move( newElement ) );
+				numElements++;
+			}
+#endif
+			
+			
+			
+			
 			/// Add the contents of one ArrayList to another.
 			/**
 			  * This method has the effect of adding each element of
@@ -413,11 +455,7 @@ class ArrayList
 					
 					// Replace it with the last element if necessary.
 					if ( index != numElements )
-					{
-						T* source = array + numElements;
-						new (destination) T(*source);
-						source->~T();
-					}
+						util::relocate( destination, array + numElements, 1 );
 					
 					return true;
 				}
@@ -495,11 +533,7 @@ class ArrayList
 					
 					// Replace it with the last element if necessary.
 					if ( index != numElements )
-					{
-						T* source = array + numElements;
-						new (destination) T(*source);
-						source->~T();
-					}
+						util::relocate( destination, array + numElements, 1 );
 					
 					return true;
 				}
@@ -668,6 +702,8 @@ class ArrayList
 				{
 					if ( *element == object )
 						return true;
+					
+					element++;
 				}
 				
 				return false;
@@ -705,6 +741,8 @@ class ArrayList
 						index = element - array;
 						return true;
 					}
+					
+					element++;
 				}
 				
 				return false;
@@ -1392,7 +1430,10 @@ class ArrayList
 			
 			
 			/// Move the specified number of objects from the source to destination pointer.
-			static void moveObjects( T* destination, const T* source, Size number );
+			GSOUND_FORCE_INLINE static void moveObjects( T* destination, T* source, Size number )
+			{
+				util::relocate( destination, source, number );
+			}
 			
 			
 			
@@ -1502,6 +1543,39 @@ ArrayList<T>& ArrayList<T>:: operator = ( const ArrayList<T>& other )
 
 
 
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+
+
+template < typename T >
+ArrayList<T>& ArrayList<T>:: operator = ( ArrayList<T>&& other )
+{
+	if ( this != &other )
+	{
+		if ( array != NULL )
+		{
+			ArrayList<T>::callDestructors( array, numElements );
+			util::deallocate( array );
+		}
+		
+		// Take the other list's array.
+		numElements = other.numElements;
+		capacity = other.capacity;
+		array = other.array;
+		
+		other.numElements = 0;
+		other.capacity = 0;
+		other.array = NULL;
+	}
+	
+	return *this;
+}
+
+
+#endif
+
+
+
+
 //##########################################################################################
 //##########################################################################################
 //############		
@@ -1521,18 +1595,8 @@ Bool ArrayList<T>:: insert( const T& newElement, Index index )
 		if ( numElements == capacity )
 			doubleCapacity();
 		
-		T* destination = array + numElements;
-		const T* source = array + numElements - 1;
-		const T* const sourceEnd = array + index - 1;
-		
-		while ( source != sourceEnd )
-		{
-			new (destination) T(*source);
-			source->~T();
-			
-			source--;
-			destination--;
-		}
+		// Shift the elements after the index back by one to make room for the new element.
+		util::relocate( array + index + 1, array + index, numElements - index );
 		
 		new (array + index) T( newElement );
 		numElements++;
@@ -1677,23 +1741,25 @@ void ArrayList<T>:: copyObjects( T* destination, const T* source, Size number )
 
 
 
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Trivial Relocation Trait Specialization
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+/// An array list only points to its elements, so it can be relocated by copying its bytes.
 template < typename T >
-void ArrayList<T>:: moveObjects( T* destination, const T* source, Size number )
+class IsTriviallyRelocatable< ArrayList<T> >
 {
-	const T* const sourceEnd = source + number;
-	
-	while ( source != sourceEnd )
-	{
-		// copy the object from the source to destination
-		new (destination) T(*source);
-		
-		// call the destructors on the source
-		source->~T();
+	public:
 		
-		destination++;
-		source++;
-	}
-}
+		static const Bool value = true;
+};
 
 
 
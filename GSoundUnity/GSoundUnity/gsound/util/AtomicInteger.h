@@ -0,0 +1,241 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/AtomicInteger.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::util::AtomicInteger class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_ATOMIC_INTEGER_H
+#define INCLUDE_GSOUND_ATOMIC_INTEGER_H
+
+
+#include "GSoundUtilitiesConfig.h"
+
+
+// Include platform-specific header files
+#if defined(GSOUND_PLATFORM_WINDOWS)
+	#include <intrin.h>
+	#pragma intrinsic(_InterlockedExchange)
+	#pragma intrinsic(_InterlockedCompareExchange)
+#endif
+
+
+//##########################################################################################
+//*************************  Start GSound Utilities Namespace  *****************************
+GSOUND_UTILITIES_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which wraps a 32-bit integer that can be shared between threads without locking.
+/**
+  * The class is a wrapper around the host platform's atomic operations. Every operation
+  * is performed as a single indivisible step and acts as a full memory barrier, so that
+  * all writes made by a thread before it changes the value are visible to another thread
+  * once that thread has read the new value. None of the operations ever block, which
+  * makes the class suitable for communicating with threads that must not wait, such
+  * as an audio rendering thread.
+  */
+class AtomicInteger
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructors
+			
+			
+			
+			
+			/// Create a new atomic integer with the value 0.
+			GSOUND_INLINE AtomicInteger()
+				:	value( 0 )
+			{
+			}
+			
+			
+			
+			
+			/// Create a new atomic integer with the specified initial value.
+			GSOUND_INLINE AtomicInteger( Int32 newValue )
+				:	value( newValue )
+			{
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Value Accessor Methods
+			
+			
+			
+			
+			/// Return the current value of the atomic integer.
+			GSOUND_FORCE_INLINE Int32 get() const
+			{
+#if defined(GSOUND_PLATFORM_WINDOWS)
+				return (Int32)_InterlockedCompareExchange( const_cast<volatile long*>(&value), 0, 0 );
+#else
+				return __atomic_load_n( &value, __ATOMIC_SEQ_CST );
+#endif
+			}
+			
+			
+			
+			
+			/// Set the value of the atomic integer.
+			GSOUND_FORCE_INLINE void set( Int32 newValue )
+			{
+				this->exchange( newValue );
+			}
+			
+			
+			
+			
+			/// Set the value of the atomic integer and return the value that it had before.
+			GSOUND_FORCE_INLINE Int32 exchange( Int32 newValue )
+			{
+#if defined(GSOUND_PLATFORM_WINDOWS)
+				return (Int32)_InterlockedExchange( &value, (long)newValue );
+#else
+				return __atomic_exchange_n( &value, newValue, __ATOMIC_SEQ_CST );
+#endif
+			}
+			
+			
+			
+			
+			/// Set the value of the atomic integer only if it is equal to the expected value.
+			/**
+			  * If the value was equal to the expected value, it is replaced by the new value
+			  * and TRUE is returned. Otherwise, the value is left unchanged and FALSE is returned.
+			  */
+			GSOUND_FORCE_INLINE Bool compareAndSwap( Int32 expectedValue, Int32 newValue )
+			{
+#if defined(GSOUND_PLATFORM_WINDOWS)
+				return _InterlockedCompareExchange( &value, (long)newValue, (long)expectedValue ) == (long)expectedValue;
+#else
+				return __atomic_compare_exchange_n( &value, &expectedValue, newValue, false,
+													__ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST );
+#endif
+			}
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Copy Operations
+			
+			
+			
+			
+			/// Declared but not defined, atomic integers can't be copied.
+			AtomicInteger( const AtomicInteger& other );
+			
+			
+			
+			
+			/// Declared but not defined, atomic integers can't be copied.
+			AtomicInteger& operator = ( const AtomicInteger& other );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+#if defined(GSOUND_PLATFORM_WINDOWS)
+			/// The value of the atomic integer, stored in the type that the Interlocked functions operate on.
+			volatile long value;
+#else
+			/// The value of the atomic integer.
+			volatile Int32 value;
+#endif
+			
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//*************************  End GSound Utilities Namespace  *******************************
+GSOUND_UTILITIES_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_ATOMIC_INTEGER_H
@@ -107,6 +107,16 @@ class HashMap
 					{
 					}
 					
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+					GSOUND_INLINE Entry( Hash newKeyHash, const K& newKey, V&& newValue )
+						:	next( NULL ),
+							keyHash( newKeyHash ),
+							key( newKey ),
+							value( util::move( newValue ) )
+					{
+					}
+#endif
+					
 					Entry( const Entry& other )
 						:	keyHash( other.keyHash ),
 							key( other.key ),
@@ -137,6 +147,22 @@ class HashMap
 			
 			
 			
+			/// The raw storage of a removed entry while it waits in the free list.
+			/**
+			  * A recycled entry has been destroyed, so its memory is reinterpreted
+			  * as this plain node rather than writing to the dead entry's members.
+			  */
+			class FreeEntry
+			{
+				public:
+					
+					FreeEntry* next;
+					
+			};
+			
+			
+			
+			
 	public:
 		
 		//********************************************************************************
@@ -153,7 +179,9 @@ class HashMap
 					loadThreshold( Size(DEFAULT_LOAD_FACTOR*DEFAULT_NUMBER_OF_BUCKETS) ),
 					numElements( 0 ),
 					numBuckets( DEFAULT_NUMBER_OF_BUCKETS ),
-					buckets( util::allocate<Entry*>(DEFAULT_NUMBER_OF_BUCKETS) )
+					buckets( util::allocate<Entry*>(DEFAULT_NUMBER_OF_BUCKETS) ),
+					freeEntries( NULL ),
+					numFreeEntries( 0 )
 			{
 				nullBuckets();
 			}
@@ -166,7 +194,9 @@ class HashMap
 				:	loadFactor( math::clamp( newLoadFactor, 0.1f, 2.0f ) ),
 					numElements( 0 ),
 					numBuckets( DEFAULT_NUMBER_OF_BUCKETS ),
-					buckets( util::allocate<Entry*>(DEFAULT_NUMBER_OF_BUCKETS) )
+					buckets( util::allocate<Entry*>(DEFAULT_NUMBER_OF_BUCKETS) ),
+					freeEntries( NULL ),
+					numFreeEntries( 0 )
 			{
 				loadThreshold = loadFactor*DEFAULT_NUMBER_OF_BUCKETS;
 				nullBuckets();
@@ -179,7 +209,9 @@ class HashMap
 			GSOUND_INLINE HashMap( Hash newNumBuckets )
 				:	loadFactor( DEFAULT_LOAD_FACTOR ),
 					numElements( 0 ),
-					numBuckets( nextPrime(newNumBuckets) )
+					numBuckets( nextPrime(newNumBuckets) ),
+					freeEntries( NULL ),
+					numFreeEntries( 0 )
 			{
 				buckets = util::allocate<Entry*>(numBuckets);
 				loadThreshold = DEFAULT_LOAD_FACTOR*numBuckets;
@@ -193,7 +225,9 @@ class HashMap
 			GSOUND_INLINE HashMap( Hash newNumBuckets, Float newLoadFactor )
 				:	loadFactor( math::clamp( newLoadFactor, 0.1f, 2.0f ) ),
 					numElements( 0 ),
-					numBuckets( nextPrime(newNumBuckets) )
+					numBuckets( nextPrime(newNumBuckets) ),
+					freeEntries( NULL ),
+					numFreeEntries( 0 )
 			{
 				buckets = util::allocate<Entry*>(numBuckets);
 				loadThreshold = loadFactor*numBuckets;
@@ -214,9 +248,12 @@ class HashMap
 			/// Create a hash map with the specified load factor and number of buckets.
 			GSOUND_INLINE HashMap( const HashMap& other )
 				:	loadFactor( other.loadFactor ),
+					loadThreshold( other.loadThreshold ),
 					numElements( other.numElements ),
 					numBuckets( other.numBuckets ),
-					buckets( util::allocate<Entry*>(other.numBuckets) )
+					buckets( util::allocate<Entry*>(other.numBuckets) ),
+					freeEntries( NULL ),
+					numFreeEntries( 0 )
 			{
 				// Copy the hash table buckets
 				const Entry* const * otherBucket = other.buckets;
@@ -256,6 +293,7 @@ class HashMap
 					// Copy the parameters from the other hash map.
 					numBuckets = other.numBuckets;
 					loadFactor = other.loadFactor;
+					loadThreshold = other.loadThreshold;
 					numElements = other.numElements;
 					buckets = util::allocate<Entry*>( numBuckets );
 					
@@ -296,6 +334,7 @@ class HashMap
 			GSOUND_INLINE ~HashMap()
 			{
 				deleteBuckets( buckets, numBuckets );
+				deleteFreeEntries();
 			}
 			
 			
@@ -310,29 +349,35 @@ class HashMap
 			
 			
 			/// Add a new mapping to the hash map, associating the given key with the given value.
-			GSOUND_INLINE void add( Hash keyHash, const K& key, const V& value )
+			/**
+			  * A reference to the value stored in the map is returned. It remains valid
+			  * until the mapping is removed or the map is cleared or destroyed.
+			  */
+			GSOUND_INLINE V& add( Hash keyHash, const K& key, const V& value )
 			{
-				// Check the load constraint, if necessary, increase the size of the table.
-				if ( numElements > loadThreshold )
-					resize( nextPrime( numBuckets + 1 ) );
+				Entry** location = getNewEntryLocation( keyHash );
+				*location = newEntry( keyHash, key, value );
 				
-				// Compute the bucket for the new element.
-				Entry** bucket = buckets + keyHash % numBuckets;
-				numElements++;
+				return (*location)->value;
+			}
+			
+			
+			
+			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Add a new mapping to the hash map, moving the given value into the map.
+			/**
+			  * A reference to the value stored in the map is returned. It remains valid
+			  * until the mapping is removed or the map is cleared or destroyed.
+			  */
+			GSOUND_INLINE V& add( Hash keyHash, const K& key, V&& value )
+			{
+				Entry** location = getNewEntryLocation( keyHash );
+				*location = newEntry( keyHash, key, util::move( value ) );
 				
-				// Add the new element.
-				if ( *bucket == NULL )
-					*bucket = util::construct<Entry>( keyHash, key, value );
-				else
-				{
-					Entry* entry = *bucket;
-					
-					while ( entry->next )
-						entry = entry->next;
-					
-					entry->next = util::construct<Entry>( keyHash, key, value );
-				}
+				return (*location)->value;
 			}
+#endif
 			
 			
 			
@@ -356,7 +401,7 @@ class HashMap
 				Entry** bucket = buckets + keyHash % numBuckets;
 				
 				if ( *bucket == NULL )
-					*bucket = util::construct<Entry>( keyHash, key, value );
+					*bucket = newEntry( keyHash, key, value );
 				else
 				{
 					Entry* entry = *bucket;
@@ -378,7 +423,7 @@ class HashMap
 						}
 					}
 					
-					entry->next = util::construct<Entry>( keyHash, key, value );
+					entry->next = newEntry( keyHash, key, value );
 				}
 				
 				numElements++;
@@ -416,7 +461,7 @@ class HashMap
 						*previousNext = entry->next;
 						entry->next = NULL;
 						
-						util::destruct(entry);
+						recycleEntry( entry );
 						
 						numElements--;
 						
@@ -448,7 +493,7 @@ class HashMap
 						*previousNext = entry->next;
 						entry->next = NULL;
 						
-						util::destruct(entry);
+						recycleEntry( entry );
 						
 						numElements--;
 						
@@ -492,6 +537,9 @@ class HashMap
 				}
 				
 				numElements = 0;
+				
+				// Release the memory kept for reuse by removed entries.
+				deleteFreeEntries();
 			}
 			
 			
@@ -810,12 +858,12 @@ class HashMap
 								if ( *currentBucket != NULL )
 								{
 									currentEntry->next = NULL;
-									util::destruct( currentEntry );
+									hashMap.recycleEntry( currentEntry );
 									currentEntry = *currentBucket;
 								}
 								else
 								{
-									util::destruct( currentEntry );
+									hashMap.recycleEntry( currentEntry );
 									currentBucket++;
 									
 									advanceToNextFullBucket();
@@ -834,7 +882,7 @@ class HashMap
 								Entry* temp = currentEntry;
 								operator++();
 								temp->next = NULL;
-								util::destruct( temp );
+								hashMap.recycleEntry( temp );
 							}
 							
 							hashMap.numElements--;
@@ -865,7 +913,7 @@ class HashMap
 						/// Advance the iterator to the next non-empty bucket.
 						GSOUND_INLINE void advanceToNextFullBucket()
 						{
-							while ( *currentBucket == NULL && currentBucket != bucketsEnd )
+							while ( currentBucket != bucketsEnd && *currentBucket == NULL )
 								currentBucket++;
 							
 							if ( currentBucket == bucketsEnd )
@@ -1048,7 +1096,7 @@ class HashMap
 						/// Advance the iterator to the next non-empty bucket.
 						GSOUND_INLINE void advanceToNextFullBucket()
 						{
-							while ( *currentBucket == NULL && currentBucket != bucketsEnd )
+							while ( currentBucket != bucketsEnd && *currentBucket == NULL )
 								currentBucket++;
 							
 							if ( currentBucket == bucketsEnd )
@@ -1190,6 +1238,7 @@ class HashMap
 				{
 					Entry* oldEntry = *oldBucket;
 					
+					// The old entries are relinked, so their keys and values are neither copied nor moved.
 					while ( oldEntry )
 					{
 						Entry** bucket = buckets + oldEntry->keyHash % numBuckets;
@@ -1224,6 +1273,126 @@ class HashMap
 			
 			
 			
+			/// Return the location where a new entry with the given key hash should be linked into the table.
+			/**
+			  * The table is resized first if the load constraint requires it, and the
+			  * new entry is counted, so the caller must store the new entry at the location.
+			  */
+			GSOUND_INLINE Entry** getNewEntryLocation( Hash keyHash )
+			{
+				// Check the load constraint, if necessary, increase the size of the table.
+				if ( numElements > loadThreshold )
+					resize( nextPrime( numBuckets + 1 ) );
+				
+				// Compute the bucket for the new element.
+				Entry** bucket = buckets + keyHash % numBuckets;
+				numElements++;
+				
+				// The new element goes at the end of the bucket.
+				while ( *bucket )
+					bucket = &(*bucket)->next;
+				
+				return bucket;
+			}
+			
+			
+			
+			
+			/// Construct a new entry, reusing the memory of a previously removed entry if there is one.
+			GSOUND_INLINE Entry* newEntry( Hash keyHash, const K& key, const V& value )
+			{
+				Entry* entry = popFreeEntry();
+				
+				if ( entry == NULL )
+					return util::construct<Entry>( keyHash, key, value );
+				
+				new (entry) Entry( keyHash, key, value );
+				
+				return entry;
+			}
+			
+			
+			
+			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Construct a new entry by moving the given value, reusing the memory of a previously removed entry if there is one.
+			GSOUND_INLINE Entry* newEntry( Hash keyHash, const K& key, V&& value )
+			{
+				Entry* entry = popFreeEntry();
+				
+				if ( entry == NULL )
+					entry = util::allocate<Entry>();
+				
+				new (entry) Entry( keyHash, key, util::move( value ) );
+				
+				return entry;
+			}
+#endif
+			
+			
+			
+			
+			/// Destroy an entry which has been unlinked from its bucket and keep its memory for later reuse.
+			/**
+			  * Maps which have elements removed and added every frame then don't
+			  * need to go through the system allocator for each element. The
+			  * free list never holds more entries than the map could hold before
+			  * resizing, any further entries are deallocated.
+			  */
+			GSOUND_INLINE void recycleEntry( Entry* entry )
+			{
+				entry->~Entry();
+				
+				if ( numFreeEntries >= loadThreshold )
+				{
+					util::deallocate( entry );
+					return;
+				}
+				
+				// The entry is no longer an object, so link it through raw storage.
+				FreeEntry* freeEntry = new (entry) FreeEntry();
+				freeEntry->next = freeEntries;
+				freeEntries = freeEntry;
+				numFreeEntries++;
+			}
+			
+			
+			
+			
+			/// Unlink the memory of a previously recycled entry, or return NULL if there is none.
+			GSOUND_INLINE Entry* popFreeEntry()
+			{
+				FreeEntry* freeEntry = freeEntries;
+				
+				if ( freeEntry == NULL )
+					return NULL;
+				
+				freeEntries = freeEntry->next;
+				numFreeEntries--;
+				
+				return reinterpret_cast<Entry*>( freeEntry );
+			}
+			
+			
+			
+			
+			/// Deallocate the memory of all entries that are waiting to be reused.
+			GSOUND_INLINE void deleteFreeEntries()
+			{
+				while ( freeEntries != NULL )
+				{
+					FreeEntry* freeEntry = freeEntries;
+					freeEntries = freeEntry->next;
+					
+					util::deallocate( reinterpret_cast<Entry*>( freeEntry ) );
+				}
+				
+				numFreeEntries = 0;
+			}
+			
+			
+			
+			
 			GSOUND_INLINE void nullBuckets()
 			{
 				Entry** bucket = buckets;
@@ -1320,6 +1489,18 @@ class HashMap
 			
 			
 			
+			/// A linked list of removed entries whose memory can be reused by new entries.
+			FreeEntry* freeEntries;
+			
+			
+			
+			
+			/// The number of removed entries in the free list.
+			Size numFreeEntries;
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -106,6 +106,16 @@ class HashSet
 					}
 					
 					
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+					GSOUND_INLINE Entry( Hash newHash, T&& newValue )
+						:	next( NULL ),
+							hash( newHash ),
+							value( util::move( newValue ) )
+					{
+					}
+#endif
+					
+					
 					GSOUND_INLINE Entry( const Entry& other )
 						:	hash( other.hash ),
 							value( other.value )
@@ -313,32 +323,37 @@ class HashSet
 			  */
 			GSOUND_INLINE Bool add( Hash hash, const T& value )
 			{
-				// Compute the bucket for the new element.
-				Entry** bucket = buckets + hash % numBuckets;
+				Entry** location = getNewEntryLocation( hash, value );
 				
-				if ( *bucket == NULL )
-					*bucket = HashSet::newEntry( hash, value );
-				else
-				{
-					Entry* entry = *bucket;
-					
-					if ( entry->value == value )
-						return false;
-					
-					while ( entry->next )
-					{
-						entry = entry->next;
-						
-						if ( entry->value == value )
-							return false;
-					}
-					
-					entry->next = HashSet::newEntry( hash, value );
-				}
+				if ( location == NULL )
+					return false;
+				
+				*location = HashSet::newEntry( hash, value );
+				numElements++;
+				return true;
+			}
+			
+			
+			
+			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Add a new element to the hash set if it does not already exist, moving it into the set.
+			/**
+			  * If the element did not previously exist in the set, return TRUE.
+			  * Otherwise return FALSE and leave the element unchanged.
+			  */
+			GSOUND_INLINE Bool add( Hash hash, T&& value )
+			{
+				Entry** location = getNewEntryLocation( hash, value );
 				
+				if ( location == NULL )
+					return false;
+				
+				*location = HashSet::newEntry( hash, util::move( value ) );
 				numElements++;
 				return true;
 			}
+#endif
 			
 			
 			
@@ -668,7 +683,7 @@ class HashSet
 						/// Advance the iterator to the next non-empty bucket.
 						GSOUND_INLINE void advanceToNextFullBucket()
 						{
-							while ( *currentBucket == NULL && currentBucket != bucketsEnd )
+							while ( currentBucket != bucketsEnd && *currentBucket == NULL )
 								currentBucket++;
 							
 							if ( currentBucket == bucketsEnd )
@@ -865,7 +880,7 @@ class HashSet
 						/// Advance the iterator to the next non-empty bucket.
 						GSOUND_INLINE void advanceToNextFullBucket()
 						{
-							while ( *currentBucket == NULL && currentBucket != bucketsEnd )
+							while ( currentBucket != bucketsEnd && *currentBucket == NULL )
 								currentBucket++;
 							
 							if ( currentBucket == bucketsEnd )
@@ -995,31 +1010,44 @@ class HashSet
 				{
 					Entry* oldEntry = *oldBucket;
 					
+					// Link the old entry at the end of its new bucket, so that its value is neither copied nor moved.
 					while ( oldEntry )
 					{
 						Entry** bucket = buckets + oldEntry->hash % numBuckets;
 						
-						// Add the new element.
-						if ( *bucket == NULL )
-							*bucket = HashSet::newEntry( oldEntry->hash, oldEntry->value );
-						else
-						{
-							Entry* entry = *bucket;
-							
-							while ( entry->next )
-								entry = entry->next;
-							
-							entry->next = HashSet::newEntry( oldEntry->hash, oldEntry->value );
-						}
+						while ( *bucket )
+							bucket = &(*bucket)->next;
 						
+						*bucket = oldEntry;
 						oldEntry = oldEntry->next;
+						(*bucket)->next = NULL;
 					}
 					
 					oldBucket++;
 				}
 								
-				// deallocate all memory currently used by the old buckets
-				deleteBuckets( oldBuckets, oldNumBuckets );
+				// deallocate all memory currently used by the old bucket array
+				util::deallocate( oldBuckets );
+			}
+			
+			
+			
+			
+			/// Return the location where a new entry for the given value should be linked, or NULL if the value is already in the set.
+			GSOUND_INLINE Entry** getNewEntryLocation( Hash hash, const T& value )
+			{
+				// Compute the bucket for the new element.
+				Entry** bucket = buckets + hash % numBuckets;
+				
+				while ( *bucket )
+				{
+					if ( (*bucket)->value == value )
+						return NULL;
+					
+					bucket = &(*bucket)->next;
+				}
+				
+				return bucket;
 			}
 			
 			
@@ -1099,6 +1127,20 @@ class HashSet
 			
 			
 			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			GSOUND_INLINE static Entry* newEntry( Hash hash, T&& value )
+			{
+				Entry* result = util::allocate<Entry>();
+				
+				new (result) Entry( hash, util::move( value ) );
+				
+				return result;
+			}
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -65,7 +65,7 @@
 
 
 // Include platform-specific header files
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 	#include <pthread.h>
 #elif defined(GSOUND_PLATFORM_WINDOWS)
 	#include <Windows.h>
@@ -106,7 +106,7 @@ class Mutex:: MutexWrapper
 			
 			GSOUND_INLINE MutexWrapper()
 			{
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 				
 				// Create a new Mutex object.
 				int result = pthread_mutex_init( &mutex, NULL );
@@ -138,7 +138,7 @@ class Mutex:: MutexWrapper
 			
 			GSOUND_INLINE ~MutexWrapper()
 			{
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 				
 				// acquire the mutex before destroying it.
 				int result = pthread_mutex_lock( &mutex );
@@ -182,7 +182,7 @@ class Mutex:: MutexWrapper
 			
 			GSOUND_INLINE Bool isAvailable() const
 			{
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 				
 				// Test the mutex to see if it is available at this moment.
 				int result = pthread_mutex_trylock( &mutex );
@@ -234,7 +234,7 @@ class Mutex:: MutexWrapper
 			
 			GSOUND_INLINE void acquire()
 			{
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 				
 				int result = pthread_mutex_lock( &mutex );
 				
@@ -264,7 +264,7 @@ class Mutex:: MutexWrapper
 			
 			GSOUND_INLINE void release()
 			{
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 				
 				// Unlock the mutex.
 				int result = pthread_mutex_unlock( &mutex );
@@ -295,7 +295,7 @@ class Mutex:: MutexWrapper
 			
 			
 			
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 			
 			/// A handle to a pthread mutex object.
 			mutable pthread_mutex_t mutex;
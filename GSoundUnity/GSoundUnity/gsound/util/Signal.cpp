@@ -0,0 +1,317 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/Signal.cpp
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::util::Signal class implementation
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+
+#include "Signal.h"
+
+
+#include "Allocator.h"
+
+
+// Include platform-specific header files
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+	#include <pthread.h>
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+	#include <Windows.h>
+#endif
+
+
+//##########################################################################################
+//*************************  Start GSound Utilities Namespace  *****************************
+GSOUND_UTILITIES_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Platform-Specific Signal Wrapper Class
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+class Signal:: SignalWrapper
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			GSOUND_INLINE SignalWrapper()
+			{
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+				
+				signaled = false;
+				
+				int result = pthread_mutex_init( &mutex, NULL );
+				
+				// Make sure that an error has not been encountered.
+				GSOUND_ASSERT_MESSAGE( result == 0, "An error was encountered while creating a Signal object." );
+				
+				result = pthread_cond_init( &condition, NULL );
+				
+				// Make sure that an error has not been encountered.
+				GSOUND_ASSERT_MESSAGE( result == 0, "An error was encountered while creating a Signal object." );
+				
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+				
+				// Create an auto-reset event which is released by each wait.
+				event = CreateEvent( NULL, FALSE, FALSE, NULL );
+				
+				// Make sure that an error has not been encountered.
+				GSOUND_ASSERT_MESSAGE( event != NULL, "An error was encountered while creating a Signal object." );
+				
+#endif
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Destructor
+			
+			
+			
+			
+			GSOUND_INLINE ~SignalWrapper()
+			{
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+				
+				pthread_cond_destroy( &condition );
+				pthread_mutex_destroy( &mutex );
+				
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+				
+				CloseHandle( event );
+				
+#endif
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Signal Method
+			
+			
+			
+			
+			GSOUND_INLINE void signal()
+			{
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+				
+				pthread_mutex_lock( &mutex );
+				signaled = true;
+				pthread_cond_signal( &condition );
+				pthread_mutex_unlock( &mutex );
+				
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+				
+				BOOL success = SetEvent( event );
+				
+				// Make sure that an error has not been encountered.
+				GSOUND_ASSERT_MESSAGE( success != 0, "An error was encountered while signaling a Signal object." );
+				
+#endif
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Wait Method
+			
+			
+			
+			
+			GSOUND_INLINE void wait()
+			{
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+				
+				pthread_mutex_lock( &mutex );
+				
+				// Condition variables can wake up spuriously, so wait until the flag is set.
+				while ( !signaled )
+					pthread_cond_wait( &condition, &mutex );
+				
+				signaled = false;
+				pthread_mutex_unlock( &mutex );
+				
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+				
+				DWORD result = WaitForSingleObject( event, INFINITE );
+				
+				// Make sure that an error has not been encountered.
+				GSOUND_ASSERT_MESSAGE( result == WAIT_OBJECT_0, "An error was encountered while waiting on a Signal object." );
+				
+#endif
+			}
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+			
+			/// A mutex which protects the signaled flag.
+			pthread_mutex_t mutex;
+			
+			
+			
+			
+			/// A condition variable which waiting threads block on.
+			pthread_cond_t condition;
+			
+			
+			
+			
+			/// Whether or not a signal has been sent that no thread has consumed yet.
+			Bool signaled;
+			
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+			
+			/// A handle to a windows auto-reset event object.
+			HANDLE event;
+			
+#endif
+			
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Platform-Independent Code
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Signal:: Signal()
+	:	wrapper( util::construct<SignalWrapper>() )
+{
+}
+
+
+
+
+Signal:: ~Signal()
+{
+	// Destroy the wrapper object.
+	util::destruct( wrapper );
+}
+
+
+
+
+void Signal:: signal()
+{
+	wrapper->signal();
+}
+
+
+
+
+void Signal:: wait()
+{
+	wrapper->wait();
+}
+
+
+
+
+//##########################################################################################
+//*************************  End GSound Utilities Namespace  *******************************
+GSOUND_UTILITIES_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
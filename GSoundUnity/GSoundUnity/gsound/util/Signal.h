@@ -0,0 +1,207 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/Signal.h
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::util::Signal class declaration
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+#ifndef INCLUDE_GSOUND_SIGNAL_H
+#define INCLUDE_GSOUND_SIGNAL_H
+
+
+#include "GSoundUtilitiesConfig.h"
+
+
+//##########################################################################################
+//*************************  Start GSound Utilities Namespace  *****************************
+GSOUND_UTILITIES_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which lets one thread block until another thread signals it.
+/** 
+  * The class is a thin wrapper around the host platform's event facilities.
+  * A thread calls wait() to block until another thread calls signal(). A signal
+  * is remembered until a waiting thread consumes it, so a thread that starts
+  * waiting after the signal was sent returns immediately. Each signal wakes at
+  * most one waiting thread, and several signals sent before a thread waits are
+  * consumed by a single wait.
+  */
+class Signal
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			/// Create a new signal which has not been signaled.
+			Signal();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Destructor
+			
+			
+			
+			
+			/// Destroy a Signal object. No thread should be waiting on it.
+			~Signal();
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Signal and Wait Methods
+			
+			
+			
+			
+			/// Signal the object, waking one thread that is waiting on it.
+			/**
+			  * If no thread is waiting, the signal is remembered and the next call
+			  * to wait() returns immediately.
+			  */
+			void signal();
+			
+			
+			
+			
+			/// Block the calling thread until the object is signaled, then consume the signal.
+			void wait();
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Copy Operations
+			
+			
+			
+			
+			/// Declared but not defined, signal objects can't be copied.
+			Signal( const Signal& other );
+			
+			
+			
+			
+			/// Declared but not defined, signal objects can't be copied.
+			Signal& operator = ( const Signal& other );
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Signal Wrapper Class Declaration
+			
+			
+			
+			
+			/// A class which encapsulates internal platform-specific signal code.
+			class SignalWrapper;
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// A pointer to a wrapper object containing the internal state of the signal.
+			SignalWrapper* wrapper;
+			
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//*************************  End GSound Utilities Namespace  *******************************
+GSOUND_UTILITIES_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
+
+
+#endif // INCLUDE_GSOUND_SIGNAL_H
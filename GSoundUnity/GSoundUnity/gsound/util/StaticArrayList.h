@@ -65,6 +65,9 @@
 #include "GSoundUtilitiesConfig.h"
 
 
+#include "Allocator.h"
+
+
 //##########################################################################################
 //*************************  Start GSound Utilities Namespace  *****************************
 GSOUND_UTILITIES_NAMESPACE_START
@@ -82,6 +85,10 @@ GSOUND_UTILITIES_NAMESPACE_START
   * The StaticArrayList class allows basic list operations: add(), remove(),
   * insert(), clear() and getSize(). Once the static capacity of the list is
   * reached, no more elements can be added to the list.
+  *
+  * The list's element pointer refers to storage inside the list object itself,
+  * so a StaticArrayList is never trivially relocatable and must be moved or
+  * copied through its constructors and assignment operators.
   */
 template < typename T, Size capacity >
 class StaticArrayList
@@ -117,6 +124,84 @@ class StaticArrayList
 			
 			
 			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Create a static array list which takes the elements of another list, leaving the other list empty.
+			GSOUND_INLINE StaticArrayList( StaticArrayList&& otherArray )
+				:	numElements( otherArray.numElements ),
+					array( (T*)data )
+			{
+				StaticArrayList::moveObjects( array, otherArray.array, otherArray.numElements );
+				otherArray.numElements = 0;
+			}
+#endif
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Destructor
+			
+			
+			
+			
+			/// Destroy a static array list, calling the destructors of its elements.
+			GSOUND_INLINE ~StaticArrayList()
+			{
+				StaticArrayList::callDestructors( array, numElements );
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Assignment Operators
+			
+			
+			
+			
+			/// Assign the contents of another static array list to this one, performing a deep copy.
+			/**
+			  * The list's array pointer refers to its own storage, so it must not be copied
+			  * from the other list.
+			  */
+			GSOUND_INLINE StaticArrayList& operator = ( const StaticArrayList& other )
+			{
+				if ( this != &other )
+				{
+					StaticArrayList::callDestructors( array, numElements );
+					StaticArrayList::copyObjects( array, other.array, other.numElements );
+					numElements = other.numElements;
+				}
+				
+				return *this;
+			}
+			
+			
+			
+			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Replace the contents of this static array list with another's elements, leaving the other list empty.
+			GSOUND_INLINE StaticArrayList& operator = ( StaticArrayList&& other )
+			{
+				if ( this != &other )
+				{
+					StaticArrayList::callDestructors( array, numElements );
+					StaticArrayList::moveObjects( array, other.array, other.numElements );
+					numElements = other.numElements;
+					other.numElements = 0;
+				}
+				
+				return *this;
+			}
+#endif
+			
+			
+			
+			
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
@@ -197,6 +282,32 @@ class StaticArrayList
 			
 			
 			
+#if GSOUND_RVALUE_REFERENCES_ARE_SUPPORTED
+			/// Add an element to the end of the static array list, moving it into the list.
+			/** 
+			  * If the static array list is full, then FALSE is returned and the
+			  * element is not moved.
+			  * 
+			  * @param newElement - the new element to move to the end of the static array list.
+			  * @return whether or not the element was successfully added.
+			  */
+			GSOUND_INLINE Bool add( T&& newElement )
+			{
+				if ( numElements != capacity )
+				{
+					new (array + numElements) T( util::move( newElement ) );
+					numElements++;
+					
+					return true;
+				}
+				else
+					return false;
+			}
+#endif
+			
+			
+			
+			
 			/// Add the contents of one static array list to another.
 			/**
 			  * This method has the effect of adding each element of
@@ -240,18 +351,8 @@ class StaticArrayList
 			{
 				if ( index >= 0 && index <= numElements && numElements != capacity )
 				{
-					T* destination = array + numElements;
-					const T* source = array + numElements - 1;
-					const T* const sourceEnd = array + index - 1;
-					
-					while ( source != sourceEnd )
-					{
-						new (destination) T(*source);
-						source->~T();
-						
-						source--;
-						destination--;
-					}
+					// Shift the elements after the index back by one to make room for the new element.
+					StaticArrayList::moveObjects( array + index + 1, array + index, numElements - index );
 					
 					new (array + index) T( newElement );
 					numElements++;
@@ -376,11 +477,7 @@ class StaticArrayList
 					
 					// Replace it with the last element if necessary.
 					if ( index != numElements )
-					{
-						T* source = array + numElements;
-						new (destination) T(*source);
-						source->~T();
-					}
+						StaticArrayList::moveObjects( destination, array + numElements, 1 );
 					
 					return true;
 				}
@@ -458,11 +555,7 @@ class StaticArrayList
 					
 					// Replace it with the last element if necessary.
 					if ( index != numElements )
-					{
-						T* source = array + numElements;
-						new (destination) T(*source);
-						source->~T();
-					}
+						StaticArrayList::moveObjects( destination, array + numElements, 1 );
 					
 					return true;
 				}
@@ -517,7 +610,7 @@ class StaticArrayList
 				numElements -= number;
 				
 				// destroy the elements that were removed.
-				ArrayList<T>::callDestructors( array + numElements, number );
+				StaticArrayList::callDestructors( array + numElements, number );
 				
 				return number;
 			}
@@ -581,6 +674,8 @@ class StaticArrayList
 				{
 					if ( *element == anElement )
 						return true;
+					
+					element++;
 				}
 				
 				return false;
@@ -618,6 +713,8 @@ class StaticArrayList
 						index = element - array;
 						return true;
 					}
+					
+					element++;
 				}
 				
 				return false;
@@ -1261,21 +1358,9 @@ class StaticArrayList
 			
 			
 			
-			GSOUND_INLINE static void moveObjects( T* destination, const T* source, Size number )
+			GSOUND_INLINE static void moveObjects( T* destination, T* source, Size number )
 			{
-				const T* const sourceEnd = source + number;
-				
-				while ( source != sourceEnd )
-				{
-					// copy the object from the source to destination
-					new (destination) T(*source);
-					
-					// call the destructors on the source
-					source->~T();
-					
-					destination++;
-					source++;
-				}
+				util::relocate( destination, source, number );
 			}
 			
 			
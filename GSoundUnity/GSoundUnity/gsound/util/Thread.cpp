@@ -0,0 +1,368 @@
+/*
+ * Project:     GSound
+ * 
+ * File:        gsound/Thread.cpp
+ * 
+ * Version:     1.0.0
+ * 
+ * Contents:    gsound::util::Thread class implementation
+ * 
+ * License:
+ * 
+ *     Copyright (C) 2010-12 Carl Schissler, University of North Carolina at Chapel Hill.
+ *     All rights reserved.
+ *     
+ *     Permission to use, copy, modify, and distribute this software and its
+ *     documentation for educational, research, and non-profit purposes, without
+ *     fee, and without a written agreement is hereby granted, provided that the
+ *     above copyright notice, this paragraph, and the following four paragraphs
+ *     appear in all copies.
+ *     
+ *     Permission to incorporate this software into commercial products may be
+ *     obtained by contacting the University of North Carolina at Chapel Hill.
+ *     
+ *     This software program and documentation are copyrighted by Carl Schissler and
+ *     the University of North Carolina at Chapel Hill. The software program and
+ *     documentation are supplied "as is", without any accompanying services from
+ *     the University of North Carolina at Chapel Hill or the authors. The University
+ *     of North Carolina at Chapel Hill and the authors do not warrant that the
+ *     operation of the program will be uninterrupted or error-free. The end-user
+ *     understands that the program was developed for research purposes and is advised
+ *     not to rely exclusively on the program for any reason.
+ *     
+ *     IN NO EVENT SHALL THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR ITS
+ *     EMPLOYEES OR THE AUTHORS BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ *     SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES, INCLUDING LOST PROFITS,
+ *     ARISING OUT OF THE USE OF THIS SOFTWARE AND ITS DOCUMENTATION, EVEN IF THE
+ *     UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL OR THE AUTHORS HAVE BEEN ADVISED
+ *     OF THE POSSIBILITY OF SUCH DAMAGE.
+ *     
+ *     THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND THE AUTHORS SPECIFICALLY
+ *     DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *     WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE AND ANY
+ *     STATUTORY WARRANTY OF NON-INFRINGEMENT. THE SOFTWARE PROVIDED HEREUNDER IS
+ *     ON AN "AS IS" BASIS, AND THE UNIVERSITY OF NORTH CAROLINA AT CHAPEL HILL AND
+ *     THE AUTHORS HAVE NO OBLIGATIONS TO PROVIDE MAINTENANCE, SUPPORT, UPDATES,
+ *     ENHANCEMENTS, OR MODIFICATIONS.
+ * 
+ * 
+ * Contact Information:
+ *     
+ *     Please send all bug reports and other contact to:
+ *     Carl Schissler
+ *     carl.schissler@gmail.com
+ * 
+ *     Updates and downloads are available at the main GSound web page:
+ *     http://gamma.cs.unc.edu/GSOUND/
+ * 
+ */
+
+
+
+#include "Thread.h"
+
+
+#include "Allocator.h"
+
+
+// Include platform-specific header files
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+	#include <pthread.h>
+	#include <unistd.h>
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+	#include <Windows.h>
+#endif
+
+
+//##########################################################################################
+//*************************  Start GSound Utilities Namespace  *****************************
+GSOUND_UTILITIES_NAMESPACE_START
+//******************************************************************************************
+//##########################################################################################
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Platform-Specific Thread Wrapper Class
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+class Thread:: ThreadWrapper
+{
+	public:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Constructor
+			
+			
+			
+			
+			GSOUND_INLINE ThreadWrapper()
+				:	function( NULL ),
+					data( NULL )
+			{
+#if defined(GSOUND_PLATFORM_WINDOWS)
+				thread = NULL;
+#endif
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Thread Start Method
+			
+			
+			
+			
+			GSOUND_INLINE Bool start( Function newFunction, void* newData )
+			{
+				function = newFunction;
+				data = newData;
+				
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+				
+				// Create a new thread which starts executing the entry point function.
+				return pthread_create( &thread, NULL, threadEntry, this ) == 0;
+				
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+				
+				// Create a new thread which starts executing the entry point function.
+				thread = CreateThread( NULL, 0, threadEntry, this, 0, NULL );
+				
+				return thread != NULL;
+				
+#else
+				return false;
+#endif
+			}
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Thread Join Method
+			
+			
+			
+			
+			GSOUND_INLINE void join()
+			{
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+				
+				// Wait for the thread to finish.
+				int result = pthread_join( thread, NULL );
+				
+				// Make sure that an error has not been encountered.
+				GSOUND_ASSERT_MESSAGE( result == 0, "An error was encountered while joining a Thread object." );
+				
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+				
+				// Wait for the thread to finish.
+				DWORD result = WaitForSingleObject( thread, INFINITE );
+				
+				// Make sure that an error has not been encountered.
+				GSOUND_ASSERT_MESSAGE( result == WAIT_OBJECT_0, "An error was encountered while joining a Thread object." );
+				
+				// Release the thread's handle.
+				CloseHandle( thread );
+				thread = NULL;
+				
+#endif
+			}
+			
+			
+			
+			
+	private:
+		
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Static Thread Entry Point
+			
+			
+			
+			
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+			
+			static void* threadEntry( void* wrapper )
+			{
+				ThreadWrapper* threadWrapper = (ThreadWrapper*)wrapper;
+				threadWrapper->function( threadWrapper->data );
+				
+				return NULL;
+			}
+			
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+			
+			static DWORD WINAPI threadEntry( LPVOID wrapper )
+			{
+				ThreadWrapper* threadWrapper = (ThreadWrapper*)wrapper;
+				threadWrapper->function( threadWrapper->data );
+				
+				return 0;
+			}
+			
+#endif
+			
+			
+			
+			
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Private Data Members
+			
+			
+			
+			
+			/// The function which the thread is executing.
+			Function function;
+			
+			
+			
+			
+			/// The user data which is passed to the thread's function.
+			void* data;
+			
+			
+			
+			
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+			
+			/// A handle to a pthread thread object.
+			pthread_t thread;
+			
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+			
+			/// A handle to a windows thread object.
+			HANDLE thread;
+			
+#endif
+			
+			
+			
+			
+};
+
+
+
+
+//##########################################################################################
+//##########################################################################################
+//############		
+//############		Platform-Independent Code
+//############		
+//##########################################################################################
+//##########################################################################################
+
+
+
+
+Thread:: Thread()
+	:	wrapper( util::construct<ThreadWrapper>() ),
+		running( false )
+{
+}
+
+
+
+
+Thread:: ~Thread()
+{
+	// Make sure that the thread is finished before its state is destroyed.
+	join();
+	
+	// Destroy the wrapper object.
+	util::destruct( wrapper );
+}
+
+
+
+
+Bool Thread:: start( Function function, void* data )
+{
+	if ( running || function == NULL )
+		return false;
+	
+	running = wrapper->start( function, data );
+	
+	return running;
+}
+
+
+
+
+void Thread:: join()
+{
+	if ( !running )
+		return;
+	
+	wrapper->join();
+	running = false;
+}
+
+
+
+
+Size Thread:: getNumberOfProcessors()
+{
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+	
+	long numProcessors = sysconf( _SC_NPROCESSORS_ONLN );
+	
+	return numProcessors > 0 ? Size(numProcessors) : Size(1);
+	
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+	
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo( &systemInfo );
+	
+	return systemInfo.dwNumberOfProcessors > 0 ? Size(systemInfo.dwNumberOfProcessors) : Size(1);
+	
+#else
+	return 1;
+#endif
+}
+
+
+
+
+void Thread:: sleep( Double seconds )
+{
+	if ( seconds <= 0.0 )
+		return;
+	
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
+	
+	usleep( useconds_t(seconds*1000000.0) );
+	
+#elif defined(GSOUND_PLATFORM_WINDOWS)
+	
+	Sleep( DWORD(seconds*1000.0) );
+	
+#endif
+}
+
+
+
+
+//##########################################################################################
+//*************************  End GSound Utilities Namespace  *******************************
+GSOUND_UTILITIES_NAMESPACE_END
+//******************************************************************************************
+//##########################################################################################
@@ -1,11 +1,11 @@
 /*
  * Project:     GSound
  * 
- * File:        gsound/internal/SphereTree.h
+ * File:        gsound/Thread.h
  * 
  * Version:     1.0.0
  * 
- * Contents:    gsound::internal::SphereTree class declaration
+ * Contents:    gsound::util::Thread class declaration
  * 
  * License:
  * 
@@ -58,58 +58,51 @@
  */
 
 
-#ifndef INCLUDE_GSOUND_SPHERE_TREE_H
-#define INCLUDE_GSOUND_SPHERE_TREE_H
 
+#ifndef INCLUDE_GSOUND_THREAD_H
+#define INCLUDE_GSOUND_THREAD_H
 
-#include "GSoundInternalConfig.h"
 
-
-#include "../SoundObject.h"
-#include "BoundingSphere.h"
+#include "GSoundUtilitiesConfig.h"
 
 
 //##########################################################################################
-//**************************  Start GSound Internal Namespace  *****************************
-GSOUND_INTERNAL_NAMESPACE_START
+//*************************  Start GSound Utilities Namespace  *****************************
+GSOUND_UTILITIES_NAMESPACE_START
 //******************************************************************************************
 //##########################################################################################
 
 
 
 
-class SphereTree
+//********************************************************************************
+//********************************************************************************
+//********************************************************************************
+/// A class which runs a function on a separate thread of execution.
+/** 
+  * The class is a thin wrapper around the host platform's thread facilities.
+  * A thread is started by calling start() with a function and a pointer to
+  * user data which is passed to that function. The join() method blocks the
+  * calling thread until the function has returned. A Thread object can be
+  * started again after it has been joined.
+  *
+  * If a Thread object is destroyed while it is still running, the destructor
+  * waits for the thread to finish.
+  */
+class Thread
 {
 	public:
 		
-		
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Constructors
-			
-			
-			
-			
-			GSOUND_INLINE SphereTree( ArrayList<SoundObject*>& objects )
-				:	object( NULL ),
-					left( NULL ),
-					right( NULL )
-			{
-				generateTree( objects );
-			}
+		//******	Public Type Declarations
 			
 			
 			
 			
-			GSOUND_INLINE SphereTree( const SphereTree& other )
-				:	object( other.object ),
-					left( other.left ? util::construct<SphereTree>(*other.left) : NULL ),
-					right( other.right ? util::construct<SphereTree>(*other.right) : NULL ),
-					boundingVolume( other.boundingVolume )
-			{
-			}
-			
+			/// The type of function that can be executed by a thread.
+			typedef void (*Function)( void* data );
 			
 			
 			
@@ -117,12 +110,13 @@ class SphereTree
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Destructor
+		//******	Constructor
 			
 			
 			
 			
-			~SphereTree();
+			/// Create a new thread object which is not running.
+			Thread();
 			
 			
 			
@@ -130,29 +124,13 @@ class SphereTree
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Assignment Operator
+		//******	Destructor
 			
 			
 			
 			
-			GSOUND_INLINE SphereTree& operator = ( const SphereTree& other )
-			{
-				if ( &other != this )
-				{
-					if ( left != NULL )
-						util::destruct(left);
-					
-					if ( right != NULL )
-						util::destruct(right);
-					
-					left = other.left ? util::construct<SphereTree>(*other.left) : NULL;
-					right = other.right ? util::construct<SphereTree>(*other.right) : NULL;
-					object = other.object;
-					boundingVolume = other.boundingVolume;
-				}
-				
-				return *this;
-			}
+			/// Destroy a Thread object, waiting for it to finish if it is still running.
+			~Thread();
 			
 			
 			
@@ -160,45 +138,47 @@ class SphereTree
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Property Accessor Methods
+		//******	Thread Start and Join Methods
 			
 			
 			
 			
-			GSOUND_INLINE const SphereTree* getLeftChild() const
-			{
-				return left;
-			}
-			
-			
-			
-			GSOUND_INLINE const SphereTree* getRightChild() const
-			{
-				return right;
-			}
+			/// Start executing the specified function with the given data on a new thread.
+			/**
+			  * If the thread is already running, or if the new thread could not be
+			  * created, FALSE is returned and the function is not executed.
+			  * Otherwise, TRUE is returned.
+			  * 
+			  * @param function - the function to execute on the new thread.
+			  * @param data - a pointer which is passed to the function when it is executed.
+			  * @return whether or not the thread was successfully started.
+			  */
+			Bool start( Function function, void* data );
 			
 			
 			
 			
-			GSOUND_INLINE SoundObject* getObject() const
-			{
-				return object;
-			}
+			/// Block the calling thread until this thread's function has returned.
+			/**
+			  * If the thread is not running, this method has no effect.
+			  */
+			void join();
 			
 			
 			
 			
-			GSOUND_INLINE Bool isLeaf() const
-			{
-				return object != NULL;
-			}
+		//********************************************************************************
+		//********************************************************************************
+		//********************************************************************************
+		//******	Thread Status Accessor Method
 			
 			
 			
 			
-			GSOUND_INLINE const BoundingSphere& getVolume() const
+			/// Return whether or not the thread has been started and not yet joined.
+			GSOUND_INLINE Bool isRunning() const
 			{
-				return boundingVolume;
+				return running;
 			}
 			
 			
@@ -207,75 +187,52 @@ class SphereTree
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Tree Update Method
+		//******	Processor Count Accessor Method
 			
 			
 			
 			
-			/// Update the bounding volumes of this BVH so that they are consistent with new object sizes/positions.
+			/// Return the number of logical processors that are available on the host system.
 			/**
-			  * This method does not change the internal structure of the tree and thus
-			  * will not provide an optimally-split BVH. However, it is much faster to call
-			  * this method than to rebuild the entire BVH.
+			  * If the number of processors can't be determined, 1 is returned.
 			  */
-			void update();
+			static Size getNumberOfProcessors();
 			
 			
 			
 			
-	private:
-		
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Private Constructors
-			
-			
-			
-			
-			GSOUND_INLINE SphereTree()
-				:	object( NULL ),
-					left( NULL ),
-					right( NULL )
-			{
-			}
+		//******	Sleep Method
 			
 			
 			
 			
-			GSOUND_INLINE SphereTree( SoundObject* newObject, const BoundingSphere& newBoundingVolume )
-				:	object( newObject ),
-					boundingVolume( newBoundingVolume ),
-					left( NULL ),
-					right( NULL )
-			{
-			}
+			/// Suspend the calling thread for at least the specified number of seconds.
+			static void sleep( Double seconds );
 			
 			
 			
 			
+	private:
+		
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Tree Generation Helper Method
+		//******	Private Copy Operations
 			
 			
 			
 			
-			void generateTree( ArrayList<SoundObject*>& objects );
+			/// Declared but not defined, thread objects can't be copied.
+			Thread( const Thread& other );
 			
 			
 			
 			
-		//********************************************************************************
-		//********************************************************************************
-		//********************************************************************************
-		//******	Node Generation Method
-			
-			
-			
-			
-			void generateNode( ArrayList<SoundObject*>& objects, Index start, Index end, Index splitAxis );
+			/// Declared but not defined, thread objects can't be copied.
+			Thread& operator = ( const Thread& other );
 			
 			
 			
@@ -283,13 +240,13 @@ class SphereTree
 		//********************************************************************************
 		//********************************************************************************
 		//********************************************************************************
-		//******	Median-Point Split Method
+		//******	Private Thread Wrapper Class Declaration
 			
 			
 			
 			
-			static void medianPointSplit( ArrayList<SoundObject*>& objects,
-										Index start, Index end, Size dimension );
+			/// A class which encapsulates internal platform-specific thread code.
+			class ThreadWrapper;
 			
 			
 			
@@ -302,23 +259,14 @@ class SphereTree
 			
 			
 			
-			BoundingSphere boundingVolume;
-			
-			
-			
+			/// A pointer to a wrapper object containing the internal state of the thread.
+			ThreadWrapper* wrapper;
 			
 			
-			SoundObject* object;
 			
 			
-			
-			
-			SphereTree* left;
-			
-			
-			
-			
-			SphereTree* right;
+			/// Whether or not the thread has been started and not yet joined.
+			Bool running;
 			
 			
 			
@@ -328,12 +276,11 @@ class SphereTree
 
 
 
-
 //##########################################################################################
-//**************************  End GSound Internal Namespace  *******************************
-GSOUND_INTERNAL_NAMESPACE_END
+//*************************  End GSound Utilities Namespace  *******************************
+GSOUND_UTILITIES_NAMESPACE_END
 //******************************************************************************************
 //##########################################################################################
 
 
-#endif // INCLUDE_GSOUND_SPHERE_TREE_H
+#endif // INCLUDE_GSOUND_THREAD_H
@@ -61,7 +61,7 @@
 #include "Timer.h"
 
 
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 	#include <sys/time.h>
 	
 #elif defined(GSOUND_PLATFORM_WINDOWS)
@@ -111,7 +111,7 @@ GSOUND_UTILITIES_NAMESPACE_START
 
 Double Timer:: getTime()
 {
-#if defined(GSOUND_PLATFORM_APPLE)
+#if defined(GSOUND_PLATFORM_APPLE) || defined(GSOUND_PLATFORM_LINUX)
 	
 	// A struct representing the current state of the system timer on Mac OS X.
 	timeval timeData;